@@ -301,6 +301,103 @@ static uint8_t output_from_address(uint32_t i, uint8_t is_higher_half) {
                                : alu_zero_flag) |
                ((uint8_t)(half_q << 4));
     }
+
+    case ALU_OP_ROL_LS: {
+        uint8_t q = (uint8_t)(half_A << 1) | other_half_carry;
+        uint8_t half_q = q & 0xf;
+        uint8_t half_zero = !half_q ? HALF_ZERO_FLAG_SET : 0;
+        uint8_t half_carry = (half_A & 0x8) ? HALF_CARRY_FLAG_SET : 0;
+
+        uint8_t alu_zero_flag =
+            half_zero && other_half_zero ? ZERO_FLAG_SET : 0;
+
+        uint8_t alu_carry_flag =
+            is_higher_half && half_carry ? CARRY_FLAG_SET : 0;
+
+        uint8_t alu_overflow_flag = 0; // Clear unconditionally
+
+        return half_zero | half_carry |
+               (is_higher_half ? alu_overflow_flag | alu_carry_flag
+                               : alu_zero_flag) |
+               ((uint8_t)(half_q << 4));
+    }
+
+    case ALU_OP_SAR_LS: {
+        uint8_t q = is_higher_half
+                        ? (half_A & 0x8) | (half_A >> 1) // Keep the sign
+                        : (uint8_t)(other_half_carry << 3) | (half_A >> 1);
+        uint8_t half_q = q & 0xf;
+        uint8_t half_zero = !half_q ? HALF_ZERO_FLAG_SET : 0;
+        uint8_t half_carry = (half_A & 1) ? HALF_CARRY_FLAG_SET : 0;
+
+        uint8_t alu_zero_flag =
+            half_zero && other_half_zero ? ZERO_FLAG_SET : 0;
+
+        uint8_t alu_carry_flag =
+            is_higher_half && other_half_carry ? CARRY_FLAG_SET : 0;
+
+        uint8_t alu_overflow_flag = 0; // Clear unconditionally
+
+        return half_zero | half_carry |
+               (is_higher_half ? alu_overflow_flag | alu_carry_flag
+                               : alu_zero_flag) |
+               ((uint8_t)(half_q << 4));
+    }
+
+    case ALU_OP_LS_SBC_RS: {
+        uint8_t q = is_higher_half ? (uint8_t)(half_A - (half_B + other_half_carry))
+                                   : (uint8_t)(half_A - (half_B + global_carry));
+        uint8_t half_q = q & 0xf;
+        uint8_t half_zero = half_q == 0 ? HALF_ZERO_FLAG_SET : 0;
+        uint8_t half_carry = (q & 0x10) ? HALF_CARRY_FLAG_SET : 0;
+
+        uint8_t alu_zero_flag =
+            (half_zero && other_half_zero) ? ZERO_FLAG_SET : 0;
+
+        uint8_t alu_carry_flag = half_carry ? CARRY_FLAG_SET : 0;
+
+        uint8_t a_sign = (half_A >> 3);
+        uint8_t b_sign = (half_B >> 3);
+        uint8_t sum_sign = (half_q >> 3);
+
+        uint8_t alu_overflow_flag =
+            ((!a_sign && b_sign && sum_sign) || (a_sign && !b_sign && !sum_sign))
+                ? OVERFLOW_FLAG_SET
+                : 0;
+
+        return half_zero | half_carry |
+               (is_higher_half ? alu_overflow_flag | alu_carry_flag
+                               : alu_zero_flag) |
+               ((uint8_t)(half_q << 4));
+    }
+
+    case ALU_OP_LS_ADD_RS_IF_CF: {
+        uint8_t half_b = global_carry ? half_B : 0;
+        uint8_t q = is_higher_half ? half_A + half_b + other_half_carry
+                                   : half_A + half_b;
+        uint8_t half_q = q & 0xf;
+        uint8_t half_zero = !half_q ? HALF_ZERO_FLAG_SET : 0;
+        uint8_t half_carry = (q & 0x10) ? HALF_CARRY_FLAG_SET : 0;
+
+        uint8_t alu_zero_flag =
+            half_zero && other_half_zero ? ZERO_FLAG_SET : 0;
+
+        uint8_t alu_carry_flag = half_carry ? CARRY_FLAG_SET : 0;
+
+        uint8_t a_sign = (half_A >> 3);
+        uint8_t b_sign = (half_b >> 3);
+        uint8_t sum_sign = (half_q >> 3);
+
+        uint8_t alu_overflow_flag =
+            ((!a_sign && !b_sign && sum_sign) || (a_sign && b_sign && !sum_sign))
+                ? OVERFLOW_FLAG_SET
+                : 0x0;
+
+        return half_zero | half_carry |
+               (is_higher_half ? alu_overflow_flag | alu_carry_flag
+                               : alu_zero_flag) |
+               ((uint8_t)(half_q << 4));
+    }
     }
 
     return 0;
@@ -325,12 +422,11 @@ static int write_to_file(const char *filename,
 
     if (fwrite(*table, sizeof(*table), 1, file) == 0) {
         perror(__func__);
+        fclose(file);
         return 2;
     }
 
-    fclose(file);
-
-    return ferror(file);
+    return fclose(file) == 0 ? 0 : 3;
 }
 
 int main(void) {
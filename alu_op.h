@@ -9,7 +9,6 @@ typedef enum {
     ALU_OP_NOT_LS,
     ALU_OP_DEC_LS,
     ALU_OP_ROR_LS,
-    // ALU_OP_ROL_LS,
 
     // Binary operations
     ALU_OP_LS_ADD_RS,
@@ -19,6 +18,12 @@ typedef enum {
     ALU_OP_LS_ADC_RS,
     ALU_OP_LS_SUB_RS,
 
+    // Extended operations, after the above to keep their numbering
+    ALU_OP_ROL_LS,
+    ALU_OP_SAR_LS,
+    ALU_OP_LS_SBC_RS,
+    ALU_OP_LS_ADD_RS_IF_CF, // Multiply step, RS is only added when CF is set
+
     // Special operations
     ALU_OP_SET_IO_OE_FLAG = 31 // Important to be above 0xf to not clash with any constant addresses
 } ALU_OP;
@@ -0,0 +1,581 @@
+#ifndef BOOT_DEVICE_H
+#define BOOT_DEVICE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "boot_protocol.h"
+
+// The boot device without the board: the program being uploaded over serial and
+// the boot frames served from it, shared by the sketch, the emulator and
+// boot_device_pty.c. Serial bytes are fed one at a time as they arrive, so a
+// frame is parsed while the rest of it is still on the line.
+//
+// The program goes into a ring of BOOT_DEVICE_RING_SIZE bytes, a boot frame per
+// slot. A slot is written again once the loader has acknowledged its frame, so a
+// program bigger than the ring is booted while it is being uploaded, the loader
+// reading BOOT_NOT_READY in place of a frame that is not uploaded yet. A program
+// that fits is kept and can be booted again.
+//
+// Uploads are binary frames:
+//
+//   UPLOAD_SOF
+//   type, UPLOAD_BEGIN, UPLOAD_DATA or UPLOAD_END
+//   sequence number, 0 for UPLOAD_BEGIN and one more per frame after it
+//   number of data bytes, up to UPLOAD_FRAME_MAX_DATA
+//   the data
+//   CRC-16/CCITT of the type through the data, low byte first
+//
+// answered by UPLOAD_ACK or UPLOAD_NAK followed by the sequence number. The host
+// may send UPLOAD_WINDOW frames past the last acknowledged one, the device holds
+// back an acknowledgement until the ring has room for that many more. A frame
+// that is broken is answered by UPLOAD_NAK with the sequence number expected,
+// frames after it are dropped without an answer until that one arrives.
+//
+// Intel HEX lines work as well, for pasting into a serial monitor, a line of text
+// is the answer to a broken one. Records of up to UPLOAD_FRAME_MAX_DATA bytes are
+// taken in address order without flow control, so the program has to fit in the
+// ring unless the loader is booting it meanwhile.
+
+#ifndef BOOT_DEVICE_RING_SIZE
+#define BOOT_DEVICE_RING_SIZE (4 * BOOT_FRAME_MAX_DATA)
+#endif
+
+#define BOOT_DEVICE_RING_SLOTS (BOOT_DEVICE_RING_SIZE / BOOT_FRAME_MAX_DATA)
+
+#define UPLOAD_SOF (0x7e)
+#define UPLOAD_BEGIN (0x01)
+#define UPLOAD_DATA (0x02)
+#define UPLOAD_END (0x03)
+#define UPLOAD_ACK (0x06)
+#define UPLOAD_NAK (0x15)
+
+#define UPLOAD_FRAME_HEADER_SIZE (4)
+#define UPLOAD_FRAME_MAX_DATA (64)
+#define UPLOAD_FRAME_CAP (UPLOAD_FRAME_HEADER_SIZE + UPLOAD_FRAME_MAX_DATA + 2)
+#define UPLOAD_WINDOW (4)
+
+#define BOOT_DEVICE_REPLY_CAP (40)
+#define BOOT_DEVICE_HEX_LINE_CAP (4 + UPLOAD_FRAME_MAX_DATA + 1) // Bytes of the longest record taken
+
+typedef enum {
+    UPLOAD_PARSE_IDLE,
+    UPLOAD_PARSE_TYPE,
+    UPLOAD_PARSE_SEQ,
+    UPLOAD_PARSE_LENGTH,
+    UPLOAD_PARSE_DATA,
+    UPLOAD_PARSE_CRC_LOW,
+    UPLOAD_PARSE_CRC_HIGH,
+    UPLOAD_PARSE_HEX,
+    UPLOAD_PARSE_HEX_SKIP, // To the end of a broken line
+} UploadParseState;
+
+typedef enum {
+    BOOT_BUS_WAITING_FOR_COMMAND,
+    BOOT_BUS_SENDING_FRAME,
+    BOOT_BUS_WAITING_FOR_ACK,
+} BootBusState;
+
+// Everything the loader's reads and writes change, written by the bus side only.
+typedef struct {
+    BootBusState state;
+    uint16_t frame_start; // Program offset of the frame being sent
+    uint16_t frame_n_bytes;
+    uint8_t frame_header[BOOT_FRAME_HEADER_SIZE];
+    uint8_t frame_checksum;
+    uint16_t frame_size; // 0 until the frame's data is uploaded
+    uint16_t frame_pos;
+    uint16_t consumed; // Program bytes in acknowledged frames, their slots can be written again
+
+    uint16_t n_frames;
+    uint16_t n_naks;
+    uint16_t n_boots;
+} BootDeviceBus;
+
+typedef struct {
+    uint8_t ring[BOOT_DEVICE_RING_SIZE];
+    uint8_t slot_sums[BOOT_DEVICE_RING_SLOTS]; // 8-bit sum of the program bytes in each slot
+
+    bool uploading;
+    bool hex; // The upload is Intel HEX lines, a ':' in between binary frames is not taken for one
+    bool complete;
+    uint16_t received; // Program bytes uploaded, the size once complete
+
+    UploadParseState parse_state;
+    uint8_t frame_type;
+    uint8_t frame_seq;
+    uint8_t frame_length;
+    uint16_t frame_pos;
+    uint16_t frame_crc;
+    uint8_t frame_crc_low;
+    bool frame_stored; // The data goes into the ring
+    uint8_t expected_seq;
+    bool nak_sent;
+    bool ack_held;
+    uint8_t held_ack_seq;
+
+    uint8_t hex_line[BOOT_DEVICE_HEX_LINE_CAP];
+    uint16_t hex_size;
+    uint8_t hex_high_nibble; // 0x10 when no nibble is pending
+
+    uint8_t reply[BOOT_DEVICE_REPLY_CAP]; // For the host, taken by boot_device_take_reply
+    uint8_t reply_size;
+
+    uint16_t n_upload_naks;
+
+    BootDeviceBus bus;
+} BootDevice;
+
+static uint16_t upload_crc16(uint16_t crc, uint8_t byte) {
+    crc = (uint16_t)(crc ^ (byte << 8));
+
+    for (int i = 0; i < 8; ++i) {
+        crc = (uint16_t)(crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1);
+    }
+
+    return crc;
+}
+
+#define UPLOAD_CRC_INIT (0xffff)
+
+// Frames `n_bytes` of `data` into `frame`, returns the size of the frame.
+static uint16_t upload_frame(uint8_t *frame, uint8_t type, uint8_t seq, const uint8_t *data, uint8_t n_bytes) {
+    uint16_t size = 0;
+
+    frame[size++] = UPLOAD_SOF;
+    frame[size++] = type;
+    frame[size++] = seq;
+    frame[size++] = n_bytes;
+
+    for (uint8_t i = 0; i < n_bytes; ++i) {
+        frame[size++] = data[i];
+    }
+
+    uint16_t crc = UPLOAD_CRC_INIT;
+
+    for (uint16_t i = 1; i < size; ++i) {
+        crc = upload_crc16(crc, frame[i]);
+    }
+
+    frame[size++] = (uint8_t)(crc & 0xff);
+    frame[size++] = (uint8_t)(crc >> 8);
+
+    return size;
+}
+
+static void boot_device_reply(BootDevice *device, const uint8_t *bytes, uint8_t n_bytes) {
+    for (uint8_t i = 0; i < n_bytes && device->reply_size < BOOT_DEVICE_REPLY_CAP; ++i) {
+        device->reply[device->reply_size++] = bytes[i];
+    }
+}
+
+static void boot_device_reply_text(BootDevice *device, const char *text) {
+    while (*text != '\0' && device->reply_size < BOOT_DEVICE_REPLY_CAP) {
+        device->reply[device->reply_size++] = (uint8_t)*text++;
+    }
+}
+
+static void boot_device_reply_upload(BootDevice *device, uint8_t answer, uint8_t seq) {
+    uint8_t bytes[2] = {answer, seq};
+    boot_device_reply(device, bytes, 2);
+}
+
+static uint16_t boot_device_free(const BootDevice *device) {
+    return (uint16_t)(BOOT_DEVICE_RING_SIZE - (device->received - device->bus.consumed));
+}
+
+// Can the upload write `n_bytes` past the received ones without overwriting a slot still to be booted.
+static bool boot_device_has_room(const BootDevice *device, uint16_t n_bytes) {
+    return BOOT_PROGRAM_SIZE_CAP - device->received >= n_bytes && boot_device_free(device) >= n_bytes;
+}
+
+// Where program byte `offset` goes.
+static uint8_t *boot_device_at(BootDevice *device, uint16_t offset) {
+    return device->ring + offset % BOOT_DEVICE_RING_SIZE;
+}
+
+// Makes `n_bytes` already written past the received ones part of the program.
+static void boot_device_commit(BootDevice *device, uint16_t n_bytes) {
+    for (uint16_t i = 0; i < n_bytes; ++i) {
+        uint16_t offset = (uint16_t)(device->received + i);
+        uint8_t *slot_sum = device->slot_sums + (offset / BOOT_FRAME_MAX_DATA) % BOOT_DEVICE_RING_SLOTS;
+
+        if (offset % BOOT_FRAME_MAX_DATA == 0) {
+            *slot_sum = 0;
+        }
+
+        *slot_sum = (uint8_t)(*slot_sum + *boot_device_at(device, offset));
+    }
+
+    device->received = (uint16_t)(device->received + n_bytes);
+}
+
+// Forgets the program for a new upload, a boot in progress is left waiting for a command.
+static void boot_device_begin(BootDevice *device) {
+    device->uploading = true;
+    device->complete = false;
+    device->received = 0;
+    device->ack_held = false;
+    device->bus.state = BOOT_BUS_WAITING_FOR_COMMAND;
+    device->bus.consumed = 0;
+}
+
+static void boot_device_end(BootDevice *device) {
+    device->uploading = false;
+    device->complete = true;
+}
+
+// The whole of a program at once, when there is no serial line to upload it over.
+static void boot_device_load(BootDevice *device, const uint8_t *program, uint16_t size) {
+    boot_device_begin(device);
+
+    for (uint16_t i = 0; i < size; ++i) {
+        *boot_device_at(device, i) = program[i];
+    }
+
+    boot_device_commit(device, size);
+    boot_device_end(device);
+}
+
+static void boot_device_acknowledge(BootDevice *device, uint8_t seq) {
+    if (boot_device_free(device) >= UPLOAD_WINDOW * UPLOAD_FRAME_MAX_DATA) {
+        boot_device_reply_upload(device, UPLOAD_ACK, seq);
+    } else {
+        device->ack_held = true;
+        device->held_ack_seq = seq;
+    }
+}
+
+static void boot_device_upload_frame(BootDevice *device, bool crc_ok) {
+    uint8_t seq = device->frame_seq;
+    bool in_sequence = seq == device->expected_seq || device->frame_type == UPLOAD_BEGIN;
+
+    if (!crc_ok || (in_sequence && device->frame_type != UPLOAD_BEGIN && !device->uploading)) {
+        // Frames already on the line after a broken one are dropped quietly, the one sent again is not.
+        if (!device->nak_sent || seq == device->expected_seq) {
+            ++device->n_upload_naks;
+            device->nak_sent = true;
+            boot_device_reply_upload(device, UPLOAD_NAK, device->expected_seq);
+        }
+        return;
+    }
+
+    if (!in_sequence) {
+        uint8_t behind = (uint8_t)(device->expected_seq - seq);
+
+        // Sent again after a lost acknowledgement, the host is told where the device is.
+        if (behind >= 1 && behind <= UPLOAD_WINDOW && !device->ack_held) {
+            boot_device_reply_upload(device, UPLOAD_ACK, (uint8_t)(device->expected_seq - 1));
+        }
+        return;
+    }
+
+    if (device->frame_type == UPLOAD_DATA && !device->frame_stored) {
+        return;
+    }
+
+    device->nak_sent = false;
+    device->expected_seq = (uint8_t)(seq + 1);
+
+    switch (device->frame_type) {
+    case UPLOAD_BEGIN:
+        boot_device_begin(device);
+        device->hex = false;
+        break;
+    case UPLOAD_DATA:
+        boot_device_commit(device, device->frame_length);
+        break;
+    case UPLOAD_END:
+        boot_device_end(device);
+        break;
+    }
+
+    boot_device_acknowledge(device, seq);
+}
+
+static uint8_t boot_device_hex_digit(uint8_t c) {
+    if (c >= '0' && c <= '9') return (uint8_t)(c - '0');
+    if (c >= 'A' && c <= 'F') return (uint8_t)(c - 'A' + 10);
+    if (c >= 'a' && c <= 'f') return (uint8_t)(c - 'a' + 10);
+    return 0x10;
+}
+
+static void boot_device_hex_fail(BootDevice *device, const char *error) {
+    boot_device_reply_text(device, error);
+    boot_device_reply_text(device, ", try again\n");
+
+    if (device->uploading) {
+        device->uploading = false;
+        device->received = 0;
+    }
+}
+
+// A record with its line, :SSAAAARRDD..CC, turned into bytes.
+static void boot_device_hex_record(BootDevice *device) {
+    const uint8_t *line = device->hex_line;
+    uint8_t checksum = 0;
+
+    for (uint16_t i = 0; i < device->hex_size; ++i) {
+        checksum = (uint8_t)(checksum + line[i]);
+    }
+
+    if (device->hex_size < 5 || device->hex_size != 5 + line[0]) {
+        boot_device_hex_fail(device, "Size doesn't match line");
+        return;
+    }
+
+    if (checksum != 0) {
+        boot_device_hex_fail(device, "Checksum doesn't match");
+        return;
+    }
+
+    if (!device->uploading) {
+        boot_device_begin(device);
+        device->hex = true;
+    }
+
+    uint8_t size = line[0];
+    uint16_t address = (uint16_t)(line[1] << 8 | line[2]);
+
+    if (line[3] == 0x00) {
+        if (address != device->received) {
+            boot_device_hex_fail(device, "Out of order");
+        } else if (!boot_device_has_room(device, size)) {
+            boot_device_hex_fail(device, "Too big");
+        } else {
+            for (uint8_t i = 0; i < size; ++i) {
+                *boot_device_at(device, (uint16_t)(device->received + i)) = line[4 + i];
+            }
+
+            boot_device_commit(device, size);
+        }
+    } else if (line[3] == 0x01) {
+        boot_device_end(device);
+    } else {
+        boot_device_hex_fail(device, "Unsupported record");
+    }
+}
+
+static void boot_device_hex_byte(BootDevice *device, uint8_t c) {
+    if (c == '\n' || c == '\r') {
+        if (device->hex_high_nibble != 0x10) {
+            boot_device_hex_fail(device, "Odd number of digits");
+        } else {
+            boot_device_hex_record(device);
+        }
+        device->parse_state = UPLOAD_PARSE_IDLE;
+        return;
+    }
+
+    uint8_t digit = boot_device_hex_digit(c);
+
+    if (digit == 0x10 || (device->hex_high_nibble == 0x10 && device->hex_size == BOOT_DEVICE_HEX_LINE_CAP)) {
+        boot_device_hex_fail(device, "Unknown input");
+        device->parse_state = UPLOAD_PARSE_HEX_SKIP;
+    } else if (device->hex_high_nibble == 0x10) {
+        device->hex_high_nibble = digit;
+    } else {
+        device->hex_line[device->hex_size++] = (uint8_t)(device->hex_high_nibble << 4 | digit);
+        device->hex_high_nibble = 0x10;
+    }
+}
+
+// Takes the next byte received over serial, the answers to it are added to `reply`.
+static void boot_device_serial_byte(BootDevice *device, uint8_t byte) {
+    switch (device->parse_state) {
+    case UPLOAD_PARSE_IDLE:
+        if (byte == UPLOAD_SOF) {
+            device->frame_crc = UPLOAD_CRC_INIT;
+            device->parse_state = UPLOAD_PARSE_TYPE;
+        } else if (byte == ':' && (!device->uploading || device->hex)) {
+            device->hex_size = 0;
+            device->hex_high_nibble = 0x10;
+            device->parse_state = UPLOAD_PARSE_HEX;
+        }
+        break;
+    case UPLOAD_PARSE_TYPE:
+        device->frame_type = byte;
+        device->frame_crc = upload_crc16(device->frame_crc, byte);
+        device->parse_state = UPLOAD_PARSE_SEQ;
+        break;
+    case UPLOAD_PARSE_SEQ:
+        device->frame_seq = byte;
+        device->frame_crc = upload_crc16(device->frame_crc, byte);
+        device->parse_state = UPLOAD_PARSE_LENGTH;
+        break;
+    case UPLOAD_PARSE_LENGTH:
+        device->frame_length = byte;
+        device->frame_pos = 0;
+        device->frame_crc = upload_crc16(device->frame_crc, byte);
+
+        // Only written with room for it, a host keeping to the window always has it.
+        device->frame_stored = device->frame_type == UPLOAD_DATA && device->uploading &&
+                               device->frame_seq == device->expected_seq && boot_device_has_room(device, byte);
+
+        if (byte > UPLOAD_FRAME_MAX_DATA || (device->frame_type != UPLOAD_DATA && byte > 0)) {
+            // Not a frame this device takes, resynchronised at the next UPLOAD_SOF.
+            device->parse_state = UPLOAD_PARSE_IDLE;
+            boot_device_upload_frame(device, false);
+        } else {
+            device->parse_state = byte > 0 ? UPLOAD_PARSE_DATA : UPLOAD_PARSE_CRC_LOW;
+        }
+        break;
+    case UPLOAD_PARSE_DATA:
+        // Written past the received bytes right away, they only count once the CRC matches.
+        if (device->frame_stored) {
+            *boot_device_at(device, (uint16_t)(device->received + device->frame_pos)) = byte;
+        }
+
+        device->frame_crc = upload_crc16(device->frame_crc, byte);
+
+        if (++device->frame_pos == device->frame_length) {
+            device->parse_state = UPLOAD_PARSE_CRC_LOW;
+        }
+        break;
+    case UPLOAD_PARSE_CRC_LOW:
+        device->frame_crc_low = byte;
+        device->parse_state = UPLOAD_PARSE_CRC_HIGH;
+        break;
+    case UPLOAD_PARSE_CRC_HIGH:
+        device->parse_state = UPLOAD_PARSE_IDLE;
+        boot_device_upload_frame(device, device->frame_crc == (uint16_t)(byte << 8 | device->frame_crc_low));
+        break;
+    case UPLOAD_PARSE_HEX:
+        boot_device_hex_byte(device, byte);
+        break;
+    case UPLOAD_PARSE_HEX_SKIP:
+        if (byte == '\n' || byte == '\r') {
+            device->parse_state = UPLOAD_PARSE_IDLE;
+        }
+        break;
+    }
+}
+
+// Sends an acknowledgement held back for lack of room once the loader has made some.
+static void boot_device_poll(BootDevice *device) {
+    if (device->ack_held && boot_device_free(device) >= UPLOAD_WINDOW * UPLOAD_FRAME_MAX_DATA) {
+        device->ack_held = false;
+        boot_device_reply_upload(device, UPLOAD_ACK, device->held_ack_seq);
+    }
+}
+
+// Copies the answers for the host to `output`, at least BOOT_DEVICE_REPLY_CAP bytes,
+// returns how many.
+static uint8_t boot_device_take_reply(BootDevice *device, uint8_t *output) {
+    uint8_t size = device->reply_size;
+
+    for (uint8_t i = 0; i < size; ++i) {
+        output[i] = device->reply[i];
+    }
+
+    device->reply_size = 0;
+
+    return size;
+}
+
+// Sets up the frame at bus.frame_start if its data is uploaded, the last frame once
+// the whole program is sent.
+static bool boot_device_frame_ready(BootDevice *device) {
+    BootDeviceBus *bus = &device->bus;
+
+    if (bus->frame_size > 0) {
+        return true;
+    }
+
+    uint16_t n_left = (uint16_t)(device->received - bus->frame_start);
+
+    if (n_left < BOOT_FRAME_MAX_DATA && !device->complete) {
+        return false;
+    }
+
+    bus->frame_n_bytes = n_left < BOOT_FRAME_MAX_DATA ? n_left : BOOT_FRAME_MAX_DATA;
+
+    uint16_t address = (uint16_t)(bus->frame_n_bytes > 0 ? BOOT_ADDRESS + bus->frame_start : BOOT_ADDRESS);
+    uint8_t sum = bus->frame_n_bytes > 0
+                      ? device->slot_sums[(bus->frame_start / BOOT_FRAME_MAX_DATA) % BOOT_DEVICE_RING_SLOTS]
+                      : 0;
+
+    bus->frame_header[0] = boot_frame_groups(bus->frame_n_bytes);
+    bus->frame_header[1] = (uint8_t)(address & 0xff);
+    bus->frame_header[2] = (uint8_t)(address >> 8);
+    bus->frame_checksum = (uint8_t)(0x100 - (uint8_t)(sum + bus->frame_header[0] + bus->frame_header[1] + bus->frame_header[2]));
+    bus->frame_size = (uint16_t)(BOOT_FRAME_HEADER_SIZE + 4 * bus->frame_header[0] + 1);
+
+    return true;
+}
+
+static void boot_device_start_frame(BootDevice *device, uint16_t start) {
+    device->bus.frame_start = start;
+    device->bus.frame_size = 0;
+    device->bus.frame_pos = 0;
+    device->bus.state = BOOT_BUS_SENDING_FRAME;
+}
+
+// The value for the loader's next read of the boot port.
+static uint8_t boot_device_bus_read(BootDevice *device) {
+    BootDeviceBus *bus = &device->bus;
+
+    switch (bus->state) {
+    case BOOT_BUS_WAITING_FOR_COMMAND:
+        return device->uploading || device->complete ? BOOT_READY : BOOT_NOT_READY;
+    case BOOT_BUS_SENDING_FRAME: {
+        if (bus->frame_pos == 0 && !boot_device_frame_ready(device)) {
+            return BOOT_NOT_READY;
+        }
+
+        uint16_t pos = bus->frame_pos++;
+
+        if (bus->frame_pos == bus->frame_size) {
+            bus->state = BOOT_BUS_WAITING_FOR_ACK;
+        }
+
+        if (pos < BOOT_FRAME_HEADER_SIZE) {
+            return bus->frame_header[pos];
+        }
+
+        if (pos == bus->frame_size - 1) {
+            return bus->frame_checksum;
+        }
+
+        uint16_t i = (uint16_t)(pos - BOOT_FRAME_HEADER_SIZE);
+
+        return i < bus->frame_n_bytes ? *boot_device_at(device, (uint16_t)(bus->frame_start + i)) : 0;
+    }
+    case BOOT_BUS_WAITING_FOR_ACK:
+        return BOOT_NOT_READY;
+    }
+
+    return BOOT_NOT_READY;
+}
+
+// Takes what the loader wrote to the boot port.
+static void boot_device_bus_write(BootDevice *device, uint8_t value) {
+    BootDeviceBus *bus = &device->bus;
+
+    if (value == BOOT_COMMAND_GET_BLOCKS) {
+        // The program has to be whole in the ring to start over, a bigger one is uploaded again.
+        if ((device->uploading || device->complete) &&
+            (bus->consumed == 0 || (device->complete && device->received <= BOOT_DEVICE_RING_SIZE))) {
+            bus->consumed = 0;
+            bus->n_frames = 0;
+            bus->n_naks = 0;
+            boot_device_start_frame(device, 0);
+        }
+    } else if (bus->state == BOOT_BUS_WAITING_FOR_ACK && value == BOOT_NAK) {
+        ++bus->n_naks;
+        bus->frame_pos = 0;
+        bus->state = BOOT_BUS_SENDING_FRAME;
+    } else if (bus->state == BOOT_BUS_WAITING_FOR_ACK && value == BOOT_ACK) {
+        ++bus->n_frames;
+
+        if (bus->frame_n_bytes == 0) {
+            ++bus->n_boots;
+            bus->state = BOOT_BUS_WAITING_FOR_COMMAND;
+        } else {
+            bus->consumed = (uint16_t)(bus->frame_start + bus->frame_n_bytes);
+            boot_device_start_frame(device, bus->consumed);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef BOOT_PROTOCOL_H
+#define BOOT_PROTOCOL_H
+
+#include <stdint.h>
+
+// What software/boot_device_loader.asm and the boot device say to each other
+// over the boot port, shared by the sketch and the emulator's model of it.
+//
+// The device answers BOOT_READY until the loader writes BOOT_COMMAND_GET_BLOCKS,
+// then sends the program as frames, answering BOOT_NOT_READY in place of a frame
+// it does not have yet:
+//
+//   number of 4 byte groups, 0 for the last frame
+//   address low, address high, where to load the data or jump to for the last frame
+//   the groups
+//   checksum, making the 8-bit sum of the whole frame 0
+//
+// The loader writes BOOT_ACK after each frame or BOOT_NAK to get it again.
+
+#define BOOT_PORT (0)
+
+#define BOOT_READY (0x01)
+#define BOOT_NOT_READY (0xff) // Nothing driving the bus, or the next frame still being uploaded
+#define BOOT_COMMAND_GET_BLOCKS (0xb1)
+#define BOOT_ACK (0x06)
+#define BOOT_NAK (0x15)
+
+#define BOOT_ADDRESS (0x8000)
+#define BOOT_PROGRAM_SIZE_CAP (0x7f00) // Up to the stack page
+
+#define BOOT_FRAME_HEADER_SIZE (3)
+#define BOOT_FRAME_MAX_GROUPS (64)
+#define BOOT_FRAME_MAX_DATA (4 * BOOT_FRAME_MAX_GROUPS)
+#define BOOT_FRAME_CAP (BOOT_FRAME_HEADER_SIZE + BOOT_FRAME_MAX_DATA + 1)
+
+static uint8_t boot_frame_groups(uint16_t n_bytes) {
+    return (uint8_t)((n_bytes + 3) / 4);
+}
+
+// Last byte of the frame with up to BOOT_FRAME_MAX_DATA bytes of `data` loaded at `address`.
+static uint8_t boot_frame_checksum(const uint8_t *data, uint16_t n_bytes, uint16_t address) {
+    uint8_t sum = (uint8_t)(boot_frame_groups(n_bytes) + (address & 0xff) + (address >> 8));
+
+    for (uint16_t i = 0; i < n_bytes; ++i) {
+        sum = (uint8_t)(sum + data[i]);
+    }
+
+    return (uint8_t)(0x100 - sum);
+}
+
+// Frames up to BOOT_FRAME_MAX_DATA bytes of `data` loaded at `address` into `frame`,
+// the last group is padded with zeros. No bytes makes the last frame, jumping to
+// `address`. Returns the size of the frame.
+static uint16_t boot_frame(uint8_t *frame, const uint8_t *data, uint16_t n_bytes, uint16_t address) {
+    uint8_t n_groups = boot_frame_groups(n_bytes);
+
+    frame[0] = n_groups;
+    frame[1] = (uint8_t)(address & 0xff);
+    frame[2] = (uint8_t)(address >> 8);
+
+    uint16_t size = BOOT_FRAME_HEADER_SIZE;
+
+    for (uint16_t i = 0; i < 4 * n_groups; ++i) {
+        frame[size++] = i < n_bytes ? data[i] : 0;
+    }
+
+    frame[size++] = boot_frame_checksum(data, n_bytes, address);
+
+    return size;
+}
+
+#endif
@@ -0,0 +1,1208 @@
+#ifndef ASSEMBLER_H
+#define ASSEMBLER_H
+
+#include <assert.h>
+#include <ctype.h> // is*
+#include <stdarg.h> // va_*
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h> // f*
+#include <stdlib.h> // atoi
+#include <string.h> // str*, mem*
+
+#include "opcode_rule.h"
+
+// Assembles the customasm dialect our sources use with the rules from `rule_from_opcode`,
+// so no generated `bleh_instructions.asm` or external customasm is needed:
+// labels, `.local` labels, `NAME = expr` constants, `#include`, `#d`, `#res`, `#addr`,
+// `#bankdef`/`#bank` and expressions with the customasm operators, `$` and `le()`.
+
+#define ASM_MAX_SOURCE_SIZE (1 << 20)
+#define ASM_MAX_LINES (1 << 15)
+#define ASM_MAX_FILES (64)
+#define ASM_MAX_SYMBOLS (4096) // Power of two, open addressing
+#define ASM_MAX_SYMBOL_LENGTH (64)
+#define ASM_MAX_BANKS (8)
+#define ASM_MAX_PASSES (8)
+#define ASM_MAX_ARGS (2)
+#define ASM_MAX_INCLUDE_DEPTH (16)
+
+typedef struct {
+    const char *text; // Without the comment
+    uint8_t file;
+    int line;
+    int rule; // Index + 1 of the rule the instruction matched, matching only depends on the text
+    int64_t pc; // Address the statement starts at in the last pass
+    int64_t offset; // Into the output of the first byte it emitted in the last pass, -1 if none
+    bool labeled; // Defines a label, so something may jump to it
+} AsmLine;
+
+typedef struct {
+    char name[ASM_MAX_SYMBOL_LENGTH];
+    int64_t value;
+    int pass; // Last pass that defined it, 0 if never
+} AsmSymbol;
+
+typedef struct {
+    char name[32];
+    int64_t addr;
+    int64_t size;
+    int64_t outp; // In bits like customasm, -1 if the bank is not written to the output
+    bool fill;
+    int64_t pc;
+    int64_t end; // Highest address written + 1
+} AsmBank;
+
+typedef struct {
+    uint8_t opcode;
+    Operand op;
+    char pattern[64];
+    char prefix[64]; // Lower case literal characters before the first parameter, without spaces
+    size_t prefix_length;
+} AsmRule;
+
+typedef struct {
+    int64_t value;
+    int size; // In bits, 0 if unknown
+} AsmValue;
+
+typedef struct {
+    char source[ASM_MAX_SOURCE_SIZE];
+    size_t source_size;
+
+    char files[ASM_MAX_FILES][256];
+    bool files_once[ASM_MAX_FILES];
+    int n_files;
+
+    AsmLine lines[ASM_MAX_LINES];
+    int n_lines;
+
+    AsmRule rules[256]; // Grouped by the first character of their prefix
+    int n_rules;
+    int rules_first[128]; // Index of the first rule with that first character
+    int rules_end[128];
+
+    AsmSymbol symbols[ASM_MAX_SYMBOLS];
+
+    AsmBank banks[ASM_MAX_BANKS];
+    int n_banks;
+    int bank;
+
+    int pass;
+    bool report; // Errors are only printed by the last pass, earlier ones may see symbols before they are defined
+    bool trying; // Matching a rule that may not be the one used, errors are not counted
+    bool unresolved; // A symbol was used that no pass has defined yet
+    bool changed; // A symbol got a different value than in the previous pass
+    char scope[ASM_MAX_SYMBOL_LENGTH]; // Last global symbol, prefix of `.local` ones
+    int64_t statement_pc; // `$`, the address the current statement starts at
+    AsmLine *line;
+    int n_errors;
+
+    uint8_t *output;
+    size_t output_size;
+    size_t output_length;
+} Assembler;
+
+static Assembler assembler;
+
+static void asm_error(const char *format, ...) {
+    if (assembler.trying) {
+        return;
+    }
+
+    ++assembler.n_errors;
+
+    if (!assembler.report) {
+        return;
+    }
+
+    if (assembler.line != NULL) {
+        fprintf(stderr, "%s:%d: ", assembler.files[assembler.line->file], assembler.line->line);
+    }
+
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+
+    fprintf(stderr, "\n");
+}
+
+static const char *asm_skip_spaces(const char *s) {
+    while (*s == ' ' || *s == '\t' || *s == '\r') {
+        ++s;
+    }
+
+    return s;
+}
+
+static bool asm_is_identifier_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+// Copies `[.]identifier` from `s` into `name`, returns the character after it or NULL if there is none.
+static const char *asm_identifier(const char *s, char *name, size_t size) {
+    const char *start = s;
+
+    if (*s == '.') {
+        ++s;
+    }
+
+    if (!isalpha((unsigned char)*s) && *s != '_') {
+        return NULL;
+    }
+
+    while (asm_is_identifier_char(*s)) {
+        ++s;
+    }
+
+    size_t length = (size_t)(s - start);
+
+    if (length >= size) {
+        asm_error("Symbol %.*s is too long", (int)length, start);
+        length = size - 1;
+    }
+
+    memcpy(name, start, length);
+    name[length] = '\0';
+
+    return s;
+}
+
+// Concatenates `a` and the first `b_length` characters of `b`, cut to `size`. On the hot path where snprintf shows.
+static void asm_copy(char *dest, size_t size, const char *a, const char *b, size_t b_length) {
+    size_t a_length = strlen(a);
+    a_length = a_length < size - 1 ? a_length : size - 1;
+    b_length = b_length < size - 1 - a_length ? b_length : size - 1 - a_length;
+
+    memcpy(dest, a, a_length);
+    memcpy(dest + a_length, b, b_length);
+    dest[a_length + b_length] = '\0';
+}
+
+// `.local` symbols belong to the last global one.
+static void asm_full_name(const char *name, char *full_name) {
+    asm_copy(full_name, ASM_MAX_SYMBOL_LENGTH, name[0] == '.' ? assembler.scope : "", name, strlen(name));
+}
+
+static AsmSymbol *asm_symbol(const char *full_name) {
+    uint32_t hash = 0;
+
+    for (const char *c = full_name; *c != '\0'; ++c) {
+        hash = ((hash & 0x07ffffff) << 5) ^ (hash >> 27) ^ (uint8_t)*c;
+    }
+
+    // The low bits only see the last few characters, `lcd_a.not_busy` and `lcd_b.not_busy` would collide.
+    hash ^= (hash >> 11) ^ (hash >> 22);
+
+    for (uint32_t i = 0; i < ASM_MAX_SYMBOLS; ++i) {
+        AsmSymbol *symbol = &assembler.symbols[(hash + i) & (ASM_MAX_SYMBOLS - 1)];
+
+        if (symbol->name[0] == '\0') {
+            asm_copy(symbol->name, sizeof(symbol->name), "", full_name, strlen(full_name));
+            return symbol;
+        }
+
+        if (strcmp(symbol->name, full_name) == 0) {
+            return symbol;
+        }
+    }
+
+    assert(false && "Too many symbols");
+    return NULL;
+}
+
+static void asm_define(const char *name, int64_t value) {
+    char full_name[ASM_MAX_SYMBOL_LENGTH];
+    asm_full_name(name, full_name);
+
+    if (name[0] != '.') {
+        asm_copy(assembler.scope, sizeof(assembler.scope), "", name, strlen(name));
+    }
+
+    AsmSymbol *symbol = asm_symbol(full_name);
+
+    if (symbol->pass == assembler.pass) {
+        asm_error("Symbol %s is already defined", full_name);
+        return;
+    }
+
+    assembler.changed |= symbol->pass == 0 || symbol->value != value;
+    symbol->value = value;
+    symbol->pass = assembler.pass;
+}
+
+static int64_t asm_pc(void) {
+    return assembler.banks[assembler.bank].pc;
+}
+
+// Expressions, lowest precedence first. Each parser returns NULL on a syntax error.
+
+static const char *asm_expression(const char *s, AsmValue *value);
+
+static const char *asm_number(const char *s, AsmValue *value) {
+    int base = 10;
+    int bits_per_digit = 0;
+
+    if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        base = 16;
+        bits_per_digit = 4;
+        s += 2;
+    } else if (s[0] == '0' && (s[1] == 'b' || s[1] == 'B')) {
+        base = 2;
+        bits_per_digit = 1;
+        s += 2;
+    }
+
+    int64_t result = 0;
+    int n_digits = 0;
+
+    for (;; ++s) {
+        int digit;
+
+        if (*s == '_') {
+            continue;
+        } else if (*s >= '0' && *s <= '9') {
+            digit = *s - '0';
+        } else if (*s >= 'a' && *s <= 'f') {
+            digit = *s - 'a' + 10;
+        } else if (*s >= 'A' && *s <= 'F') {
+            digit = *s - 'A' + 10;
+        } else {
+            break;
+        }
+
+        if (digit >= base) {
+            return NULL;
+        }
+
+        if (result > (INT64_MAX - digit) / base) {
+            asm_error("Number is too big");
+            return NULL;
+        }
+
+        result = result * base + digit;
+        ++n_digits;
+    }
+
+    if (n_digits == 0 || asm_is_identifier_char(*s)) {
+        return NULL;
+    }
+
+    // Like customasm, hex and binary literals are as wide as their digits.
+    *value = (AsmValue){.value = result, .size = n_digits * bits_per_digit};
+    return s;
+}
+
+static const char *asm_primary(const char *s, AsmValue *value) {
+    s = asm_skip_spaces(s);
+
+    if (*s == '(') {
+        s = asm_expression(s + 1, value);
+        s = s != NULL ? asm_skip_spaces(s) : NULL;
+        return s != NULL && *s == ')' ? s + 1 : NULL;
+    }
+
+    if (isdigit((unsigned char)*s)) {
+        return asm_number(s, value);
+    }
+
+    if (*s == '\'' && s[1] != '\0' && s[1] != '\\' && s[2] == '\'') {
+        *value = (AsmValue){.value = (uint8_t)s[1], .size = 8};
+        return s + 3;
+    }
+
+    if (*s == '$') {
+        *value = (AsmValue){.value = assembler.statement_pc};
+        return s + 1;
+    }
+
+    char name[ASM_MAX_SYMBOL_LENGTH];
+    const char *end = asm_identifier(s, name, sizeof(name));
+
+    if (end == NULL) {
+        return NULL;
+    }
+
+    // Byte swaps a sized value, the rules use it for 16 bit operands.
+    if (strcmp(name, "le") == 0 && *asm_skip_spaces(end) == '(') {
+        end = asm_primary(end, value);
+
+        if (end != NULL) {
+            if (value->size <= 0 || value->size % 8 != 0) {
+                asm_error("le() needs a value with a size in whole bytes, e.g. x`16");
+            }
+
+            int64_t swapped = 0;
+
+            for (int i = 0; i < value->size / 8; ++i) {
+                swapped = (swapped << 8) | ((value->value >> (8 * i)) & 0xff);
+            }
+
+            value->value = swapped;
+        }
+
+        return end;
+    }
+
+    char full_name[ASM_MAX_SYMBOL_LENGTH];
+    asm_full_name(name, full_name);
+
+    AsmSymbol *symbol = asm_symbol(full_name);
+
+    if (symbol->pass == 0) {
+        assembler.unresolved = true;
+        asm_error("Unknown symbol %s", full_name);
+    }
+
+    *value = (AsmValue){.value = symbol->value};
+    return end;
+}
+
+// `x`8` keeps the low 8 bits and gives the value that size.
+static const char *asm_postfix(const char *s, AsmValue *value) {
+    s = asm_primary(s, value);
+
+    while (s != NULL && *asm_skip_spaces(s) == '`') {
+        AsmValue size;
+        s = asm_number(asm_skip_spaces(asm_skip_spaces(s) + 1), &size);
+
+        if (s == NULL || size.value < 1 || size.value > 62) {
+            return NULL;
+        }
+
+        value->size = (int)size.value;
+        value->value &= ((int64_t)1 << value->size) - 1;
+    }
+
+    return s;
+}
+
+static const char *asm_unary(const char *s, AsmValue *value) {
+    s = asm_skip_spaces(s);
+
+    if (*s == '-' || *s == '!' || *s == '~') {
+        char op = *s;
+        s = asm_unary(s + 1, value);
+
+        if (s != NULL) {
+            value->value = op == '-' ? -value->value : ~value->value;
+            value->size = 0;
+        }
+
+        return s;
+    }
+
+    return asm_postfix(s, value);
+}
+
+typedef enum {
+    ASM_PRECEDENCE_OR,
+    ASM_PRECEDENCE_XOR,
+    ASM_PRECEDENCE_AND,
+    ASM_PRECEDENCE_EQUALITY,
+    ASM_PRECEDENCE_RELATIONAL,
+    ASM_PRECEDENCE_SHIFT,
+    ASM_PRECEDENCE_ADDITIVE,
+    ASM_PRECEDENCE_MULTIPLICATIVE,
+    ASM_PRECEDENCE_UNARY,
+} AsmPrecedence;
+
+// The binary operator at `s` and its precedence, `length` is 0 if there is none.
+static AsmPrecedence asm_binary_operator(const char *s, int *length) {
+    *length = 1;
+
+    switch (s[0]) {
+    case '|': return ASM_PRECEDENCE_OR;
+    case '^': return ASM_PRECEDENCE_XOR;
+    case '&': return ASM_PRECEDENCE_AND;
+    case '+':
+    case '-': return ASM_PRECEDENCE_ADDITIVE;
+    case '*':
+    case '/':
+    case '%': return ASM_PRECEDENCE_MULTIPLICATIVE;
+    case '=':
+    case '!':
+        *length = s[1] == '=' ? 2 : 0;
+        return ASM_PRECEDENCE_EQUALITY;
+    case '<':
+    case '>':
+        if (s[1] == s[0]) {
+            *length = 2;
+            return ASM_PRECEDENCE_SHIFT;
+        }
+
+        *length = s[1] == '=' ? 2 : 1;
+        return ASM_PRECEDENCE_RELATIONAL;
+    }
+
+    *length = 0;
+    return ASM_PRECEDENCE_UNARY;
+}
+
+static int64_t asm_apply(const char *op, int64_t l, int64_t r) {
+    switch (op[0]) {
+    case '|': return l | r;
+    case '^': return l ^ r;
+    case '&': return l & r;
+    case '=': return l == r;
+    case '!': return l != r;
+    case '+': return l + r;
+    case '-': return l - r;
+    case '*': return l * r;
+    case '/':
+    case '%':
+        if (r == 0) {
+            asm_error("Division by zero");
+            return 0;
+        }
+        return op[0] == '/' ? l / r : l % r;
+    case '<':
+    case '>':
+        if (op[1] == op[0]) {
+            if (r < 0 || r > 62) {
+                asm_error("Shift by %lld", (long long)r);
+                return 0;
+            }
+            return op[0] == '<' ? l * ((int64_t)1 << r) : l >> r;
+        }
+        if (op[1] == '=') {
+            return op[0] == '<' ? l <= r : l >= r;
+        }
+        return op[0] == '<' ? l < r : l > r;
+    }
+
+    assert(false && "Unknown operator");
+    return 0;
+}
+
+// Precedence climbing, operators of the same precedence are left associative.
+static const char *asm_binary(const char *s, AsmValue *value, AsmPrecedence min_precedence) {
+    s = asm_unary(s, value);
+
+    while (s != NULL) {
+        s = asm_skip_spaces(s);
+
+        int length;
+        AsmPrecedence precedence = asm_binary_operator(s, &length);
+
+        if (length == 0 || precedence < min_precedence) {
+            break;
+        }
+
+        AsmValue right;
+        const char *op = s;
+        s = asm_binary(s + length, &right, (AsmPrecedence)(precedence + 1));
+
+        if (s != NULL) {
+            value->value = asm_apply(op, value->value, right.value);
+            value->size = 0;
+        }
+    }
+
+    return s;
+}
+
+static const char *asm_expression(const char *s, AsmValue *value) {
+    return asm_binary(s, value, ASM_PRECEDENCE_OR);
+}
+
+// Evaluates an expression that must be the whole of `s`.
+static bool asm_evaluate(const char *s, AsmValue *value) {
+    const char *end = asm_expression(s, value);
+
+    if (end == NULL || *asm_skip_spaces(end) != '\0') {
+        asm_error("Invalid expression %s", s);
+        return false;
+    }
+
+    return true;
+}
+
+static void asm_emit(uint8_t byte) {
+    AsmBank *bank = &assembler.banks[assembler.bank];
+
+    if (bank->pc >= bank->addr + bank->size) {
+        asm_error("Bank %s is full", bank->name);
+    } else if (bank->outp < 0) {
+        asm_error("Bank %s has no #outp, only #res can be used in it", bank->name);
+    } else {
+        int64_t offset = bank->outp / 8 + bank->pc - bank->addr;
+
+        if ((size_t)offset >= assembler.output_size) {
+            asm_error("Output is bigger than %zu bytes", assembler.output_size);
+        } else {
+            assembler.output[offset] = byte;
+        }
+
+        if (assembler.line != NULL && assembler.line->offset < 0) {
+            assembler.line->offset = offset;
+        }
+    }
+
+    ++bank->pc;
+    bank->end = bank->pc > bank->end ? bank->pc : bank->end;
+}
+
+// Matches `text` against a rule pattern, parameters are parsed as expressions. Returns the number
+// of literal characters matched, the most specific rule wins like `ld a, b` over `ld a, {imm: i8}`.
+static int asm_match(const char *pattern, const char *text, AsmValue *args, char (*arg_types)[8], bool evaluate) {
+    int n_literal = 0;
+    int n_args = 0;
+
+    // Trying a rule must not report or count the unknown symbols of another rule's parameters.
+    bool unresolved = assembler.unresolved;
+    assembler.trying = !evaluate;
+
+    for (;;) {
+        bool pattern_space = *pattern == ' ';
+        pattern = asm_skip_spaces(pattern);
+
+        const char *text_start = text;
+        text = asm_skip_spaces(text);
+
+        // Words the pattern separates must be separated in the text too.
+        if (pattern_space && text == text_start && asm_is_identifier_char(text[-1]) && asm_is_identifier_char(*text)) {
+            n_literal = -1;
+            break;
+        }
+
+        if (*pattern == '\0') {
+            n_literal = *text == '\0' ? n_literal : -1;
+            break;
+        }
+
+        if (*pattern == '{') {
+            const char *type = strchr(pattern, ':');
+            const char *end = strchr(pattern, '}');
+            assert(type != NULL && end != NULL && n_args < ASM_MAX_ARGS);
+
+            type = asm_skip_spaces(type + 1);
+            asm_copy(arg_types[n_args], sizeof(arg_types[0]), "", type, (size_t)(end - type));
+
+            text = asm_expression(text, &args[n_args]);
+            ++n_args;
+
+            if (text == NULL) {
+                n_literal = -1;
+                break;
+            }
+
+            pattern = end + 1;
+            continue;
+        }
+
+        if (tolower((unsigned char)*pattern) != tolower((unsigned char)*text)) {
+            n_literal = -1;
+            break;
+        }
+
+        ++pattern;
+        ++text;
+        ++n_literal;
+    }
+
+    assembler.trying = false;
+    assembler.unresolved = evaluate ? assembler.unresolved : unresolved;
+    return n_literal;
+}
+
+// Checks that an argument fits its customasm type: uN unsigned, sN signed and iN either.
+static int64_t asm_fit(AsmValue value, const char *type) {
+    int bits = atoi(type + 1);
+    int64_t max = ((int64_t)1 << bits) - 1;
+    int64_t min = type[0] == 'u' ? 0 : -((int64_t)1 << (bits - 1));
+
+    if (type[0] == 's') {
+        max >>= 1;
+    }
+
+    if (value.value < min || value.value > max) {
+        asm_error("%lld does not fit in %s", (long long)value.value, type);
+    }
+
+    return value.value & (((int64_t)1 << bits) - 1);
+}
+
+// Lower cases `text` without spaces up to the first `{`.
+static size_t asm_literal_key(const char *text, char *key, size_t size) {
+    size_t length = 0;
+
+    for (; *text != '\0' && *text != '{' && length < size - 1; ++text) {
+        if (*text != ' ' && *text != '\t') {
+            key[length++] = (char)tolower((unsigned char)*text);
+        }
+    }
+
+    key[length] = '\0';
+    return length;
+}
+
+static void asm_instruction(const char *text) {
+    const AsmRule *best = assembler.line->rule > 0 ? &assembler.rules[assembler.line->rule - 1] : NULL;
+    int best_n_literal = -1;
+
+    // Most rules differ from the text before their first parameter, compared without the spaces.
+    char key[64] = "";
+    size_t key_length = assembler.line->rule == 0 ? asm_literal_key(text, key, sizeof(key)) : 0;
+
+    uint8_t first = (uint8_t)key[0] & 0x7f;
+
+    for (int i = assembler.rules_first[first]; assembler.line->rule == 0 && i < assembler.rules_end[first]; ++i) {
+        const AsmRule *candidate = &assembler.rules[i];
+
+        if (candidate->prefix_length > key_length || memcmp(candidate->prefix, key, candidate->prefix_length) != 0) {
+            continue;
+        }
+
+        AsmValue args[ASM_MAX_ARGS];
+        char arg_types[ASM_MAX_ARGS][8];
+
+        int n_literal = asm_match(candidate->pattern, text, args, arg_types, false);
+
+        if (n_literal > best_n_literal) {
+            best_n_literal = n_literal;
+            best = candidate;
+        }
+    }
+
+    if (best == NULL) {
+        asm_error("No instruction matches %s", text);
+        return;
+    }
+
+    assembler.line->rule = (int)(best - assembler.rules) + 1;
+
+    // Matched again to evaluate the arguments with errors reported.
+    AsmValue args[ASM_MAX_ARGS];
+    char arg_types[ASM_MAX_ARGS][8];
+    asm_match(best->pattern, text, args, arg_types, true);
+
+    switch (best->op) {
+    case NONE:
+        asm_emit(best->opcode);
+        break;
+    case PORT:
+    case PORT_A:
+        asm_emit((uint8_t)(best->opcode + asm_fit(args[0], arg_types[0])));
+        break;
+    case PORT_IMM8:
+        asm_emit((uint8_t)(best->opcode + asm_fit(args[0], arg_types[0])));
+        asm_emit((uint8_t)asm_fit(args[1], arg_types[1]));
+        break;
+    case IMM8:
+    case IMM8_IN_NAME:
+        asm_emit(best->opcode);
+        asm_emit((uint8_t)asm_fit(args[0], arg_types[0]));
+        break;
+    case IMM16: {
+        int64_t imm = asm_fit(args[0], arg_types[0]);
+        asm_emit(best->opcode);
+        asm_emit((uint8_t)(imm & 0xff));
+        asm_emit((uint8_t)(imm >> 8));
+        break;
+    }
+    }
+}
+
+// `#d` takes strings and values with a known size like 0xff, 0b1010_1010 or x`16, written big endian.
+static void asm_data(const char *s) {
+    for (;;) {
+        s = asm_skip_spaces(s);
+
+        if (*s == '"') {
+            for (++s; *s != '"'; ++s) {
+                if (*s == '\0') {
+                    asm_error("Unterminated string");
+                    return;
+                }
+
+                if (*s != '\\') {
+                    asm_emit((uint8_t)*s);
+                    continue;
+                }
+
+                ++s;
+
+                switch (*s) {
+                case '0': asm_emit('\0'); break;
+                case 'n': asm_emit('\n'); break;
+                case 'r': asm_emit('\r'); break;
+                case 't': asm_emit('\t'); break;
+                case '\\': asm_emit('\\'); break;
+                case '"': asm_emit('"'); break;
+                case '\'': asm_emit('\''); break;
+                case 'x':
+                    if (isxdigit((unsigned char)s[1]) && isxdigit((unsigned char)s[2])) {
+                        char hex[3] = {s[1], s[2], '\0'};
+                        asm_emit((uint8_t)strtoul(hex, NULL, 16));
+                        s += 2;
+                        break;
+                    }
+                    // fall through
+                default: asm_error("Unknown escape \\%c", *s); return;
+                }
+            }
+
+            ++s;
+        } else {
+            AsmValue value;
+            const char *end = asm_expression(s, &value);
+
+            if (end == NULL) {
+                asm_error("Invalid data %s", s);
+                return;
+            }
+
+            if (value.size == 0 || value.size % 8 != 0) {
+                asm_error("Data needs a size in whole bytes, e.g. 0x00, 0b0000_0000 or x`8");
+            }
+
+            for (int i = value.size / 8 - 1; i >= 0; --i) {
+                asm_emit((uint8_t)((value.value >> (8 * i)) & 0xff));
+            }
+
+            s = end;
+        }
+
+        s = asm_skip_spaces(s);
+
+        if (*s == '\0') {
+            return;
+        }
+
+        if (*s != ',') {
+            asm_error("Expected , in data");
+            return;
+        }
+
+        ++s;
+    }
+}
+
+static AsmBank *asm_find_bank(const char *name) {
+    for (int i = 0; i < assembler.n_banks; ++i) {
+        if (strcmp(assembler.banks[i].name, name) == 0) {
+            return &assembler.banks[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool asm_directive_is(const char **s, const char *directive) {
+    size_t length = strlen(directive);
+
+    if (strncmp(*s, directive, length) != 0 || asm_is_identifier_char((*s)[length])) {
+        return false;
+    }
+
+    *s = asm_skip_spaces(*s + length);
+    return true;
+}
+
+// Lines inside `#bankdef name { ... }`.
+static void asm_bankdef_line(AsmBank *bank, const char *s) {
+    AsmValue value = {0};
+
+    if (*s == '{' || *s == '\0') {
+        return;
+    } else if (asm_directive_is(&s, "#addr")) {
+        asm_evaluate(s, &value);
+        bank->addr = value.value;
+    } else if (asm_directive_is(&s, "#size")) {
+        asm_evaluate(s, &value);
+        bank->size = value.value;
+    } else if (asm_directive_is(&s, "#outp")) {
+        asm_evaluate(s, &value);
+        bank->outp = value.value;
+
+        if (bank->outp < 0 || bank->outp % 8 != 0) {
+            asm_error("#outp must be a multiple of 8 bits");
+            bank->outp = -1;
+        }
+    } else if (asm_directive_is(&s, "#fill")) {
+        bank->fill = true;
+    } else {
+        asm_error("Unknown bank setting %s", s);
+    }
+}
+
+static void asm_directive(const char *s) {
+    AsmValue value = {0};
+
+    if (asm_directive_is(&s, "#d")) {
+        asm_data(s);
+    } else if (asm_directive_is(&s, "#res")) {
+        if (asm_evaluate(s, &value)) {
+            if (value.value < 0) {
+                asm_error("Negative #res");
+            }
+
+            AsmBank *bank = &assembler.banks[assembler.bank];
+            bank->pc += value.value > 0 ? value.value : 0;
+        }
+    } else if (asm_directive_is(&s, "#addr")) {
+        if (asm_evaluate(s, &value)) {
+            assembler.banks[assembler.bank].pc = value.value;
+        }
+    } else if (asm_directive_is(&s, "#bank")) {
+        AsmBank *bank = asm_find_bank(s);
+
+        if (bank == NULL) {
+            asm_error("Unknown bank %s", s);
+        } else {
+            assembler.bank = (int)(bank - assembler.banks);
+        }
+    } else if (asm_directive_is(&s, "#bits")) {
+        if (asm_evaluate(s, &value) && value.value != 8) {
+            asm_error("Only #bits 8 is supported");
+        }
+    } else if (asm_directive_is(&s, "#once")) {
+        // Handled when loading
+    } else {
+        asm_error("Unknown directive %s", s);
+    }
+}
+
+// One line: any number of `label:`, then a constant, a directive or an instruction.
+static void asm_statement(const char *s) {
+    assembler.statement_pc = asm_pc();
+    assembler.line->pc = assembler.statement_pc;
+    assembler.line->offset = -1;
+    assembler.line->labeled = false;
+
+    for (;;) {
+        s = asm_skip_spaces(s);
+
+        char name[ASM_MAX_SYMBOL_LENGTH];
+        const char *end = asm_identifier(s, name, sizeof(name));
+
+        if (end == NULL) {
+            break;
+        }
+
+        end = asm_skip_spaces(end);
+
+        if (*end == ':') {
+            asm_define(name, asm_pc());
+            assembler.line->labeled = true;
+            s = end + 1;
+        } else if (*end == '=' && end[1] != '=') {
+            AsmValue value = {0};
+            asm_evaluate(end + 1, &value);
+            asm_define(name, value.value);
+            return;
+        } else {
+            break;
+        }
+    }
+
+    if (*s == '\0') {
+        return;
+    }
+
+    if (*s == '#') {
+        asm_directive(s);
+    } else {
+        asm_instruction(s);
+    }
+}
+
+// Ends the line at its `;` comment, not counting semicolons in strings and character literals.
+static void asm_strip_comment(char *s) {
+    const char *start = s;
+    char quote = '\0';
+
+    for (; *s != '\0'; ++s) {
+        if (quote != '\0') {
+            if (*s == '\\' && s[1] != '\0') {
+                ++s;
+            } else if (*s == quote) {
+                quote = '\0';
+            }
+        } else if (*s == '"' || (*s == '\'' && s[1] != '\0' && s[2] == '\'')) {
+            quote = *s;
+        } else if (*s == ';') {
+            break;
+        }
+    }
+
+    // Trailing spaces as well so statements end at '\0'.
+    while (s > start && (s[-1] == ' ' || s[-1] == '\t' || s[-1] == '\r')) {
+        --s;
+    }
+
+    *s = '\0';
+}
+
+// Reads `filename` and the files it includes into lines, `#include`s are relative to the including file.
+static void asm_load(const char *filename, int depth) {
+    if (depth > ASM_MAX_INCLUDE_DEPTH) {
+        asm_error("#include nested too deep at %s", filename);
+        return;
+    }
+
+    for (int i = 0; i < assembler.n_files; ++i) {
+        if (assembler.files_once[i] && strcmp(assembler.files[i], filename) == 0) {
+            return;
+        }
+    }
+
+    // The rules are built in, a stale generated rule file must not shadow them.
+    const char *basename = strrchr(filename, '/') != NULL ? strrchr(filename, '/') + 1 : filename;
+
+    if (strcmp(basename, "bleh_instructions.asm") == 0) {
+        return;
+    }
+
+    FILE *file = fopen(filename, "r");
+
+    if (file == NULL) {
+        asm_error("Failed to read %s", filename);
+        return;
+    }
+
+    assert(assembler.n_files < ASM_MAX_FILES && "Too many files");
+    uint8_t file_index = (uint8_t)assembler.n_files++;
+    snprintf(assembler.files[file_index], sizeof(assembler.files[0]), "%s", filename);
+
+    char *source = assembler.source + assembler.source_size;
+    size_t size = fread(source, sizeof(char), ASM_MAX_SOURCE_SIZE - assembler.source_size - 1, file);
+    assert(size < ASM_MAX_SOURCE_SIZE - assembler.source_size - 1 && "Source too big");
+    fclose(file);
+
+    source[size] = '\0';
+    assembler.source_size += size + 1;
+
+    AsmLine *including_line = assembler.line;
+    int line_number = 1;
+
+    for (char *line = source; line != NULL; ++line_number) {
+        char *next = strchr(line, '\n');
+
+        if (next != NULL) {
+            *next = '\0';
+        }
+
+        asm_strip_comment(line);
+
+        const char *s = asm_skip_spaces(line);
+        AsmLine at = {.text = s, .file = file_index, .line = line_number, .offset = -1};
+
+        if (asm_directive_is(&s, "#include")) {
+            char path[256];
+            size_t length = strlen(s);
+
+            if (length < 2 || s[0] != '"' || s[length - 1] != '"') {
+                assembler.line = &at;
+                asm_error("Expected #include \"file\"");
+            } else if (s[1] == '/' || basename == filename) {
+                snprintf(path, sizeof(path), "%.*s", (int)(length - 2), s + 1);
+                assembler.line = &at;
+                asm_load(path, depth + 1);
+            } else {
+                snprintf(path, sizeof(path), "%.*s%.*s", (int)(basename - filename), filename, (int)(length - 2), s + 1);
+                assembler.line = &at;
+                asm_load(path, depth + 1);
+            }
+        } else if (asm_directive_is(&s, "#once")) {
+            assembler.files_once[file_index] = true;
+        } else if (*s != '\0') {
+            assert(assembler.n_lines < ASM_MAX_LINES && "Too many lines");
+            assembler.lines[assembler.n_lines++] = at;
+        }
+
+        line = next != NULL ? next + 1 : NULL;
+    }
+
+    assembler.line = including_line;
+}
+
+static void asm_pass(void) {
+    assembler.n_banks = 1;
+    assembler.bank = 0;
+    assembler.banks[0] = (AsmBank){.name = "", .size = 0x10000};
+    assembler.scope[0] = '\0';
+    assembler.unresolved = false;
+    assembler.changed = false;
+    memset(assembler.output, 0, assembler.output_size);
+
+    AsmBank *bankdef = NULL;
+    int ruledef_depth = 0;
+
+    for (int i = 0; i < assembler.n_lines; ++i) {
+        assembler.line = &assembler.lines[i];
+        const char *s = assembler.line->text;
+
+        // Rules come from rule_from_opcode, a #ruledef block is skipped.
+        if (ruledef_depth > 0 || asm_directive_is(&s, "#ruledef")) {
+            for (const char *c = s; *c != '\0'; ++c) {
+                ruledef_depth += *c == '{' ? 1 : *c == '}' ? -1 : 0;
+            }
+
+            continue;
+        }
+
+        if (bankdef != NULL) {
+            if (*s == '}') {
+                bankdef->pc = bankdef->addr;
+                bankdef->end = bankdef->addr;
+                bankdef = NULL;
+            } else {
+                asm_bankdef_line(bankdef, s);
+            }
+
+            continue;
+        }
+
+        if (asm_directive_is(&s, "#bankdef")) {
+            char name[32];
+            snprintf(name, sizeof(name), "%.*s", (int)strcspn(s, " \t{"), s);
+
+            if (asm_find_bank(name) != NULL || assembler.n_banks == ASM_MAX_BANKS) {
+                asm_error("Bank %s is already defined or too many banks", name);
+                continue;
+            }
+
+            bankdef = &assembler.banks[assembler.n_banks];
+            *bankdef = (AsmBank){.outp = -1};
+            snprintf(bankdef->name, sizeof(bankdef->name), "%s", name);
+
+            // Like customasm, the latest bank definition is the one used until a #bank.
+            assembler.bank = assembler.n_banks++;
+
+            if (strchr(s, '}') != NULL) {
+                bankdef = NULL;
+            }
+
+            continue;
+        }
+
+        asm_statement(assembler.line->text);
+    }
+
+    assembler.line = NULL;
+
+    if (bankdef != NULL) {
+        asm_error("Missing } after #bankdef %s", bankdef->name);
+    }
+
+    assembler.output_length = 0;
+
+    for (int i = 0; i < assembler.n_banks; ++i) {
+        const AsmBank *bank = &assembler.banks[i];
+
+        if (bank->outp >= 0) {
+            int64_t end = bank->outp / 8 + (bank->fill ? bank->size : bank->end - bank->addr);
+            assembler.output_length = end > (int64_t)assembler.output_length ? (size_t)end : assembler.output_length;
+        }
+    }
+
+    if (assembler.output_length > assembler.output_size) {
+        asm_error("Output is bigger than %zu bytes", assembler.output_size);
+        assembler.output_length = assembler.output_size;
+    }
+}
+
+// Passes repeat until every label keeps its address, errors are printed by a last pass if there are any.
+static int asm_passes(size_t *output_length) {
+    assembler.report = false;
+
+    for (assembler.pass = 1; assembler.pass < ASM_MAX_PASSES; ++assembler.pass) {
+        assembler.n_errors = 0;
+        asm_pass();
+
+        if (!assembler.changed && !assembler.unresolved) {
+            break;
+        }
+    }
+
+    // A pass that changed nothing and counted no errors is final, otherwise one more prints the errors.
+    if (assembler.pass == ASM_MAX_PASSES || assembler.n_errors > 0) {
+        ++assembler.pass;
+        assembler.n_errors = 0;
+        assembler.report = true;
+        asm_pass();
+    }
+
+    *output_length = assembler.output_length;
+    return assembler.n_errors;
+}
+
+// Assembles `filename` into `output` and returns the number of errors, printed to stderr.
+static int assemble(const char *filename, uint8_t *output, size_t output_size, size_t *output_length) {
+    // The source and line buffers are only read up to their sizes, so they are not cleared.
+    assembler.source_size = 0;
+    assembler.n_files = 0;
+    memset(assembler.files_once, 0, sizeof(assembler.files_once));
+    assembler.n_lines = 0;
+    memset(assembler.symbols, 0, sizeof(assembler.symbols));
+    assembler.pass = 0;
+    assembler.line = NULL;
+    assembler.n_errors = 0;
+    assembler.output = output;
+    assembler.output_size = output_size;
+    assembler.report = true;
+
+    // Built once. Like rule_defined_before, the first opcode of a pattern wins.
+    if (assembler.n_rules == 0) {
+        static AsmRule rules[256];
+        int n_rules = 0;
+
+        for (Opcode opcode = 0; opcode < 0x100; ++opcode) {
+            Rule r = rule_from_opcode(opcode);
+
+            if (r.n[0] == '\0' || r.n[0] == ';') {
+                continue;
+            }
+
+            AsmRule *asm_rule = &rules[n_rules];
+            asm_rule->opcode = (uint8_t)opcode;
+            asm_rule->op = r.op;
+            rule_pattern(r, asm_rule->pattern, sizeof(asm_rule->pattern));
+            asm_rule->prefix_length = asm_literal_key(asm_rule->pattern, asm_rule->prefix, sizeof(asm_rule->prefix));
+
+            bool defined_before = false;
+
+            for (int i = 0; i < n_rules && !defined_before; ++i) {
+                defined_before = rules[i].op == asm_rule->op && strcmp(rules[i].pattern, asm_rule->pattern) == 0;
+            }
+
+            n_rules += defined_before ? 0 : 1;
+        }
+
+        for (int first = 0; first < 128; ++first) {
+            assembler.rules_first[first] = assembler.n_rules;
+
+            for (int i = 0; i < n_rules; ++i) {
+                if (rules[i].prefix[0] == first) {
+                    assembler.rules[assembler.n_rules++] = rules[i];
+                }
+            }
+
+            assembler.rules_end[first] = assembler.n_rules;
+        }
+    }
+
+    asm_load(filename, 0);
+
+    if (assembler.n_errors > 0) {
+        return assembler.n_errors;
+    }
+
+    return asm_passes(output_length);
+}
+
+// Assembles the loaded lines again after a tool replaced the text of some, clearing their `rule`.
+static int reassemble(uint8_t *output, size_t output_size, size_t *output_length) {
+    memset(assembler.symbols, 0, sizeof(assembler.symbols));
+    assembler.line = NULL;
+    assembler.n_errors = 0;
+    assembler.output = output;
+    assembler.output_size = output_size;
+
+    return asm_passes(output_length);
+}
+
+#endif
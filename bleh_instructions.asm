@@ -0,0 +1,242 @@
+; Generated Mon Oct 19 02:08:18 2026
+
+#bits 8
+
+#ruledef {
+    nop => (0x00) ; 8 cycles
+    ld a, {imm: i8} => (0x01) @ imm ; 3 cycles
+    ld b, {imm: i8} => (0x02) @ imm ; 3 cycles
+    ld c, {imm: i8} => (0x03) @ imm ; 3 cycles
+    ld d, {imm: i8} => (0x04) @ imm ; 3 cycles
+    ld i, {imm: i16} => (0x05) @ le(imm) ; 5 cycles
+    ld j, {imm: i16} => (0x06) @ le(imm) ; 5 cycles
+    ld a, [i] => (0x07) ; 10 cycles
+    ld a, [j] => (0x08) ; 10 cycles
+    ld a, [i++] => (0x09) ; 12 cycles
+    ld a, [j++] => (0x0a) ; 12 cycles
+    ld [i], a => (0x0b) ; 10 cycles
+    ld [j], a => (0x0c) ; 10 cycles
+    ld [i++], a => (0x0d) ; 12 cycles
+    ld [j++], a => (0x0e) ; 12 cycles
+    ld [i], ab => (0x0f) ; 12 cycles
+    ld [i], cd => (0x10) ; 12 cycles
+    ld [j], cd => (0x11) ; 12 cycles
+    ld ab, [i] => (0x12) ; 12 cycles
+    ld cd, [i] => (0x13) ; 12 cycles
+    ld cd, [j] => (0x14) ; 12 cycles
+    ld a, b => (0x15) ; 4 cycles
+    ld a, c => (0x16) ; 4 cycles
+    ld a, d => (0x17) ; 4 cycles
+    ld b, a => (0x18) ; 4 cycles
+    ld b, c => (0x19) ; 4 cycles
+    ld b, d => (0x1a) ; 4 cycles
+    ld c, a => (0x1b) ; 4 cycles
+    ld c, b => (0x1c) ; 4 cycles
+    ld c, d => (0x1d) ; 4 cycles
+    ld d, a => (0x1e) ; 4 cycles
+    ld d, b => (0x1f) ; 4 cycles
+    ld d, c => (0x20) ; 4 cycles
+    inc a => (0x21) ; 5 cycles
+    shl a => (0x22) ; 5 cycles
+    shr a => (0x23) ; 5 cycles
+    not a => (0x24) ; 5 cycles
+    dec a => (0x25) ; 5 cycles
+    ror a => (0x26) ; 5 cycles
+    add a, b => (0x27) ; 7 cycles
+    or a, b => (0x28) ; 7 cycles
+    and a, b => (0x29) ; 7 cycles
+    xor a, b => (0x2a) ; 7 cycles
+    adc a, b => (0x2b) ; 7 cycles
+    dec b => (0x2c) ; 5 cycles
+    dec c => (0x2d) ; 5 cycles
+    dec d => (0x2e) ; 5 cycles
+    inc b => (0x2f) ; 5 cycles
+    inc c => (0x30) ; 5 cycles
+    inc d => (0x31) ; 5 cycles
+    add d, b => (0x32) ; 7 cycles
+    adc c, a => (0x33) ; 7 cycles
+    adc d, {imm: i8} => (0x34) @ imm ; 6 cycles
+    add a, {imm: i8} => (0x35) @ imm ; 6 cycles
+    or a, {imm: i8} => (0x36) @ imm ; 6 cycles
+    and a, {imm: i8} => (0x37) @ imm ; 6 cycles
+    xor a, {imm: i8} => (0x38) @ imm ; 6 cycles
+    adc a, {imm: i8} => (0x39) @ imm ; 6 cycles
+    add b, {imm: i8} => (0x3a) @ imm ; 6 cycles
+    cmp a, {imm: i8} => (0x3b) @ imm ; 5 cycles
+    cmp b, {imm: i8} => (0x3c) @ imm ; 5 cycles
+    jmp i => (0x3d) ; 4 cycles
+    jmp j => (0x3e) ; 4 cycles
+    jmp {imm: i16} => (0x3f) @ le(imm) ; 4 cycles
+    jz {imm: i16} => (0x40) @ le(imm) ; 4 cycles
+    jnz {imm: i16} => (0x41) @ le(imm) ; 4 cycles
+    jc {imm: i16} => (0x42) @ le(imm) ; 4 cycles
+    jnc {imm: i16} => (0x43) @ le(imm) ; 4 cycles
+    jo {imm: i16} => (0x44) @ le(imm) ; 4 cycles
+    jno {imm: i16} => (0x45) @ le(imm) ; 4 cycles
+    js {imm: i16} => (0x46) @ le(imm) ; 4 cycles
+    jns {imm: i16} => (0x47) @ le(imm) ; 4 cycles
+    ld sp, {imm: i8} => (0x48) @ imm ; 3 cycles
+    push a => (0x49) ; 11 cycles
+    push b => (0x4a) ; 11 cycles
+    push c => (0x4b) ; 11 cycles
+    push d => (0x4c) ; 11 cycles
+    push i => (0x4d) ; 13 cycles
+    push j => (0x4e) ; 13 cycles
+    pop a => (0x4f) ; 11 cycles
+    pop b => (0x50) ; 11 cycles
+    pop c => (0x51) ; 11 cycles
+    pop d => (0x52) ; 11 cycles
+    pop i => (0x53) ; 15 cycles
+    pop j => (0x54) ; 15 cycles
+    call {imm: i16} => (0x55) @ le(imm) ; 15 cycles
+    ret => (0x56) ; 11 cycles
+    ld a, [sp+{imm: i8}] => (0x57) @ imm ; 12 cycles
+    halt => (0x58)
+    ld [j++], [i++] => (0x59) ; 16 cycles
+    inc i => (0x5a) ; 5/8 cycles
+    inc j => (0x5b) ; 5/8 cycles
+    dec i => (0x5c) ; 7/9 cycles
+    dec j => (0x5d) ; 7/9 cycles
+    add i, {imm: i8} => (0x5e) @ imm ; 6/9 cycles
+    add i, a => (0x5f) ; 7/10 cycles
+    ld [sp+{imm: i8}], a => (0x60) @ imm ; 12 cycles
+    ld a, [i+{imm: u8}] => (0x61) @ imm ; 13 cycles
+    ld a, [j+{imm: u8}] => (0x62) @ imm ; 13 cycles
+    ld [i+{imm: u8}], a => (0x63) @ imm ; 13 cycles
+    ld [j+{imm: u8}], a => (0x64) @ imm ; 13 cycles
+    djnz b, {imm: i16} => (0x65) @ le(imm) ; 6/8 cycles
+    djnz c, {imm: i16} => (0x66) @ le(imm) ; 6/8 cycles
+    djnz d, {imm: i16} => (0x67) @ le(imm) ; 6/8 cycles
+    ld a, [i+a] => (0x68) ; 14 cycles
+    rol a => (0x69) ; 5 cycles
+    sar a => (0x6a) ; 5 cycles
+    swap a => (0x6b) ; 8 cycles
+    sub a, b => (0x6c) ; 7 cycles
+    sbc a, b => (0x6d) ; 7 cycles
+    cmp a, b => (0x6e) ; 6 cycles
+    mulstep a, b => (0x6f) ; 7 cycles
+    ; add a, {imm: i8} => (0x70) @ imm ; 6 cycles
+    ; add a, b => (0x71) ; 7 cycles
+    add a, c => (0x72) ; 7 cycles
+    add a, d => (0x73) ; 7 cycles
+    add b, a => (0x74) ; 7 cycles
+    ; add b, {imm: i8} => (0x75) @ imm ; 6 cycles
+    add b, c => (0x76) ; 7 cycles
+    add b, d => (0x77) ; 7 cycles
+    add c, a => (0x78) ; 7 cycles
+    add c, b => (0x79) ; 7 cycles
+    add c, {imm: i8} => (0x7a) @ imm ; 6 cycles
+    add c, d => (0x7b) ; 7 cycles
+    add d, a => (0x7c) ; 7 cycles
+    ; add d, b => (0x7d) ; 7 cycles
+    add d, c => (0x7e) ; 7 cycles
+    add d, {imm: i8} => (0x7f) @ imm ; 6 cycles
+    ; adc a, {imm: i8} => (0x80) @ imm ; 6 cycles
+    ; adc a, b => (0x81) ; 7 cycles
+    adc a, c => (0x82) ; 7 cycles
+    adc a, d => (0x83) ; 7 cycles
+    adc b, a => (0x84) ; 7 cycles
+    adc b, {imm: i8} => (0x85) @ imm ; 6 cycles
+    adc b, c => (0x86) ; 7 cycles
+    adc b, d => (0x87) ; 7 cycles
+    ; adc c, a => (0x88) ; 7 cycles
+    adc c, b => (0x89) ; 7 cycles
+    adc c, {imm: i8} => (0x8a) @ imm ; 6 cycles
+    adc c, d => (0x8b) ; 7 cycles
+    adc d, a => (0x8c) ; 7 cycles
+    adc d, b => (0x8d) ; 7 cycles
+    adc d, c => (0x8e) ; 7 cycles
+    ; adc d, {imm: i8} => (0x8f) @ imm ; 6 cycles
+    sub a, {imm: i8} => (0x90) @ imm ; 6 cycles
+    ; sub a, b => (0x91) ; 7 cycles
+    sub a, c => (0x92) ; 7 cycles
+    sub a, d => (0x93) ; 7 cycles
+    sub b, a => (0x94) ; 7 cycles
+    sub b, {imm: i8} => (0x95) @ imm ; 6 cycles
+    sub b, c => (0x96) ; 7 cycles
+    sub b, d => (0x97) ; 7 cycles
+    sub c, a => (0x98) ; 7 cycles
+    sub c, b => (0x99) ; 7 cycles
+    sub c, {imm: i8} => (0x9a) @ imm ; 6 cycles
+    sub c, d => (0x9b) ; 7 cycles
+    sub d, a => (0x9c) ; 7 cycles
+    sub d, b => (0x9d) ; 7 cycles
+    sub d, c => (0x9e) ; 7 cycles
+    sub d, {imm: i8} => (0x9f) @ imm ; 6 cycles
+    ; and a, {imm: i8} => (0xa0) @ imm ; 6 cycles
+    ; and a, b => (0xa1) ; 7 cycles
+    and a, c => (0xa2) ; 7 cycles
+    and a, d => (0xa3) ; 7 cycles
+    and b, a => (0xa4) ; 7 cycles
+    and b, {imm: i8} => (0xa5) @ imm ; 6 cycles
+    and b, c => (0xa6) ; 7 cycles
+    and b, d => (0xa7) ; 7 cycles
+    and c, a => (0xa8) ; 7 cycles
+    and c, b => (0xa9) ; 7 cycles
+    and c, {imm: i8} => (0xaa) @ imm ; 6 cycles
+    and c, d => (0xab) ; 7 cycles
+    and d, a => (0xac) ; 7 cycles
+    and d, b => (0xad) ; 7 cycles
+    and d, c => (0xae) ; 7 cycles
+    and d, {imm: i8} => (0xaf) @ imm ; 6 cycles
+    ; or a, {imm: i8} => (0xb0) @ imm ; 6 cycles
+    ; or a, b => (0xb1) ; 7 cycles
+    or a, c => (0xb2) ; 7 cycles
+    or a, d => (0xb3) ; 7 cycles
+    or b, a => (0xb4) ; 7 cycles
+    or b, {imm: i8} => (0xb5) @ imm ; 6 cycles
+    or b, c => (0xb6) ; 7 cycles
+    or b, d => (0xb7) ; 7 cycles
+    or c, a => (0xb8) ; 7 cycles
+    or c, b => (0xb9) ; 7 cycles
+    or c, {imm: i8} => (0xba) @ imm ; 6 cycles
+    or c, d => (0xbb) ; 7 cycles
+    or d, a => (0xbc) ; 7 cycles
+    or d, b => (0xbd) ; 7 cycles
+    or d, c => (0xbe) ; 7 cycles
+    or d, {imm: i8} => (0xbf) @ imm ; 6 cycles
+    ; xor a, {imm: i8} => (0xc0) @ imm ; 6 cycles
+    ; xor a, b => (0xc1) ; 7 cycles
+    xor a, c => (0xc2) ; 7 cycles
+    xor a, d => (0xc3) ; 7 cycles
+    xor b, a => (0xc4) ; 7 cycles
+    xor b, {imm: i8} => (0xc5) @ imm ; 6 cycles
+    xor b, c => (0xc6) ; 7 cycles
+    xor b, d => (0xc7) ; 7 cycles
+    xor c, a => (0xc8) ; 7 cycles
+    xor c, b => (0xc9) ; 7 cycles
+    xor c, {imm: i8} => (0xca) @ imm ; 6 cycles
+    xor c, d => (0xcb) ; 7 cycles
+    xor d, a => (0xcc) ; 7 cycles
+    xor d, b => (0xcd) ; 7 cycles
+    xor d, c => (0xce) ; 7 cycles
+    xor d, {imm: i8} => (0xcf) @ imm ; 6 cycles
+    ; cmp a, {imm: i8} => (0xd0) @ imm ; 5 cycles
+    ; cmp a, b => (0xd1) ; 6 cycles
+    cmp a, c => (0xd2) ; 6 cycles
+    cmp a, d => (0xd3) ; 6 cycles
+    cmp b, a => (0xd4) ; 6 cycles
+    ; cmp b, {imm: i8} => (0xd5) @ imm ; 5 cycles
+    cmp b, c => (0xd6) ; 6 cycles
+    cmp b, d => (0xd7) ; 6 cycles
+    cmp c, a => (0xd8) ; 6 cycles
+    cmp c, b => (0xd9) ; 6 cycles
+    cmp c, {imm: i8} => (0xda) @ imm ; 5 cycles
+    cmp c, d => (0xdb) ; 6 cycles
+    cmp d, a => (0xdc) ; 6 cycles
+    cmp d, b => (0xdd) ; 6 cycles
+    cmp d, c => (0xde) ; 6 cycles
+    cmp d, {imm: i8} => (0xdf) @ imm ; 5 cycles
+    ld i, [j] => (0xe0) ; 12 cycles
+    ld j, [i] => (0xe1) ; 12 cycles
+    ld i, [i] => (0xe2) ; 12 cycles
+    ; ? => (0xe3)
+    ; ; ? => (0xe4)
+    ; ; ? => (0xe5)
+    ; ; ? => (0xe6)
+    ; ; ? => (0xe7)
+    in a, {port: u3} => (0xe8 + port)`8 ; 5 cycles
+    out {port: u3}, a => (0xf0 + port)`8 ; 4 cycles
+    out {port: u3}, {imm: i8} => (0xf8 + port)`8 @ imm ; 3 cycles
+}
+
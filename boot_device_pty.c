@@ -0,0 +1,230 @@
+#define _XOPEN_SOURCE 700 // posix_openpt, grantpt, unlockpt, ptsname
+#define _DEFAULT_SOURCE // cfmakeraw
+#define _DARWIN_C_SOURCE // cfmakeraw
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h> // open, O_*
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h> // f*, printf
+#include <stdlib.h> // exit, rand, strtoul, posix_openpt, grantpt, unlockpt, ptsname
+#include <string.h> // memcpy, strcmp
+#include <termios.h> // cfmakeraw, tcgetattr, tcsetattr
+#include <time.h> // clock_gettime, nanosleep
+#include <unistd.h> // read, write
+
+#include "arduino/BootDeviceSketch/boot_device.h"
+
+// Stand-in for the arduino boot device on a pseudo-terminal, running the sketch's
+// arduino/BootDeviceSketch/boot_device.h. Bytes written to the terminal are taken
+// at the serial line's rate while a model of software/boot_device_loader.asm reads
+// frames at the rate the CPU would, 26 cycles a byte. Once the loader has booted,
+// what it loaded is written to a file and the tool exits.
+
+#define LOADER_CYCLES_PER_BYTE (26)
+
+typedef enum {
+    LOADER_WAITING_FOR_READY,
+    LOADER_READING_FRAME,
+    LOADER_BOOTED,
+} LoaderState;
+
+// The loader's side of the boot port, one `in` per step.
+typedef struct {
+    LoaderState state;
+    uint8_t frame[BOOT_FRAME_CAP];
+    uint16_t frame_size;
+    uint8_t image[BOOT_PROGRAM_SIZE_CAP];
+    uint16_t image_size;
+    int n_naks;
+} Loader;
+
+static BootDevice device;
+static Loader loader;
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static void loader_frame_read(void) {
+    uint8_t sum = 0;
+
+    for (uint16_t i = 0; i < loader.frame_size; ++i) {
+        sum = (uint8_t)(sum + loader.frame[i]);
+    }
+
+    if (sum != 0) {
+        ++loader.n_naks;
+        boot_device_bus_write(&device, BOOT_NAK);
+        loader.frame_size = 0;
+        return;
+    }
+
+    boot_device_bus_write(&device, BOOT_ACK);
+
+    uint16_t n_bytes = (uint16_t)(4 * loader.frame[0]);
+    uint16_t offset = (uint16_t)((loader.frame[1] | loader.frame[2] << 8) - BOOT_ADDRESS);
+
+    if (n_bytes == 0) {
+        loader.state = LOADER_BOOTED;
+    } else if (offset + n_bytes <= BOOT_PROGRAM_SIZE_CAP) {
+        memcpy(loader.image + offset, loader.frame + BOOT_FRAME_HEADER_SIZE, n_bytes);
+        loader.image_size = (uint16_t)(offset + n_bytes > loader.image_size ? offset + n_bytes : loader.image_size);
+    }
+
+    loader.frame_size = 0;
+}
+
+static void loader_step(void) {
+    uint8_t value = boot_device_bus_read(&device);
+
+    switch (loader.state) {
+    case LOADER_WAITING_FOR_READY:
+        if (value == BOOT_READY) {
+            boot_device_bus_write(&device, BOOT_COMMAND_GET_BLOCKS);
+            loader.frame_size = 0;
+            loader.state = LOADER_READING_FRAME;
+        }
+        break;
+    case LOADER_READING_FRAME:
+        if (loader.frame_size == 0 && value == BOOT_NOT_READY) {
+            break;
+        }
+
+        loader.frame[loader.frame_size++] = value;
+
+        if (loader.frame_size == BOOT_FRAME_HEADER_SIZE + 4 * loader.frame[0] + 1) {
+            loader_frame_read();
+        }
+        break;
+    case LOADER_BOOTED:
+        break;
+    }
+}
+
+static void write_all(int fd, const uint8_t *bytes, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+
+        if (written < 0 && errno == EAGAIN) {
+            continue;
+        }
+
+        assert(written > 0 && "Failed to write to the pseudo-terminal");
+        bytes += written;
+        size -= (size_t)written;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <BOOTED PROGRAM>.bin [CLOCK FREQUENCY IN HZ] [--baud <RATE>] [--corrupt-every <N>]\n", argv[0]);
+        exit(1);
+    }
+
+    uint32_t clock_hz = argc > 2 && argv[2][0] != '-' ? (uint32_t)strtoul(argv[2], NULL, 10) : 1000000;
+    uint32_t baud = 115200;
+    uint32_t corrupt_every = 0; // Flips a bit of one in N bytes received at random, 0 for none
+
+    for (int i = argc > 2 && argv[2][0] != '-' ? 3 : 2; i < argc; ++i) {
+        if (strcmp(argv[i], "--baud") == 0 && i + 1 < argc) {
+            baud = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--corrupt-every") == 0 && i + 1 < argc) {
+            corrupt_every = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            exit(1);
+        }
+    }
+
+    if (clock_hz < LOADER_CYCLES_PER_BYTE || baud < 10) {
+        fprintf(stderr, "Unsupported clock or baud rate\n");
+        exit(1);
+    }
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    assert(master >= 0 && grantpt(master) == 0 && unlockpt(master) == 0 && "Failed to open a pseudo-terminal");
+
+    // Kept open so the terminal stays raw between uploaders, 8 bits through untouched.
+    int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    assert(slave >= 0 && "Failed to open the pseudo-terminal's slave side");
+
+    struct termios tio;
+    assert(tcgetattr(slave, &tio) == 0);
+    cfmakeraw(&tio);
+    assert(tcsetattr(slave, TCSANOW, &tio) == 0);
+
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+    printf("Boot device on %s\n", ptsname(master));
+    fflush(stdout);
+
+    uint64_t start_us = now_us();
+    uint64_t first_byte_us = 0;
+    uint64_t n_serial_bytes = 0; // Taken from the line so far
+    uint64_t n_loader_bytes = 0; // Read by the loader so far
+    uint8_t reply[BOOT_DEVICE_REPLY_CAP];
+
+    while (loader.state != LOADER_BOOTED) {
+        struct pollfd pfd = {.fd = master, .events = POLLIN};
+        poll(&pfd, 1, 1);
+
+        uint64_t elapsed_us = now_us() - start_us;
+
+        // 10 bits a byte on the line.
+        uint64_t line_budget = elapsed_us * baud / 10000000 - n_serial_bytes;
+        uint8_t bytes[256];
+        size_t n_to_read = line_budget < sizeof(bytes) ? (size_t)line_budget : sizeof(bytes);
+        ssize_t n_read = n_to_read > 0 ? read(master, bytes, n_to_read) : 0;
+
+        if (n_read > 0 && first_byte_us == 0) {
+            first_byte_us = elapsed_us;
+        }
+
+        for (ssize_t i = 0; i < n_read; ++i) {
+            if (corrupt_every > 0 && (uint32_t)rand() % corrupt_every == 0) {
+                bytes[i] ^= 0x10;
+            }
+
+            boot_device_serial_byte(&device, bytes[i]);
+        }
+
+        n_serial_bytes = n_read > 0 ? n_serial_bytes + (uint64_t)n_read : elapsed_us * baud / 10000000;
+
+        uint64_t loader_budget = elapsed_us * clock_hz / LOADER_CYCLES_PER_BYTE / 1000000;
+
+        while (n_loader_bytes < loader_budget && loader.state != LOADER_BOOTED) {
+            loader_step();
+            ++n_loader_bytes;
+        }
+
+        boot_device_poll(&device);
+        uint8_t n_reply = boot_device_take_reply(&device, reply);
+        write_all(master, reply, n_reply);
+    }
+
+    double boot_ms = (double)(now_us() - start_us - first_byte_us) / 1000.0;
+
+    printf("Booted %u bytes in %.1f ms after the first byte, %u frames, %d again, %u upload frames asked for again\n",
+           loader.image_size, boot_ms, device.bus.n_frames, loader.n_naks, device.n_upload_naks);
+
+    FILE *file = fopen(argv[1], "wb");
+    assert(file != NULL && "Failed to open the output");
+    assert(fwrite(loader.image, 1, loader.image_size, file) == loader.image_size && "Failed to write the output");
+    assert(fclose(file) == 0 && "Failed to close the output");
+
+    // Drains the last acknowledgement before the terminal goes away.
+    boot_device_poll(&device);
+    uint8_t n_reply = boot_device_take_reply(&device, reply);
+    write_all(master, reply, n_reply);
+    nanosleep(&(struct timespec){.tv_nsec = 100000000}, NULL);
+
+    close(slave);
+    close(master);
+
+    return 0;
+}
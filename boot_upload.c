@@ -0,0 +1,325 @@
+#define _DEFAULT_SOURCE // cfmakeraw
+#define _DARWIN_C_SOURCE // cfmakeraw
+
+#include <assert.h>
+#include <fcntl.h> // open, O_*
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h> // f*, printf
+#include <stdlib.h> // exit, strtoul
+#include <string.h> // strcmp, strlen, strrchr
+#include <termios.h> // cf*, tcgetattr, tcsetattr, tcdrain
+#include <time.h> // clock_gettime
+#include <unistd.h> // read, write
+
+#include "arduino/BootDeviceSketch/boot_device.h"
+
+// Uploads a program to the arduino boot device, or boot_device_pty.c, as binary
+// frames, see arduino/BootDeviceSketch/boot_device.h. Frames are sent up to
+// UPLOAD_WINDOW ahead of the last acknowledgement, so the line is kept busy
+// instead of waiting on an answer per frame. A NAK sends the frames from the one
+// it names again, as does hearing nothing for a while, which also covers the
+// board still starting after being reset by the port opening.
+
+#define MAX_FRAMES (2 + (BOOT_PROGRAM_SIZE_CAP + UPLOAD_FRAME_MAX_DATA - 1) / UPLOAD_FRAME_MAX_DATA)
+#define RESEND_AFTER_MS (250)
+#define GIVE_UP_AFTER_MS (5000) // Without any frame acknowledged
+
+typedef struct {
+    uint8_t bytes[UPLOAD_FRAME_CAP];
+    uint16_t size;
+} Frame;
+
+static uint8_t program[BOOT_PROGRAM_SIZE_CAP];
+static Frame frames[MAX_FRAMES];
+
+static uint64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static int hex_value(const char *digits, int n_digits) {
+    int value = 0;
+
+    for (int i = 0; i < n_digits; ++i) {
+        char c = digits[i];
+        int digit = c >= '0' && c <= '9'   ? c - '0'
+                    : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                    : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                                           : -1;
+        if (digit < 0) {
+            return -1;
+        }
+
+        value = value << 4 | digit;
+    }
+
+    return value;
+}
+
+// Intel HEX as customasm writes it, data records and the end of file record, the
+// addresses relative to the start of the program. Gaps are zeros.
+static size_t read_intel_hex(FILE *file, const char *filename) {
+    char line[600];
+    size_t size = 0;
+    int line_number = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        ++line_number;
+
+        size_t length = strlen(line);
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            line[--length] = '\0';
+        }
+
+        if (length == 0) {
+            continue;
+        }
+
+        int n_bytes = length >= 11 && line[0] == ':' ? hex_value(line + 1, 2) : -1;
+
+        if (n_bytes < 0 || length != 11 + 2 * (size_t)n_bytes) {
+            fprintf(stderr, "%s:%d: not an Intel HEX record\n", filename, line_number);
+            exit(1);
+        }
+
+        uint8_t sum = 0;
+
+        for (size_t i = 1; i < length; i += 2) {
+            int value = hex_value(line + i, 2);
+
+            if (value < 0) {
+                fprintf(stderr, "%s:%d: not an Intel HEX record\n", filename, line_number);
+                exit(1);
+            }
+
+            sum = (uint8_t)(sum + value);
+        }
+
+        if (sum != 0) {
+            fprintf(stderr, "%s:%d: checksum doesn't match\n", filename, line_number);
+            exit(1);
+        }
+
+        int address = hex_value(line + 3, 4);
+        int type = hex_value(line + 7, 2);
+
+        if (type == 0x01) {
+            return size;
+        } else if (type != 0x00) {
+            fprintf(stderr, "%s:%d: unsupported record type 0x%02x\n", filename, line_number, type);
+            exit(1);
+        } else if ((size_t)address + (size_t)n_bytes > sizeof(program)) {
+            fprintf(stderr, "%s:%d: beyond the %zu bytes a program can have\n", filename, line_number, sizeof(program));
+            exit(1);
+        }
+
+        for (int i = 0; i < n_bytes; ++i) {
+            program[address + i] = (uint8_t)hex_value(line + 9 + 2 * i, 2);
+        }
+
+        size = (size_t)address + (size_t)n_bytes > size ? (size_t)address + (size_t)n_bytes : size;
+    }
+
+    fprintf(stderr, "%s: missing the end of file record\n", filename);
+    exit(1);
+}
+
+static size_t read_program(const char *filename) {
+    FILE *file = fopen(filename, "rb");
+
+    if (file == NULL) {
+        fprintf(stderr, "Failed to open %s\n", filename);
+        exit(1);
+    }
+
+    const char *extension = strrchr(filename, '.');
+    size_t size;
+
+    if (extension != NULL && (strcmp(extension, ".hex") == 0 || strcmp(extension, ".ihex") == 0)) {
+        size = read_intel_hex(file, filename);
+    } else {
+        size = fread(program, 1, sizeof(program), file);
+
+        if (fgetc(file) != EOF) {
+            fprintf(stderr, "%s is bigger than the %zu bytes a program can have\n", filename, sizeof(program));
+            exit(1);
+        }
+    }
+
+    assert(fclose(file) == 0 && "Failed to close the program");
+
+    return size;
+}
+
+static speed_t speed_from_baud(uint32_t baud) {
+    switch (baud) {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    default:
+        fprintf(stderr, "Unsupported baud rate: %u\n", baud);
+        exit(1);
+    }
+}
+
+static void write_all(int fd, const uint8_t *bytes, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        assert(written > 0 && "Failed to write to the boot device");
+        bytes += written;
+        size -= (size_t)written;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <SERIAL PORT> <PROGRAM>.bin|.hex [--baud <RATE>]\n", argv[0]);
+        exit(1);
+    }
+
+    uint32_t baud = 115200;
+
+    for (int i = 3; i < argc; ++i) {
+        if (strcmp(argv[i], "--baud") == 0 && i + 1 < argc) {
+            baud = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            exit(1);
+        }
+    }
+
+    speed_t speed = speed_from_baud(baud);
+    size_t program_size = read_program(argv[2]);
+
+    // BEGIN, the data, END, numbered from 0 in 8 bits.
+    int n_frames = 0;
+    frames[n_frames].size = upload_frame(frames[n_frames].bytes, UPLOAD_BEGIN, 0, NULL, 0);
+    ++n_frames;
+
+    for (size_t offset = 0; offset < program_size; offset += UPLOAD_FRAME_MAX_DATA) {
+        size_t n_left = program_size - offset;
+        uint8_t n_bytes = (uint8_t)(n_left < UPLOAD_FRAME_MAX_DATA ? n_left : UPLOAD_FRAME_MAX_DATA);
+
+        frames[n_frames].size = upload_frame(frames[n_frames].bytes, UPLOAD_DATA, (uint8_t)n_frames, program + offset, n_bytes);
+        ++n_frames;
+    }
+
+    frames[n_frames].size = upload_frame(frames[n_frames].bytes, UPLOAD_END, (uint8_t)n_frames, NULL, 0);
+    ++n_frames;
+
+    int fd = open(argv[1], O_RDWR | O_NOCTTY);
+
+    if (fd < 0) {
+        fprintf(stderr, "Failed to open %s\n", argv[1]);
+        exit(1);
+    }
+
+    struct termios tio;
+    assert(tcgetattr(fd, &tio) == 0 && "Not a serial port");
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cflag |= CLOCAL | CREAD;
+    assert(tcsetattr(fd, TCSANOW, &tio) == 0 && "Failed to configure the serial port");
+
+    int base = 0; // Oldest frame not acknowledged
+    int next = 0; // Next frame to send
+    int n_resent = 0;
+    int n_naks = 0;
+    int n_timeouts = 0;
+    uint64_t n_bytes_sent = 0;
+    uint64_t start_ms = now_ms();
+    uint64_t progress_ms = start_ms; // Last time a frame was acknowledged
+    uint64_t sent_ms = start_ms; // Last time the frames from base were sent
+    uint8_t answer[2];
+    int answer_size = 0;
+
+    while (base < n_frames) {
+        while (next < n_frames && next < base + UPLOAD_WINDOW) {
+            write_all(fd, frames[next].bytes, frames[next].size);
+            n_bytes_sent += frames[next].size;
+            ++next;
+        }
+
+        struct pollfd pfd = {.fd = fd, .events = POLLIN};
+        int ready = poll(&pfd, 1, 10);
+        uint64_t ms = now_ms();
+
+        if (ready > 0) {
+            uint8_t bytes[64];
+            ssize_t n_read = read(fd, bytes, sizeof(bytes));
+
+            for (ssize_t i = 0; i < n_read; ++i) {
+                // Anything but an answer, like the sketch's banner after a reset, is skipped.
+                if (answer_size == 0 && bytes[i] != UPLOAD_ACK && bytes[i] != UPLOAD_NAK) {
+                    continue;
+                }
+
+                answer[answer_size++] = bytes[i];
+
+                if (answer_size < 2) {
+                    continue;
+                }
+
+                answer_size = 0;
+
+                // Answers are for frames in the window, a sequence number is frame number modulo 256.
+                int ahead = (uint8_t)(answer[1] - (uint8_t)base);
+
+                if (answer[0] == UPLOAD_ACK && ahead < next - base) {
+                    base += ahead + 1;
+                    progress_ms = ms;
+                } else if (answer[0] == UPLOAD_NAK && ahead <= next - base) {
+                    ++n_naks;
+                    n_resent += next - (base + ahead);
+                    base += ahead;
+                    next = base;
+                    progress_ms = ms;
+                    sent_ms = ms;
+                } else if (answer[0] == UPLOAD_NAK && answer[1] == 0) {
+                    // The device forgot the upload, reset in the middle of it.
+                    n_resent += next;
+                    base = next = 0;
+                    sent_ms = ms;
+                }
+            }
+        }
+
+        if (ms - progress_ms > GIVE_UP_AFTER_MS) {
+            fprintf(stderr, "No answer from the boot device on %s\n", argv[1]);
+
+            if (program_size > BOOT_DEVICE_RING_SIZE) {
+                fprintf(stderr, "A program bigger than its %d byte ring is only taken while the CPU boots\n", BOOT_DEVICE_RING_SIZE);
+            }
+
+            exit(1);
+        }
+
+        // Nothing heard back, the frames or their answers were lost.
+        if (ms - sent_ms > RESEND_AFTER_MS && ms - progress_ms > RESEND_AFTER_MS) {
+            ++n_timeouts;
+            n_resent += next - base;
+            next = base;
+            sent_ms = ms;
+        }
+    }
+
+    tcdrain(fd);
+    assert(close(fd) == 0);
+
+    double seconds = (double)(now_ms() - start_ms) / 1000.0;
+    double bytes_per_second = (double)program_size / (seconds > 0 ? seconds : 0.001);
+
+    printf("Uploaded %zu bytes in %d frames in %.2f s, %.0f bytes/s, %.0f%% of the line's %u bytes/s\n",
+           program_size, n_frames, seconds, bytes_per_second,
+           100.0 * (double)n_bytes_sent / (seconds > 0 ? seconds : 0.001) / (baud / 10), baud / 10);
+    printf("%d frames sent again after %d NAKs and %d timeouts\n", n_resent, n_naks, n_timeouts);
+
+    return 0;
+}
@@ -0,0 +1,1010 @@
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <assert.h> // assert
+#include <stdbool.h> // bool
+#include <stdint.h> // uint*_t
+#include <stdio.h> // FILE, f* functions
+#include <string.h> // memset
+
+#include "alu_op.h"
+#include "opcode.h"
+
+#define CONTROL_ROM_SIZE (1 << 17)
+
+#define PIN_OPCODE_0 0
+#define PIN_OPCODE_1 1
+#define PIN_OPCODE_2 2
+#define PIN_OPCODE_3 3
+#define PIN_OPCODE_4 4
+#define PIN_OPCODE_5 5
+#define PIN_OPCODE_6 6
+#define PIN_OPCODE_7 7
+
+#define PIN_HIGH_SLICE 10
+
+#define PIN_FLAG_0_ZERO 11
+#define PIN_FLAG_1_CARRY 9
+#define PIN_FLAG_2_OVERFLOW 8
+#define PIN_FLAG_3_SIGN 13
+
+#define PIN_STEP_0 12
+#define PIN_STEP_1 15
+#define PIN_STEP_2 16
+#define PIN_STEP_3 14
+
+#define CE_M_NOT_LD_C (1 << 0)
+#define LD_O_NOT_LD_C (1 << 1)
+#define LD_S_NOT_LD_C (1 << 2)
+#define LD_RS_NOT_LD_C (1 << 3)
+#define LD_IO_NOT_LD_C (1 << 4)
+#define C_LS_ALU_Q (1 << 5)
+#define HALT_NOT_LD_C (1 << 5)
+#define LD_C (1 << 6)
+#define TG_M_C (1 << 7)
+#define LD_MEM (1 << 8)
+#define LD_LS (1 << 9)
+#define LD_ML (1 << 10)
+#define LD_MH (1 << 11)
+#define OE_ML (1 << 12)
+#define OE_MH (1 << 13)
+#define OE_ALU (1 << 14)
+#define OE_MEM (1 << 15)
+
+#define ACTIVE_LOW_MASK (LD_C | LD_LS | LD_ML | LD_MH | OE_ML | OE_MH | OE_ALU | OE_MEM)
+
+#define FETCH_OPCODE (OE_MEM | LD_O_NOT_LD_C | CE_M_NOT_LD_C)
+
+#define C_A (0x0)
+#define C_B (0x1)
+#define C_C (0x2)
+#define C_D (0x3)
+#define C_SPL (0x4)
+#define C_IL (0x5)
+#define C_IH (0x6)
+#define C_JL (0x7)
+#define C_JH (0x8)
+// #define C_ (0x9)
+// #define C_ (0xa)
+#define C_TL (0xb)
+#define C_TH (0xc)
+#define C_UL (0xd)
+// #define C_ (0xe)
+// #define C_ (0xf)
+
+_Static_assert(ALU_OP_DEC_LS == C_SPL, "C_SPL must be identical to ALU_OP_DEC_LS");
+
+static uint16_t opcode_nop(uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return 0;
+    case 2: return 0;
+    case 3: return 0;
+    case 4: return 0;
+    case 5: return 0;
+    case 6: return 0;
+    case 7: return LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_halt(uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return HALT_NOT_LD_C;
+    case 2: return LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_reg_imm8(uint8_t dest_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_LS | C_LS_ALU_Q | dest_const_reg | LD_C | TG_M_C;
+    case 2: return OE_ALU | LD_MEM | TG_M_C | CE_M_NOT_LD_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_index_imm16(uint8_t dest_const_index_l, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_LS | C_LS_ALU_Q | dest_const_index_l | LD_C | TG_M_C;
+    case 2: return OE_ALU | LD_MEM | TG_M_C | CE_M_NOT_LD_C;
+    case 3: return OE_MEM | LD_LS | C_LS_ALU_Q | (dest_const_index_l + 1) | LD_C | TG_M_C;
+    case 4: return OE_ALU | LD_MEM | TG_M_C | CE_M_NOT_LD_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_reg_index_ptr(uint8_t dest_const_reg, uint8_t const_index_l, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | const_index_l | LD_C;
+    case 4: return OE_MEM | LD_ML | (const_index_l + 1) | LD_C;
+    case 5: return OE_MEM | LD_MH | TG_M_C;
+    case 6: return OE_MEM | LD_LS | C_LS_ALU_Q | dest_const_reg | LD_C | TG_M_C;
+    case 7: return OE_ALU | LD_MEM | C_TL | LD_C;
+    case 8: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 9: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_reg_index_ptr_inc1(uint8_t dest_const_reg, uint8_t const_index_l, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | const_index_l | LD_C;
+    case 4: return OE_MEM | LD_ML | (const_index_l + 1) | LD_C;
+    case 5: return OE_MEM | LD_MH | TG_M_C;
+    case 6: return OE_MEM | LD_LS | CE_M_NOT_LD_C | TG_M_C;
+    case 7: return OE_MH | LD_MEM | const_index_l | LD_C;
+    case 8: return OE_ML | LD_MEM | C_LS_ALU_Q | dest_const_reg | LD_C;
+    case 9: return OE_ALU | LD_MEM | C_TL | LD_C;
+    case 10: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 11: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+// Copies [i] to [j] and increments both, saving pc in tl/th as the other index ops do.
+// That takes all 16 steps so the byte count stays with the caller.
+static uint16_t opcode_ld_j_ptr_inc1_i_ptr_inc1(uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | C_IL | LD_C;
+    case 4: return OE_MEM | LD_ML | C_IH | LD_C;
+    case 5: return OE_MEM | LD_MH | TG_M_C;
+    case 6: return OE_MEM | LD_LS | CE_M_NOT_LD_C | TG_M_C;
+    case 7: return OE_MH | LD_MEM | C_IL | LD_C;
+    case 8: return OE_ML | LD_MEM | C_JL | LD_C;
+    case 9: return OE_MEM | LD_ML | C_JH | LD_C;
+    case 10: return OE_MEM | LD_MH | C_LS_ALU_Q | C_JH | LD_C | TG_M_C;
+    case 11: return OE_ALU | LD_MEM | CE_M_NOT_LD_C | TG_M_C;
+    case 12: return OE_MH | LD_MEM | C_JL | LD_C;
+    case 13: return OE_ML | LD_MEM | C_TL | LD_C;
+    case 14: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 15: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_index_ptr_reg(uint8_t const_index_l, uint8_t dest_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | const_index_l | LD_C;
+    case 4: return OE_MEM | LD_ML | (const_index_l + 1) | LD_C;
+    case 5: return OE_MEM | LD_MH | C_LS_ALU_Q | dest_const_reg | LD_C;
+    case 6: return OE_MEM | LD_LS | TG_M_C;
+    case 7: return OE_ALU | LD_MEM | C_TL | LD_C | TG_M_C;
+    case 8: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 9: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_index_ptr_inc1_reg(uint8_t const_index_l, uint8_t dest_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return dest_const_reg | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_LS | C_TL | LD_C;
+    case 3: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 4: return OE_MH | LD_MEM | const_index_l | LD_C;
+    case 5: return OE_MEM | LD_ML | C_LS_ALU_Q | (const_index_l + 1) | LD_C;
+    case 6: return OE_MEM | LD_MH | TG_M_C;
+    case 7: return OE_ALU | LD_MEM | CE_M_NOT_LD_C | TG_M_C;
+    case 8: return OE_MH | LD_MEM | const_index_l | LD_C;
+    case 9: return OE_ML | LD_MEM | C_TL | LD_C;
+    case 10: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 11: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_index_ptr_reg_reg(uint8_t const_index_l, uint8_t src_const_reg_h, uint8_t src_const_reg_l, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | const_index_l | LD_C;
+    case 4: return OE_MEM | LD_ML | (const_index_l + 1) | LD_C;
+    case 5: return OE_MEM | LD_MH | C_LS_ALU_Q | src_const_reg_l | LD_C;
+    case 6: return OE_MEM | LD_LS | TG_M_C;
+    case 7: return OE_ALU | LD_MEM | C_LS_ALU_Q | src_const_reg_h | LD_C | TG_M_C;
+    case 8: return OE_MEM | LD_LS | CE_M_NOT_LD_C | TG_M_C;
+    case 9: return OE_ALU | LD_MEM | C_TL | LD_C | TG_M_C;
+    case 10: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 11: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_reg_reg_index_ptr(uint8_t dest_const_reg_h, uint8_t dest_const_reg_l, uint8_t const_index_l, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | const_index_l | LD_C;
+    case 4: return OE_MEM | LD_ML | (const_index_l + 1) | LD_C;
+    case 5: return OE_MEM | LD_MH | C_LS_ALU_Q | dest_const_reg_l | LD_C | TG_M_C;
+    case 6: return OE_MEM | LD_LS | CE_M_NOT_LD_C | TG_M_C;
+    case 7: return OE_ALU | LD_MEM | C_LS_ALU_Q | dest_const_reg_h | LD_C | TG_M_C;
+    case 8: return OE_MEM | LD_LS | TG_M_C;
+    case 9: return OE_ALU | LD_MEM | C_TL | LD_C;
+    case 10: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 11: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static u_int16_t opcode_ld_reg_reg(uint8_t dest_const_reg, uint8_t src_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return src_const_reg | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_LS | C_LS_ALU_Q | dest_const_reg | LD_C;
+    case 3: return OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_alu_op_reg(ALU_OP alu_op, uint8_t dest_and_src_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return dest_and_src_const_reg | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_LS | (uint8_t)alu_op | LD_C;
+    case 3: return OE_ALU | LD_LS | C_LS_ALU_Q | dest_and_src_const_reg | LD_C;
+    case 4: return OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_alu_op_reg_reg(ALU_OP alu_op, uint8_t dest_const_reg, uint8_t src_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return dest_const_reg | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_LS | src_const_reg | LD_C;
+    case 3: return OE_MEM | LD_RS_NOT_LD_C;
+    case 4: return (uint8_t)alu_op | LD_C;
+    case 5: return OE_ALU | LD_LS | C_LS_ALU_Q | dest_const_reg | LD_C;
+    case 6: return OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_alu_op_reg_imm8(ALU_OP alu_op, uint8_t dest_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_RS_NOT_LD_C | CE_M_NOT_LD_C;
+    case 2: return dest_const_reg | LD_C | TG_M_C;
+    case 3: return OE_MEM | LD_LS | (uint8_t)alu_op | LD_C;
+    case 4: return OE_ALU | LD_LS | C_LS_ALU_Q | dest_const_reg | LD_C;
+    case 5: return OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_alu_cmp_reg_imm8(uint8_t const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_RS_NOT_LD_C | CE_M_NOT_LD_C;
+    case 2: return const_reg | LD_C | TG_M_C;
+    case 3: return OE_MEM | LD_LS | ALU_OP_LS_SUB_RS | LD_C;
+    case 4: return OE_ALU | LD_LS | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+// The high byte is only touched when the low byte wrapped, which the flags of
+// the low byte tell. INC and DEC keep CF so it is left as it was.
+static uint16_t opcode_inc_index(uint8_t const_index_l, bool zero_flag_set, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return const_index_l | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_LS | ALU_OP_INC_LS | LD_C;
+    case 3: return OE_ALU | LD_LS | C_LS_ALU_Q | const_index_l | LD_C;
+    case 4: return zero_flag_set ? OE_ALU | LD_MEM | (const_index_l + 1) | LD_C
+                                 : OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    case 5: return OE_MEM | LD_LS | ALU_OP_INC_LS | LD_C;
+    case 6: return OE_ALU | LD_LS | C_LS_ALU_Q | (const_index_l + 1) | LD_C;
+    case 7: return OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+// DEC gives no flag for wrapping to 0xff so the decremented low byte is
+// incremented back, setting ZF when it was 0.
+static uint16_t opcode_dec_index(uint8_t const_index_l, bool zero_flag_set, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return const_index_l | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_LS | ALU_OP_DEC_LS | LD_C;
+    case 3: return OE_ALU | LD_LS | C_LS_ALU_Q | const_index_l | LD_C;
+    case 4: return OE_ALU | LD_MEM | ALU_OP_INC_LS | LD_C;
+    case 5: return OE_ALU | LD_LS | (const_index_l + 1) | LD_C;
+    case 6: return zero_flag_set ? OE_MEM | LD_LS | ALU_OP_DEC_LS | LD_C
+                                 : TG_M_C | LD_S_NOT_LD_C;
+    case 7: return OE_ALU | LD_LS | C_LS_ALU_Q | (const_index_l + 1) | LD_C;
+    case 8: return OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+// Unsigned add to the low byte, the carry increments the high byte. CF tells if the low byte carried.
+static uint16_t opcode_add_index_imm8(uint8_t const_index_l, bool carry_flag_set, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_RS_NOT_LD_C | CE_M_NOT_LD_C;
+    case 2: return const_index_l | LD_C | TG_M_C;
+    case 3: return OE_MEM | LD_LS | ALU_OP_LS_ADD_RS | LD_C;
+    case 4: return OE_ALU | LD_LS | C_LS_ALU_Q | const_index_l | LD_C;
+    case 5: return carry_flag_set ? OE_ALU | LD_MEM | (const_index_l + 1) | LD_C
+                                  : OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    case 6: return OE_MEM | LD_LS | ALU_OP_INC_LS | LD_C;
+    case 7: return OE_ALU | LD_LS | C_LS_ALU_Q | (const_index_l + 1) | LD_C;
+    case 8: return OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_add_index_reg(uint8_t const_index_l, uint8_t src_const_reg, bool carry_flag_set, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return const_index_l | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_LS | src_const_reg | LD_C;
+    case 3: return OE_MEM | LD_RS_NOT_LD_C;
+    case 4: return ALU_OP_LS_ADD_RS | LD_C;
+    case 5: return OE_ALU | LD_LS | C_LS_ALU_Q | const_index_l | LD_C;
+    case 6: return carry_flag_set ? OE_ALU | LD_MEM | (const_index_l + 1) | LD_C
+                                  : OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    case 7: return OE_MEM | LD_LS | ALU_OP_INC_LS | LD_C;
+    case 8: return OE_ALU | LD_LS | C_LS_ALU_Q | (const_index_l + 1) | LD_C;
+    case 9: return OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_alu_cmp_reg_reg(uint8_t const_reg, uint8_t src_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return const_reg | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_LS | src_const_reg | LD_C;
+    case 3: return OE_MEM | LD_RS_NOT_LD_C;
+    case 4: return ALU_OP_LS_SUB_RS | LD_C;
+    case 5: return OE_ALU | LD_LS | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+// Each slice of the ALU only sees its own nibble so the swap is four ROR in a row.
+static uint16_t opcode_swap_reg(uint8_t dest_and_src_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return dest_and_src_const_reg | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_LS | ALU_OP_ROR_LS | LD_C;
+    case 3: return OE_ALU | LD_LS;
+    case 4: return OE_ALU | LD_LS;
+    case 5: return OE_ALU | LD_LS;
+    case 6: return OE_ALU | LD_LS | C_LS_ALU_Q | dest_and_src_const_reg | LD_C;
+    case 7: return OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_jmp_imm16(uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_LS | CE_M_NOT_LD_C;
+    case 2: return OE_MEM | LD_MH | C_LS_ALU_Q | LD_C;
+    case 3: return OE_ALU | LD_ML | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_jmp_index(uint8_t const_index_l, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return const_index_l | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_ML | (const_index_l + 1) | LD_C;
+    case 3: return OE_MEM | LD_MH | LD_S_NOT_LD_C | TG_M_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static u_int16_t opcode_jmp_condition_imm16(bool condition, uint8_t step) {
+    if (condition) {
+        switch (step) {
+        case 0: return FETCH_OPCODE;
+        case 1: return OE_MEM | LD_LS | CE_M_NOT_LD_C;
+        case 2: return OE_MEM | LD_MH | C_LS_ALU_Q | LD_C;
+        case 3: return OE_ALU | LD_ML | LD_S_NOT_LD_C;
+        default: return HALT_NOT_LD_C;
+        }
+    } else {
+        switch (step) {
+        case 0: return FETCH_OPCODE;
+        case 1: return CE_M_NOT_LD_C;
+        case 2: return CE_M_NOT_LD_C;
+        case 3: return LD_S_NOT_LD_C;
+        default: return HALT_NOT_LD_C;
+        }
+    }
+}
+
+// Steps 1-3 are dec reg. F is from the DEC from step 4 on, where the write back of reg
+// overlaps the pc increment of the not taken branch.
+static uint16_t opcode_djnz_reg_imm16(uint8_t const_reg, bool zero_flag_set, uint8_t step) {
+    if (!zero_flag_set) {
+        switch (step) {
+        case 0: return FETCH_OPCODE;
+        case 1: return const_reg | LD_C | TG_M_C;
+        case 2: return OE_MEM | LD_LS | ALU_OP_DEC_LS | LD_C;
+        case 3: return OE_ALU | LD_LS | C_LS_ALU_Q | const_reg | LD_C;
+        case 4: return OE_ALU | LD_MEM | TG_M_C;
+        case 5: return OE_MEM | LD_LS | CE_M_NOT_LD_C;
+        case 6: return OE_MEM | LD_MH | C_LS_ALU_Q | LD_C;
+        case 7: return OE_ALU | LD_ML | LD_S_NOT_LD_C;
+        default: return HALT_NOT_LD_C;
+        }
+    } else {
+        switch (step) {
+        case 0: return FETCH_OPCODE;
+        case 1: return const_reg | LD_C | TG_M_C;
+        case 2: return OE_MEM | LD_LS | ALU_OP_DEC_LS | LD_C;
+        case 3: return OE_ALU | LD_LS | C_LS_ALU_Q | const_reg | LD_C;
+        case 4: return OE_ALU | LD_MEM | TG_M_C | CE_M_NOT_LD_C;
+        case 5: return CE_M_NOT_LD_C | LD_S_NOT_LD_C;
+        default: return HALT_NOT_LD_C;
+        }
+    }
+}
+
+static uint16_t opcode_push_reg(uint8_t src_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | C_SPL | LD_C;
+    case 4: return OE_MEM | LD_ML;
+    case 5: return LD_MH | CE_M_NOT_LD_C;
+    case 6: return OE_ML | LD_MEM | C_LS_ALU_Q | src_const_reg | LD_C;
+    case 7: return OE_MEM | LD_LS | TG_M_C;
+    case 8: return OE_ALU | LD_MEM | C_TL | LD_C | TG_M_C;
+    case 9: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 10: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_pop_reg(uint8_t dest_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | C_SPL | LD_C; // ALU_OP_DEC_LS at the same time
+    case 4: return OE_MEM | LD_ML | LD_LS;
+    case 5: return OE_ALU | LD_MEM; // --sp
+    case 6: return LD_MH | TG_M_C; // MH = 0xff
+    case 7: return OE_MEM | LD_LS | C_LS_ALU_Q | dest_const_reg | LD_C | TG_M_C;
+    case 8: return OE_ALU | LD_MEM | C_TL | LD_C;
+    case 9: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 10: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_push_index(uint8_t src_const_index_l, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | C_SPL | LD_C;
+    case 4: return OE_MEM | LD_ML | src_const_index_l | LD_C;
+    case 5: return LD_MH | CE_M_NOT_LD_C;
+    case 6: return OE_MEM | LD_LS | C_LS_ALU_Q | (src_const_index_l + 1) | LD_C | TG_M_C;
+    case 7: return OE_ALU | LD_MEM | CE_M_NOT_LD_C | TG_M_C;
+    case 8: return OE_MEM | LD_LS | TG_M_C;
+    case 9: return OE_ALU | LD_MEM | C_SPL | LD_C | TG_M_C;
+    case 10: return OE_ML | LD_MEM | C_TL | LD_C;
+    case 11: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 12: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_pop_index(uint8_t dest_const_index_l, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | C_SPL | LD_C; // ALU_OP_DEC_LS at the same time
+    case 4: return OE_MEM | LD_ML | LD_LS;
+    case 5: return OE_ALU | LD_MEM; // --sp
+    case 6: return LD_MH | TG_M_C;
+    case 7: return OE_MEM | LD_LS | C_LS_ALU_Q | (dest_const_index_l + 1) | LD_C | TG_M_C;
+    case 8: return OE_ALU | LD_MEM | C_SPL | LD_C;
+    case 9: return OE_MEM | LD_ML | LD_LS;
+    case 10: return OE_ALU | LD_MEM | TG_M_C; // --sp
+    case 11: return OE_MEM | LD_LS | C_LS_ALU_Q | dest_const_index_l | LD_C | TG_M_C;
+    case 12: return OE_ALU | LD_MEM | C_TL | LD_C;
+    case 13: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 14: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_call_imm16(uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_LS | C_LS_ALU_Q | C_TL | LD_C | TG_M_C;
+    case 2: return OE_ALU | LD_MEM | TG_M_C | CE_M_NOT_LD_C;
+    case 3: return OE_MEM | LD_LS | C_LS_ALU_Q | C_TH | LD_C | TG_M_C;
+    case 4: return OE_ALU | LD_MEM | CE_M_NOT_LD_C;
+    case 5: return OE_ML | LD_LS | C_UL | LD_C;
+    case 6: return OE_MH | LD_MEM | C_SPL | LD_C;
+    case 7: return OE_MEM | LD_ML | C_LS_ALU_Q | C_UL | LD_C;
+    case 8: return LD_MH | CE_M_NOT_LD_C | TG_M_C;
+    case 9: return OE_ALU | LD_MEM | CE_M_NOT_LD_C | TG_M_C;
+    case 10: return OE_MEM | LD_LS | TG_M_C;
+    case 11: return OE_ALU | LD_MEM | C_SPL | LD_C | TG_M_C;
+    case 12: return OE_ML | LD_MEM | C_TL | LD_C;
+    case 13: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 14: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ret(uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_SPL | LD_C | TG_M_C; // ALU_OP_DEC_LS at the same time
+    case 2: return OE_MEM | LD_ML | LD_LS;
+    case 3: return OE_ALU | LD_MEM; // --sp
+    case 4: return LD_MH | TG_M_C;
+    case 5: return OE_MEM | LD_LS | C_LS_ALU_Q | C_TH | LD_C | TG_M_C;
+    case 6: return OE_ALU | LD_MEM | C_SPL | LD_C;
+    case 7: return OE_MEM | LD_ML | LD_LS;
+    case 8: return OE_ALU | LD_MEM | TG_M_C; // --sp
+    case 9: return OE_MEM | LD_ML | C_TH | LD_C | TG_M_C;
+    case 10: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_reg_sp_plus_imm8_ptr(uint8_t dest_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_RS_NOT_LD_C | CE_M_NOT_LD_C; // RS = imm
+    case 2: return C_TL | LD_C | TG_M_C;
+    case 3: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 4: return OE_MH | LD_MEM | C_SPL | LD_C;
+    case 5: return OE_MEM | LD_LS | ALU_OP_LS_ADD_RS | LD_C; // LS = sp
+    case 6: return OE_ALU | LD_ML; // ML = (sp + imm) & 0xff
+    case 7: return LD_MH | TG_M_C;
+    case 8: return OE_MEM | LD_LS | C_LS_ALU_Q | dest_const_reg | LD_C | TG_M_C;
+    case 9: return OE_ALU | LD_MEM | C_TL | LD_C;
+    case 10: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 11: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_sp_plus_imm8_ptr_reg(uint8_t src_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_RS_NOT_LD_C | CE_M_NOT_LD_C; // RS = imm
+    case 2: return C_TL | LD_C | TG_M_C;
+    case 3: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 4: return OE_MH | LD_MEM | C_SPL | LD_C;
+    case 5: return OE_MEM | LD_LS | ALU_OP_LS_ADD_RS | LD_C; // LS = sp
+    case 6: return OE_ALU | LD_ML | C_LS_ALU_Q | src_const_reg | LD_C; // ML = (sp + imm) & 0xff
+    case 7: return LD_MH;
+    case 8: return OE_MEM | LD_LS | TG_M_C;
+    case 9: return OE_ALU | LD_MEM | C_TL | LD_C | TG_M_C;
+    case 10: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 11: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+// Unsigned imm added to the index, F is left from adding imm to the low byte.
+// Without a carry the high byte passes the ALU unchanged so both paths take the same steps.
+static uint16_t opcode_ld_reg_index_plus_imm8_ptr(uint8_t dest_const_reg, uint8_t const_index_l, bool carry_flag_set, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_RS_NOT_LD_C | CE_M_NOT_LD_C; // RS = imm
+    case 2: return C_TL | LD_C | TG_M_C;
+    case 3: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 4: return OE_MH | LD_MEM | const_index_l | LD_C;
+    case 5: return OE_MEM | LD_LS | ALU_OP_LS_ADD_RS | LD_C;
+    case 6: return OE_ALU | LD_ML | LD_LS | (const_index_l + 1) | LD_C; // ML = index l + imm
+    case 7: return OE_MEM | LD_LS | (carry_flag_set ? ALU_OP_INC_LS : C_LS_ALU_Q | (const_index_l + 1)) | LD_C;
+    case 8: return OE_ALU | LD_MH | TG_M_C; // MH = index h + carry
+    case 9: return OE_MEM | LD_LS | C_LS_ALU_Q | dest_const_reg | LD_C | TG_M_C;
+    case 10: return OE_ALU | LD_MEM | C_TL | LD_C;
+    case 11: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 12: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+// As opcode_ld_reg_index_plus_imm8_ptr but adding an unsigned register instead of imm.
+static uint16_t opcode_ld_reg_index_plus_reg_ptr(uint8_t dest_const_reg, uint8_t const_index_l, uint8_t src_const_reg, bool carry_flag_set, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return C_TL | LD_C | TG_M_C;
+    case 2: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 3: return OE_MH | LD_MEM | src_const_reg | LD_C;
+    case 4: return OE_MEM | LD_RS_NOT_LD_C; // RS = src reg
+    case 5: return const_index_l | LD_C;
+    case 6: return OE_MEM | LD_LS | ALU_OP_LS_ADD_RS | LD_C;
+    case 7: return OE_ALU | LD_ML | LD_LS | (const_index_l + 1) | LD_C; // ML = index l + src reg
+    case 8: return OE_MEM | LD_LS | (carry_flag_set ? ALU_OP_INC_LS : C_LS_ALU_Q | (const_index_l + 1)) | LD_C;
+    case 9: return OE_ALU | LD_MH | TG_M_C; // MH = index h + carry
+    case 10: return OE_MEM | LD_LS | C_LS_ALU_Q | dest_const_reg | LD_C | TG_M_C;
+    case 11: return OE_ALU | LD_MEM | C_TL | LD_C;
+    case 12: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 13: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_ld_index_plus_imm8_ptr_reg(uint8_t const_index_l, uint8_t src_const_reg, bool carry_flag_set, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_RS_NOT_LD_C | CE_M_NOT_LD_C; // RS = imm
+    case 2: return C_TL | LD_C | TG_M_C;
+    case 3: return OE_ML | LD_MEM | C_TH | LD_C;
+    case 4: return OE_MH | LD_MEM | const_index_l | LD_C;
+    case 5: return OE_MEM | LD_LS | ALU_OP_LS_ADD_RS | LD_C;
+    case 6: return OE_ALU | LD_ML | LD_LS | (const_index_l + 1) | LD_C; // ML = index l + imm
+    case 7: return OE_MEM | LD_LS | (carry_flag_set ? ALU_OP_INC_LS : C_LS_ALU_Q | (const_index_l + 1)) | LD_C;
+    case 8: return OE_ALU | LD_MH | C_LS_ALU_Q | src_const_reg | LD_C; // MH = index h + carry
+    case 9: return OE_MEM | LD_LS | TG_M_C;
+    case 10: return OE_ALU | LD_MEM | C_TL | LD_C | TG_M_C;
+    case 11: return OE_MEM | LD_ML | C_TH | LD_C;
+    case 12: return OE_MEM | LD_MH | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_in_reg_port(uint8_t dest_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return ALU_OP_SET_IO_OE_FLAG | LD_C | TG_M_C;
+    case 2: return LD_C;
+    case 3: return LD_LS | C_LS_ALU_Q | dest_const_reg | LD_C;
+    case 4: return OE_ALU | LD_MEM | TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_out_port_reg(uint8_t src_const_reg, uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return src_const_reg | LD_C | TG_M_C;
+    case 2: return OE_MEM | LD_IO_NOT_LD_C;
+    case 3: return TG_M_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_out_port_imm8(uint8_t step) {
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    case 1: return OE_MEM | LD_IO_NOT_LD_C;
+    case 2: return CE_M_NOT_LD_C | LD_S_NOT_LD_C;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+static uint16_t opcode_alu_matrix(Opcode opcode, uint8_t step) {
+    AluMatrixOp op = OPCODE_ALU_MATRIX_OP(opcode);
+    uint8_t dest = OPCODE_ALU_MATRIX_DEST(opcode);
+    uint8_t src = OPCODE_ALU_MATRIX_SRC(opcode);
+
+    ALU_OP alu_op = op == ALU_MATRIX_ADD   ? ALU_OP_LS_ADD_RS
+                    : op == ALU_MATRIX_ADC ? ALU_OP_LS_ADC_RS
+                    : op == ALU_MATRIX_SUB ? ALU_OP_LS_SUB_RS
+                    : op == ALU_MATRIX_AND ? ALU_OP_LS_AND_RS
+                    : op == ALU_MATRIX_OR  ? ALU_OP_LS_OR_RS
+                                           : ALU_OP_LS_XOR_RS;
+
+    if (op == ALU_MATRIX_CMP) {
+        return dest == src ? opcode_alu_cmp_reg_imm8(dest, step) : opcode_alu_cmp_reg_reg(dest, src, step);
+    }
+
+    return dest == src ? opcode_alu_op_reg_imm8(alu_op, dest, step) : opcode_alu_op_reg_reg(alu_op, dest, src, step);
+}
+
+static uint16_t signals_from_input(uint8_t step, bool zero_flag_set, bool carry_flag_set, bool overflow_flag_set, bool sign_flag_set, Opcode opcode) {
+    assert(step < 16);
+
+    if (opcode >= OPCODE_ALU_MATRIX_FIRST && opcode <= OPCODE_ALU_MATRIX_LAST) {
+        return opcode_alu_matrix(opcode, step); // {add,adc,sub,and,or,xor,cmp} {a,b,c,d}, {a,b,c,d}/{imm: i8}
+    }
+
+    switch (opcode) {
+    case OPCODE_NOP: return opcode_nop(step);
+    case OPCODE_HALT: return opcode_halt(step);
+    case OPCODE_LD_A_IMM8: return opcode_ld_reg_imm8(C_A, step); // ld a, {imm: i8}
+    case OPCODE_LD_B_IMM8: return opcode_ld_reg_imm8(C_B, step); // ld b, {imm: i8}
+    case OPCODE_LD_C_IMM8: return opcode_ld_reg_imm8(C_C, step); // ld c, {imm: i8}
+    case OPCODE_LD_D_IMM8: return opcode_ld_reg_imm8(C_D, step); // ld d, {imm: i8}
+    case OPCODE_LD_I_IMM16: return opcode_ld_index_imm16(C_IL, step); // ld i, {imm: i16}
+    case OPCODE_LD_J_IMM16: return opcode_ld_index_imm16(C_JL, step); // ld j, {imm: i16}
+    case OPCODE_LD_A_I_PTR: return opcode_ld_reg_index_ptr(C_A, C_IL, step); // ld a, [i]
+    case OPCODE_LD_A_J_PTR: return opcode_ld_reg_index_ptr(C_A, C_JL, step); // ld a, [j]
+    case OPCODE_LD_A_I_PTR_INC1: return opcode_ld_reg_index_ptr_inc1(C_A, C_IL, step); // ld a, [i++]
+    case OPCODE_LD_A_J_PTR_INC1: return opcode_ld_reg_index_ptr_inc1(C_A, C_JL, step); // ld a, [j++]
+    case OPCODE_LD_I_PTR_A: return opcode_ld_index_ptr_reg(C_IL, C_A, step); // ld [i], a
+    case OPCODE_LD_J_PTR_A: return opcode_ld_index_ptr_reg(C_JL, C_A, step); // ld [j], a
+    case OPCODE_LD_I_PTR_INC1_A: return opcode_ld_index_ptr_inc1_reg(C_IL, C_A, step); // ld [i++], a
+    case OPCODE_LD_J_PTR_INC1_A: return opcode_ld_index_ptr_inc1_reg(C_JL, C_A, step); // ld [j++], a
+    case OPCODE_LD_I_PTR_AB: return opcode_ld_index_ptr_reg_reg(C_IL, C_A, C_B, step); // ld [i], ab
+    case OPCODE_LD_I_PTR_CD: return opcode_ld_index_ptr_reg_reg(C_IL, C_C, C_D, step); // ld [i], cd
+    case OPCODE_LD_J_PTR_CD: return opcode_ld_index_ptr_reg_reg(C_JL, C_C, C_D, step); // ld [j], cd
+    case OPCODE_LD_AB_I_PTR: return opcode_ld_reg_reg_index_ptr(C_A, C_B, C_IL, step); // ld ab, [i]
+    case OPCODE_LD_CD_I_PTR: return opcode_ld_reg_reg_index_ptr(C_C, C_D, C_IL, step); // ld cd, [i]
+    case OPCODE_LD_CD_J_PTR: return opcode_ld_reg_reg_index_ptr(C_C, C_D, C_JL, step); // ld cd, [j]
+    case OPCODE_LD_A_B: return opcode_ld_reg_reg(C_A, C_B, step); // ld a, b
+    case OPCODE_LD_A_C: return opcode_ld_reg_reg(C_A, C_C, step); // ld a, c
+    case OPCODE_LD_A_D: return opcode_ld_reg_reg(C_A, C_D, step); // ld a, d
+    case OPCODE_LD_B_A: return opcode_ld_reg_reg(C_B, C_A, step); // ld b, a
+    case OPCODE_LD_B_C: return opcode_ld_reg_reg(C_B, C_C, step); // ld b, c
+    case OPCODE_LD_B_D: return opcode_ld_reg_reg(C_B, C_D, step); // ld b, d
+    case OPCODE_LD_C_A: return opcode_ld_reg_reg(C_C, C_A, step); // ld c, a
+    case OPCODE_LD_C_B: return opcode_ld_reg_reg(C_C, C_B, step); // ld c, b
+    case OPCODE_LD_C_D: return opcode_ld_reg_reg(C_C, C_D, step); // ld c, d
+    case OPCODE_LD_D_A: return opcode_ld_reg_reg(C_D, C_A, step); // ld d, a
+    case OPCODE_LD_D_B: return opcode_ld_reg_reg(C_D, C_B, step); // ld d, b
+    case OPCODE_LD_D_C: return opcode_ld_reg_reg(C_D, C_C, step); // ld d, c
+    case OPCODE_INC_A: return opcode_alu_op_reg(ALU_OP_INC_LS, C_A, step); // inc a
+    case OPCODE_INC_B: return opcode_alu_op_reg(ALU_OP_INC_LS, C_B, step); // inc b
+    case OPCODE_INC_C: return opcode_alu_op_reg(ALU_OP_INC_LS, C_C, step); // inc c
+    case OPCODE_INC_D: return opcode_alu_op_reg(ALU_OP_INC_LS, C_D, step); // inc d
+    case OPCODE_DEC_A: return opcode_alu_op_reg(ALU_OP_DEC_LS, C_A, step); // dec a
+    case OPCODE_DEC_B: return opcode_alu_op_reg(ALU_OP_DEC_LS, C_B, step); // dec b
+    case OPCODE_DEC_C: return opcode_alu_op_reg(ALU_OP_DEC_LS, C_C, step); // dec c
+    case OPCODE_DEC_D: return opcode_alu_op_reg(ALU_OP_DEC_LS, C_D, step); // dec d
+    case OPCODE_SHL_A: return opcode_alu_op_reg(ALU_OP_SHL_LS, C_A, step); // shl a
+    case OPCODE_SHR_A: return opcode_alu_op_reg(ALU_OP_SHR_LS, C_A, step); // shr a
+    case OPCODE_NOT_A: return opcode_alu_op_reg(ALU_OP_NOT_LS, C_A, step); // not a
+    case OPCODE_ROR_A: return opcode_alu_op_reg(ALU_OP_ROR_LS, C_A, step); // ror a
+    case OPCODE_ADD_A_B: return opcode_alu_op_reg_reg(ALU_OP_LS_ADD_RS, C_A, C_B, step); // add a, b
+    case OPCODE_OR_A_B: return opcode_alu_op_reg_reg(ALU_OP_LS_OR_RS, C_A, C_B, step); // or a, b
+    case OPCODE_AND_A_B: return opcode_alu_op_reg_reg(ALU_OP_LS_AND_RS, C_A, C_B, step); // and a, b
+    case OPCODE_XOR_A_B: return opcode_alu_op_reg_reg(ALU_OP_LS_XOR_RS, C_A, C_B, step); // xor a, b
+    case OPCODE_ADC_A_B: return opcode_alu_op_reg_reg(ALU_OP_LS_ADC_RS, C_A, C_B, step); // adc a, b
+    case OPCODE_ADC_C_A: return opcode_alu_op_reg_reg(ALU_OP_LS_ADC_RS, C_C, C_A, step); // adc c, a
+    case OPCODE_ADD_D_B: return opcode_alu_op_reg_reg(ALU_OP_LS_ADD_RS, C_D, C_B, step); // add d, b
+    case OPCODE_ADD_A_IMM8: return opcode_alu_op_reg_imm8(ALU_OP_LS_ADD_RS, C_A, step); // add a, {imm: i8}
+    case OPCODE_ADD_B_IMM8: return opcode_alu_op_reg_imm8(ALU_OP_LS_ADD_RS, C_B, step); // add b, {imm: i8}
+    case OPCODE_AND_A_IMM8: return opcode_alu_op_reg_imm8(ALU_OP_LS_AND_RS, C_A, step); // and a, {imm: i8}
+    case OPCODE_OR_A_IMM8: return opcode_alu_op_reg_imm8(ALU_OP_LS_OR_RS, C_A, step); // or a, {imm: i8}
+    case OPCODE_XOR_A_IMM8: return opcode_alu_op_reg_imm8(ALU_OP_LS_XOR_RS, C_A, step); // xor a, {imm: i8}
+    case OPCODE_ADC_A_IMM8: return opcode_alu_op_reg_imm8(ALU_OP_LS_ADC_RS, C_A, step); // adc a, {imm: i8}
+    case OPCODE_ADC_D_IMM8: return opcode_alu_op_reg_imm8(ALU_OP_LS_ADC_RS, C_D, step); // adc d, {imm: i8}
+    case OPCODE_CMP_A_IMM8: return opcode_alu_cmp_reg_imm8(C_A, step); // cmp a, {imm: i8}
+    case OPCODE_CMP_B_IMM8: return opcode_alu_cmp_reg_imm8(C_B, step); // cmp b, {imm: i8}
+    case OPCODE_JMP_I: return opcode_jmp_index(C_IL, step); // jmp i
+    case OPCODE_JMP_J: return opcode_jmp_index(C_JL, step); // jmp j
+    case OPCODE_JMP_IMM16: return opcode_jmp_imm16(step); // jmp {imm: i16}
+    case OPCODE_JZ_IMM16: return opcode_jmp_condition_imm16(zero_flag_set, step); // jz  {imm: i16}
+    case OPCODE_JNZ_IMM16: return opcode_jmp_condition_imm16(!zero_flag_set, step); // jnz {imm: i16}
+    case OPCODE_JC_IMM16: return opcode_jmp_condition_imm16(carry_flag_set, step); // jc  {imm: i16}
+    case OPCODE_JNC_IMM16: return opcode_jmp_condition_imm16(!carry_flag_set, step); // jnc {imm: i16}
+    case OPCODE_JO_IMM16: return opcode_jmp_condition_imm16(overflow_flag_set, step); // jo {imm: i16}
+    case OPCODE_JNO_IMM16: return opcode_jmp_condition_imm16(!overflow_flag_set, step); // jno {imm: i16}
+    case OPCODE_JS_IMM16: return opcode_jmp_condition_imm16(sign_flag_set, step); // js {imm: i16}
+    case OPCODE_JNS_IMM16: return opcode_jmp_condition_imm16(!sign_flag_set, step); // jns {imm: i16}
+    case OPCODE_LD_SP_IMM8: return opcode_ld_reg_imm8(C_SPL, step); // ld sp, {imm: i8}
+    case OPCODE_PUSH_A: return opcode_push_reg(C_A, step); // push a (store at ++sp)
+    case OPCODE_PUSH_B: return opcode_push_reg(C_B, step); // push b (store at ++sp)
+    case OPCODE_PUSH_C: return opcode_push_reg(C_C, step); // push c (store at ++sp)
+    case OPCODE_PUSH_D: return opcode_push_reg(C_D, step); // push d (store at ++sp)
+    case OPCODE_PUSH_I: return opcode_push_index(C_IL, step); // push i (store l at ++sp, h at ++sp)
+    case OPCODE_PUSH_J: return opcode_push_index(C_JL, step); // push j (store l at ++sp, h at ++sp)
+    case OPCODE_POP_A: return opcode_pop_reg(C_A, step); // pop a (load from sp--)
+    case OPCODE_POP_B: return opcode_pop_reg(C_B, step); // pop b (load from sp--)
+    case OPCODE_POP_C: return opcode_pop_reg(C_C, step); // pop c (load from sp--)
+    case OPCODE_POP_D: return opcode_pop_reg(C_D, step); // pop d (load from sp--)
+    case OPCODE_POP_I: return opcode_pop_index(C_IL, step); // pop i (read h at sp--, l at sp--)
+    case OPCODE_POP_J: return opcode_pop_index(C_JL, step); // pop j (read h at sp--, l at sp--)
+    case OPCODE_CALL_IMM16: return opcode_call_imm16(step); // call {imm: i16} (store pc l at ++sp, pc h at ++sp)
+    case OPCODE_RET: return opcode_ret(step); // ret (read pc h at sp--, pc l at sp--)
+    case OPCODE_LD_A_SP_PLUS_IMM8_PTR: return opcode_ld_reg_sp_plus_imm8_ptr(C_A, step); // ld a, [sp+{imm:i8}]
+    case OPCODE_LD_J_PTR_INC1_I_PTR_INC1: return opcode_ld_j_ptr_inc1_i_ptr_inc1(step); // ld [j++], [i++]
+    case OPCODE_INC_I: return opcode_inc_index(C_IL, zero_flag_set, step); // inc i
+    case OPCODE_INC_J: return opcode_inc_index(C_JL, zero_flag_set, step); // inc j
+    case OPCODE_DEC_I: return opcode_dec_index(C_IL, zero_flag_set, step); // dec i
+    case OPCODE_DEC_J: return opcode_dec_index(C_JL, zero_flag_set, step); // dec j
+    case OPCODE_ADD_I_IMM8: return opcode_add_index_imm8(C_IL, carry_flag_set, step); // add i, {imm: i8}
+    case OPCODE_ADD_I_A: return opcode_add_index_reg(C_IL, C_A, carry_flag_set, step); // add i, a
+    case OPCODE_LD_SP_PLUS_IMM8_PTR_A: return opcode_ld_sp_plus_imm8_ptr_reg(C_A, step); // ld [sp+{imm:i8}], a
+    case OPCODE_LD_A_I_PLUS_IMM8_PTR: return opcode_ld_reg_index_plus_imm8_ptr(C_A, C_IL, carry_flag_set, step); // ld a, [i+{imm:u8}]
+    case OPCODE_LD_A_J_PLUS_IMM8_PTR: return opcode_ld_reg_index_plus_imm8_ptr(C_A, C_JL, carry_flag_set, step); // ld a, [j+{imm:u8}]
+    case OPCODE_LD_I_PLUS_IMM8_PTR_A: return opcode_ld_index_plus_imm8_ptr_reg(C_IL, C_A, carry_flag_set, step); // ld [i+{imm:u8}], a
+    case OPCODE_LD_J_PLUS_IMM8_PTR_A: return opcode_ld_index_plus_imm8_ptr_reg(C_JL, C_A, carry_flag_set, step); // ld [j+{imm:u8}], a
+    case OPCODE_DJNZ_B_IMM16: return opcode_djnz_reg_imm16(C_B, zero_flag_set, step); // djnz b, {imm: i16}
+    case OPCODE_DJNZ_C_IMM16: return opcode_djnz_reg_imm16(C_C, zero_flag_set, step); // djnz c, {imm: i16}
+    case OPCODE_DJNZ_D_IMM16: return opcode_djnz_reg_imm16(C_D, zero_flag_set, step); // djnz d, {imm: i16}
+    case OPCODE_LD_A_I_PLUS_A_PTR: return opcode_ld_reg_index_plus_reg_ptr(C_A, C_IL, C_A, carry_flag_set, step); // ld a, [i+a]
+    case OPCODE_ROL_A: return opcode_alu_op_reg(ALU_OP_ROL_LS, C_A, step); // rol a
+    case OPCODE_SAR_A: return opcode_alu_op_reg(ALU_OP_SAR_LS, C_A, step); // sar a
+    case OPCODE_SWAP_A: return opcode_swap_reg(C_A, step); // swap a
+    case OPCODE_SUB_A_B: return opcode_alu_op_reg_reg(ALU_OP_LS_SUB_RS, C_A, C_B, step); // sub a, b
+    case OPCODE_SBC_A_B: return opcode_alu_op_reg_reg(ALU_OP_LS_SBC_RS, C_A, C_B, step); // sbc a, b
+    case OPCODE_CMP_A_B: return opcode_alu_cmp_reg_reg(C_A, C_B, step); // cmp a, b
+    case OPCODE_MULSTEP_A_B: return opcode_alu_op_reg_reg(ALU_OP_LS_ADD_RS_IF_CF, C_A, C_B, step); // mulstep a, b (add b if carry)
+    case OPCODE_LD_I_J_PTR: return opcode_ld_reg_reg_index_ptr(C_IH, C_IL, C_JL, step); // ld i, [j]
+    case OPCODE_LD_J_I_PTR: return opcode_ld_reg_reg_index_ptr(C_JH, C_JL, C_IL, step); // ld j, [i]
+    case OPCODE_LD_I_I_PTR: return opcode_ld_reg_reg_index_ptr(C_IH, C_IL, C_IL, step); // ld i, [i], M holds the address before IL is written
+    case OPCODE_IN_A_PORT0: // in a, {port: u3}
+    case OPCODE_IN_A_PORT1:
+    case OPCODE_IN_A_PORT2:
+    case OPCODE_IN_A_PORT3:
+    case OPCODE_IN_A_PORT4:
+    case OPCODE_IN_A_PORT5:
+    case OPCODE_IN_A_PORT6:
+    case OPCODE_IN_A_PORT7: return opcode_in_reg_port(C_A, step);
+    case OPCODE_OUT_PORT0_A: // out {port: u3}, a
+    case OPCODE_OUT_PORT1_A:
+    case OPCODE_OUT_PORT2_A:
+    case OPCODE_OUT_PORT3_A:
+    case OPCODE_OUT_PORT4_A:
+    case OPCODE_OUT_PORT5_A:
+    case OPCODE_OUT_PORT6_A:
+    case OPCODE_OUT_PORT7_A: return opcode_out_port_reg(C_A, step);
+    case OPCODE_OUT_PORT0_IMM8: // out {port: u3}, {imm: i8}
+    case OPCODE_OUT_PORT1_IMM8:
+    case OPCODE_OUT_PORT2_IMM8:
+    case OPCODE_OUT_PORT3_IMM8:
+    case OPCODE_OUT_PORT4_IMM8:
+    case OPCODE_OUT_PORT5_IMM8:
+    case OPCODE_OUT_PORT6_IMM8:
+    case OPCODE_OUT_PORT7_IMM8: return opcode_out_port_imm8(step);
+    }
+
+    // Ensure step 0 always is fetch opcode, we don't know the output of O during start up.
+    switch (step) {
+    case 0: return FETCH_OPCODE;
+    default: return HALT_NOT_LD_C;
+    }
+}
+
+// Rules a single step must follow no matter the opcode, not counting the dynamic IO OE.
+static bool signals_valid(uint16_t signals) {
+    int n_oe = ((signals & OE_ML) != 0) + ((signals & OE_MH) != 0) + ((signals & OE_ALU) != 0) + ((signals & OE_MEM) != 0);
+
+    return n_oe <= 1 &&
+           (signals & (LD_MEM | OE_MEM)) != (LD_MEM | OE_MEM);
+}
+
+// The fetch can share the last step when that step neither uses the data bus nor changes ML, MH
+// or the M/C selection, i.e. ML/MH is the program counter and stays so until the next setup.
+static bool can_prefetch_in(uint16_t signals, bool sel_c) {
+    bool uses_bus = signals & (OE_ML | OE_MH | OE_ALU | OE_MEM | LD_LS | LD_MEM | LD_ML | LD_MH);
+    bool uses_low_bits = signals & (LD_C | CE_M_NOT_LD_C | LD_O_NOT_LD_C | LD_RS_NOT_LD_C | LD_IO_NOT_LD_C);
+
+    return !sel_c && !uses_bus && !uses_low_bits && !(signals & TG_M_C);
+}
+
+typedef struct {
+    Opcode opcode;
+    bool visited[16][16][2];
+    bool set[16][16];
+    uint16_t signals[16][16];
+} PrefetchWalk;
+
+static void prefetch_set(PrefetchWalk *walk, uint8_t step, uint8_t flags, uint16_t signals) {
+    assert((!walk->set[step][flags] || walk->signals[step][flags] == signals) && "Paths disagree on a prefetched step");
+
+    walk->set[step][flags] = true;
+    walk->signals[step][flags] = signals;
+}
+
+// Follows every path through the reference steps of an opcode, like verify_walk, as F latched in one
+// step selects the signals of the next. Each reference step is placed one step earlier.
+static void prefetch_walk(PrefetchWalk *walk, uint8_t reference_step, uint8_t flags, bool sel_c) {
+    if (reference_step >= 16 || walk->visited[reference_step][flags][sel_c]) {
+        return;
+    }
+
+    walk->visited[reference_step][flags][sel_c] = true;
+
+    uint16_t signals = signals_from_input(reference_step, flags & 1, (flags >> 1) & 1, (flags >> 2) & 1, (flags >> 3) & 1, walk->opcode);
+
+    bool is_last = (signals & (LD_C | LD_S_NOT_LD_C)) == LD_S_NOT_LD_C;
+    bool latches_f = (signals & (OE_ALU | LD_LS)) == (OE_ALU | LD_LS);
+    uint8_t step = (uint8_t)(reference_step - 1);
+
+    if (is_last && can_prefetch_in(signals, sel_c)) {
+        prefetch_set(walk, step, flags, signals | FETCH_OPCODE);
+        return;
+    }
+
+    prefetch_set(walk, step, flags, is_last ? signals & (uint16_t)~LD_S_NOT_LD_C : signals);
+
+    for (uint8_t next_flags = 0; next_flags < 16; ++next_flags) {
+        if (!latches_f && next_flags != flags) {
+            continue;
+        }
+
+        if (is_last) {
+            prefetch_set(walk, reference_step, next_flags, FETCH_OPCODE | LD_S_NOT_LD_C);
+        } else {
+            prefetch_walk(walk, (uint8_t)(reference_step + 1), next_flags, (signals & TG_M_C) ? !sel_c : sel_c);
+        }
+    }
+}
+
+// Same as signals_from_input but the last step of an instruction fetches the next opcode, in a step
+// of its own unless it fits in the last one, so step 0 is the first step after FETCH_OPCODE.
+// Requires O to be cleared on reset, making the first instruction a nop that fetches from 0x0000.
+static uint16_t signals_with_prefetch(uint8_t step, bool zero_flag_set, bool carry_flag_set, bool overflow_flag_set, bool sign_flag_set, Opcode opcode) {
+    static PrefetchWalk walk;
+    static bool walked = false;
+
+    if (!walked || walk.opcode != opcode) {
+        memset(&walk, 0, sizeof(walk));
+        walk.opcode = opcode;
+        walked = true;
+
+        for (uint8_t flags = 0; flags < 16; ++flags) {
+            prefetch_walk(&walk, 1, flags, false);
+        }
+    }
+
+    uint8_t flags = (uint8_t)(zero_flag_set | (carry_flag_set << 1) | (overflow_flag_set << 2) | (sign_flag_set << 3));
+
+    return walk.set[step][flags] ? walk.signals[step][flags] : HALT_NOT_LD_C;
+}
+
+typedef uint16_t (*SignalsFromInput)(uint8_t step, bool zero_flag_set, bool carry_flag_set, bool overflow_flag_set, bool sign_flag_set, Opcode opcode);
+
+static void generate_table_with(uint8_t (*table)[CONTROL_ROM_SIZE], SignalsFromInput signals) {
+    for (size_t i = 0; i < CONTROL_ROM_SIZE; ++i) {
+        uint8_t step = (uint8_t)((((i >> PIN_STEP_3) & 1) << 3) |
+                                 (((i >> PIN_STEP_2) & 1) << 2) |
+                                 (((i >> PIN_STEP_1) & 1) << 1) |
+                                 (((i >> PIN_STEP_0) & 1) << 0));
+
+        bool zero_flag_set = (i >> PIN_FLAG_0_ZERO) & 1;
+        bool carry_flag_set = (i >> PIN_FLAG_1_CARRY) & 1;
+        bool overflow_flag_set = (i >> PIN_FLAG_2_OVERFLOW) & 1;
+        bool sign_flag_set = (i >> PIN_FLAG_3_SIGN) & 1;
+
+        uint8_t opcode = (uint8_t)((((i >> PIN_OPCODE_7) & 1) << 7) |
+                                   (((i >> PIN_OPCODE_6) & 1) << 6) |
+                                   (((i >> PIN_OPCODE_5) & 1) << 5) |
+                                   (((i >> PIN_OPCODE_4) & 1) << 4) |
+                                   (((i >> PIN_OPCODE_3) & 1) << 3) |
+                                   (((i >> PIN_OPCODE_2) & 1) << 2) |
+                                   (((i >> PIN_OPCODE_1) & 1) << 1) |
+                                   (((i >> PIN_OPCODE_0) & 1) << 0));
+
+        bool is_high_slice = (i >> PIN_HIGH_SLICE) & 1;
+
+        uint16_t active_high_signals =
+            signals(step, zero_flag_set, carry_flag_set, overflow_flag_set, sign_flag_set, opcode);
+
+        uint16_t unmasked_signals = active_high_signals ^ ACTIVE_LOW_MASK;
+
+        (*table)[i] = is_high_slice ? (unmasked_signals >> 8)
+                                    : (unmasked_signals & 0xff);
+    }
+}
+
+static void generate_table(uint8_t (*table)[CONTROL_ROM_SIZE]) {
+    generate_table_with(table, signals_from_input);
+}
+
+#endif
@@ -0,0 +1,268 @@
+// Generated by verify_control.c from ./bin/control.bin, do not edit.
+#ifndef CONTROL_CYCLES_H
+#define CONTROL_CYCLES_H
+
+#include <stdint.h> // uint*_t
+
+// Clock cycles per opcode including the fetch, {fewest, most}.
+// Conditional jumps take the most when taken. {0, 0} for opcodes halting the clock.
+static const uint8_t opcode_cycles[256][2] = {
+    [0x00] = {8, 8},
+    [0x01] = {3, 3},
+    [0x02] = {3, 3},
+    [0x03] = {3, 3},
+    [0x04] = {3, 3},
+    [0x05] = {5, 5},
+    [0x06] = {5, 5},
+    [0x07] = {10, 10},
+    [0x08] = {10, 10},
+    [0x09] = {12, 12},
+    [0x0a] = {12, 12},
+    [0x0b] = {10, 10},
+    [0x0c] = {10, 10},
+    [0x0d] = {12, 12},
+    [0x0e] = {12, 12},
+    [0x0f] = {12, 12},
+    [0x10] = {12, 12},
+    [0x11] = {12, 12},
+    [0x12] = {12, 12},
+    [0x13] = {12, 12},
+    [0x14] = {12, 12},
+    [0x15] = {4, 4},
+    [0x16] = {4, 4},
+    [0x17] = {4, 4},
+    [0x18] = {4, 4},
+    [0x19] = {4, 4},
+    [0x1a] = {4, 4},
+    [0x1b] = {4, 4},
+    [0x1c] = {4, 4},
+    [0x1d] = {4, 4},
+    [0x1e] = {4, 4},
+    [0x1f] = {4, 4},
+    [0x20] = {4, 4},
+    [0x21] = {5, 5},
+    [0x22] = {5, 5},
+    [0x23] = {5, 5},
+    [0x24] = {5, 5},
+    [0x25] = {5, 5},
+    [0x26] = {5, 5},
+    [0x27] = {7, 7},
+    [0x28] = {7, 7},
+    [0x29] = {7, 7},
+    [0x2a] = {7, 7},
+    [0x2b] = {7, 7},
+    [0x2c] = {5, 5},
+    [0x2d] = {5, 5},
+    [0x2e] = {5, 5},
+    [0x2f] = {5, 5},
+    [0x30] = {5, 5},
+    [0x31] = {5, 5},
+    [0x32] = {7, 7},
+    [0x33] = {7, 7},
+    [0x34] = {6, 6},
+    [0x35] = {6, 6},
+    [0x36] = {6, 6},
+    [0x37] = {6, 6},
+    [0x38] = {6, 6},
+    [0x39] = {6, 6},
+    [0x3a] = {6, 6},
+    [0x3b] = {5, 5},
+    [0x3c] = {5, 5},
+    [0x3d] = {4, 4},
+    [0x3e] = {4, 4},
+    [0x3f] = {4, 4},
+    [0x40] = {4, 4},
+    [0x41] = {4, 4},
+    [0x42] = {4, 4},
+    [0x43] = {4, 4},
+    [0x44] = {4, 4},
+    [0x45] = {4, 4},
+    [0x46] = {4, 4},
+    [0x47] = {4, 4},
+    [0x48] = {3, 3},
+    [0x49] = {11, 11},
+    [0x4a] = {11, 11},
+    [0x4b] = {11, 11},
+    [0x4c] = {11, 11},
+    [0x4d] = {13, 13},
+    [0x4e] = {13, 13},
+    [0x4f] = {11, 11},
+    [0x50] = {11, 11},
+    [0x51] = {11, 11},
+    [0x52] = {11, 11},
+    [0x53] = {15, 15},
+    [0x54] = {15, 15},
+    [0x55] = {15, 15},
+    [0x56] = {11, 11},
+    [0x57] = {12, 12},
+    [0x58] = {0, 0},
+    [0x59] = {16, 16},
+    [0x5a] = {5, 8},
+    [0x5b] = {5, 8},
+    [0x5c] = {7, 9},
+    [0x5d] = {7, 9},
+    [0x5e] = {6, 9},
+    [0x5f] = {7, 10},
+    [0x60] = {12, 12},
+    [0x61] = {13, 13},
+    [0x62] = {13, 13},
+    [0x63] = {13, 13},
+    [0x64] = {13, 13},
+    [0x65] = {6, 8},
+    [0x66] = {6, 8},
+    [0x67] = {6, 8},
+    [0x68] = {14, 14},
+    [0x69] = {5, 5},
+    [0x6a] = {5, 5},
+    [0x6b] = {8, 8},
+    [0x6c] = {7, 7},
+    [0x6d] = {7, 7},
+    [0x6e] = {6, 6},
+    [0x6f] = {7, 7},
+    [0x70] = {6, 6},
+    [0x71] = {7, 7},
+    [0x72] = {7, 7},
+    [0x73] = {7, 7},
+    [0x74] = {7, 7},
+    [0x75] = {6, 6},
+    [0x76] = {7, 7},
+    [0x77] = {7, 7},
+    [0x78] = {7, 7},
+    [0x79] = {7, 7},
+    [0x7a] = {6, 6},
+    [0x7b] = {7, 7},
+    [0x7c] = {7, 7},
+    [0x7d] = {7, 7},
+    [0x7e] = {7, 7},
+    [0x7f] = {6, 6},
+    [0x80] = {6, 6},
+    [0x81] = {7, 7},
+    [0x82] = {7, 7},
+    [0x83] = {7, 7},
+    [0x84] = {7, 7},
+    [0x85] = {6, 6},
+    [0x86] = {7, 7},
+    [0x87] = {7, 7},
+    [0x88] = {7, 7},
+    [0x89] = {7, 7},
+    [0x8a] = {6, 6},
+    [0x8b] = {7, 7},
+    [0x8c] = {7, 7},
+    [0x8d] = {7, 7},
+    [0x8e] = {7, 7},
+    [0x8f] = {6, 6},
+    [0x90] = {6, 6},
+    [0x91] = {7, 7},
+    [0x92] = {7, 7},
+    [0x93] = {7, 7},
+    [0x94] = {7, 7},
+    [0x95] = {6, 6},
+    [0x96] = {7, 7},
+    [0x97] = {7, 7},
+    [0x98] = {7, 7},
+    [0x99] = {7, 7},
+    [0x9a] = {6, 6},
+    [0x9b] = {7, 7},
+    [0x9c] = {7, 7},
+    [0x9d] = {7, 7},
+    [0x9e] = {7, 7},
+    [0x9f] = {6, 6},
+    [0xa0] = {6, 6},
+    [0xa1] = {7, 7},
+    [0xa2] = {7, 7},
+    [0xa3] = {7, 7},
+    [0xa4] = {7, 7},
+    [0xa5] = {6, 6},
+    [0xa6] = {7, 7},
+    [0xa7] = {7, 7},
+    [0xa8] = {7, 7},
+    [0xa9] = {7, 7},
+    [0xaa] = {6, 6},
+    [0xab] = {7, 7},
+    [0xac] = {7, 7},
+    [0xad] = {7, 7},
+    [0xae] = {7, 7},
+    [0xaf] = {6, 6},
+    [0xb0] = {6, 6},
+    [0xb1] = {7, 7},
+    [0xb2] = {7, 7},
+    [0xb3] = {7, 7},
+    [0xb4] = {7, 7},
+    [0xb5] = {6, 6},
+    [0xb6] = {7, 7},
+    [0xb7] = {7, 7},
+    [0xb8] = {7, 7},
+    [0xb9] = {7, 7},
+    [0xba] = {6, 6},
+    [0xbb] = {7, 7},
+    [0xbc] = {7, 7},
+    [0xbd] = {7, 7},
+    [0xbe] = {7, 7},
+    [0xbf] = {6, 6},
+    [0xc0] = {6, 6},
+    [0xc1] = {7, 7},
+    [0xc2] = {7, 7},
+    [0xc3] = {7, 7},
+    [0xc4] = {7, 7},
+    [0xc5] = {6, 6},
+    [0xc6] = {7, 7},
+    [0xc7] = {7, 7},
+    [0xc8] = {7, 7},
+    [0xc9] = {7, 7},
+    [0xca] = {6, 6},
+    [0xcb] = {7, 7},
+    [0xcc] = {7, 7},
+    [0xcd] = {7, 7},
+    [0xce] = {7, 7},
+    [0xcf] = {6, 6},
+    [0xd0] = {5, 5},
+    [0xd1] = {6, 6},
+    [0xd2] = {6, 6},
+    [0xd3] = {6, 6},
+    [0xd4] = {6, 6},
+    [0xd5] = {5, 5},
+    [0xd6] = {6, 6},
+    [0xd7] = {6, 6},
+    [0xd8] = {6, 6},
+    [0xd9] = {6, 6},
+    [0xda] = {5, 5},
+    [0xdb] = {6, 6},
+    [0xdc] = {6, 6},
+    [0xdd] = {6, 6},
+    [0xde] = {6, 6},
+    [0xdf] = {5, 5},
+    [0xe0] = {12, 12},
+    [0xe1] = {12, 12},
+    [0xe2] = {12, 12},
+    [0xe3] = {0, 0},
+    [0xe4] = {0, 0},
+    [0xe5] = {0, 0},
+    [0xe6] = {0, 0},
+    [0xe7] = {0, 0},
+    [0xe8] = {5, 5},
+    [0xe9] = {5, 5},
+    [0xea] = {5, 5},
+    [0xeb] = {5, 5},
+    [0xec] = {5, 5},
+    [0xed] = {5, 5},
+    [0xee] = {5, 5},
+    [0xef] = {5, 5},
+    [0xf0] = {4, 4},
+    [0xf1] = {4, 4},
+    [0xf2] = {4, 4},
+    [0xf3] = {4, 4},
+    [0xf4] = {4, 4},
+    [0xf5] = {4, 4},
+    [0xf6] = {4, 4},
+    [0xf7] = {4, 4},
+    [0xf8] = {3, 3},
+    [0xf9] = {3, 3},
+    [0xfa] = {3, 3},
+    [0xfb] = {3, 3},
+    [0xfc] = {3, 3},
+    [0xfd] = {3, 3},
+    [0xfe] = {3, 3},
+    [0xff] = {3, 3},
+};
+
+#endif
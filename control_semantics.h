@@ -0,0 +1,576 @@
+#ifndef CONTROL_SEMANTICS_H
+#define CONTROL_SEMANTICS_H
+
+#include <stdbool.h> // bool
+#include <stdint.h> // uint*_t
+#include <string.h> // memset
+
+#include "alu_op.h"
+#include "control.h"
+#include "control_verify.h"
+
+// What an instruction depends on, a value is computed from a set of these.
+#define SEMANTICS_DEP_REGISTERS (0xffffu) // Bit per offset into the register area
+#define SEMANTICS_DEP_OPERAND_0 (1u << 16) // Byte at pc + 1
+#define SEMANTICS_DEP_OPERAND_1 (1u << 17) // Byte at pc + 2
+#define SEMANTICS_DEP_PC (1u << 18)
+#define SEMANTICS_DEP_MEMORY (1u << 19) // Byte read through a pointer or from the stack
+#define SEMANTICS_DEP_IO (1u << 20) // Byte read from the IO port
+#define SEMANTICS_DEP_FLAG(bit) (1u << (24 + (bit))) // Bit of F, ZF is 0 like in F
+#define SEMANTICS_DEP_FLAGS (0xfu << 24)
+#define SEMANTICS_DEP_UNDEFINED (1u << 31) // LS, RS or C before the instruction loaded them
+
+#define SEMANTICS_MEMORY_READ (1 << 0) // Through a pointer
+#define SEMANTICS_MEMORY_WRITE (1 << 1)
+#define SEMANTICS_STACK_READ (1 << 2) // MH is the pulled up 0xff
+#define SEMANTICS_STACK_WRITE (1 << 3)
+#define SEMANTICS_IO_IN (1 << 4)
+#define SEMANTICS_IO_OUT (1 << 5)
+
+#define SEMANTICS_CF_BIT (1)
+
+typedef enum {
+    SEMANTICS_VALUE_ANY, // Computed from `deps`
+    SEMANTICS_VALUE_CONSTANT, // `arg`
+    SEMANTICS_VALUE_INPUT, // Unchanged, `deps` is the one input
+    SEMANTICS_VALUE_PC_L, // Low byte of pc + `arg`
+    SEMANTICS_VALUE_PC_H, // High byte of pc + `arg`
+    SEMANTICS_VALUE_UNARY, // ALU op `arg` on the unchanged register `reg`
+} SemanticsValueKind;
+
+typedef struct {
+    SemanticsValueKind kind;
+    uint8_t arg;
+    uint8_t reg;
+    uint32_t deps;
+} SemanticsValue;
+
+// Transfer function of an opcode, merged over every path through its steps.
+typedef struct {
+    bool defined; // Some path loads S, halt and undefined opcodes halt the clock instead
+    bool halts;
+    bool uses_undefined; // Something observable depends on LS, RS or C before they were loaded
+    bool lengths_disagree; // Paths falling through continue at different addresses
+
+    uint8_t length; // Bytes, where falling through continues or one past the last operand
+    uint8_t min_cycles; // Including the fetch
+    uint8_t max_cycles;
+
+    uint16_t reads; // Registers anything observable depends on, bit per offset into the register area
+    uint16_t writes; // Registers left changed, scratch registers left out
+    uint16_t address_reads; // Registers memory and stack addresses are computed from
+    uint8_t flags_read; // F bits selecting steps or feeding the ALU
+    uint8_t flags_written; // F bits left changed
+    uint8_t control_flags_read; // F bits selecting steps before the instruction latched F
+    uint8_t effects; // SEMANTICS_MEMORY_*, SEMANTICS_STACK_* and SEMANTICS_IO_*
+
+    bool falls_through; // Some path continues at pc + length
+    bool jumps; // Some path continues elsewhere
+    uint32_t jump_deps; // What the address jumped to is computed from
+    uint8_t fall_through_cycles; // Most cycles of the paths falling through
+    uint8_t jump_cycles; // Most cycles of the paths jumping
+
+    uint32_t register_deps[16]; // What each written register is computed from
+    uint32_t flag_deps[4];
+    uint32_t memory_write_deps; // What is written to memory or the stack is computed from
+    uint32_t out_deps;
+
+    // Set when every path only writes `update_reg = update_alu_op(update_reg)`, `inc a` or `djnz b` for example.
+    bool has_unary_update;
+    uint8_t update_reg;
+    uint8_t update_alu_op;
+} OpcodeSemantics;
+
+typedef struct {
+    uint8_t step;
+    uint8_t flags; // Selects the signals, F the ALU latched is forked into every value giving other steps
+    bool latched_f;
+
+    uint8_t c;
+    bool c_known;
+    bool io_oe;
+    bool sel_c;
+
+    SemanticsValue ls;
+    SemanticsValue rs;
+    SemanticsValue ml;
+    SemanticsValue mh;
+    SemanticsValue f[4];
+    SemanticsValue registers[16];
+
+    uint32_t deps; // What addresses, written memory and IO so far depend on
+    uint8_t control_flags_read;
+    uint8_t effects;
+    uint16_t address_reads;
+    uint8_t max_operand; // One past the last operand byte read
+    uint32_t memory_write_deps;
+    uint32_t out_deps;
+} SemanticsState;
+
+typedef struct {
+    const uint8_t (*table)[CONTROL_ROM_SIZE];
+    Opcode opcode;
+    bool prefetches;
+    bool first_path;
+    bool first_fall_through;
+    OpcodeSemantics *result;
+} SemanticsWalk;
+
+static SemanticsValue semantics_value(SemanticsValueKind kind, uint8_t arg, uint32_t deps) {
+    return (SemanticsValue){.kind = kind, .arg = arg, .deps = deps};
+}
+
+static SemanticsValue semantics_any(uint32_t deps) {
+    return semantics_value(SEMANTICS_VALUE_ANY, 0, deps);
+}
+
+static bool semantics_is_input(SemanticsValue value, uint32_t dep) {
+    return value.kind == SEMANTICS_VALUE_INPUT && value.deps == dep;
+}
+
+// Q of the ALU for what C, LS, RS and CF are now, following alu.c. Ops 0x20 and up pass LS through.
+// Latched flags go to `f` when given.
+static SemanticsValue semantics_alu(const SemanticsState *s, SemanticsValue *f) {
+    if (!s->c_known) {
+        for (int bit = 0; f != NULL && bit < 4; ++bit) {
+            f[bit] = semantics_any(SEMANTICS_DEP_UNDEFINED);
+        }
+
+        return semantics_any(SEMANTICS_DEP_UNDEFINED);
+    }
+
+    uint8_t op = s->c & 0x3f;
+
+    if (op >= 0x20) {
+        if (f != NULL) {
+            f[0] = f[1] = f[2] = semantics_value(SEMANTICS_VALUE_CONSTANT, 0, 0);
+            f[3] = semantics_any(s->ls.deps);
+        }
+
+        return s->ls;
+    }
+
+    bool is_unary = false;
+    bool keeps_cf = false;
+    uint32_t deps = 0;
+
+    switch (op) {
+    case ALU_OP_INC_LS:
+    case ALU_OP_DEC_LS:
+        keeps_cf = true;
+        is_unary = true;
+        deps = s->ls.deps;
+        break;
+
+    case ALU_OP_SHL_LS:
+    case ALU_OP_SHR_LS:
+    case ALU_OP_NOT_LS:
+    case ALU_OP_ROR_LS:
+    case ALU_OP_ROL_LS:
+    case ALU_OP_SAR_LS:
+        is_unary = true;
+        deps = s->ls.deps;
+        break;
+
+    case ALU_OP_LS_ADD_RS:
+    case ALU_OP_LS_OR_RS:
+    case ALU_OP_LS_AND_RS:
+    case ALU_OP_LS_XOR_RS:
+    case ALU_OP_LS_SUB_RS: deps = s->ls.deps | s->rs.deps; break;
+
+    case ALU_OP_LS_ADC_RS:
+    case ALU_OP_LS_SBC_RS:
+    case ALU_OP_LS_ADD_RS_IF_CF: deps = s->ls.deps | s->rs.deps | s->f[SEMANTICS_CF_BIT].deps; break;
+
+    default: // Unused ops and setting the IO OE flag give 0 and no flags
+        if (f != NULL) {
+            f[0] = f[1] = f[2] = f[3] = semantics_value(SEMANTICS_VALUE_CONSTANT, 0, 0);
+        }
+
+        return semantics_value(SEMANTICS_VALUE_CONSTANT, 0, 0);
+    }
+
+    SemanticsValue q = semantics_any(deps);
+
+    // Unary ops on a register as it was, for consumers like the emulator's counted loops.
+    for (uint8_t reg = 0; is_unary && reg < 16; ++reg) {
+        if (semantics_is_input(s->ls, 1u << reg)) {
+            q = (SemanticsValue){.kind = SEMANTICS_VALUE_UNARY, .arg = op, .reg = reg, .deps = deps};
+        }
+    }
+
+    if (f != NULL) {
+        f[0] = f[2] = f[3] = semantics_any(deps);
+        f[SEMANTICS_CF_BIT] = keeps_cf ? s->f[SEMANTICS_CF_BIT] : semantics_any(deps);
+    }
+
+    return q;
+}
+
+static bool semantics_m_is_pc(const SemanticsState *s) {
+    return s->ml.kind == SEMANTICS_VALUE_PC_L && s->mh.kind == SEMANTICS_VALUE_PC_H && s->ml.arg == s->mh.arg;
+}
+
+static SemanticsValue semantics_read(const SemanticsWalk *walk, SemanticsState *s, bool is_fetch) {
+    if (s->sel_c) {
+        return s->c_known ? s->registers[s->c & 0xf] : semantics_any(SEMANTICS_DEP_UNDEFINED);
+    }
+
+    // This opcode or, when prefetching, the next one wherever it jumped to.
+    if (is_fetch) {
+        return semantics_any(SEMANTICS_DEP_PC | SEMANTICS_DEP_MEMORY);
+    }
+
+    if (semantics_m_is_pc(s)) {
+        uint8_t offset = s->ml.arg;
+
+        if (offset == 0) {
+            return semantics_value(SEMANTICS_VALUE_CONSTANT, (uint8_t)walk->opcode, 0);
+        }
+
+        if (offset + 1 > s->max_operand) {
+            s->max_operand = (uint8_t)(offset + 1);
+        }
+
+        return offset == 1   ? semantics_value(SEMANTICS_VALUE_INPUT, 0, SEMANTICS_DEP_OPERAND_0)
+               : offset == 2 ? semantics_value(SEMANTICS_VALUE_INPUT, 0, SEMANTICS_DEP_OPERAND_1)
+                             : semantics_any(SEMANTICS_DEP_PC | SEMANTICS_DEP_MEMORY);
+    }
+
+    bool is_stack = s->mh.kind == SEMANTICS_VALUE_CONSTANT && s->mh.arg == 0xff;
+    uint32_t address_deps = s->ml.deps | s->mh.deps;
+
+    s->effects |= is_stack ? SEMANTICS_STACK_READ : SEMANTICS_MEMORY_READ;
+    s->deps |= address_deps;
+    s->address_reads |= (uint16_t)(address_deps & SEMANTICS_DEP_REGISTERS);
+
+    return semantics_any(SEMANTICS_DEP_MEMORY);
+}
+
+static void semantics_write(SemanticsState *s, SemanticsValue value) {
+    if (s->sel_c) {
+        if (s->c_known) {
+            s->registers[s->c & 0xf] = value;
+        } else {
+            s->deps |= SEMANTICS_DEP_UNDEFINED;
+        }
+
+        return;
+    }
+
+    bool is_stack = s->mh.kind == SEMANTICS_VALUE_CONSTANT && s->mh.arg == 0xff;
+    uint32_t address_deps = s->ml.deps | s->mh.deps;
+
+    s->effects |= is_stack ? SEMANTICS_STACK_WRITE : SEMANTICS_MEMORY_WRITE;
+    s->deps |= address_deps | value.deps;
+    s->address_reads |= (uint16_t)(address_deps & SEMANTICS_DEP_REGISTERS);
+    s->memory_write_deps |= value.deps;
+}
+
+static void semantics_finish(SemanticsWalk *walk, const SemanticsState *s) {
+    OpcodeSemantics *result = walk->result;
+
+    uint8_t cycles = (uint8_t)(s->step + 1);
+    uint32_t deps = s->deps;
+    uint16_t writes = 0;
+
+    for (uint8_t reg = 0; reg < 16; ++reg) {
+        // TL, TH and UL are scratch, left as whatever the microcode needed them for.
+        if ((reg >= C_TL && reg <= C_UL) || semantics_is_input(s->registers[reg], 1u << reg)) {
+            continue;
+        }
+
+        writes |= (uint16_t)(1 << reg);
+        result->register_deps[reg] |= s->registers[reg].deps;
+        deps |= s->registers[reg].deps;
+    }
+
+    for (uint8_t bit = 0; bit < 4; ++bit) {
+        if (!semantics_is_input(s->f[bit], SEMANTICS_DEP_FLAG(bit))) {
+            result->flags_written |= (uint8_t)(1 << bit);
+            result->flag_deps[bit] |= s->f[bit].deps;
+            deps |= s->f[bit].deps;
+        }
+    }
+
+    if (semantics_m_is_pc(s)) {
+        uint8_t length = (uint8_t)(s->ml.arg - walk->prefetches);
+
+        if (!walk->first_fall_through && length != result->length) {
+            result->lengths_disagree = true;
+        }
+
+        result->length = length;
+        result->falls_through = true;
+        result->fall_through_cycles = cycles > result->fall_through_cycles ? cycles : result->fall_through_cycles;
+        walk->first_fall_through = false;
+    } else {
+        result->jumps = true;
+        result->jump_cycles = cycles > result->jump_cycles ? cycles : result->jump_cycles;
+        result->jump_deps |= s->ml.deps | s->mh.deps;
+        deps |= s->ml.deps | s->mh.deps;
+    }
+
+    result->defined = true;
+    result->min_cycles = walk->first_path || cycles < result->min_cycles ? cycles : result->min_cycles;
+    result->max_cycles = walk->first_path || cycles > result->max_cycles ? cycles : result->max_cycles;
+    result->reads |= (uint16_t)(deps & SEMANTICS_DEP_REGISTERS);
+    result->writes |= writes;
+    result->address_reads |= s->address_reads;
+    result->control_flags_read |= s->control_flags_read;
+    result->flags_read |= (uint8_t)(((deps & SEMANTICS_DEP_FLAGS) >> 24) | s->control_flags_read);
+    result->effects |= s->effects;
+    result->memory_write_deps |= s->memory_write_deps;
+    result->out_deps |= s->out_deps;
+    result->uses_undefined |= (deps & SEMANTICS_DEP_UNDEFINED) != 0;
+
+    // Paths that only jump are as long as the operands they read.
+    if (!result->falls_through) {
+        uint8_t length = s->max_operand > 1 ? s->max_operand : 1;
+        result->length = length > result->length ? length : result->length;
+    }
+
+    // A unary update must be the only register write on every path.
+    bool is_unary_update = false;
+
+    for (uint8_t reg = 0; reg < 16; ++reg) {
+        if (writes == (1 << reg) &&
+            s->registers[reg].kind == SEMANTICS_VALUE_UNARY &&
+            s->registers[reg].reg == reg) {
+            is_unary_update = walk->first_path ||
+                              (result->has_unary_update &&
+                               result->update_reg == reg &&
+                               result->update_alu_op == s->registers[reg].arg);
+
+            result->update_reg = reg;
+            result->update_alu_op = s->registers[reg].arg;
+        }
+    }
+
+    result->has_unary_update = is_unary_update;
+    walk->first_path = false;
+}
+
+// Steps through one path, forking on every F latch into the F values that select different steps.
+static void semantics_walk(SemanticsWalk *walk, SemanticsState s) {
+    for (;;) {
+        uint16_t signals = signals_from_table(walk->table, s.step, s.flags, walk->opcode);
+
+        bool ld_c = signals & LD_C;
+
+        if (!ld_c && (signals & HALT_NOT_LD_C)) {
+            walk->result->halts = true;
+            return;
+        }
+
+        for (uint8_t bit = 0; !s.latched_f && bit < 4; ++bit) {
+            if (signals_from_table(walk->table, s.step, (uint8_t)(s.flags ^ (1 << bit)), walk->opcode) != signals) {
+                s.control_flags_read |= (uint8_t)(1 << bit);
+            }
+        }
+
+        bool ld_o = !ld_c && (signals & LD_O_NOT_LD_C);
+
+        // Setup, what is on the data bus.
+        SemanticsValue bus = semantics_value(SEMANTICS_VALUE_CONSTANT, 0xff, 0); // Pulled up
+
+        if (signals & OE_ML) {
+            bus = s.ml;
+        }
+
+        if (signals & OE_MH) {
+            bus = s.mh;
+        }
+
+        if (signals & OE_ALU) {
+            bus = semantics_alu(&s, NULL);
+        }
+
+        if (signals & OE_MEM) {
+            bus = semantics_read(walk, &s, ld_o);
+        }
+
+        if (s.io_oe) {
+            bus = semantics_any(SEMANTICS_DEP_IO);
+            s.effects |= SEMANTICS_IO_IN;
+        }
+
+        // Exec, F is from what the ALU had before LS is latched.
+        bool latches_f = (signals & OE_ALU) && (signals & LD_LS);
+
+        if (latches_f) {
+            semantics_alu(&s, s.f);
+            s.latched_f = true;
+        }
+
+        if (!ld_c && (signals & LD_RS_NOT_LD_C)) {
+            s.rs = bus;
+        }
+
+        if (signals & LD_LS) {
+            s.ls = bus;
+        }
+
+        if (signals & LD_MEM) {
+            semantics_write(&s, bus);
+        }
+
+        if (!ld_c && (signals & LD_IO_NOT_LD_C)) {
+            s.effects |= SEMANTICS_IO_OUT;
+            s.deps |= bus.deps;
+            s.out_deps |= bus.deps;
+        }
+
+        // Next setup, C, ML, MH and the M/C selection.
+        if (ld_c) {
+            s.io_oe = s.c_known && (s.c & 0x3f) == ALU_OP_SET_IO_OE_FLAG;
+            s.c = signals & 0x3f;
+            s.c_known = true;
+        } else if ((signals & CE_M_NOT_LD_C) && !(signals & LD_ML)) {
+            bool carries = !(signals & LD_MH);
+
+            if (semantics_m_is_pc(&s)) {
+                ++s.ml.arg;
+                s.mh.arg = carries ? s.ml.arg : s.mh.arg;
+            } else {
+                s.ml = semantics_any(s.ml.deps);
+                s.mh = carries ? semantics_any(s.mh.deps | s.ml.deps) : s.mh;
+            }
+        }
+
+        if (signals & LD_ML) {
+            s.ml = bus;
+        }
+
+        if (signals & LD_MH) {
+            s.mh = bus;
+        }
+
+        if (signals & TG_M_C) {
+            s.sel_c = !s.sel_c;
+        }
+
+        if (!ld_c && (signals & LD_S_NOT_LD_C)) {
+            semantics_finish(walk, &s);
+            return;
+        }
+
+        if (s.step == N_STEPS - 1) {
+            return; // Never loads S, left to the verifier
+        }
+
+        ++s.step;
+
+        if (!latches_f) {
+            continue;
+        }
+
+        // Only F values giving different signals for the remaining steps need a path of their own.
+        for (uint8_t flags = 0; flags < 16; ++flags) {
+            bool is_new = true;
+
+            for (uint8_t other = 0; other < flags && is_new; ++other) {
+                bool is_same = true;
+
+                for (uint8_t step = s.step; step < N_STEPS && is_same; ++step) {
+                    is_same = signals_from_table(walk->table, step, flags, walk->opcode) ==
+                              signals_from_table(walk->table, step, other, walk->opcode);
+                }
+
+                is_new = !is_same;
+            }
+
+            if (is_new) {
+                SemanticsState forked = s;
+                forked.flags = flags;
+                semantics_walk(walk, forked);
+            }
+        }
+
+        return;
+    }
+}
+
+// Runs the steps of every opcode with symbolic registers, memory and flags, from each F value.
+static void derive_semantics(const uint8_t (*table)[CONTROL_ROM_SIZE], OpcodeSemantics (*semantics)[256]) {
+    // A prefetching ROM starts at the first step after the fetch, with ML/MH past the opcode.
+    bool prefetches = signals_from_table(table, 0, 0, OPCODE_JMP_IMM16) != FETCH_OPCODE;
+
+    for (int opcode = 0; opcode < 256; ++opcode) {
+        OpcodeSemantics *result = &(*semantics)[opcode];
+        memset(result, 0, sizeof(*result));
+
+        SemanticsWalk walk = {
+            .table = table,
+            .opcode = (Opcode)opcode,
+            .prefetches = prefetches,
+            .first_path = true,
+            .first_fall_through = true,
+            .result = result,
+        };
+
+        SemanticsState start = {
+            .ls = semantics_any(SEMANTICS_DEP_UNDEFINED),
+            .rs = semantics_any(SEMANTICS_DEP_UNDEFINED),
+            .ml = semantics_value(SEMANTICS_VALUE_PC_L, prefetches, SEMANTICS_DEP_PC),
+            .mh = semantics_value(SEMANTICS_VALUE_PC_H, prefetches, SEMANTICS_DEP_PC),
+        };
+
+        for (uint8_t reg = 0; reg < 16; ++reg) {
+            start.registers[reg] = semantics_value(SEMANTICS_VALUE_INPUT, 0, 1u << reg);
+        }
+
+        for (uint8_t bit = 0; bit < 4; ++bit) {
+            start.f[bit] = semantics_value(SEMANTICS_VALUE_INPUT, 0, SEMANTICS_DEP_FLAG(bit));
+        }
+
+        for (uint8_t flags = 0; flags < 16; ++flags) {
+            start.flags = flags;
+            semantics_walk(&walk, start);
+        }
+
+        if (result->halts && !result->defined) {
+            result->length = 1;
+        }
+    }
+}
+
+// Whether expected, as opcode_semantics.h holds it, says the same as derived from a
+// control ROM. Only the fields the header writes are compared.
+static bool semantics_equal(const OpcodeSemantics *derived, const OpcodeSemantics *expected) {
+    if (!derived->defined || !expected->defined) {
+        return derived->defined == expected->defined;
+    }
+
+    bool equal = derived->length == expected->length &&
+                 derived->min_cycles == expected->min_cycles &&
+                 derived->max_cycles == expected->max_cycles &&
+                 derived->reads == expected->reads &&
+                 derived->writes == expected->writes &&
+                 derived->address_reads == expected->address_reads &&
+                 derived->flags_read == expected->flags_read &&
+                 derived->flags_written == expected->flags_written &&
+                 derived->control_flags_read == expected->control_flags_read &&
+                 derived->effects == expected->effects &&
+                 derived->falls_through == expected->falls_through &&
+                 derived->jumps == expected->jumps &&
+                 derived->jump_deps == expected->jump_deps &&
+                 derived->fall_through_cycles == expected->fall_through_cycles &&
+                 derived->jump_cycles == expected->jump_cycles &&
+                 derived->memory_write_deps == expected->memory_write_deps &&
+                 derived->out_deps == expected->out_deps &&
+                 derived->has_unary_update == expected->has_unary_update;
+
+    for (int reg = 0; reg < 16; ++reg) {
+        equal = equal && derived->register_deps[reg] == expected->register_deps[reg];
+    }
+
+    for (int bit = 0; bit < 4; ++bit) {
+        equal = equal && derived->flag_deps[bit] == expected->flag_deps[bit];
+    }
+
+    return equal && (!derived->has_unary_update ||
+                     (derived->update_reg == expected->update_reg && derived->update_alu_op == expected->update_alu_op));
+}
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef CONTROL_VERIFY_H
+#define CONTROL_VERIFY_H
+
+#include <stdbool.h> // bool
+#include <stdint.h> // uint*_t
+#include <string.h> // memset
+
+#include "control.h"
+
+#define N_STEPS (16)
+
+// Low 6 bits of C when they are not known, at the start of an instruction for example.
+// Any instruction must leave C with IO OE cleared and a constant other than ALU_OP_SET_IO_OE_FLAG.
+#define C_UNKNOWN (64)
+
+typedef enum {
+    VERIFY_OK,
+    VERIFY_BUS_CONFLICT, // More then one is asserting to the data bus
+    VERIFY_UNDRIVEN_BUS, // Something else than MH latches the pulled up bus
+    VERIFY_NO_LD_S, // Never reaches LD_S_NOT_LD_C within 16 steps
+    VERIFY_IO_OE_LEFT_ON, // The next fetch would conflict with the IO port
+} VerifyError;
+
+typedef struct {
+    VerifyError error;
+    uint8_t error_step;
+    uint8_t error_flags;
+
+    bool halts;
+    uint8_t min_steps; // Including the fetch
+    uint8_t max_steps;
+} OpcodeVerification;
+
+static const char *verify_error_string(VerifyError error) {
+    switch (error) {
+    case VERIFY_OK: return "ok";
+    case VERIFY_BUS_CONFLICT: return "more then one is asserting to the data bus";
+    case VERIFY_UNDRIVEN_BUS: return "latches the undriven data bus";
+    case VERIFY_NO_LD_S: return "never loads S within 16 steps";
+    case VERIFY_IO_OE_LEFT_ON: return "leaves the IO port asserting to the data bus";
+    }
+
+    return "unknown";
+}
+
+static uint16_t signals_from_table(const uint8_t (*table)[CONTROL_ROM_SIZE], uint8_t step, uint8_t flags, Opcode opcode) {
+    uint32_t address = (uint32_t)((((step >> 3) & 1) << PIN_STEP_3) |
+                                  (((step >> 2) & 1) << PIN_STEP_2) |
+                                  (((step >> 1) & 1) << PIN_STEP_1) |
+                                  (((step >> 0) & 1) << PIN_STEP_0) |
+                                  (((flags >> 3) & 1) << PIN_FLAG_3_SIGN) |
+                                  (((flags >> 2) & 1) << PIN_FLAG_2_OVERFLOW) |
+                                  (((flags >> 1) & 1) << PIN_FLAG_1_CARRY) |
+                                  (((flags >> 0) & 1) << PIN_FLAG_0_ZERO) |
+                                  opcode);
+
+    uint16_t unmasked_signals = (uint16_t)(((*table)[address | (1 << PIN_HIGH_SLICE)] << 8) | (*table)[address]);
+
+    return unmasked_signals ^ ACTIVE_LOW_MASK;
+}
+
+typedef struct {
+    const uint8_t (*table)[CONTROL_ROM_SIZE];
+    Opcode opcode;
+    bool visited[N_STEPS][16][C_UNKNOWN + 1][2];
+    OpcodeVerification result;
+} VerifyWalk;
+
+// Follows every path through the steps of an opcode. F selects the next step's signals and may be
+// anything after the ALU latched it, so a path forks on every F latch.
+static void verify_walk(VerifyWalk *walk, uint8_t step, uint8_t flags, uint8_t c, bool io_oe) {
+    if (walk->result.error != VERIFY_OK || walk->visited[step][flags][c][io_oe]) {
+        return;
+    }
+
+    walk->visited[step][flags][c][io_oe] = true;
+
+    uint16_t signals = signals_from_table(walk->table, step, flags, walk->opcode);
+
+    bool ld_c = signals & LD_C;
+
+    if (!ld_c && (signals & HALT_NOT_LD_C)) {
+        walk->result.halts = true;
+        return;
+    }
+
+    int n_oe = ((signals & OE_ML) != 0) + ((signals & OE_MH) != 0) + ((signals & OE_ALU) != 0) + ((signals & OE_MEM) != 0) + io_oe;
+
+    // ML and MH latch during the next setup, from the data bus of this step.
+    // MH latching the pulled up 0xff is how the stack page is selected so it is left out.
+    bool reads_bus = (signals & (LD_LS | LD_MEM | LD_ML)) ||
+                     (!ld_c && (signals & (LD_O_NOT_LD_C | LD_RS_NOT_LD_C | LD_IO_NOT_LD_C)));
+
+    VerifyError error = VERIFY_OK;
+
+    if (n_oe > 1) {
+        error = VERIFY_BUS_CONFLICT;
+    } else if (n_oe == 0 && reads_bus) {
+        error = VERIFY_UNDRIVEN_BUS;
+    }
+
+    // C latches during the next setup, IO OE from the ALU op given by the C it replaces.
+    uint8_t next_c = ld_c ? (signals & 0x3f) : c;
+    bool next_io_oe = ld_c ? (c == ALU_OP_SET_IO_OE_FLAG) : io_oe;
+
+    bool ld_s = !ld_c && (signals & LD_S_NOT_LD_C);
+
+    if (error == VERIFY_OK && ld_s && (next_io_oe || next_c == ALU_OP_SET_IO_OE_FLAG)) {
+        error = VERIFY_IO_OE_LEFT_ON;
+    }
+
+    if (error == VERIFY_OK && !ld_s && step == N_STEPS - 1) {
+        error = VERIFY_NO_LD_S;
+    }
+
+    if (error != VERIFY_OK) {
+        walk->result.error = error;
+        walk->result.error_step = step;
+        walk->result.error_flags = flags;
+        return;
+    }
+
+    if (ld_s) {
+        uint8_t n_steps = (uint8_t)(step + 1);
+
+        if (walk->result.min_steps == 0 || n_steps < walk->result.min_steps) {
+            walk->result.min_steps = n_steps;
+        }
+
+        if (n_steps > walk->result.max_steps) {
+            walk->result.max_steps = n_steps;
+        }
+
+        return;
+    }
+
+    if ((signals & (OE_ALU | LD_LS)) == (OE_ALU | LD_LS)) {
+        for (uint8_t next_flags = 0; next_flags < 16; ++next_flags) {
+            verify_walk(walk, (uint8_t)(step + 1), next_flags, next_c, next_io_oe);
+        }
+    } else {
+        verify_walk(walk, (uint8_t)(step + 1), flags, next_c, next_io_oe);
+    }
+}
+
+static OpcodeVerification verify_opcode(const uint8_t (*table)[CONTROL_ROM_SIZE], Opcode opcode) {
+    static VerifyWalk walk;
+
+    memset(&walk, 0, sizeof(walk));
+    walk.table = table;
+    walk.opcode = opcode;
+
+    for (uint8_t flags = 0; flags < 16; ++flags) {
+        verify_walk(&walk, 0, flags, C_UNKNOWN, false);
+    }
+
+    return walk.result;
+}
+
+// Returns the number of opcodes failing verification.
+static int verify_table(const uint8_t (*table)[CONTROL_ROM_SIZE], OpcodeVerification (*verifications)[256]) {
+    int n_errors = 0;
+
+    for (int opcode = 0; opcode < 256; ++opcode) {
+        (*verifications)[opcode] = verify_opcode(table, (Opcode)opcode);
+
+        if ((*verifications)[opcode].error != VERIFY_OK) {
+            ++n_errors;
+        }
+    }
+
+    return n_errors;
+}
+
+#endif
@@ -0,0 +1,367 @@
+// BLEH-1 half cycle engine shared by the emulator and the tools running microcode.
+//
+// The includer defines the hooks declared below. RAM, ROM, IO ports and the
+// control and ALU ROMs are globals, the CPU registers are passed by value.
+#ifndef CPU_H
+#define CPU_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h> // f*
+#include <stdlib.h> // exit
+
+#define CONTROL_ROM_SIZE (1 << 17)
+#define ALU_ROM_SIZE (1 << 17)
+#define ROM_SIZE (1 << 15)
+#define RAM_SIZE (1 << 15)
+
+#define RAM_ABSOLUTE_START_ADDRESS (0x8000)
+
+// Control low signals
+#define SIGNAL_C0_OR_CE_M(signals) (((signals) >> 0) & 1)
+#define SIGNAL_C1_OR_LD_O(signals) (((signals) >> 1) & 1)
+#define SIGNAL_C2_OR_LD_S(signals) (((signals) >> 2) & 1)
+#define SIGNAL_C3_OR_LD_RS(signals) (((signals) >> 3) & 1)
+#define SIGNAL_C4_ALU_OP4_OR_LD_IO(signals) (((signals) >> 4) & 1)
+#define SIGNAL_C5_LS_ALU_Q_OR_HALT_C(signals) (((signals) >> 5) & 1)
+#define SIGNAL_LD_C(signals) (((signals) >> 6) & 1)
+#define SIGNAL_TOGGLE_M_C(signals) (((signals) >> 7) & 1)
+
+// Control high signals
+#define SIGNAL_LD_MEM(signals) (((signals) >> 8) & 1)
+#define SIGNAL_LD_LS(signals) (((signals) >> 9) & 1)
+#define SIGNAL_LD_ML(signals) (((signals) >> 10) & 1)
+#define SIGNAL_LD_MH(signals) (((signals) >> 11) & 1)
+#define SIGNAL_OE_ML(signals) (((signals) >> 12) & 1)
+#define SIGNAL_OE_MH(signals) (((signals) >> 13) & 1)
+#define SIGNAL_OE_ALU(signals) (((signals) >> 14) & 1)
+#define SIGNAL_OE_MEM(signals) (((signals) >> 15) & 1)
+
+// Combined NAND signals
+#define SIGNAL_LD_O(signals) (~(SIGNAL_C1_OR_LD_O(signals) & SIGNAL_LD_C(signals)) & 1)
+#define SIGNAL_LD_S(signals) (~(SIGNAL_C2_OR_LD_S(signals) & SIGNAL_LD_C(signals)) & 1)
+#define SIGNAL_LD_RS(signals) (~(SIGNAL_C3_OR_LD_RS(signals) & SIGNAL_LD_C(signals)) & 1)
+#define SIGNAL_LD_IO(signals) (~(SIGNAL_C4_ALU_OP4_OR_LD_IO(signals) & SIGNAL_LD_C(signals)) & 1)
+#define SIGNAL_HALT(signals) (~(SIGNAL_C5_LS_ALU_Q_OR_HALT_C(signals) & SIGNAL_LD_C(signals)) & 1)
+#define SIGNAL_LD_RS(signals) (~(SIGNAL_C3_OR_LD_RS(signals) & SIGNAL_LD_C(signals)) & 1)
+#define SIGNAL_LD_IO(signals) (~(SIGNAL_C4_ALU_OP4_OR_LD_IO(signals) & SIGNAL_LD_C(signals)) & 1)
+#define SIGNAL_HALT(signals) (~(SIGNAL_C5_LS_ALU_Q_OR_HALT_C(signals) & SIGNAL_LD_C(signals)) & 1)
+
+// Combined NAND and C signals
+#define SIGNAL_C_LD_MEM(signals, c_exec) (~(SIGNAL_LD_MEM(signals) & c_exec) & 1)
+
+// ALU low signals
+#define ALU_SIGNAL_L_QZ(alu_signals) (((alu_signals) >> 0) & 1)
+#define ALU_SIGNAL_L_QC(alu_signals) (((alu_signals) >> 1) & 1)
+#define ALU_SIGNAL_Q_ZF(alu_signals) (((alu_signals) >> 2) & 1)
+#define ALU_SIGNAL_Q_IO_OE(alu_signals) (((alu_signals) >> 3) & 1)
+
+// ALU high signals
+#define ALU_SIGNAL_H_QZ(alu_signals) (((alu_signals) >> 8) & 1)
+#define ALU_SIGNAL_H_QC(alu_signals) (((alu_signals) >> 9) & 1)
+#define ALU_SIGNAL_Q_CF(alu_signals) (((alu_signals) >> 10) & 1)
+#define ALU_SIGNAL_Q_OF(alu_signals) (((alu_signals) >> 11) & 1)
+
+// ALU combined signals
+#define ALU_SIGNAL_Q(alu_signals) ((((alu_signals) >> 8) & 0xf0) | ((alu_signals) >> 4) & 0x0f)
+#define ALU_SIGNAL_Q_SF(alu_signals) ((ALU_SIGNAL_Q(alu_signals) >> 7) & 1)
+
+// C signals
+#define C_OE_IO(c_q) (((c_q) >> 6) & 1) // Active high
+
+// Based on address bus signals
+#define SIGNAL_EN_ROM(address_bus) (((address_bus) >> 15) & 1)
+#define SIGNAL_EN_RAM(address_bus) (~SIGNAL_EN_ROM(address_bus) & 1)
+
+#define F_ZF(r_f) (((r_f) >> 0) & 1)
+#define F_CF(r_f) (((r_f) >> 1) & 1)
+#define F_OF(r_f) (((r_f) >> 2) & 1)
+#define F_SF(r_f) (((r_f) >> 3) & 1)
+
+#define S_Q0(r_s) (((r_s) >> 0) & 1)
+#define S_Q1(r_s) (((r_s) >> 1) & 1)
+#define S_Q2(r_s) (((r_s) >> 2) & 1)
+#define S_Q3(r_s) (((r_s) >> 3) & 1)
+
+typedef struct {
+    bool c_exec; // 1 bit
+
+    uint8_t r_s; // 4 bit
+    uint8_t r_o;
+    uint8_t r_f; // 4 bit
+    uint8_t r_ls;
+    uint8_t r_rs;
+    uint8_t r_c;
+    uint8_t r_ml;
+    uint8_t r_mh;
+    bool r_sel_m_or_c; // 1 bit, m when low
+
+    uint16_t control_signals;
+    uint16_t alu_signals;
+
+    uint16_t address_bus;
+    uint8_t data_bus;
+} CPU;
+
+static uint8_t control_rom[CONTROL_ROM_SIZE];
+static uint8_t alu_low_rom[ALU_ROM_SIZE];
+static uint8_t alu_high_rom[ALU_ROM_SIZE];
+
+static uint8_t rom[ROM_SIZE];
+static uint8_t ram[RAM_SIZE];
+static uint8_t io_ports[8];
+
+// Hooks
+static void update_io_ld(CPU cpu); // After latching io_ports[r_o & 7]
+static uint8_t update_io_oe(CPU cpu); // Value of the IO port asserting to the data bus
+static void update_ram_ld(uint16_t ram_address); // Before latching ram[ram_address]
+// Define CPU_CONTROL_ROM_VERIFIED before including when the control ROM passed
+// verify_table, which rules conflicts out, to leave the check out of every half cycle.
+#ifndef CPU_CONTROL_ROM_VERIFIED
+static void update_bus_conflict(CPU cpu, int n_oe); // More then one is asserting to the data bus
+#endif
+
+static void read_rom(const char *filename, uint8_t *rom_data, size_t rom_size) {
+    FILE *file = fopen(filename, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Failed to read %s\n", filename);
+        exit(1);
+    }
+
+    size_t read_bytes = fread(rom_data, sizeof(uint8_t), rom_size, file);
+    if (read_bytes != rom_size) {
+        fprintf(stderr, "Failed to read the entire contents of %s\n", filename);
+        exit(1);
+    }
+
+    assert(fclose(file) == 0 && "Failed to close file");
+}
+
+static uint16_t alu_signals(CPU cpu) {
+    uint8_t c_q0 = (cpu.r_c >> 0) & 1;
+    uint8_t c_q1 = (cpu.r_c >> 1) & 1;
+    uint8_t c_q2 = (cpu.r_c >> 2) & 1;
+    uint8_t c_q3 = (cpu.r_c >> 3) & 1;
+    uint8_t c_q4 = (cpu.r_c >> 4) & 1;
+    uint8_t c_q5 = (cpu.r_c >> 5) & 1;
+
+    uint8_t alu_l_qz = ALU_SIGNAL_L_QZ(cpu.alu_signals);
+    uint8_t alu_l_qc = ALU_SIGNAL_L_QC(cpu.alu_signals);
+
+    uint8_t alu_h_qz = ALU_SIGNAL_H_QZ(cpu.alu_signals);
+    uint8_t alu_h_qc = ALU_SIGNAL_H_QC(cpu.alu_signals);
+
+    for (int i = 0; i < 5; ++i) {
+        uint32_t alu_l_address = (uint32_t)((c_q5 << 16) | (alu_h_qc << 15) | (c_q4 << 14) | (c_q3 << 13) | (alu_h_qz << 12) | (c_q2 << 11) | (c_q1 << 10) | (c_q0 << 9) | (F_CF(cpu.r_f) << 8) | ((cpu.r_rs & 0xf) << 4) | (cpu.r_ls & 0xf));
+        uint32_t alu_h_address = (uint32_t)((c_q5 << 16) | (alu_l_qc << 15) | (c_q4 << 14) | (c_q3 << 13) | (alu_l_qz << 12) | (c_q2 << 11) | (c_q1 << 10) | (c_q0 << 9) | (F_CF(cpu.r_f) << 8) | ((cpu.r_rs >> 4) << 4) | (cpu.r_ls >> 4));
+
+        uint16_t alu_signals = (uint16_t)(alu_high_rom[alu_h_address] << 8) | alu_low_rom[alu_l_address];
+
+        uint8_t alu_l_q0_alu_l_qz = ALU_SIGNAL_L_QZ(alu_signals);
+        uint8_t alu_l_q1_alu_l_qc = ALU_SIGNAL_L_QC(alu_signals);
+
+        uint8_t alu_h_q0_alu_h_qz = ALU_SIGNAL_H_QZ(alu_signals);
+        uint8_t alu_h_q1_alu_h_qc = ALU_SIGNAL_H_QC(alu_signals);
+
+        if (alu_l_qz == alu_l_q0_alu_l_qz && alu_l_qc == alu_l_q1_alu_l_qc &&
+            alu_h_qz == alu_h_q0_alu_h_qz && alu_h_qc == alu_h_q1_alu_h_qc) {
+            // The carries ripple from one half to the other and back at most once.
+            assert(i <= 2 && "ALU signals took more than three passes to settle");
+
+            return alu_signals;
+        }
+
+        alu_l_qz = alu_l_q0_alu_l_qz;
+        alu_l_qc = alu_l_q1_alu_l_qc;
+
+        alu_h_qz = alu_h_q0_alu_h_qz;
+        alu_h_qc = alu_h_q1_alu_h_qc;
+    }
+
+    assert(0 && "ALU signals never settled");
+}
+
+// Runs the setup or exec half of a clock cycle, whichever is next.
+static CPU cpu_half_cycle(CPU cpu) {
+    cpu.c_exec = (!cpu.c_exec) & 1;
+
+    if (!cpu.c_exec) { // C SETUP (~C EXEC)
+        // Count S
+        if (++cpu.r_s >= 0x10) {
+            cpu.r_s = 0;
+        }
+
+        // Latch S
+        if (!SIGNAL_LD_S(cpu.control_signals)) {
+            cpu.r_s = 0x0;
+        }
+
+        // Latch C
+        if (!SIGNAL_LD_C(cpu.control_signals)) {
+            cpu.r_c = (uint8_t)((1 << 7) |
+                                (ALU_SIGNAL_Q_IO_OE(cpu.alu_signals) << 6) |
+                                (SIGNAL_C5_LS_ALU_Q_OR_HALT_C(cpu.control_signals) << 5) |
+                                (SIGNAL_C4_ALU_OP4_OR_LD_IO(cpu.control_signals) << 4) |
+                                (SIGNAL_C3_OR_LD_RS(cpu.control_signals) << 3) |
+                                (SIGNAL_C2_OR_LD_S(cpu.control_signals) << 2) |
+                                (SIGNAL_C1_OR_LD_O(cpu.control_signals) << 1) |
+                                (SIGNAL_C0_OR_CE_M(cpu.control_signals) << 0));
+
+            cpu.alu_signals = alu_signals(cpu);
+        }
+
+        // Count ML/MH
+        if (SIGNAL_LD_C(cpu.control_signals) && SIGNAL_C0_OR_CE_M(cpu.control_signals) && SIGNAL_LD_ML(cpu.control_signals)) {
+            // TODO: Understand why ++cpu.r_ml gives "runtime error: implicit conversion from type 'int' of value 256 (32-bit, signed) to type 'uint8_t' (aka 'unsigned char') changed the value to 0 (8-bit, unsigned)"
+            cpu.r_ml = (u_int8_t)(cpu.r_ml + 1);
+            if (cpu.r_ml == 0 && SIGNAL_LD_MH(cpu.control_signals)) {
+                ++cpu.r_mh;
+            }
+        }
+
+        // Latch ML
+        if (!SIGNAL_LD_ML(cpu.control_signals)) {
+            cpu.r_ml = cpu.data_bus;
+        }
+
+        // Latch MH
+        if (!SIGNAL_LD_MH(cpu.control_signals)) {
+            cpu.r_mh = cpu.data_bus;
+        }
+
+        // Toggle SEL ~M/C
+        if (SIGNAL_TOGGLE_M_C(cpu.control_signals)) {
+            cpu.r_sel_m_or_c = (!cpu.r_sel_m_or_c) & 1;
+        }
+
+        uint32_t control_l_address = (uint32_t)((S_Q2(cpu.r_s) << 16) |
+                                                (S_Q1(cpu.r_s) << 15) |
+                                                (S_Q3(cpu.r_s) << 14) |
+                                                (F_SF(cpu.r_f) << 13) |
+                                                (S_Q0(cpu.r_s) << 12) |
+                                                (F_ZF(cpu.r_f) << 11) |
+                                                (0 << 10) |
+                                                (F_CF(cpu.r_f) << 9) |
+                                                (F_OF(cpu.r_f) << 8) |
+                                                cpu.r_o);
+
+        uint32_t control_h_address = (uint32_t)((S_Q2(cpu.r_s) << 16) |
+                                                (S_Q1(cpu.r_s) << 15) |
+                                                (S_Q3(cpu.r_s) << 14) |
+                                                (F_SF(cpu.r_f) << 13) |
+                                                (S_Q0(cpu.r_s) << 12) |
+                                                (F_ZF(cpu.r_f) << 11) |
+                                                (1 << 10) | (F_CF(cpu.r_f) << 9) |
+                                                (F_OF(cpu.r_f) << 8) |
+                                                cpu.r_o);
+
+        cpu.control_signals = (uint16_t)(control_rom[control_h_address] << 8) |
+                              control_rom[control_l_address];
+
+        cpu.address_bus = cpu.r_sel_m_or_c
+                              ? (0xfff0 | (cpu.r_c & 0xf))
+                              : (uint16_t)(cpu.r_mh << 8) | cpu.r_ml;
+
+        int n_oe = 0;
+
+        // Assert ML to data bus
+        if (!SIGNAL_OE_ML(cpu.control_signals)) {
+            cpu.data_bus = cpu.r_ml;
+            ++n_oe;
+        }
+
+        // Assert MH to data bus
+        if (!SIGNAL_OE_MH(cpu.control_signals)) {
+            cpu.data_bus = cpu.r_mh;
+            ++n_oe;
+        }
+
+        // Assert ALU to data bus
+        if (!SIGNAL_OE_ALU(cpu.control_signals)) {
+            cpu.data_bus = ALU_SIGNAL_Q(cpu.alu_signals);
+            ++n_oe;
+        }
+
+        // Assert MEM to data bus
+        if (!SIGNAL_OE_MEM(cpu.control_signals)) {
+            if (!SIGNAL_EN_ROM(cpu.address_bus)) {
+                cpu.data_bus = rom[cpu.address_bus & (RAM_ABSOLUTE_START_ADDRESS - 1)];
+                ++n_oe;
+            }
+
+            if (!SIGNAL_EN_RAM(cpu.address_bus)) {
+                cpu.data_bus = ram[cpu.address_bus & (RAM_ABSOLUTE_START_ADDRESS - 1)];
+                ++n_oe;
+            }
+        }
+
+        if (C_OE_IO(cpu.r_c)) {
+            cpu.data_bus = update_io_oe(cpu);
+            ++n_oe;
+        }
+
+        if (n_oe == 0) {
+            cpu.data_bus = 0xff; // Data bus is pulled up
+        }
+
+#ifndef CPU_CONTROL_ROM_VERIFIED
+        if (n_oe > 1) {
+            update_bus_conflict(cpu, n_oe);
+        }
+#endif
+    } else { // C EXEC
+        bool update_alu_signals = false;
+
+        // Latch O
+        if (!SIGNAL_LD_O(cpu.control_signals)) {
+            cpu.r_o = cpu.data_bus;
+        }
+
+        // Latch RS
+        if (!SIGNAL_LD_RS(cpu.control_signals)) {
+            cpu.r_rs = cpu.data_bus;
+
+            update_alu_signals = true;
+        }
+
+        // Latch LS
+        if (!SIGNAL_LD_LS(cpu.control_signals)) {
+            cpu.r_ls = cpu.data_bus;
+
+            update_alu_signals = true;
+        }
+
+        // Latch RAM (ROM is read only :))
+        if (!SIGNAL_C_LD_MEM(cpu.control_signals, cpu.c_exec) && !SIGNAL_EN_RAM(cpu.address_bus)) {
+            update_ram_ld(cpu.address_bus & (RAM_ABSOLUTE_START_ADDRESS - 1));
+
+            ram[cpu.address_bus & (RAM_ABSOLUTE_START_ADDRESS - 1)] = cpu.data_bus;
+        }
+
+        // Latch F
+        if (!SIGNAL_OE_ALU(cpu.control_signals) && !SIGNAL_LD_LS(cpu.control_signals)) {
+            cpu.r_f = (uint8_t)((ALU_SIGNAL_Q_SF(cpu.alu_signals) << 3) |
+                                (ALU_SIGNAL_Q_OF(cpu.alu_signals) << 2) |
+                                (ALU_SIGNAL_Q_CF(cpu.alu_signals) << 1) |
+                                (ALU_SIGNAL_Q_ZF(cpu.alu_signals) << 0));
+
+            update_alu_signals = true;
+        }
+
+        // Latch IO
+        if (!SIGNAL_LD_IO(cpu.control_signals)) {
+            io_ports[cpu.r_o & 7] = cpu.data_bus;
+
+            update_io_ld(cpu);
+        }
+
+        if (update_alu_signals) {
+            cpu.alu_signals = alu_signals(cpu);
+        }
+    }
+
+    return cpu;
+}
+
+#endif
@@ -0,0 +1,1339 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h> // f*, printf, snprintf
+#include <stdlib.h> // exit, strtoul
+#include <string.h> // memset, strlen
+
+#include "assembler.h"
+#include "control.h"
+#include "control_semantics.h"
+#include "opcode_rule.h"
+
+// Disassembler with static timing, decodes a program by following its jumps and calls from
+// the origin, splits it into basic blocks and functions and annotates every instruction with
+// its cycles from the control ROM.
+//
+// The worst case of a function is the longest path through its blocks after collapsing its
+// loops innermost first. A loop runs at most N times when every edge back to its header is a
+// counter, `djnz r` or `dec r`/`inc r` followed by `jnz`, that nothing else in the loop writes.
+// N is the product of the counter bounds, from the `ld r, imm8` every entry into the loop does
+// for counters that leave the loop when done and 256 for the others. Other loops, recursion and
+// jumps to addresses it can't tell are unbounded, their repetitions are left out of the sum.
+
+#define ADDRESS_SPACE (0x10000)
+#define MAX_BLOCKS (0x8000)
+#define MAX_FUNCTIONS (1024)
+#define MAX_POOL (1 << 18) // Function blocks and callees, loop bodies and collapsed loop exits
+#define MAX_LINKED_STEPS (16) // Instructions looked back for the value of i or j at `jmp i` and `jmp j`
+
+#define DEFAULT_ORIGIN (0x8000)
+
+#define FLAG_START (1 << 0) // First byte of an instruction
+#define FLAG_LEADER (1 << 1) // First instruction of a block
+#define FLAG_JUMPED_TO (1 << 2)
+#define FLAG_CALLED (1 << 3)
+
+#define SINK (-1) // Edge leaving the function
+
+typedef enum {
+    INSN_NEXT, // Continues at the next instruction
+    INSN_BRANCH, // Jumps to `target` or continues at the next instruction
+    INSN_JUMP, // Jumps to `target`
+    INSN_CALL, // Calls `target`, `call` or `ld j, next` and `jmp` returning through j
+    INSN_RETURN, // `ret`, or `jmp i`/`jmp j` to where the caller loaded i or j with
+    INSN_INDIRECT, // Jumps somewhere it can't tell
+    INSN_HALT,
+    INSN_UNDEFINED, // Undefined opcode or operands past the end of the program
+} InsnKind;
+
+typedef struct {
+    uint8_t opcode;
+    int length;
+    InsnKind kind;
+    uint16_t target;
+} Insn;
+
+typedef struct {
+    uint16_t start;
+    uint16_t last; // Address of the last instruction
+    int n_insns;
+    int cycles; // Of its instructions, callees left out
+    int n_succs;
+    int succs[2];
+    bool succ_taken[2]; // Reached by jumping, cycles of the last instruction differ
+    bool exits; // Leaves the function after the last instruction
+    bool exit_known; // Returns, halts or leaves the program, rather than jumping somewhere unknown
+} Block;
+
+typedef enum {
+    FUNCTION_UNVISITED,
+    FUNCTION_VISITING,
+    FUNCTION_DONE,
+} FunctionState;
+
+typedef struct {
+    uint16_t entry;
+    int first_block; // Into `pool`
+    int n_blocks;
+    int first_callee; // Into `pool`
+    int n_callees;
+
+    FunctionState state;
+    bool bounded;
+    bool recursive;
+    bool returns; // Some path leaves the function
+    uint64_t cycles;
+    uint16_t writes; // Registers written, callees included
+    int n_unbounded_loops;
+} Function;
+
+typedef struct {
+    int to; // Local block index or SINK
+    uint64_t cycles; // From entering the node until entering `to`
+} Edge;
+
+typedef struct {
+    int header; // Local block index
+    int first_body; // Into `loop_bodies`
+    int n_body;
+} Loop;
+
+typedef struct {
+    uint16_t header; // Address
+    bool bounded;
+    uint64_t iterations;
+    uint64_t iteration_cycles; // Most cycles of one trip round the loop
+} LoopReport;
+
+static OpcodeSemantics semantics[256];
+
+static uint8_t image[ADDRESS_SPACE];
+static uint32_t origin;
+static uint32_t image_end;
+
+static uint8_t flags[ADDRESS_SPACE];
+static int32_t prev_insn[ADDRESS_SPACE]; // Instruction falling through into the address, -1 if none
+static int32_t block_at[ADDRESS_SPACE];
+static int32_t function_at[ADDRESS_SPACE];
+static int32_t loop_report_at[ADDRESS_SPACE];
+
+static Block blocks[MAX_BLOCKS];
+static int n_blocks;
+
+static Function functions[MAX_FUNCTIONS];
+static int n_functions;
+
+static int pool[MAX_POOL];
+static int n_pool;
+
+static LoopReport loop_reports[MAX_BLOCKS];
+static int n_loop_reports;
+
+// Scratch of the function being analyzed, indexed by local block index.
+static int local_of[MAX_BLOCKS];
+static int local_blocks[MAX_BLOCKS];
+static int rpo_number[MAX_BLOCKS];
+static int rpo_order[MAX_BLOCKS];
+static int idom[MAX_BLOCKS];
+static int rep[MAX_BLOCKS]; // Header of the outermost collapsed loop containing the block, or itself
+static int first_edge[MAX_BLOCKS];
+static int n_edges[MAX_BLOCKS];
+static Edge edges[MAX_POOL];
+static int n_edges_total;
+static Loop loops[MAX_BLOCKS];
+static int loop_bodies[MAX_POOL];
+static int n_loop_bodies;
+static uint64_t dist[MAX_BLOCKS];
+static bool reached[MAX_BLOCKS];
+static int in_loop[MAX_BLOCKS]; // Loop index + 1 of the loop being collapsed, 0 otherwise
+
+static int stack[2 * ADDRESS_SPACE];
+
+static bool in_program(uint32_t address) {
+    return address >= origin && address < image_end;
+}
+
+static uint16_t imm16_at(uint16_t pc) {
+    return (uint16_t)(image[(uint16_t)(pc + 1)] | (image[(uint16_t)(pc + 2)] << 8));
+}
+
+static bool is_ld_imm16(uint8_t opcode, uint16_t pair) {
+    const OpcodeSemantics *s = &semantics[opcode];
+    int low = pair == C_IL ? C_IL : C_JL;
+
+    return s->defined && !s->jumps && s->falls_through && s->length == 3 &&
+           s->writes == ((1 << low) | (1 << (low + 1))) &&
+           s->register_deps[low] == SEMANTICS_DEP_OPERAND_0 && s->register_deps[low + 1] == SEMANTICS_DEP_OPERAND_1;
+}
+
+static bool is_ld_imm8(uint8_t opcode, int reg) {
+    const OpcodeSemantics *s = &semantics[opcode];
+
+    return s->defined && !s->jumps && s->length == 2 && s->writes == (1 << reg) &&
+           s->register_deps[reg] == SEMANTICS_DEP_OPERAND_0;
+}
+
+// Where `jmp i` or `jmp j` at `pc` goes, from an `ld i, imm16` or `ld j, imm16` falling into it.
+static InsnKind resolve_register_jump(uint16_t pc, int low, uint16_t *target) {
+    int32_t at = prev_insn[pc];
+
+    for (int step = 0; step < MAX_LINKED_STEPS && at >= 0; ++step) {
+        uint8_t opcode = image[at];
+        const OpcodeSemantics *s = &semantics[opcode];
+
+        if (is_ld_imm16(opcode, (uint16_t)low)) {
+            *target = imm16_at((uint16_t)at);
+            return INSN_JUMP;
+        }
+
+        if (s->writes & ((1 << low) | (1 << (low + 1)))) {
+            return INSN_INDIRECT;
+        }
+
+        if (s->jumps) {
+            break; // A call, the callee might have loaded it
+        }
+
+        at = prev_insn[at];
+    }
+
+    return INSN_RETURN;
+}
+
+static Insn decode(uint16_t pc) {
+    uint8_t opcode = image[pc];
+    const OpcodeSemantics *s = &semantics[opcode];
+    Insn insn = {.opcode = opcode, .length = s->length > 0 ? s->length : 1, .kind = INSN_NEXT};
+
+    if (!s->defined) {
+        insn.kind = opcode == OPCODE_HALT ? INSN_HALT : INSN_UNDEFINED;
+        return insn;
+    }
+
+    if (!in_program((uint32_t)pc + (uint32_t)insn.length - 1)) {
+        insn.kind = INSN_UNDEFINED;
+        return insn;
+    }
+
+    if (!s->jumps) {
+        return insn;
+    }
+
+    if (s->jump_deps == (SEMANTICS_DEP_OPERAND_0 | SEMANTICS_DEP_OPERAND_1)) {
+        insn.target = imm16_at(pc);
+        insn.kind = s->effects & SEMANTICS_STACK_WRITE ? INSN_CALL
+                    : s->falls_through                 ? INSN_BRANCH
+                                                       : INSN_JUMP;
+
+        // `ld j, .next` then `jmp subroutine` returning with `jmp j` works like a call.
+        int32_t prev = prev_insn[pc];
+        uint16_t next = (uint16_t)(pc + insn.length);
+
+        if (insn.kind == INSN_JUMP && prev >= 0 && imm16_at((uint16_t)prev) == next &&
+            (is_ld_imm16(image[prev], C_IL) || is_ld_imm16(image[prev], C_JL))) {
+            insn.kind = INSN_CALL;
+        }
+    } else if ((s->effects & SEMANTICS_STACK_READ) && (s->jump_deps & SEMANTICS_DEP_MEMORY)) {
+        insn.kind = INSN_RETURN;
+    } else if (s->jump_deps == ((1u << C_IL) | (1u << C_IH))) {
+        insn.kind = resolve_register_jump(pc, C_IL, &insn.target);
+    } else if (s->jump_deps == ((1u << C_JL) | (1u << C_JH))) {
+        insn.kind = resolve_register_jump(pc, C_JL, &insn.target);
+    } else {
+        insn.kind = INSN_INDIRECT;
+    }
+
+    return insn;
+}
+
+static bool insn_continues(const Insn *insn) {
+    return insn->kind == INSN_NEXT || insn->kind == INSN_BRANCH || insn->kind == INSN_CALL;
+}
+
+static bool insn_has_target(const Insn *insn) {
+    return insn->kind == INSN_BRANCH || insn->kind == INSN_JUMP || insn->kind == INSN_CALL;
+}
+
+// Follows every path from the origin, returns the number of instructions found.
+static int traverse(void) {
+    memset(flags, 0, sizeof(flags));
+
+    int n_insns = 0;
+    int n_stack = 0;
+
+    if (in_program(origin)) {
+        stack[n_stack++] = (int)origin;
+        flags[origin] |= FLAG_LEADER | FLAG_CALLED;
+    }
+
+    while (n_stack > 0) {
+        uint16_t pc = (uint16_t)stack[--n_stack];
+
+        if (flags[pc] & FLAG_START) {
+            continue;
+        }
+
+        flags[pc] |= FLAG_START;
+        ++n_insns;
+
+        Insn insn = decode(pc);
+        uint32_t next = (uint32_t)pc + (uint32_t)insn.length;
+
+        if (insn_has_target(&insn) && in_program(insn.target)) {
+            flags[insn.target] |= FLAG_LEADER | (insn.kind == INSN_CALL ? FLAG_CALLED : FLAG_JUMPED_TO);
+            stack[n_stack++] = insn.target;
+        }
+
+        if (insn_continues(&insn) && in_program(next)) {
+            prev_insn[next] = pc;
+            stack[n_stack++] = (int)next;
+        }
+
+        if (!insn_continues(&insn) || insn.kind == INSN_BRANCH) {
+            if (in_program(next)) {
+                flags[next] |= FLAG_LEADER;
+            }
+        }
+    }
+
+    return n_insns;
+}
+
+static void build_blocks(void) {
+    for (uint32_t pc = origin; pc < image_end; ++pc) {
+        block_at[pc] = -1;
+    }
+
+    n_blocks = 0;
+
+    for (uint32_t pc = origin; pc < image_end; ++pc) {
+        if (!(flags[pc] & FLAG_START) || !(flags[pc] & FLAG_LEADER)) {
+            continue;
+        }
+
+        if (n_blocks == MAX_BLOCKS) {
+            fprintf(stderr, "More than %d blocks\n", MAX_BLOCKS);
+            exit(1);
+        }
+
+        Block *b = &blocks[n_blocks];
+        *b = (Block){.start = (uint16_t)pc};
+        block_at[pc] = n_blocks++;
+
+        uint32_t at = pc;
+
+        for (;;) {
+            Insn insn = decode((uint16_t)at);
+            uint32_t next = at + (uint32_t)insn.length;
+
+            b->last = (uint16_t)at;
+            b->cycles += semantics[insn.opcode].max_cycles;
+            ++b->n_insns;
+
+            if (insn.kind != INSN_NEXT && insn.kind != INSN_CALL) {
+                break;
+            }
+
+            if (!in_program(next) || !(flags[next] & FLAG_START) || (flags[next] & FLAG_LEADER)) {
+                break;
+            }
+
+            at = next;
+        }
+    }
+
+    // Successors once every block has its index.
+    for (int i = 0; i < n_blocks; ++i) {
+        Block *b = &blocks[i];
+        Insn insn = decode(b->last);
+        uint32_t next = (uint32_t)b->last + (uint32_t)insn.length;
+
+        if (insn_continues(&insn)) {
+            if (in_program(next) && block_at[next] >= 0) {
+                b->succ_taken[b->n_succs] = false;
+                b->succs[b->n_succs++] = block_at[next];
+            } else {
+                b->exits = true; // Runs off the end of the program
+            }
+        }
+
+        if (insn.kind == INSN_BRANCH || insn.kind == INSN_JUMP) {
+            if (in_program(insn.target)) {
+                b->succ_taken[b->n_succs] = true;
+                b->succs[b->n_succs++] = block_at[insn.target];
+            } else {
+                b->exits = true;
+                b->exit_known = true; // Into code loaded elsewhere, like the boot ROM jumping to RAM
+            }
+        }
+
+        if (insn.kind == INSN_RETURN || insn.kind == INSN_HALT) {
+            b->exits = true;
+            b->exit_known = true;
+        } else if (insn.kind == INSN_INDIRECT || insn.kind == INSN_UNDEFINED) {
+            b->exits = true;
+        }
+    }
+}
+
+static void add_function(uint16_t entry) {
+    if (function_at[entry] >= 0) {
+        return;
+    }
+
+    if (n_functions == MAX_FUNCTIONS) {
+        fprintf(stderr, "More than %d functions\n", MAX_FUNCTIONS);
+        exit(1);
+    }
+
+    function_at[entry] = n_functions;
+    functions[n_functions++] = (Function){.entry = entry};
+}
+
+static void pool_push(int value) {
+    if (n_pool == MAX_POOL) {
+        fprintf(stderr, "Program too big to analyze\n");
+        exit(1);
+    }
+
+    pool[n_pool++] = value;
+}
+
+// Blocks reachable from the entry without following calls, and the functions they call.
+static void build_functions(void) {
+    for (int i = 0; i < ADDRESS_SPACE; ++i) {
+        function_at[i] = -1;
+    }
+
+    n_functions = 0;
+    n_pool = 0;
+
+    for (uint32_t pc = origin; pc < image_end; ++pc) {
+        if ((flags[pc] & FLAG_START) && (flags[pc] & FLAG_CALLED)) {
+            add_function((uint16_t)pc);
+        }
+    }
+
+    for (int f = 0; f < n_functions; ++f) {
+        Function *function = &functions[f];
+        int n_stack = 0;
+
+        function->first_block = n_pool;
+        stack[n_stack++] = block_at[function->entry];
+        local_of[block_at[function->entry]] = f + 1;
+
+        while (n_stack > 0) {
+            int b = stack[--n_stack];
+            pool_push(b);
+
+            for (int s = 0; s < blocks[b].n_succs; ++s) {
+                int succ = blocks[b].succs[s];
+
+                if (local_of[succ] != f + 1) {
+                    local_of[succ] = f + 1;
+                    stack[n_stack++] = succ;
+                }
+            }
+        }
+
+        function->n_blocks = n_pool - function->first_block;
+        function->first_callee = n_pool;
+
+        for (int i = 0; i < function->n_blocks; ++i) {
+            const Block *b = &blocks[pool[function->first_block + i]];
+            uint32_t at = b->start;
+
+            for (int n = 0; n < b->n_insns; ++n) {
+                Insn insn = decode((uint16_t)at);
+
+                if (insn.kind == INSN_CALL && in_program(insn.target)) {
+                    int callee = function_at[insn.target];
+                    bool known = false;
+
+                    for (int c = function->first_callee; c < n_pool; ++c) {
+                        known |= pool[c] == callee;
+                    }
+
+                    if (!known) {
+                        pool_push(callee);
+                    }
+                }
+
+                at += (uint32_t)insn.length;
+            }
+        }
+
+        function->n_callees = n_pool - function->first_callee;
+    }
+
+    memset(local_of, 0, sizeof(local_of));
+}
+
+// Cycles from entering block `b` until entering its successor `s`, or leaving the function when
+// `s` is SINK. Callees are included, unbounded ones clear `bounded`.
+static uint64_t block_edge_cycles(int b, int s, bool *bounded) {
+    const Block *block = &blocks[b];
+    uint64_t cycles = 0;
+    uint32_t at = block->start;
+
+    for (int n = 0; n < block->n_insns; ++n) {
+        Insn insn = decode((uint16_t)at);
+        const OpcodeSemantics *sem = &semantics[insn.opcode];
+
+        if (n < block->n_insns - 1) {
+            cycles += sem->max_cycles;
+        } else if (s == SINK || insn.kind == INSN_CALL) {
+            cycles += sem->max_cycles;
+        } else {
+            cycles += block->succ_taken[s] ? sem->jump_cycles : sem->fall_through_cycles;
+        }
+
+        if (insn.kind == INSN_CALL && in_program(insn.target)) {
+            const Function *callee = &functions[function_at[insn.target]];
+
+            if (callee->state != FUNCTION_DONE) {
+                *bounded = false; // Recursion
+            } else {
+                *bounded &= callee->bounded;
+                cycles += callee->cycles;
+            }
+        }
+
+        at += (uint32_t)insn.length;
+    }
+
+    return cycles;
+}
+
+static void add_edge(int to, uint64_t cycles) {
+    if (n_edges_total == MAX_POOL) {
+        fprintf(stderr, "Program too big to analyze\n");
+        exit(1);
+    }
+
+    edges[n_edges_total++] = (Edge){.to = to, .cycles = cycles};
+}
+
+static int intersect_dominators(int a, int b) {
+    while (a != b) {
+        while (rpo_number[a] > rpo_number[b]) a = idom[a];
+        while (rpo_number[b] > rpo_number[a]) b = idom[b];
+    }
+
+    return a;
+}
+
+static bool dominates(int a, int b) {
+    for (;;) {
+        if (a == b) return true;
+        if (b == 0) return false;
+        b = idom[b];
+    }
+}
+
+// Depth first over the local blocks, numbers them in reverse post order and tells whether every
+// edge back to a block still being visited goes to one dominating it.
+static void number_blocks(int n) {
+    static int edge_index[MAX_BLOCKS];
+    static int state[MAX_BLOCKS]; // 0 unvisited, 1 on the stack, 2 done
+    int n_stack = 0;
+    int n_post = 0;
+
+    for (int i = 0; i < n; ++i) {
+        state[i] = 0;
+        edge_index[i] = 0;
+    }
+
+    stack[n_stack++] = 0;
+    state[0] = 1;
+
+    while (n_stack > 0) {
+        int x = stack[n_stack - 1];
+        const Block *b = &blocks[local_blocks[x]];
+
+        if (edge_index[x] < b->n_succs) {
+            int y = local_of[b->succs[edge_index[x]++]];
+
+            if (state[y] == 0) {
+                state[y] = 1;
+                stack[n_stack++] = y;
+            }
+        } else {
+            state[x] = 2;
+            rpo_order[n - 1 - n_post++] = x;
+            --n_stack;
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        rpo_number[rpo_order[i]] = i;
+    }
+}
+
+static void compute_dominators(int n) {
+    for (int i = 0; i < n; ++i) {
+        idom[i] = -1;
+    }
+
+    idom[0] = 0;
+
+    for (bool changed = true; changed;) {
+        changed = false;
+
+        for (int i = 1; i < n; ++i) {
+            int x = rpo_order[i];
+            int new_idom = -1;
+
+            // Predecessors of x among the local blocks.
+            for (int p = 0; p < n; ++p) {
+                const Block *b = &blocks[local_blocks[p]];
+
+                for (int s = 0; s < b->n_succs; ++s) {
+                    if (local_of[b->succs[s]] == x && idom[p] >= 0) {
+                        new_idom = new_idom < 0 ? p : intersect_dominators(p, new_idom);
+                    }
+                }
+            }
+
+            if (new_idom != idom[x]) {
+                idom[x] = new_idom;
+                changed = true;
+            }
+        }
+    }
+}
+
+// Instruction at the end of local block `x` counting down or up an 8 bit register and jumping
+// back while it's not zero. Returns the register and whether it counts down, -1 when it isn't one.
+static int counter_of_latch(int x, bool *down) {
+    const Block *b = &blocks[local_blocks[x]];
+    const OpcodeSemantics *last = &semantics[image[b->last]];
+
+    if (last->has_unary_update && last->update_reg <= C_D && last->update_alu_op == ALU_OP_DEC_LS &&
+        last->falls_through && last->jump_deps == (SEMANTICS_DEP_OPERAND_0 | SEMANTICS_DEP_OPERAND_1) &&
+        last->control_flags_read == 0 && (last->flags_written & 1)) {
+        *down = true;
+        return last->update_reg;
+    }
+
+    if (image[b->last] != OPCODE_JNZ_IMM16 || b->n_insns < 2) {
+        return -1;
+    }
+
+    const OpcodeSemantics *update = &semantics[image[prev_insn[b->last]]];
+
+    if (!update->has_unary_update || update->update_reg > C_D || update->effects != 0 ||
+        !(update->flags_written & 1) ||
+        (update->update_alu_op != ALU_OP_DEC_LS && update->update_alu_op != ALU_OP_INC_LS)) {
+        return -1;
+    }
+
+    *down = update->update_alu_op == ALU_OP_DEC_LS;
+    return update->update_reg;
+}
+
+// Value block `b` leaves in `reg`, -1 when it isn't an `ld reg, imm8` it can see.
+static int counter_start(int b, int reg) {
+    const Block *block = &blocks[b];
+    int value = -1;
+    uint32_t at = block->start;
+
+    for (int n = 0; n < block->n_insns; ++n) {
+        Insn insn = decode((uint16_t)at);
+
+        if (is_ld_imm8(insn.opcode, reg)) {
+            value = image[(uint16_t)(at + 1)];
+        } else if (semantics[insn.opcode].writes & (1 << reg)) {
+            value = -1;
+        } else if (insn.kind == INSN_CALL && in_program(insn.target) &&
+                   (functions[function_at[insn.target]].writes & (1 << reg))) {
+            value = -1;
+        }
+
+        at += (uint32_t)insn.length;
+    }
+
+    return value;
+}
+
+// How many times the loop runs at most, 0 when it isn't bounded.
+static uint64_t loop_bound(const Loop *loop, int n) {
+    uint64_t bound = 1;
+    int loop_id = in_loop[loop->header];
+
+    for (int i = 0; i < loop->n_body; ++i) {
+        int x = loop_bodies[loop->first_body + i];
+        const Block *b = &blocks[local_blocks[x]];
+        bool latch = false;
+
+        for (int s = 0; s < b->n_succs; ++s) {
+            latch |= local_of[b->succs[s]] == loop->header;
+        }
+
+        if (!latch) {
+            continue;
+        }
+
+        bool down = false;
+        int reg = rep[x] == x ? counter_of_latch(x, &down) : -1;
+
+        // The counter jumps back, its fall through has to go somewhere else.
+        if (reg < 0 || b->n_succs != 2 || !b->succ_taken[1] || local_of[b->succs[1]] != loop->header ||
+            local_of[b->succs[0]] == loop->header) {
+            return 0;
+        }
+
+        // Only the latch counts it, not even callees write it.
+        uint32_t counter_update = image[b->last] == OPCODE_JNZ_IMM16 ? (uint32_t)prev_insn[b->last] : b->last;
+
+        for (int j = 0; j < loop->n_body; ++j) {
+            const Block *other = &blocks[local_blocks[loop_bodies[loop->first_body + j]]];
+            uint32_t at = other->start;
+
+            for (int k = 0; k < other->n_insns; ++k) {
+                Insn insn = decode((uint16_t)at);
+                bool writes = semantics[insn.opcode].writes & (1 << reg);
+
+                if (insn.kind == INSN_CALL && in_program(insn.target)) {
+                    writes |= (functions[function_at[insn.target]].writes & (1 << reg)) != 0;
+                }
+
+                if (writes && at != counter_update) {
+                    return 0;
+                }
+
+                at += (uint32_t)insn.length;
+            }
+        }
+
+        // Trust the starting value only when the counter can't wrap round inside the loop.
+        uint64_t counter_bound = 256;
+
+        if (in_loop[local_of[b->succs[0]]] != loop_id) {
+            int start = -1;
+
+            for (int p = 0; p < n && start < 256; ++p) {
+                const Block *pred = &blocks[local_blocks[p]];
+                bool enters = false;
+
+                for (int s = 0; s < pred->n_succs; ++s) {
+                    enters |= local_of[pred->succs[s]] == loop->header && in_loop[p] != loop_id;
+                }
+
+                if (enters) {
+                    int value = counter_start(local_blocks[p], reg);
+                    int value_bound = value < 0 ? 256 : down ? (value == 0 ? 256 : value) : 256 - value;
+                    start = value_bound > start ? value_bound : start;
+                }
+            }
+
+            counter_bound = start < 0 ? 256 : (uint64_t)start;
+        }
+
+        bound *= counter_bound;
+    }
+
+    return bound;
+}
+
+// Longest path from the loop header, over the blocks and collapsed loops in it, stopping at
+// edges back to the header or out of the loop.
+static void longest_paths(int header, int loop_id) {
+    static int order[MAX_BLOCKS];
+    static int edge_index[MAX_BLOCKS];
+    static bool visited[MAX_BLOCKS];
+    int n_order = 0;
+    int n_stack = 0;
+
+    stack[n_stack++] = header;
+    visited[header] = true;
+    edge_index[header] = 0;
+
+    while (n_stack > 0) {
+        int x = stack[n_stack - 1];
+
+        if (edge_index[x] < n_edges[x]) {
+            const Edge *e = &edges[first_edge[x] + edge_index[x]++];
+            int y = e->to == SINK ? SINK : rep[e->to];
+
+            if (y != SINK && y != header && in_loop[y] == loop_id && !visited[y]) {
+                visited[y] = true;
+                edge_index[y] = 0;
+                stack[n_stack++] = y;
+            }
+        } else {
+            order[n_order++] = x;
+            --n_stack;
+        }
+    }
+
+    for (int i = 0; i < n_order; ++i) {
+        dist[order[i]] = 0;
+        reached[order[i]] = false;
+        visited[order[i]] = false;
+    }
+
+    reached[header] = true;
+
+    for (int i = n_order - 1; i >= 0; --i) {
+        int x = order[i];
+
+        for (int j = 0; j < n_edges[x]; ++j) {
+            const Edge *e = &edges[first_edge[x] + j];
+            int y = e->to == SINK ? SINK : rep[e->to];
+
+            if (y != SINK && y != header && in_loop[y] == loop_id) {
+                uint64_t cycles = dist[x] + e->cycles;
+
+                if (!reached[y] || cycles > dist[y]) {
+                    dist[y] = cycles;
+                    reached[y] = true;
+                }
+            }
+        }
+    }
+}
+
+static void analyze_function(int f) {
+    Function *function = &functions[f];
+    function->state = FUNCTION_VISITING;
+
+    for (int c = 0; c < function->n_callees; ++c) {
+        Function *callee = &functions[pool[function->first_callee + c]];
+
+        if (callee->state == FUNCTION_UNVISITED) {
+            analyze_function(pool[function->first_callee + c]);
+        } else if (callee->state == FUNCTION_VISITING) {
+            function->recursive = true;
+        }
+    }
+
+    // Scratch is free from here, no more recursion.
+    int n = function->n_blocks;
+    bool bounded = !function->recursive;
+    uint16_t writes = 0;
+
+    for (int i = 0; i < n; ++i) {
+        local_blocks[i] = pool[function->first_block + i];
+        local_of[local_blocks[i]] = i;
+    }
+
+    for (int c = 0; c < function->n_callees; ++c) {
+        writes |= functions[pool[function->first_callee + c]].writes;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        const Block *b = &blocks[local_blocks[i]];
+        uint32_t at = b->start;
+
+        for (int k = 0; k < b->n_insns; ++k) {
+            Insn insn = decode((uint16_t)at);
+            writes |= semantics[insn.opcode].writes;
+            at += (uint32_t)insn.length;
+        }
+    }
+
+    function->writes = writes;
+
+    n_edges_total = 0;
+
+    for (int i = 0; i < n; ++i) {
+        const Block *b = &blocks[local_blocks[i]];
+        first_edge[i] = n_edges_total;
+        rep[i] = i;
+        in_loop[i] = 0;
+
+        for (int s = 0; s < b->n_succs; ++s) {
+            add_edge(local_of[b->succs[s]], block_edge_cycles(local_blocks[i], s, &bounded));
+        }
+
+        if (b->exits) {
+            add_edge(SINK, block_edge_cycles(local_blocks[i], SINK, &bounded));
+            bounded &= b->exit_known;
+        }
+
+        n_edges[i] = n_edges_total - first_edge[i];
+    }
+
+    number_blocks(n);
+    compute_dominators(n);
+
+    // Natural loops, one per header, innermost (smallest) first.
+    int n_loops = 0;
+    n_loop_bodies = 0;
+
+    for (int h = 0; h < n; ++h) {
+        bool irreducible = false;
+        int first_body = n_loop_bodies;
+        int n_stack = 0;
+
+        for (int x = 0; x < n; ++x) {
+            const Block *b = &blocks[local_blocks[x]];
+
+            for (int s = 0; s < b->n_succs; ++s) {
+                if (local_of[b->succs[s]] != h || rpo_number[x] < rpo_number[h]) {
+                    continue;
+                }
+
+                if (!dominates(h, x)) {
+                    irreducible = true;
+                } else if (in_loop[x] != -1 - h) {
+                    in_loop[x] = -1 - h;
+                    stack[n_stack++] = x;
+                }
+            }
+        }
+
+        if (irreducible) {
+            bounded = false;
+        }
+
+        if (n_stack == 0) {
+            continue;
+        }
+
+        if (in_loop[h] != -1 - h) {
+            in_loop[h] = -1 - h;
+            stack[n_stack++] = h;
+        }
+
+        // Everything reaching a latch without passing the header.
+        while (n_stack > 0) {
+            int x = stack[--n_stack];
+
+            if (n_loop_bodies == MAX_POOL) {
+                fprintf(stderr, "Program too big to analyze\n");
+                exit(1);
+            }
+
+            loop_bodies[n_loop_bodies++] = x;
+
+            if (x == h) {
+                continue;
+            }
+
+            for (int p = 0; p < n; ++p) {
+                const Block *b = &blocks[local_blocks[p]];
+
+                for (int s = 0; s < b->n_succs; ++s) {
+                    if (local_of[b->succs[s]] == x && in_loop[p] != -1 - h && dominates(h, p)) {
+                        in_loop[p] = -1 - h;
+                        stack[n_stack++] = p;
+                    }
+                }
+            }
+        }
+
+        loops[n_loops++] = (Loop){.header = h, .first_body = first_body, .n_body = n_loop_bodies - first_body};
+
+        for (int i = first_body; i < n_loop_bodies; ++i) {
+            in_loop[loop_bodies[i]] = 0;
+        }
+    }
+
+    // Smallest body first puts inner loops before the loops containing them.
+    for (int i = 1; i < n_loops; ++i) {
+        Loop loop = loops[i];
+        int j = i;
+
+        for (; j > 0 && loops[j - 1].n_body > loop.n_body; --j) {
+            loops[j] = loops[j - 1];
+        }
+
+        loops[j] = loop;
+    }
+
+    for (int l = 0; l < n_loops; ++l) {
+        const Loop *loop = &loops[l];
+        int h = loop->header;
+
+        for (int i = 0; i < loop->n_body; ++i) {
+            in_loop[loop_bodies[loop->first_body + i]] = l + 1;
+        }
+
+        longest_paths(h, l + 1);
+
+        uint64_t iteration = 0;
+        int first_exit = n_edges_total;
+
+        for (int i = 0; i < loop->n_body; ++i) {
+            int x = loop_bodies[loop->first_body + i];
+
+            if (rep[x] != x || !reached[x]) {
+                continue;
+            }
+
+            for (int j = 0; j < n_edges[x]; ++j) {
+                Edge e = edges[first_edge[x] + j];
+                int y = e.to == SINK ? SINK : rep[e.to];
+
+                if (y == h) {
+                    iteration = dist[x] + e.cycles > iteration ? dist[x] + e.cycles : iteration;
+                }
+            }
+        }
+
+        uint64_t iterations = loop_bound(loop, n);
+
+        if (iterations == 0) {
+            bounded = false;
+            ++function->n_unbounded_loops;
+        }
+
+        // The collapsed loop leaves by any of its exits after running all but the last time.
+        uint64_t repeats = iterations > 0 ? iterations - 1 : 0;
+
+        for (int i = 0; i < loop->n_body; ++i) {
+            int x = loop_bodies[loop->first_body + i];
+
+            if (rep[x] != x || !reached[x]) {
+                continue;
+            }
+
+            for (int j = 0; j < n_edges[x]; ++j) {
+                Edge e = edges[first_edge[x] + j];
+                int y = e.to == SINK ? SINK : rep[e.to];
+
+                if (y == SINK || in_loop[y] != l + 1) {
+                    add_edge(e.to, repeats * iteration + dist[x] + e.cycles);
+                }
+            }
+        }
+
+        first_edge[h] = first_exit;
+        n_edges[h] = n_edges_total - first_exit;
+
+        for (int i = 0; i < loop->n_body; ++i) {
+            int x = loop_bodies[loop->first_body + i];
+            rep[x] = h;
+            in_loop[x] = 0;
+        }
+
+        uint16_t header_address = blocks[local_blocks[h]].start;
+
+        if (loop_report_at[header_address] < 0) {
+            loop_report_at[header_address] = n_loop_reports;
+            loop_reports[n_loop_reports++] = (LoopReport){
+                .header = header_address,
+                .bounded = iterations > 0,
+                .iterations = iterations,
+                .iteration_cycles = iteration,
+            };
+        }
+    }
+
+    // Everything left is acyclic, longest path from the entry out of the function.
+    for (int i = 0; i < n; ++i) {
+        in_loop[i] = rep[i] == i ? -1 : 0;
+    }
+
+    longest_paths(0, -1);
+
+    uint64_t cycles = 0;
+    bool returns = false;
+
+    for (int x = 0; x < n; ++x) {
+        if (rep[x] != x || !reached[x]) {
+            continue;
+        }
+
+        for (int j = 0; j < n_edges[x]; ++j) {
+            const Edge *e = &edges[first_edge[x] + j];
+
+            if (e->to == SINK) {
+                cycles = dist[x] + e->cycles > cycles ? dist[x] + e->cycles : cycles;
+                returns = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        local_of[local_blocks[i]] = 0;
+    }
+
+    function->bounded = bounded && returns;
+    function->returns = returns;
+    function->cycles = cycles;
+    function->state = FUNCTION_DONE;
+}
+
+static void label_of(uint16_t address, char *label, size_t size) {
+    if (function_at[address] >= 0) {
+        snprintf(label, size, "sub_%04x", address);
+    } else if (in_program(address) && (flags[address] & FLAG_JUMPED_TO)) {
+        snprintf(label, size, "loc_%04x", address);
+    } else {
+        snprintf(label, size, "0x%04x", address);
+    }
+}
+
+// Rule for the opcode, with the port for the `in` and `out` opcodes sharing one rule.
+static Rule disassembly_rule(uint8_t opcode, int *port) {
+    Rule r = rule_from_opcode(opcode);
+    *port = opcode & 7;
+
+    if (r.n[0] == '\0') {
+        r = rule_from_opcode((Opcode)(opcode & ~7));
+    }
+
+    return r;
+}
+
+static void format_insn(uint16_t pc, const Insn *insn, char *text, size_t size) {
+    int port = 0;
+    Rule r = disassembly_rule(insn->opcode, &port);
+    uint8_t imm8 = image[(uint16_t)(pc + 1)];
+    char operand[32];
+
+    switch (r.op) {
+    case NONE: snprintf(text, size, "%s", r.n); break;
+    case PORT: snprintf(text, size, "%s %d", r.n, port); break;
+    case PORT_IMM8: snprintf(text, size, "%s %d, 0x%02x", r.n, port, imm8); break;
+    case PORT_A: snprintf(text, size, "%s %d, a", r.n, port); break;
+    case IMM8: snprintf(text, size, "%s 0x%02x", r.n, imm8); break;
+    case IMM8_IN_NAME: {
+        // Name is like `ld a, [sp+{imm: i8}]`, the displacement replaces the parameter.
+        const char *open = strchr(r.n, '{');
+        const char *close = strchr(r.n, '}');
+        bool is_signed = open != NULL && open[6] == 'i';
+
+        if (open == NULL || close == NULL) {
+            snprintf(text, size, "%s", r.n);
+            break;
+        }
+
+        snprintf(operand, sizeof(operand), "%d", is_signed ? (int)(int8_t)imm8 : (int)imm8);
+        snprintf(text, size, "%.*s%s%s", (int)(open - r.n), r.n, operand, close + 1);
+        break;
+    }
+    case IMM16:
+        label_of(imm16_at(pc), operand, sizeof(operand));
+        snprintf(text, size, "%s %s", r.n, operand);
+        break;
+    }
+}
+
+static void format_cycles(uint64_t cycles, bool bounded, uint32_t clock_hz, char *text, size_t size) {
+    if (clock_hz > 0) {
+        snprintf(text, size, "%s%llu cycles, %.1f us at %u Hz", bounded ? "" : "unbounded, ",
+                 (unsigned long long)cycles, (double)cycles * 1000000.0 / clock_hz, clock_hz);
+    } else {
+        snprintf(text, size, "%s%llu cycles", bounded ? "" : "unbounded, ", (unsigned long long)cycles);
+    }
+}
+
+static void print_data(uint32_t from, uint32_t to) {
+    for (uint32_t at = from; at < to;) {
+        uint32_t run = at;
+
+        while (run < to && image[run] == image[at]) {
+            ++run;
+        }
+
+        // Padding, like the rest of a ROM.
+        if (run - at >= 16) {
+            printf("    %04x  #d 0x%02x ; %u times\n", at, image[at], run - at);
+            at = run;
+            continue;
+        }
+
+        printf("    %04x  #d ", at);
+
+        for (int n = 0; n < 8 && at < to; ++n, ++at) {
+            printf("%s0x%02x", n > 0 ? ", " : "", image[at]);
+        }
+
+        printf("\n");
+    }
+}
+
+static void print_listing(uint32_t clock_hz) {
+    uint32_t data_from = origin;
+
+    for (uint32_t pc = origin; pc < image_end;) {
+        if (!(flags[pc] & FLAG_START)) {
+            ++pc;
+            continue;
+        }
+
+        print_data(data_from, pc);
+
+        char label[16];
+        char text[96];
+        uint16_t address = (uint16_t)pc;
+
+        if (function_at[address] >= 0) {
+            const Function *function = &functions[function_at[address]];
+
+            if (function->returns) {
+                format_cycles(function->cycles, function->bounded, clock_hz, text, sizeof(text));
+            } else {
+                snprintf(text, sizeof(text), "unbounded, never returns");
+            }
+
+            printf("\n; Worst case %s%s%s\n", text, function->recursive ? ", recursive" : "",
+                   function->n_unbounded_loops > 0 ? ", leaves out repeating the unbounded loops" : "");
+        }
+
+        if (function_at[address] >= 0 || (flags[pc] & FLAG_JUMPED_TO)) {
+            label_of(address, label, sizeof(label));
+            printf("%s:\n", label);
+        }
+
+        if (block_at[pc] >= 0) {
+            const Block *b = &blocks[block_at[pc]];
+
+            if (loop_report_at[pc] >= 0) {
+                const LoopReport *loop = &loop_reports[loop_report_at[pc]];
+
+                if (loop->bounded) {
+                    printf("    ; Loop, at most %llu times %llu cycles\n", (unsigned long long)loop->iterations,
+                           (unsigned long long)loop->iteration_cycles);
+                } else {
+                    printf("    ; Loop, unbounded, %llu cycles per time round\n",
+                           (unsigned long long)loop->iteration_cycles);
+                }
+            }
+
+            printf("    ; Block %04x-%04x, %d cycles\n", b->start, b->last, b->cycles);
+        }
+
+        Insn insn = decode(address);
+        const OpcodeSemantics *s = &semantics[insn.opcode];
+        char bytes[16] = "";
+        char cycles[16];
+
+        for (int n = 0; n < insn.length && pc + (uint32_t)n < image_end; ++n) {
+            size_t used = strlen(bytes);
+            snprintf(bytes + used, sizeof(bytes) - used, "%s%02x", n > 0 ? " " : "", image[pc + (uint32_t)n]);
+        }
+
+        if (s->min_cycles != s->max_cycles) {
+            snprintf(cycles, sizeof(cycles), "%d/%d", s->min_cycles, s->max_cycles);
+        } else {
+            snprintf(cycles, sizeof(cycles), "%d", s->max_cycles);
+        }
+
+        if (insn.kind == INSN_UNDEFINED) {
+            snprintf(text, sizeof(text), "#d 0x%02x ; Undefined", insn.opcode);
+        } else {
+            format_insn(address, &insn, text, sizeof(text));
+        }
+
+        printf("    %04x  %-8s    %-28s ; %s%s\n", pc, bytes, text, cycles,
+               insn.kind == INSN_RETURN && image[pc] != OPCODE_RET ? ", returns"
+               : insn.kind == INSN_INDIRECT                        ? ", jumps somewhere unknown"
+                                                                   : "");
+
+        pc += (uint32_t)insn.length;
+        data_from = pc < image_end ? pc : image_end;
+    }
+
+    print_data(data_from, image_end);
+}
+
+static void print_call_graph(void) {
+    printf("\n; Call graph\n");
+
+    for (int f = 0; f < n_functions; ++f) {
+        const Function *function = &functions[f];
+
+        printf(";   sub_%04x", function->entry);
+
+        for (int c = 0; c < function->n_callees; ++c) {
+            printf("%s sub_%04x", c == 0 ? " ->" : ",", functions[pool[function->first_callee + c]].entry);
+        }
+
+        printf("\n");
+    }
+}
+
+static bool ends_with(const char *string, const char *suffix) {
+    size_t n = strlen(string);
+    size_t n_suffix = strlen(suffix);
+
+    return n >= n_suffix && strcmp(string + n - n_suffix, suffix) == 0;
+}
+
+static void load_program(const char *filename) {
+    static uint8_t program[ADDRESS_SPACE];
+    size_t size = 0;
+
+    if (ends_with(filename, ".asm")) {
+        if (assemble(filename, program, sizeof(program), &size) > 0) {
+            exit(1);
+        }
+    } else {
+        FILE *file = fopen(filename, "r");
+
+        if (file == NULL) {
+            fprintf(stderr, "Failed to read %s\n", filename);
+            exit(1);
+        }
+
+        size = fread(program, sizeof(uint8_t), sizeof(program), file);
+        fclose(file);
+    }
+
+    if (size > ADDRESS_SPACE - origin) {
+        fprintf(stderr, "Program of %zu bytes doesn't fit from 0x%04x\n", size, origin);
+        exit(1);
+    }
+
+    memcpy(image + origin, program, size);
+    image_end = origin + (uint32_t)size;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <PROGRAM>.bin|.asm [ORIGIN] [CLOCK FREQUENCY IN HZ]\n", argv[0]);
+        exit(1);
+    }
+
+    origin = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 0) : DEFAULT_ORIGIN;
+    uint32_t clock_hz = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 0) : 0;
+
+    if (origin >= ADDRESS_SPACE) {
+        fprintf(stderr, "Unsupported origin: 0x%x\n", origin);
+        exit(1);
+    }
+
+    static uint8_t table[CONTROL_ROM_SIZE];
+    const char *control_filename = "./bin/control.bin";
+    FILE *file = fopen(control_filename, "r");
+
+    if (file == NULL || fread(table, sizeof(uint8_t), CONTROL_ROM_SIZE, file) != CONTROL_ROM_SIZE) {
+        fprintf(stderr, "Failed to read the entire contents of %s\n", control_filename);
+        exit(1);
+    }
+
+    fclose(file);
+    derive_semantics((const uint8_t(*)[CONTROL_ROM_SIZE])&table, &semantics);
+
+    load_program(argv[1]);
+
+    for (int i = 0; i < ADDRESS_SPACE; ++i) {
+        prev_insn[i] = -1;
+        loop_report_at[i] = -1;
+    }
+
+    // `jmp i` and `jmp j` depend on what falls into them, which the first passes may not have seen.
+    for (int n = -1, n_insns = traverse(); n_insns != n;) {
+        n = n_insns;
+        n_insns = traverse();
+    }
+
+    build_blocks();
+    build_functions();
+
+    for (int f = 0; f < n_functions; ++f) {
+        if (functions[f].state == FUNCTION_UNVISITED) {
+            analyze_function(f);
+        }
+    }
+
+    print_listing(clock_hz);
+    print_call_graph();
+
+    return 0;
+}
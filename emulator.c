@@ -1,88 +1,32 @@
 #include <assert.h>
+#include <pthread.h> // pthread_*
+#include <stdarg.h> // va_*
+#include <stdatomic.h> // atomic_*
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h> // f*
 #include <stdlib.h> // exit
+#include <string.h> // memcpy
 #include <time.h> // nanosleep
 
+#include "alu_op.h"
+#define BOOT_DEVICE_RING_SIZE (BOOT_PROGRAM_SIZE_CAP) // Room for any program, booted as the sketch would
+#include "arduino/BootDeviceSketch/boot_device.h"
+#include "assembler.h"
+#include "control_semantics.h"
+#if __has_include("opcode_semantics.h") // Written by semantics.c, control.bin is checked against it
+#include "opcode_semantics.h"
+#define HAS_OPCODE_SEMANTICS
+#endif
+#include "control_verify.h"
+#define CPU_CONTROL_ROM_VERIFIED // control.bin is checked by verify_table before running
+#include "cpu.h"
 #include "opcode.h"
 
 #define EXIT_AFTER_N_INSTRUCTIONS (50000) // TODO: Probably an in parameter
 
-#define CONTROL_ROM_SIZE (1 << 17)
-#define ALU_ROM_SIZE (1 << 17)
-#define ROM_SIZE (1 << 15)
-#define RAM_SIZE (1 << 15)
-
-#define RAM_ABSOLUTE_START_ADDRESS (0x8000)
 #define PROGRAM_RAM_RELATIVE_START_ADDRESS (0x0000) // TODO: Probably an in parameter
 
-// Control low signals
-#define SIGNAL_C0_OR_CE_M(signals) (((signals) >> 0) & 1)
-#define SIGNAL_C1_OR_LD_O(signals) (((signals) >> 1) & 1)
-#define SIGNAL_C2_OR_LD_S(signals) (((signals) >> 2) & 1)
-#define SIGNAL_C3_OR_LD_RS(signals) (((signals) >> 3) & 1)
-#define SIGNAL_C4_ALU_OP4_OR_LD_IO(signals) (((signals) >> 4) & 1)
-#define SIGNAL_C5_LS_ALU_Q_OR_HALT_C(signals) (((signals) >> 5) & 1)
-#define SIGNAL_LD_C(signals) (((signals) >> 6) & 1)
-#define SIGNAL_TOGGLE_M_C(signals) (((signals) >> 7) & 1)
-
-// Control high signals
-#define SIGNAL_LD_MEM(signals) (((signals) >> 8) & 1)
-#define SIGNAL_LD_LS(signals) (((signals) >> 9) & 1)
-#define SIGNAL_LD_ML(signals) (((signals) >> 10) & 1)
-#define SIGNAL_LD_MH(signals) (((signals) >> 11) & 1)
-#define SIGNAL_OE_ML(signals) (((signals) >> 12) & 1)
-#define SIGNAL_OE_MH(signals) (((signals) >> 13) & 1)
-#define SIGNAL_OE_ALU(signals) (((signals) >> 14) & 1)
-#define SIGNAL_OE_MEM(signals) (((signals) >> 15) & 1)
-
-// Combined NAND signals
-#define SIGNAL_LD_O(signals) (~(SIGNAL_C1_OR_LD_O(signals) & SIGNAL_LD_C(signals)) & 1)
-#define SIGNAL_LD_S(signals) (~(SIGNAL_C2_OR_LD_S(signals) & SIGNAL_LD_C(signals)) & 1)
-#define SIGNAL_LD_RS(signals) (~(SIGNAL_C3_OR_LD_RS(signals) & SIGNAL_LD_C(signals)) & 1)
-#define SIGNAL_LD_IO(signals) (~(SIGNAL_C4_ALU_OP4_OR_LD_IO(signals) & SIGNAL_LD_C(signals)) & 1)
-#define SIGNAL_HALT(signals) (~(SIGNAL_C5_LS_ALU_Q_OR_HALT_C(signals) & SIGNAL_LD_C(signals)) & 1)
-#define SIGNAL_LD_RS(signals) (~(SIGNAL_C3_OR_LD_RS(signals) & SIGNAL_LD_C(signals)) & 1)
-#define SIGNAL_LD_IO(signals) (~(SIGNAL_C4_ALU_OP4_OR_LD_IO(signals) & SIGNAL_LD_C(signals)) & 1)
-#define SIGNAL_HALT(signals) (~(SIGNAL_C5_LS_ALU_Q_OR_HALT_C(signals) & SIGNAL_LD_C(signals)) & 1)
-
-// Combined NAND and C signals
-#define SIGNAL_C_LD_MEM(signals, c_exec) (~(SIGNAL_LD_MEM(signals) & c_exec) & 1)
-
-// ALU low signals
-#define ALU_SIGNAL_L_QZ(alu_signals) (((alu_signals) >> 0) & 1)
-#define ALU_SIGNAL_L_QC(alu_signals) (((alu_signals) >> 1) & 1)
-#define ALU_SIGNAL_Q_ZF(alu_signals) (((alu_signals) >> 2) & 1)
-#define ALU_SIGNAL_Q_IO_OE(alu_signals) (((alu_signals) >> 3) & 1)
-
-// ALU high signals
-#define ALU_SIGNAL_H_QZ(alu_signals) (((alu_signals) >> 8) & 1)
-#define ALU_SIGNAL_H_QC(alu_signals) (((alu_signals) >> 9) & 1)
-#define ALU_SIGNAL_Q_CF(alu_signals) (((alu_signals) >> 10) & 1)
-#define ALU_SIGNAL_Q_OF(alu_signals) (((alu_signals) >> 11) & 1)
-
-// ALU combined signals
-#define ALU_SIGNAL_Q(alu_signals) ((((alu_signals) >> 8) & 0xf0) | ((alu_signals) >> 4) & 0x0f)
-#define ALU_SIGNAL_Q_SF(alu_signals) ((ALU_SIGNAL_Q(alu_signals) >> 7) & 1)
-
-// C signals
-#define C_OE_IO(c_q) (((c_q) >> 6) & 1) // Active high
-
-// Based on address bus signals
-#define SIGNAL_EN_ROM(address_bus) (((address_bus) >> 15) & 1)
-#define SIGNAL_EN_RAM(address_bus) (~SIGNAL_EN_ROM(address_bus) & 1)
-
-#define F_ZF(r_f) (((r_f) >> 0) & 1)
-#define F_CF(r_f) (((r_f) >> 1) & 1)
-#define F_OF(r_f) (((r_f) >> 2) & 1)
-#define F_SF(r_f) (((r_f) >> 3) & 1)
-
-#define S_Q0(r_s) (((r_s) >> 0) & 1)
-#define S_Q1(r_s) (((r_s) >> 1) & 1)
-#define S_Q2(r_s) (((r_s) >> 2) & 1)
-#define S_Q3(r_s) (((r_s) >> 3) & 1)
-
 #define IO_LD_DEBUG_PORT (1) // TODO: Probably an in parameter
 #define IO_LD_LCD_PORT (2) // TODO: Probably an in parameter
 #define IO_OE_LCD_PORT (2) // TODO: Probably an in parameter
@@ -92,33 +36,24 @@
 #define LCD_SIGNAL_E(data_bus) (((data_bus) >> 5) & 1)
 #define LCD_SIGNAL_DATA(data_bus) ((data_bus)&0xf)
 
-typedef struct {
-    bool c_exec; // 1 bit
+// HD44780 execution times
+#define LCD_BUSY_US (37)
+#define LCD_BUSY_CLEAR_OR_HOME_US (1520)
 
-    uint8_t r_s; // 4 bit
-    uint8_t r_o;
-    uint8_t r_f; // 4 bit
-    uint8_t r_ls;
-    uint8_t r_rs;
-    uint8_t r_c;
-    uint8_t r_ml;
-    uint8_t r_mh;
-    bool r_sel_m_or_c; // 1 bit, m when low
+#define FAST_FORWARD_MAX_LOOP_INSTRUCTIONS (256)
+#define FAST_FORWARD_MAX_RAM_WRITES (16)
+#define NO_EVENT (UINT64_MAX)
 
-    uint16_t control_signals;
-    uint16_t alu_signals;
+#define PRESENTATION_FRAME_NS (1000000000 / 60)
 
-    uint16_t address_bus;
-    uint8_t data_bus;
-} CPU;
+#define DEBUG_PORT_HISTORY (8)
 
-static uint8_t control_rom[CONTROL_ROM_SIZE];
-static uint8_t alu_low_rom[ALU_ROM_SIZE];
-static uint8_t alu_high_rom[ALU_ROM_SIZE];
+#define LOG_CAP (64) // Must be a power of two
+#define LOG_LINE_CAP (80)
+#define LOG_HISTORY (8)
 
-static uint8_t rom[RAM_SIZE];
-static uint8_t ram[RAM_SIZE];
-static uint8_t io_ports[8];
+#define SNAPSHOT_DIRTY (1 << 2)
+#define SNAPSHOT_INDEX(snapshot_state) ((snapshot_state)&3)
 
 typedef struct {
     uint8_t ir;
@@ -140,20 +75,202 @@ typedef struct {
 
     bool next_is_lower_4bit;
     uint8_t resetting;
-    int8_t busy;
+    uint64_t busy_until_cycle;
 } IO_LCD;
 
 static IO_LCD io_lcd = {0};
 
+// The arduino boot device serving a program to boot_device_loader.asm, running the
+// sketch's own arduino/BootDeviceSketch/boot_device.h with the program loaded up front.
+typedef struct {
+    BootDeviceBus bus; // The device's state the loader can change, the program does not
+    uint8_t value; // Driven to the data bus by the current read
+
+    uint64_t command_cycle;
+    uint64_t booted_cycle; // When the last frame was acknowledged, 0 until then
+} IO_BootDevice;
+
+static bool boot_device_attached = false;
+static BootDevice boot_device = {0};
+static IO_BootDevice io_boot_device = {0};
+
+// Reads assert to the data bus over consecutive cycles. Kept out of io_boot_device
+// as every read changes it, a loop polling the port would never look the same twice.
+static uint64_t boot_device_last_oe_cycle = 0;
+
+// Last writes to the debug port with the cycle they happened at, programs time
+// themselves by writing a marker before and after the code to measure.
+typedef struct {
+    uint8_t value;
+    uint64_t n_cycles;
+} DebugPortWrite;
+
+static DebugPortWrite debug_port_writes[DEBUG_PORT_HISTORY];
+static int n_debug_port_writes = 0;
+
+static uint32_t clock_hz = 20;
+static uint64_t n_cycles = 0;
 static int n_instructions = 0;
 static bool step_by_keyboard = false;
+static bool control_prefetches = false; // Opcodes are fetched by the last step of the previous instruction
+static OpcodeSemantics control_semantics[256]; // Derived from control.bin at startup
+
+// State at the last armed instruction boundary, if the machine is back at the same
+// boundary in an identical state then every iteration in between will repeat
+// until a device changes its output.
+typedef struct {
+    bool armed;
+    uint16_t pc;
+    CPU cpu;
+    uint64_t n_cycles;
+    int n_instructions;
+    uint8_t io_ports[8];
+    IO_LCD io_lcd;
+    IO_BootDevice io_boot_device;
+    uint8_t registers[16];
+
+    int n_ram_writes; // Above FAST_FORWARD_MAX_RAM_WRITES means too many to track
+    uint16_t ram_write_address[FAST_FORWARD_MAX_RAM_WRITES];
+    uint8_t ram_write_prev_value[FAST_FORWARD_MAX_RAM_WRITES];
+} FastForward;
+
+static FastForward fast_forward = {0};
+static uint64_t n_fast_forwarded_cycles = 0;
+
+// State at the previous visit of a counted loop head.
+typedef struct {
+    bool armed;
+    uint16_t pc;
+    CPU cpu;
+    uint64_t n_cycles;
+    int n_instructions;
+    uint8_t registers[16];
+} CountedLoop;
+
+static CountedLoop counted_loop = {0};
+
+typedef struct {
+    CPU cpu;
+    uint8_t registers[16];
+    uint64_t n_cycles;
+    int n_instructions;
+} FastForwardTarget;
+
+static bool verify_fast_forward = false;
+static bool fast_forward_pending = false;
+static FastForwardTarget fast_forward_expected;
+static uint64_t n_fast_forwards_verified = 0;
+
+// Everything the presentation thread renders. Copied out by the CPU thread
+// after every half cycle, never read by it.
+typedef struct {
+    CPU cpu;
+    uint64_t n_cycles;
+    uint64_t n_fast_forwarded_cycles;
+    uint64_t n_fast_forwards_verified;
+    int n_instructions;
+    uint8_t io_ports[8];
+    IO_LCD io_lcd;
+    int boot_n_frames;
+    int boot_n_naks;
+    uint64_t boot_command_cycle;
+    uint64_t boot_booted_cycle;
+    uint8_t registers[16]; // 0xfff0 - 0xffff
+    uint8_t ram_dump[4]; // 0x9200 - 0x9203
+    DebugPortWrite debug_port_writes[DEBUG_PORT_HISTORY];
+    int n_debug_port_writes;
+} Snapshot;
+
+// Triple buffer, the CPU thread owns `back`, the presentation thread owns `front`
+// and the last published snapshot is parked in `middle` (index | SNAPSHOT_DIRTY).
+// Publishing is a single atomic exchange so the CPU thread never waits on the terminal.
+static Snapshot snapshots[3];
+static uint8_t snapshot_back = 0;
+static uint8_t snapshot_front = 1;
+static _Atomic uint8_t snapshot_middle = 2;
+
+// Single producer (CPU thread), single consumer (presentation thread) log ring.
+// Lines are dropped rather than blocking the CPU thread when the ring is full.
+static char log_lines[LOG_CAP][LOG_LINE_CAP];
+static _Atomic uint32_t log_head = 0;
+static _Atomic uint32_t log_tail = 0;
+static _Atomic uint32_t log_dropped = 0;
+
+static _Atomic bool emulation_done = false;
+
+__attribute__((format(printf, 1, 2))) static void log_printf(const char *format, ...) {
+    uint32_t head = atomic_load_explicit(&log_head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&log_tail, memory_order_acquire);
+
+    if (head - tail >= LOG_CAP) {
+        atomic_fetch_add_explicit(&log_dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(log_lines[head & (LOG_CAP - 1)], LOG_LINE_CAP, format, args);
+    va_end(args);
+
+    atomic_store_explicit(&log_head, head + 1, memory_order_release);
+}
+
+static void snapshot_from_state(Snapshot *snapshot, CPU cpu) {
+    snapshot->cpu = cpu;
+    snapshot->n_cycles = n_cycles;
+    snapshot->n_fast_forwarded_cycles = n_fast_forwarded_cycles;
+    snapshot->n_fast_forwards_verified = n_fast_forwards_verified;
+    snapshot->n_instructions = n_instructions;
+    memcpy(snapshot->io_ports, io_ports, sizeof(snapshot->io_ports));
+    snapshot->io_lcd = io_lcd;
+    snapshot->boot_n_frames = io_boot_device.bus.n_frames;
+    snapshot->boot_n_naks = io_boot_device.bus.n_naks;
+    snapshot->boot_command_cycle = io_boot_device.command_cycle;
+    snapshot->boot_booted_cycle = io_boot_device.booted_cycle;
+    memcpy(snapshot->registers, ram + 0x7ff0, sizeof(snapshot->registers));
+    memcpy(snapshot->ram_dump, ram + (0x9200 - RAM_ABSOLUTE_START_ADDRESS), sizeof(snapshot->ram_dump));
+    memcpy(snapshot->debug_port_writes, debug_port_writes, sizeof(snapshot->debug_port_writes));
+    snapshot->n_debug_port_writes = n_debug_port_writes;
+}
+
+static void publish_snapshot(CPU cpu) {
+    snapshot_from_state(&snapshots[snapshot_back], cpu);
+
+    uint8_t prev_middle = atomic_exchange_explicit(&snapshot_middle,
+                                                   snapshot_back | SNAPSHOT_DIRTY,
+                                                   memory_order_acq_rel);
+
+    snapshot_back = SNAPSHOT_INDEX(prev_middle);
+}
+
+static const Snapshot *take_snapshot(void) {
+    if (!(atomic_load_explicit(&snapshot_middle, memory_order_relaxed) & SNAPSHOT_DIRTY)) {
+        return NULL;
+    }
+
+    uint8_t prev_middle = atomic_exchange_explicit(&snapshot_middle,
+                                                   snapshot_front,
+                                                   memory_order_acq_rel);
+
+    snapshot_front = SNAPSHOT_INDEX(prev_middle);
+
+    return &snapshots[snapshot_front];
+}
+
+static void print_state(const Snapshot *snapshot, const char (*log_history)[LOG_LINE_CAP], int n_log_history) {
+    CPU cpu = snapshot->cpu;
+    const uint8_t *ports = snapshot->io_ports;
+    const IO_LCD *lcd = &snapshot->io_lcd;
 
-static void print_state(CPU cpu) {
     // TODO: Write to a buffer then do one write to stdout.
     printf("\033[2J\033[3J"); // Clear the viewport and the screen, the order seems to be important
     printf("\033[H"); // Position cursor at top-left corner
 
-    printf("CLK   S   O   F   LS   RS   C   ML   MH (ic: %d)\n", n_instructions);
+    printf("CLK   S   O   F   LS   RS   C   ML   MH (ic: %d, cc: %llu, ff: %llu, ffv: %llu)\n",
+           snapshot->n_instructions,
+           (unsigned long long)snapshot->n_cycles,
+           (unsigned long long)snapshot->n_fast_forwarded_cycles,
+           (unsigned long long)snapshot->n_fast_forwards_verified);
     printf("  %d%4d%4x%4x%5x%5x%4x%5x%5x\n\n", cpu.c_exec, cpu.r_s, cpu.r_o, cpu.r_f, cpu.r_ls, cpu.r_rs, cpu.r_c, cpu.r_ml, cpu.r_mh);
 
     printf("ZF   CF   OF   SF   SEL ~M/C   ~HALT\n");
@@ -214,46 +331,64 @@ static void print_state(CPU cpu) {
 
     printf("IO PORT 0   IO PORT 1   IO PORT 2   IO PORT 3\n");
     printf("%9x%12x%12x%12x\n\n",
-           io_ports[0],
-           io_ports[1],
-           io_ports[2],
-           io_ports[3]);
+           ports[0],
+           ports[1],
+           ports[2],
+           ports[3]);
 
     printf("IO PORT 4   IO PORT 5   IO PORT 6   IO PORT 7\n");
     printf("%9x%12x%12x%12x\n\n",
-           io_ports[4],
-           io_ports[5],
-           io_ports[6],
-           io_ports[7]);
+           ports[4],
+           ports[5],
+           ports[6],
+           ports[7]);
 
     printf(" A   B   C   D      I      J\n");
     printf("%2x%4x%4x%4x%7x%7x\n\n",
-           ram[0x7ff0], ram[0x7ff1], ram[0x7ff2], ram[0x7ff3],
-           (ram[0x7ff6] << 8) | ram[0x7ff5],
-           (ram[0x7ff8] << 8) | ram[0x7ff7]);
+           snapshot->registers[0x0], snapshot->registers[0x1], snapshot->registers[0x2], snapshot->registers[0x3],
+           (snapshot->registers[0x6] << 8) | snapshot->registers[0x5],
+           (snapshot->registers[0x8] << 8) | snapshot->registers[0x7]);
 
     printf("RAM DUMP at 0x9200 - 0x9203\n");
     printf("%3d %3d %3d %3d => %d\n",
-           ram[0x9200 - RAM_ABSOLUTE_START_ADDRESS],
-           ram[0x9201 - RAM_ABSOLUTE_START_ADDRESS],
-           ram[0x9202 - RAM_ABSOLUTE_START_ADDRESS],
-           ram[0x9203 - RAM_ABSOLUTE_START_ADDRESS],
+           snapshot->ram_dump[0],
+           snapshot->ram_dump[1],
+           snapshot->ram_dump[2],
+           snapshot->ram_dump[3],
 
-           ram[0x9203 - RAM_ABSOLUTE_START_ADDRESS] << 24 |
-               ram[0x9202 - RAM_ABSOLUTE_START_ADDRESS] << 16 |
-               ram[0x9201 - RAM_ABSOLUTE_START_ADDRESS] << 8 |
-               ram[0x9200 - RAM_ABSOLUTE_START_ADDRESS]);
+           snapshot->ram_dump[3] << 24 |
+               snapshot->ram_dump[2] << 16 |
+               snapshot->ram_dump[1] << 8 |
+               snapshot->ram_dump[0]);
 
-    if (io_lcd.display_on) {
+    if (snapshot->n_debug_port_writes > 0) {
+        printf("\nDEBUG PORT   CYCLE   CYCLES SINCE PREVIOUS\n");
+
+        for (int i = 0; i < snapshot->n_debug_port_writes; ++i) {
+            const DebugPortWrite *write = &snapshot->debug_port_writes[i];
+
+            printf("%10x%8llu", write->value, (unsigned long long)write->n_cycles);
+
+            if (i > 0) {
+                printf("%24llu", (unsigned long long)(write->n_cycles - snapshot->debug_port_writes[i - 1].n_cycles));
+            }
+
+            printf("\n");
+        }
+
+        printf("\n");
+    }
+
+    if (lcd->display_on) {
         printf("╔");
-        for (int x = 0; x < io_lcd.columns; ++x) {
+        for (int x = 0; x < lcd->columns; ++x) {
             printf("═");
         }
         puts("╗");
-        for (int y = 0; y < io_lcd.lines; ++y) {
+        for (int y = 0; y < lcd->lines; ++y) {
             printf("║");
-            for (int x = 0; x < io_lcd.columns; ++x) {
-                int c = io_lcd.ddram[y * 40 + x];
+            for (int x = 0; x < lcd->columns; ++x) {
+                int c = lcd->ddram[y * 40 + x];
 
                 if (c == 0xef) { // TODO: Create an explicit character map that is over-writable
                     printf("ö");
@@ -264,7 +399,7 @@ static void print_state(CPU cpu) {
             puts("║");
         }
         printf("╚");
-        for (int x = 0; x < io_lcd.columns; ++x) {
+        for (int x = 0; x < lcd->columns; ++x) {
             printf("═");
         }
         puts("╝");
@@ -272,14 +407,102 @@ static void print_state(CPU cpu) {
         printf("LCD display turned off\n");
     }
 
+    if (snapshot->boot_command_cycle > 0) {
+        printf("\nBOOT FRAMES   NAKS   COMMAND CYCLE   BOOT CYCLES\n");
+        printf("%11d%7d%16llu", snapshot->boot_n_frames, snapshot->boot_n_naks,
+               (unsigned long long)snapshot->boot_command_cycle);
+
+        if (snapshot->boot_booted_cycle > 0) {
+            printf("%14llu", (unsigned long long)(snapshot->boot_booted_cycle - snapshot->boot_command_cycle));
+        }
+
+        printf("\n");
+    }
+
+    printf("\nLOG (dropped: %u)\n", atomic_load_explicit(&log_dropped, memory_order_relaxed));
+    for (int i = 0; i < n_log_history; ++i) {
+        puts(log_history[i]);
+    }
+
     fflush(stdout);
 }
 
+static void lcd_set_busy_us(uint32_t us) {
+    io_lcd.busy_until_cycle = n_cycles + ((uint64_t)us * clock_hz + 999999) / 1000000;
+}
+
+static bool lcd_busy(void) {
+    return n_cycles < io_lcd.busy_until_cycle;
+}
+
+// First cycle after `after_cycle` where the LCD changes its output without any
+// interaction from the CPU.
+static uint64_t lcd_next_event_cycle(uint64_t after_cycle) {
+    return io_lcd.busy_until_cycle > after_cycle ? io_lcd.busy_until_cycle : NO_EVENT;
+}
+
+// The program is loaded up front, so what the loader reads only changes when it
+// reads or writes the port itself.
+static uint64_t boot_device_next_event_cycle(uint64_t after_cycle) {
+    (void)after_cycle;
+    return NO_EVENT;
+}
+
+static void boot_device_receive(uint8_t value) {
+    if (!boot_device_attached) {
+        return;
+    }
+
+    BootBusState prev_state = boot_device.bus.state;
+    uint16_t prev_n_naks = boot_device.bus.n_naks;
+
+    boot_device_bus_write(&boot_device, value);
+    io_boot_device.bus = boot_device.bus;
+
+    if (value == BOOT_COMMAND_GET_BLOCKS) {
+        io_boot_device.command_cycle = n_cycles;
+        io_boot_device.booted_cycle = 0;
+        log_printf("Boot device: sending %u bytes", boot_device.received);
+    } else if (boot_device.bus.n_naks != prev_n_naks) {
+        log_printf("Boot device: frame %u not acknowledged, sending it again", boot_device.bus.n_frames);
+    } else if (prev_state == BOOT_BUS_WAITING_FOR_ACK && boot_device.bus.state == BOOT_BUS_WAITING_FOR_COMMAND) {
+        io_boot_device.booted_cycle = n_cycles;
+        log_printf("Boot device: booted in %llu cycles",
+                   (unsigned long long)(io_boot_device.booted_cycle - io_boot_device.command_cycle));
+    } else if (prev_state != BOOT_BUS_WAITING_FOR_ACK) {
+        log_printf("Boot device: unexpected 0x%02x", value);
+    }
+}
+
+static uint8_t boot_device_send(void) {
+    // Nothing drives the bus without a device, the port reads the same forever.
+    if (!boot_device_attached) {
+        return BOOT_NOT_READY;
+    }
+
+    bool is_new_read = boot_device_last_oe_cycle == 0 || n_cycles > boot_device_last_oe_cycle + 1;
+    boot_device_last_oe_cycle = n_cycles;
+
+    if (is_new_read) {
+        io_boot_device.value = boot_device_bus_read(&boot_device);
+        io_boot_device.bus = boot_device.bus;
+    }
+
+    return io_boot_device.value;
+}
+
 static void update_io_ld(CPU cpu) {
     uint8_t port = cpu.r_o & 7;
 
-    if (port == IO_LD_DEBUG_PORT) {
-        // Do nothing
+    if (port == BOOT_PORT) {
+        boot_device_receive(cpu.data_bus);
+    } else if (port == IO_LD_DEBUG_PORT) {
+        if (n_debug_port_writes == DEBUG_PORT_HISTORY) {
+            memmove(debug_port_writes, debug_port_writes + 1, sizeof(debug_port_writes[0]) * (DEBUG_PORT_HISTORY - 1));
+            --n_debug_port_writes;
+        }
+
+        debug_port_writes[n_debug_port_writes++] = (DebugPortWrite){.value = cpu.data_bus, .n_cycles = n_cycles};
     } else if (port == IO_LD_LCD_PORT) {
         bool e_toggled = !io_lcd.e && LCD_SIGNAL_E(cpu.data_bus);
 
@@ -303,7 +526,7 @@ static void update_io_ld(CPU cpu) {
                     io_lcd.next_is_lower_4bit = (!io_lcd.next_is_lower_4bit) & 1;
 
                     if (!io_lcd.next_is_lower_4bit) {
-                        printf("Got LCD data: 0x%02x AC: %d\n", io_lcd.dr, io_lcd.ac);
+                        log_printf("Got LCD data: 0x%02x AC: %d", io_lcd.dr, io_lcd.ac);
 
                         io_lcd.ddram[io_lcd.ac] = io_lcd.dr;
                         io_lcd.ac = io_lcd.entry_mode ? io_lcd.ac + 1 : io_lcd.ac - 1;
@@ -312,7 +535,7 @@ static void update_io_ld(CPU cpu) {
                             io_lcd.ac = 0;
                         }
 
-                        io_lcd.busy = 1;
+                        lcd_set_busy_us(LCD_BUSY_US);
                     }
                 }
             }
@@ -324,12 +547,6 @@ static void update_io_ld(CPU cpu) {
                 // Read
                 if (e_toggled) {
                     io_lcd.next_is_lower_4bit = (!io_lcd.next_is_lower_4bit) & 1;
-
-                    if (!io_lcd.next_is_lower_4bit) {
-                        if (--io_lcd.busy < 0) {
-                            io_lcd.busy = 0;
-                        };
-                    }
                 }
             } else {
                 // Write
@@ -341,16 +558,16 @@ static void update_io_ld(CPU cpu) {
                     io_lcd.next_is_lower_4bit = (!io_lcd.next_is_lower_4bit) & 1;
 
                     if (!io_lcd.next_is_lower_4bit) {
-                        printf("Got LCD instruction: 0x%02x\n", io_lcd.ir);
+                        log_printf("Got LCD instruction: 0x%02x", io_lcd.ir);
 
                         if (io_lcd.ir == 0x33) {
                             // Reset sequence start
                             ++io_lcd.resetting;
                         } else if (io_lcd.ir == 0x32) {
                             // Reset sequence end
-                            assert(io_lcd.resetting == 1 && !io_lcd.busy);
+                            assert(io_lcd.resetting == 1 && !lcd_busy());
                             io_lcd.resetting = 0;
-                            io_lcd.busy = 4;
+                            lcd_set_busy_us(LCD_BUSY_US);
                         } else if ((io_lcd.ir & 0xe0) == 0x20) {
                             // Function set
                             uint8_t dl = (io_lcd.ir >> 4) & 1;
@@ -360,9 +577,9 @@ static void update_io_ld(CPU cpu) {
 
                             io_lcd.lines = (nf >> 1) ? 2 : 1;
                             io_lcd.columns = 16; // TODO: Depends on the model
-                            io_lcd.busy = 3;
+                            lcd_set_busy_us(LCD_BUSY_US);
 
-                            printf("LCD lines: %d\n", io_lcd.lines);
+                            log_printf("LCD lines: %d", io_lcd.lines);
                         } else if ((io_lcd.ir & 0xfc) == 0x0c) {
                             // Display on/off control
                             uint8_t d = (io_lcd.ir >> 2) & 1;
@@ -372,29 +589,40 @@ static void update_io_ld(CPU cpu) {
                             io_lcd.display_on = d;
                             io_lcd.cursor_on = c;
                             io_lcd.cursor_blink_on = b;
-                            io_lcd.busy = 1;
-                            printf("LCD: Display on: %d   Cursor on: %d   Blink cursor on: %d\n", io_lcd.display_on, io_lcd.cursor_on, io_lcd.cursor_blink_on);
+                            lcd_set_busy_us(LCD_BUSY_US);
+                            log_printf("LCD: Display on: %d   Cursor on: %d   Blink cursor on: %d", io_lcd.display_on, io_lcd.cursor_on, io_lcd.cursor_blink_on);
                         } else if ((io_lcd.ir & 0xfe) == 0x02) {
                             // Return home
                             io_lcd.ac = 0;
-                            io_lcd.busy = 5;
-                            printf("LCD: address counter: %d\n", io_lcd.ac);
+                            lcd_set_busy_us(LCD_BUSY_CLEAR_OR_HOME_US);
+                            log_printf("LCD: address counter: %d", io_lcd.ac);
                         } else if (io_lcd.ir == 0x01) {
                             // Clear display
                             io_lcd.ac = 0;
                             io_lcd.entry_mode = 1;
-                            io_lcd.busy = 5;
+                            lcd_set_busy_us(LCD_BUSY_CLEAR_OR_HOME_US);
 
                             for (int i = 0; i < 80; ++i) {
                                 io_lcd.ddram[i] = ' ';
                             }
 
-                            printf("LCD: address counter: %d\n", io_lcd.ac);
+                            log_printf("LCD: address counter: %d", io_lcd.ac);
                         } else if ((io_lcd.ir & 0xc0) == 0x40) {
                             // Set CGRAM/DDRAM address
                             io_lcd.ac = io_lcd.ir & 0x3f;
-                            io_lcd.busy = 2;
-                            printf("LCD: address counter: %d\n", io_lcd.ac);
+                            lcd_set_busy_us(LCD_BUSY_US);
+                            log_printf("LCD: address counter: %d", io_lcd.ac);
+                        } else if (io_lcd.ir & 0x80) {
+                            // Set DDRAM address, the second line starts at 0x40 and is
+                            // kept 40 characters after the first in ddram
+                            io_lcd.ac = (uint8_t)(((io_lcd.ir >> 6) & 1) * 40 + (io_lcd.ir & 0x3f));
+
+                            if (io_lcd.ac >= 80) {
+                                io_lcd.ac = 0;
+                            }
+
+                            lcd_set_busy_us(LCD_BUSY_US);
+                            log_printf("LCD: address counter: %d", io_lcd.ac);
                         } else {
                             assert(0 && "Unsupported LCD instruction");
                         }
@@ -411,7 +639,9 @@ static void update_io_ld(CPU cpu) {
 static uint8_t update_io_oe(CPU cpu) {
     uint8_t port = cpu.r_o & 7;
 
-    if (port == IO_OE_LCD_PORT) {
+    if (port == BOOT_PORT) {
+        return boot_device_send();
+    } else if (port == IO_OE_LCD_PORT) {
         if (io_lcd.e) {
             assert(io_lcd.rw == 1 && "LCD: Read not selected");
 
@@ -419,9 +649,9 @@ static uint8_t update_io_oe(CPU cpu) {
                 assert(0 && "LCD: Reading from DR not yet supported");
             } else {
                 // Read busy flag and address counter
-                printf("Reading IR: %02x, BUSY: %d\n", io_lcd.ir, io_lcd.busy);
+                uint8_t busy_flag = lcd_busy() ? 1 : 0;
 
-                uint8_t busy_flag = io_lcd.busy ? 1 : 0;
+                log_printf("Reading IR: %02x, BUSY: %d", io_lcd.ir, busy_flag);
                 uint8_t busy_flag_and_ac =
                     io_lcd.next_is_lower_4bit
                         // Upper 4 bit
@@ -435,243 +665,404 @@ static uint8_t update_io_oe(CPU cpu) {
             return 0xff;
         }
     } else {
-        print_state(cpu);
-        printf("IO port: %d\n", port);
+        fprintf(stderr, "IO port: %d\n", port);
         assert(0 && "IO port has no configured output enable");
     }
 }
 
-static uint16_t alu_signals(CPU cpu) {
-    uint8_t c_q0 = (cpu.r_c >> 0) & 1;
-    uint8_t c_q1 = (cpu.r_c >> 1) & 1;
-    uint8_t c_q2 = (cpu.r_c >> 2) & 1;
-    uint8_t c_q3 = (cpu.r_c >> 3) & 1;
-    uint8_t c_q4 = (cpu.r_c >> 4) & 1;
-    uint8_t c_q5 = (cpu.r_c >> 5) & 1;
+static void fast_forward_note_ram_write(uint16_t ram_address) {
+    // Instruction registers are compared as a whole.
+    if (!fast_forward.armed || ram_address >= 0x7ff0) {
+        return;
+    }
 
-    uint8_t alu_l_qz = ALU_SIGNAL_L_QZ(cpu.alu_signals);
-    uint8_t alu_l_qc = ALU_SIGNAL_L_QC(cpu.alu_signals);
+    for (int i = 0; i < fast_forward.n_ram_writes && i < FAST_FORWARD_MAX_RAM_WRITES; ++i) {
+        if (fast_forward.ram_write_address[i] == ram_address) {
+            return;
+        }
+    }
 
-    uint8_t alu_h_qz = ALU_SIGNAL_H_QZ(cpu.alu_signals);
-    uint8_t alu_h_qc = ALU_SIGNAL_H_QC(cpu.alu_signals);
+    if (fast_forward.n_ram_writes < FAST_FORWARD_MAX_RAM_WRITES) {
+        fast_forward.ram_write_address[fast_forward.n_ram_writes] = ram_address;
+        fast_forward.ram_write_prev_value[fast_forward.n_ram_writes] = ram[ram_address];
+    }
 
-    for (int i = 0; i < 5; ++i) {
-        uint32_t alu_l_address = (uint32_t)((c_q5 << 16) | (alu_h_qc << 15) | (c_q4 << 14) | (c_q3 << 13) | (alu_h_qz << 12) | (c_q2 << 11) | (c_q1 << 10) | (c_q0 << 9) | (F_CF(cpu.r_f) << 8) | ((cpu.r_rs & 0xf) << 4) | (cpu.r_ls & 0xf));
-        uint32_t alu_h_address = (uint32_t)((c_q5 << 16) | (alu_l_qc << 15) | (c_q4 << 14) | (c_q3 << 13) | (alu_l_qz << 12) | (c_q2 << 11) | (c_q1 << 10) | (c_q0 << 9) | (F_CF(cpu.r_f) << 8) | ((cpu.r_rs >> 4) << 4) | (cpu.r_ls >> 4));
+    ++fast_forward.n_ram_writes;
+}
 
-        uint16_t alu_signals = (uint16_t)(alu_high_rom[alu_h_address] << 8) | alu_low_rom[alu_l_address];
+static void fast_forward_arm(CPU cpu, uint16_t pc) {
+    fast_forward.armed = true;
+    fast_forward.pc = pc;
+    fast_forward.cpu = cpu;
+    fast_forward.n_cycles = n_cycles;
+    fast_forward.n_instructions = n_instructions;
+    memcpy(fast_forward.io_ports, io_ports, sizeof(io_ports));
+    fast_forward.io_lcd = io_lcd;
+    fast_forward.io_boot_device = io_boot_device;
+    memcpy(fast_forward.registers, ram + 0x7ff0, sizeof(fast_forward.registers));
+    fast_forward.n_ram_writes = 0;
+}
 
-        uint8_t alu_l_q0_alu_l_qz = ALU_SIGNAL_L_QZ(alu_signals);
-        uint8_t alu_l_q1_alu_l_qc = ALU_SIGNAL_L_QC(alu_signals);
+static bool cpu_equal(CPU a, CPU b) {
+    return a.c_exec == b.c_exec &&
+           a.r_s == b.r_s && a.r_o == b.r_o && a.r_f == b.r_f &&
+           a.r_ls == b.r_ls && a.r_rs == b.r_rs && a.r_c == b.r_c &&
+           a.r_ml == b.r_ml && a.r_mh == b.r_mh &&
+           a.r_sel_m_or_c == b.r_sel_m_or_c &&
+           a.control_signals == b.control_signals &&
+           a.alu_signals == b.alu_signals &&
+           a.address_bus == b.address_bus &&
+           a.data_bus == b.data_bus;
+}
 
-        uint8_t alu_h_q0_alu_h_qz = ALU_SIGNAL_H_QZ(alu_signals);
-        uint8_t alu_h_q1_alu_h_qc = ALU_SIGNAL_H_QC(alu_signals);
+static bool fast_forward_same_state(CPU cpu) {
+    if (fast_forward.n_ram_writes > FAST_FORWARD_MAX_RAM_WRITES) {
+        return false;
+    }
 
-        if (alu_l_qz == alu_l_q0_alu_l_qz && alu_l_qc == alu_l_q1_alu_l_qc &&
-            alu_h_qz == alu_h_q0_alu_h_qz && alu_h_qc == alu_h_q1_alu_h_qc) {
+    for (int i = 0; i < fast_forward.n_ram_writes; ++i) {
+        if (ram[fast_forward.ram_write_address[i]] != fast_forward.ram_write_prev_value[i]) {
+            return false;
+        }
+    }
 
-            if (i > 2) {
-                // TODO: Temp.
-                printf("\n I: %d\n", i);
-                exit(0);
-            }
+    return cpu_equal(fast_forward.cpu, cpu) &&
+           memcmp(fast_forward.io_ports, io_ports, sizeof(io_ports)) == 0 &&
+           memcmp(&fast_forward.io_lcd, &io_lcd, sizeof(io_lcd)) == 0 &&
+           memcmp(&fast_forward.io_boot_device, &io_boot_device, sizeof(io_boot_device)) == 0 &&
+           memcmp(fast_forward.registers, ram + 0x7ff0, sizeof(fast_forward.registers)) == 0;
+}
 
-            return alu_signals;
-        }
+static uint8_t read_memory(uint16_t address) {
+    return SIGNAL_EN_ROM(address) ? ram[address & (RAM_ABSOLUTE_START_ADDRESS - 1)]
+                                  : rom[address & (RAM_ABSOLUTE_START_ADDRESS - 1)];
+}
+
+// Flags as latched by an unary ALU operation on `ls`, evaluated through the ALU ROMs.
+static uint8_t alu_unary_flags(CPU cpu, ALU_OP alu_op, uint8_t ls) {
+    cpu.r_c = (uint8_t)((1 << 7) | alu_op);
+    cpu.r_ls = ls;
+    cpu.alu_signals = alu_signals(cpu);
 
-        alu_l_qz = alu_l_q0_alu_l_qz;
-        alu_l_qc = alu_l_q1_alu_l_qc;
+    return (uint8_t)((ALU_SIGNAL_Q_SF(cpu.alu_signals) << 3) |
+                     (ALU_SIGNAL_Q_OF(cpu.alu_signals) << 2) |
+                     (ALU_SIGNAL_Q_CF(cpu.alu_signals) << 1) |
+                     (ALU_SIGNAL_Q_ZF(cpu.alu_signals) << 0));
+}
 
-        alu_h_qz = alu_h_q0_alu_h_qz;
-        alu_h_qc = alu_h_q1_alu_h_qc;
+// Either jumps straight to the target state or, when verifying, remembers it
+// so it can be compared against when stepping gets there.
+static uint64_t fast_forward_to(CPU *cpu, FastForwardTarget target) {
+    if (verify_fast_forward) {
+        fast_forward_expected = target;
+        fast_forward_pending = true;
+        return 0;
     }
 
-    assert(0 && "ALU signals never settled");
+    uint64_t skipped_cycles = target.n_cycles - n_cycles;
+
+    *cpu = target.cpu;
+    memcpy(ram + 0x7ff0, target.registers, sizeof(target.registers));
+    n_cycles = target.n_cycles;
+    n_instructions = target.n_instructions;
+
+    return skipped_cycles;
 }
 
-static CPU update_cpu(CPU cpu) {
-    if (step_by_keyboard) {
-        fgetc(stdin);
+static void fast_forward_verify(CPU cpu) {
+    if (!fast_forward_pending || n_cycles < fast_forward_expected.n_cycles) {
+        return;
     }
 
-    if (!SIGNAL_HALT(cpu.control_signals)) {
-        step_by_keyboard = true;
-        cpu.control_signals ^= (1 << 5);
-        return cpu;
+    fast_forward_pending = false;
+
+    if (n_cycles != fast_forward_expected.n_cycles ||
+        n_instructions != fast_forward_expected.n_instructions ||
+        !cpu_equal(cpu, fast_forward_expected.cpu) ||
+        memcmp(ram + 0x7ff0, fast_forward_expected.registers, sizeof(fast_forward_expected.registers)) != 0) {
+        fprintf(stderr, "Fast-forward mismatch, expected cycle %llu instruction %d got cycle %llu instruction %d\n",
+                (unsigned long long)fast_forward_expected.n_cycles, fast_forward_expected.n_instructions,
+                (unsigned long long)n_cycles, n_instructions);
+        fprintf(stderr, "  Expected F: %x A: %x B: %x C: %x D: %x\n",
+                fast_forward_expected.cpu.r_f,
+                fast_forward_expected.registers[0], fast_forward_expected.registers[1],
+                fast_forward_expected.registers[2], fast_forward_expected.registers[3]);
+        fprintf(stderr, "  Got      F: %x A: %x B: %x C: %x D: %x\n",
+                cpu.r_f, ram[0x7ff0], ram[0x7ff1], ram[0x7ff2], ram[0x7ff3]);
+        exit(1);
     }
 
-    cpu.c_exec = (!cpu.c_exec) & 1;
+    ++n_fast_forwards_verified;
+}
 
-    if (!cpu.c_exec) { // C SETUP (~C EXEC)
-        // Count S
-        if (++cpu.r_s >= 0x10) {
-            cpu.r_s = 0;
-        }
+// Address of the instruction about to run, ML/MH is already past its opcode when prefetched.
+static uint16_t program_counter(CPU cpu) {
+    return (uint16_t)(((cpu.r_mh << 8) | cpu.r_ml) - control_prefetches);
+}
 
-        // Latch S
-        if (!SIGNAL_LD_S(cpu.control_signals)) {
-            cpu.r_s = 0x0;
-        }
+// Loops like `dec a` + `jnz` back to the `dec`, or `djnz b` back to itself, only change
+// the counter register and the flags, so every iteration but the last one can be applied at once.
+// The loop heads are recognized from the semantics derived from the loaded control ROM.
+static uint64_t fast_forward_counted_loop(CPU *cpu, int max_instructions) {
+    uint16_t pc = program_counter(*cpu);
+    const OpcodeSemantics *s = &control_semantics[read_memory(pc)];
 
-        // Latch C
-        if (!SIGNAL_LD_C(cpu.control_signals)) {
-            cpu.r_c = (uint8_t)((1 << 7) |
-                                (ALU_SIGNAL_Q_IO_OE(cpu.alu_signals) << 6) |
-                                (SIGNAL_C5_LS_ALU_Q_OR_HALT_C(cpu.control_signals) << 5) |
-                                (SIGNAL_C4_ALU_OP4_OR_LD_IO(cpu.control_signals) << 4) |
-                                (SIGNAL_C3_OR_LD_RS(cpu.control_signals) << 3) |
-                                (SIGNAL_C2_OR_LD_S(cpu.control_signals) << 2) |
-                                (SIGNAL_C1_OR_LD_O(cpu.control_signals) << 1) |
-                                (SIGNAL_C0_OR_CE_M(cpu.control_signals) << 0));
-
-            cpu.alu_signals = alu_signals(cpu);
-        }
+    if (!s->has_unary_update || s->update_reg > C_D || s->effects != 0 ||
+        (s->update_alu_op != ALU_OP_DEC_LS && s->update_alu_op != ALU_OP_INC_LS)) {
+        return 0;
+    }
 
-        // Count ML/MH
-        if (SIGNAL_LD_C(cpu.control_signals) && SIGNAL_C0_OR_CE_M(cpu.control_signals) && SIGNAL_LD_ML(cpu.control_signals)) {
-            // TODO: Understand why ++cpu.r_ml gives "runtime error: implicit conversion from type 'int' of value 256 (32-bit, signed) to type 'uint8_t' (aka 'unsigned char') changed the value to 0 (8-bit, unsigned)"
-            cpu.r_ml = (u_int8_t)(cpu.r_ml + 1);
-            if (cpu.r_ml == 0 && SIGNAL_LD_MH(cpu.control_signals)) {
-                ++cpu.r_mh;
-            }
-        }
+    bool is_counted_loop_head;
+    int loop_instructions;
 
-        // Latch ML
-        if (!SIGNAL_LD_ML(cpu.control_signals)) {
-            cpu.r_ml = cpu.data_bus;
-        }
+    if (!s->jumps) {
+        is_counted_loop_head =
+            s->falls_through && s->length == 1 &&
+            read_memory((uint16_t)(pc + 1)) == OPCODE_JNZ_IMM16 &&
+            read_memory((uint16_t)(pc + 2)) == (pc & 0xff) &&
+            read_memory((uint16_t)(pc + 3)) == (pc >> 8);
+        loop_instructions = 2;
+    } else {
+        // Decrements and jumps to its operand while not zero, `djnz`.
+        is_counted_loop_head =
+            s->falls_through && s->length == 3 && s->update_alu_op == ALU_OP_DEC_LS &&
+            s->jump_deps == (SEMANTICS_DEP_OPERAND_0 | SEMANTICS_DEP_OPERAND_1) &&
+            s->control_flags_read == 0 && (s->flags_written & 1) && // Steps by the ZF it produced
+            read_memory((uint16_t)(pc + 1)) == (pc & 0xff) &&
+            read_memory((uint16_t)(pc + 2)) == (pc >> 8);
+        loop_instructions = 1;
+    }
 
-        // Latch MH
-        if (!SIGNAL_LD_MH(cpu.control_signals)) {
-            cpu.r_mh = cpu.data_bus;
-        }
+    if (!is_counted_loop_head) {
+        return 0;
+    }
 
-        // Toggle SEL ~M/C
-        if (SIGNAL_TOGGLE_M_C(cpu.control_signals)) {
-            cpu.r_sel_m_or_c = (!cpu.r_sel_m_or_c) & 1;
-        }
+    ALU_OP alu_op = (ALU_OP)s->update_alu_op;
+    uint8_t reg = s->update_reg;
 
-        uint32_t control_l_address = (uint32_t)((S_Q2(cpu.r_s) << 16) |
-                                                (S_Q1(cpu.r_s) << 15) |
-                                                (S_Q3(cpu.r_s) << 14) |
-                                                (F_SF(cpu.r_f) << 13) |
-                                                (S_Q0(cpu.r_s) << 12) |
-                                                (F_ZF(cpu.r_f) << 11) |
-                                                (0 << 10) |
-                                                (F_CF(cpu.r_f) << 9) |
-                                                (F_OF(cpu.r_f) << 8) |
-                                                cpu.r_o);
-
-        uint32_t control_h_address = (uint32_t)((S_Q2(cpu.r_s) << 16) |
-                                                (S_Q1(cpu.r_s) << 15) |
-                                                (S_Q3(cpu.r_s) << 14) |
-                                                (F_SF(cpu.r_f) << 13) |
-                                                (S_Q0(cpu.r_s) << 12) |
-                                                (F_ZF(cpu.r_f) << 11) |
-                                                (1 << 10) | (F_CF(cpu.r_f) << 9) |
-                                                (F_OF(cpu.r_f) << 8) |
-                                                cpu.r_o);
-
-        cpu.control_signals = (uint16_t)(control_rom[control_h_address] << 8) |
-                              control_rom[control_l_address];
-
-        cpu.address_bus = cpu.r_sel_m_or_c
-                              ? (0xfff0 | (cpu.r_c & 0xf))
-                              : (uint16_t)(cpu.r_mh << 8) | cpu.r_ml;
-
-        int n_oe = 0;
-
-        // Assert ML to data bus
-        if (!SIGNAL_OE_ML(cpu.control_signals)) {
-            cpu.data_bus = cpu.r_ml;
-            ++n_oe;
-        }
+    uint8_t *registers = ram + 0x7ff0;
+    uint8_t step = alu_op == ALU_OP_DEC_LS ? 0xff : 1;
 
-        // Assert MH to data bus
-        if (!SIGNAL_OE_MH(cpu.control_signals)) {
-            cpu.data_bus = cpu.r_mh;
-            ++n_oe;
-        }
+    // Everything must be identical to the previous visit except the counter and the flags it produced.
+    bool is_next_iteration = counted_loop.armed &&
+                             counted_loop.pc == pc &&
+                             n_instructions - counted_loop.n_instructions == loop_instructions &&
+                             (uint8_t)(counted_loop.registers[reg] + step) == registers[reg] &&
+                             F_CF(counted_loop.cpu.r_f) == F_CF(cpu->r_f);
 
-        // Assert ALU to data bus
-        if (!SIGNAL_OE_ALU(cpu.control_signals)) {
-            cpu.data_bus = ALU_SIGNAL_Q(cpu.alu_signals);
-            ++n_oe;
-        }
+    if (is_next_iteration) {
+        CPU prev_cpu = counted_loop.cpu;
+        prev_cpu.r_f = cpu->r_f;
 
-        // Assert MEM to data bus
-        if (!SIGNAL_OE_MEM(cpu.control_signals)) {
-            if (!SIGNAL_EN_ROM(cpu.address_bus)) {
-                cpu.data_bus = rom[cpu.address_bus & (RAM_ABSOLUTE_START_ADDRESS - 1)];
-                ++n_oe;
-            }
+        counted_loop.registers[reg] = registers[reg];
 
-            if (!SIGNAL_EN_RAM(cpu.address_bus)) {
-                cpu.data_bus = ram[cpu.address_bus & (RAM_ABSOLUTE_START_ADDRESS - 1)];
-                ++n_oe;
-            }
-        }
+        is_next_iteration = cpu_equal(prev_cpu, *cpu) &&
+                            memcmp(counted_loop.registers, registers, sizeof(counted_loop.registers)) == 0;
+    }
 
-        if (C_OE_IO(cpu.r_c)) {
-            cpu.data_bus = update_io_oe(cpu);
-            ++n_oe;
-        }
+    if (!is_next_iteration) {
+        counted_loop.armed = true;
+        counted_loop.pc = pc;
+        counted_loop.cpu = *cpu;
+        counted_loop.n_cycles = n_cycles;
+        counted_loop.n_instructions = n_instructions;
+        memcpy(counted_loop.registers, registers, sizeof(counted_loop.registers));
+        return 0;
+    }
 
-        if (n_oe == 0) {
-            cpu.data_bus = 0xff; // Data bus is pulled up
-        }
+    counted_loop.armed = false;
 
-        assert(n_oe <= 1 && "More then one is asserting to the data bus");
-    } else { // C EXEC
-        bool update_alu_signals = false;
+    uint64_t loop_cycles = n_cycles - counted_loop.n_cycles;
 
-        // Latch O
-        if (!SIGNAL_LD_O(cpu.control_signals)) {
-            cpu.r_o = cpu.data_bus;
-        }
+    // Iterations left until the counter reaches zero, the last one falls through.
+    uint8_t n_to_zero = alu_op == ALU_OP_DEC_LS ? registers[reg] : (uint8_t)(0x100 - registers[reg]);
+    int n_taken = (n_to_zero == 0 ? 0x100 : n_to_zero) - 1;
+    int n_loops = (max_instructions - n_instructions) / loop_instructions;
 
-        // Latch RS
-        if (!SIGNAL_LD_RS(cpu.control_signals)) {
-            cpu.r_rs = cpu.data_bus;
+    n_loops = n_taken < n_loops ? n_taken : n_loops;
 
-            update_alu_signals = true;
-        }
+    if (n_loops <= 0) {
+        return 0;
+    }
 
-        // Latch LS
-        if (!SIGNAL_LD_LS(cpu.control_signals)) {
-            cpu.r_ls = cpu.data_bus;
+    FastForwardTarget target = {
+        .cpu = *cpu,
+        .n_cycles = n_cycles + (uint64_t)n_loops * loop_cycles,
+        .n_instructions = n_instructions + n_loops * loop_instructions,
+    };
 
-            update_alu_signals = true;
-        }
+    memcpy(target.registers, registers, sizeof(target.registers));
 
-        // Latch RAM (ROM is read only :))
-        if (!SIGNAL_C_LD_MEM(cpu.control_signals, cpu.c_exec) && !SIGNAL_EN_RAM(cpu.address_bus)) {
-            ram[cpu.address_bus & (RAM_ABSOLUTE_START_ADDRESS - 1)] = cpu.data_bus;
-        }
+    target.registers[reg] = (uint8_t)(registers[reg] + n_loops * step);
+    target.cpu.r_f = alu_unary_flags(*cpu, alu_op, (uint8_t)(target.registers[reg] - step));
+
+    return fast_forward_to(cpu, target);
+}
+
+// Loops where nothing but time can change the outcome, e.g. polling the LCD
+// busy flag, are skipped up to the next device event.
+static uint64_t fast_forward_idle_loop(CPU *cpu, int max_instructions) {
+    uint16_t pc = program_counter(*cpu);
+
+    if (!fast_forward.armed ||
+        n_instructions - fast_forward.n_instructions > FAST_FORWARD_MAX_LOOP_INSTRUCTIONS) {
+        fast_forward_arm(*cpu, pc);
+        return 0;
+    }
+
+    if (pc != fast_forward.pc) {
+        return 0;
+    }
+
+    if (!fast_forward_same_state(*cpu)) {
+        fast_forward_arm(*cpu, pc);
+        return 0;
+    }
+
+    uint64_t loop_cycles = n_cycles - fast_forward.n_cycles;
+    int loop_instructions = n_instructions - fast_forward.n_instructions;
+
+    // Any device output change during the recorded iteration makes it unusable.
+    uint64_t lcd_event_cycle = lcd_next_event_cycle(fast_forward.n_cycles);
+    uint64_t boot_device_event_cycle = boot_device_next_event_cycle(fast_forward.n_cycles);
+    uint64_t next_event_cycle = lcd_event_cycle < boot_device_event_cycle ? lcd_event_cycle : boot_device_event_cycle;
+
+    if (next_event_cycle <= n_cycles || loop_cycles == 0 || loop_instructions == 0) {
+        fast_forward_arm(*cpu, pc);
+        return 0;
+    }
+
+    uint64_t n_loops = (uint64_t)((max_instructions - n_instructions) / loop_instructions);
+
+    if (next_event_cycle != NO_EVENT) {
+        uint64_t n_loops_until_event = (next_event_cycle - n_cycles) / loop_cycles;
+        n_loops = n_loops_until_event < n_loops ? n_loops_until_event : n_loops;
+    }
+
+    FastForwardTarget target = {
+        .cpu = *cpu,
+        .n_cycles = n_cycles + n_loops * loop_cycles,
+        .n_instructions = n_instructions + (int)n_loops * loop_instructions,
+    };
+
+    memcpy(target.registers, ram + 0x7ff0, sizeof(target.registers));
+
+    uint64_t skipped_cycles = n_loops > 0 ? fast_forward_to(cpu, target) : 0;
+
+    fast_forward_arm(*cpu, pc);
+
+    return skipped_cycles;
+}
+
+// Called when about to fetch an opcode, returns the number of skipped cycles.
+static uint64_t fast_forward_loop(CPU *cpu, int max_instructions) {
+    fast_forward_verify(*cpu);
+
+    if (step_by_keyboard) {
+        fast_forward.armed = false;
+        counted_loop.armed = false;
+        return 0;
+    }
+
+    // ML/MH is only the program counter when fetching from it.
+    if (cpu->r_sel_m_or_c || fast_forward_pending) {
+        return 0;
+    }
+
+    uint64_t skipped_cycles = fast_forward_counted_loop(cpu, max_instructions);
+
+    return skipped_cycles > 0 || fast_forward_pending
+               ? skipped_cycles
+               : fast_forward_idle_loop(cpu, max_instructions);
+}
+
+static void update_ram_ld(uint16_t ram_address) {
+    fast_forward_note_ram_write(ram_address);
+}
+
+static CPU update_cpu(CPU cpu) {
+    if (step_by_keyboard) {
+        fgetc(stdin);
+    }
+
+    if (!SIGNAL_HALT(cpu.control_signals)) {
+        step_by_keyboard = true;
+        cpu.control_signals ^= (1 << 5);
+        return cpu;
+    }
+
+    return cpu_half_cycle(cpu);
+}
 
-        // Latch F
-        if (!SIGNAL_OE_ALU(cpu.control_signals) && !SIGNAL_LD_LS(cpu.control_signals)) {
-            cpu.r_f = (uint8_t)((ALU_SIGNAL_Q_SF(cpu.alu_signals) << 3) |
-                                (ALU_SIGNAL_Q_OF(cpu.alu_signals) << 2) |
-                                (ALU_SIGNAL_Q_CF(cpu.alu_signals) << 1) |
-                                (ALU_SIGNAL_Q_ZF(cpu.alu_signals) << 0));
+static void *present(void *arg) {
+    (void)arg;
 
-            update_alu_signals = true;
+    static char log_history[LOG_HISTORY][LOG_LINE_CAP];
+    int n_log_history = 0;
+
+    struct timespec frame_ts = {.tv_sec = 0, .tv_nsec = PRESENTATION_FRAME_NS};
+
+    while (1) {
+        // Read the done flag before taking a snapshot to never miss the last one.
+        bool done = atomic_load_explicit(&emulation_done, memory_order_acquire);
+
+        uint32_t tail = atomic_load_explicit(&log_tail, memory_order_relaxed);
+        uint32_t head = atomic_load_explicit(&log_head, memory_order_acquire);
+
+        for (; tail != head; ++tail) {
+            if (n_log_history == LOG_HISTORY) {
+                memmove(log_history[0], log_history[1], sizeof(log_history[0]) * (LOG_HISTORY - 1));
+                --n_log_history;
+            }
+
+            memcpy(log_history[n_log_history++], log_lines[tail & (LOG_CAP - 1)], LOG_LINE_CAP);
         }
 
-        // Latch IO
-        if (!SIGNAL_LD_IO(cpu.control_signals)) {
-            io_ports[cpu.r_o & 7] = cpu.data_bus;
+        atomic_store_explicit(&log_tail, tail, memory_order_release);
+
+        const Snapshot *snapshot = take_snapshot();
 
-            update_io_ld(cpu);
+        if (snapshot != NULL) {
+            print_state(snapshot, (const char(*)[LOG_LINE_CAP])log_history, n_log_history);
+        } else if (done) {
+            break;
         }
 
-        if (update_alu_signals) {
-            cpu.alu_signals = alu_signals(cpu);
+        nanosleep(&frame_ts, NULL);
+    }
+
+    return NULL;
+}
+
+// Reads a binary, or assembles a `.asm` file, into `output` and returns its size.
+static size_t load_program(const char *filename, uint8_t *output, size_t output_size) {
+    size_t program_name_length = strlen(filename);
+
+    if (program_name_length > 4 && strcmp(filename + program_name_length - 4, ".asm") == 0) {
+        // Assembled in-process with the rules from rule_from_opcode, no customasm step needed.
+        size_t program_size = 0;
+
+        if (assemble(filename, output, output_size, &program_size) > 0) {
+            exit(1);
         }
+
+        return program_size;
     }
 
-    return cpu;
+    FILE *file = fopen(filename, "r");
+    assert(file != NULL && "Failed to read program");
+
+    fseek(file, 0, SEEK_END);
+    long program_size = ftell(file);
+    assert(program_size >= 0);
+    fseek(file, 0, SEEK_SET);
+    assert((size_t)program_size <= output_size && "Program too big");
+
+    size_t read_bytes = fread(output, sizeof(uint8_t), (size_t)program_size, file);
+    assert(read_bytes == (size_t)program_size && "Failed to read entire contents of program");
+    assert(fclose(file) == 0 && "Failed to close file");
+
+    return (size_t)program_size;
 }
 
 int main(int argc, char **argv) {
@@ -680,51 +1071,84 @@ int main(int argc, char **argv) {
         exit(1);
     }
 
-    uint32_t clock_hz = argc > 2
-                            ? (uint32_t)strtoul(argv[2], NULL, 10)
-                            : 20;
+    clock_hz = argc > 2
+                   ? (uint32_t)strtoul(argv[2], NULL, 10)
+                   : clock_hz;
+
+    const char *boot_device_program = NULL;
+
+    for (int i = 3; i < argc; ++i) {
+        if (strcmp(argv[i], "--verify-fast-forward") == 0) {
+            verify_fast_forward = true;
+        } else if (strcmp(argv[i], "--boot-device") == 0 && i + 1 < argc) {
+            boot_device_program = argv[++i];
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            exit(1);
+        }
+    }
 
     if (clock_hz < 1 || clock_hz > 16000000) {
         fprintf(stderr, "Unsupported clock rate: %u\n", clock_hz);
         exit(1);
     }
 
-    FILE *file = fopen(argv[1], "r");
-    assert(file != NULL && "Failed to read program");
+    // With a boot device the program is the boot ROM, loading the device's program into RAM.
+    if (boot_device_program != NULL) {
+        static uint8_t boot_program[BOOT_PROGRAM_SIZE_CAP];
 
-    fseek(file, 0, SEEK_END);
-    long program_size = ftell(file);
-    assert(program_size >= 0);
-    fseek(file, 0, SEEK_SET);
-    assert(program_size <= (RAM_SIZE - PROGRAM_RAM_RELATIVE_START_ADDRESS) && "Program too big");
+        load_program(argv[1], rom, ROM_SIZE);
+        boot_device_load(&boot_device, boot_program,
+                         (uint16_t)load_program(boot_device_program, boot_program, sizeof(boot_program)));
+        boot_device_attached = true;
+    } else {
+        load_program(argv[1], ram + PROGRAM_RAM_RELATIVE_START_ADDRESS, RAM_SIZE - PROGRAM_RAM_RELATIVE_START_ADDRESS);
+    }
 
-    size_t read_bytes = fread(ram + PROGRAM_RAM_RELATIVE_START_ADDRESS, sizeof(uint8_t), (size_t)program_size, file);
-    assert(read_bytes == (size_t)program_size && "Failed to read entire contents of program");
-    assert(fclose(file) == 0 && "Failed to close file");
+    read_rom("./bin/control.bin", control_rom, CONTROL_ROM_SIZE);
+    read_rom("./bin/alu_low.bin", alu_low_rom, ALU_ROM_SIZE);
+    read_rom("./bin/alu_high.bin", alu_high_rom, ALU_ROM_SIZE);
+
+    // Checks every opcode, flag and step up front instead of only the paths the program happens to run.
+    static OpcodeVerification verifications[256];
+    if (verify_table((const uint8_t(*)[CONTROL_ROM_SIZE])&control_rom, &verifications) > 0) {
+        for (int opcode = 0; opcode < 256; ++opcode) {
+            if (verifications[opcode].error != VERIFY_OK) {
+                fprintf(stderr, "control.bin opcode 0x%02x step %d with flags %x %s\n", opcode,
+                        verifications[opcode].error_step, verifications[opcode].error_flags,
+                        verify_error_string(verifications[opcode].error));
+            }
+        }
+        exit(1);
+    }
 
-    file = fopen("./bin/control.bin", "r");
-    assert(file != NULL && "Failed to read control.bin");
-    read_bytes = fread(control_rom, sizeof(uint8_t), CONTROL_ROM_SIZE, file);
-    assert(read_bytes == CONTROL_ROM_SIZE && "Failed to read the entire contents of control.bin");
-    assert(fclose(file) == 0 && "Failed to close file");
+    control_prefetches = signals_from_table((const uint8_t(*)[CONTROL_ROM_SIZE])&control_rom, 0, 0, OPCODE_JMP_IMM16) != FETCH_OPCODE;
+    derive_semantics((const uint8_t(*)[CONTROL_ROM_SIZE])&control_rom, &control_semantics);
 
-    file = fopen("./bin/alu_low.bin", "r");
-    assert(file != NULL && "Failed to read alu_low.bin");
-    read_bytes = fread(alu_low_rom, sizeof(uint8_t), ALU_ROM_SIZE, file);
-    assert(read_bytes == ALU_ROM_SIZE && "Failed to read the entire contents of alu_low.bin");
-    assert(fclose(file) == 0 && "Failed to close file");
+#ifdef HAS_OPCODE_SEMANTICS
+    // A control.bin built since the emulator was compiled against opcode_semantics.h would run other semantics.
+    int n_mismatches = 0;
+    for (int opcode = 0; opcode < 256; ++opcode) {
+        if (!semantics_equal(&control_semantics[opcode], &opcode_semantics[opcode])) {
+            fprintf(stderr, "control.bin opcode 0x%02x doesn't match opcode_semantics.h\n", opcode);
+            ++n_mismatches;
+        }
+    }
 
-    file = fopen("./bin/alu_high.bin", "r");
-    assert(file != NULL && "Failed to read alu_high.bin");
-    read_bytes = fread(alu_high_rom, sizeof(uint8_t), ALU_ROM_SIZE, file);
-    assert(read_bytes == ALU_ROM_SIZE && "Failed to read the entire contents of alu_high.bin");
-    assert(fclose(file) == 0 && "Failed to close file");
+    if (n_mismatches > 0) {
+        fprintf(stderr, "Run semantics.c on control.bin and compile the emulator again\n");
+        exit(1);
+    }
+#endif
 
-    rom[0] = OPCODE_JMP_IMM16;
-    rom[1] = (RAM_ABSOLUTE_START_ADDRESS + PROGRAM_RAM_RELATIVE_START_ADDRESS) & 0xff;
-    rom[2] = (RAM_ABSOLUTE_START_ADDRESS + PROGRAM_RAM_RELATIVE_START_ADDRESS) >> 8;
+    if (!boot_device_attached) {
+        rom[0] = OPCODE_JMP_IMM16;
+        rom[1] = (RAM_ABSOLUTE_START_ADDRESS + PROGRAM_RAM_RELATIVE_START_ADDRESS) & 0xff;
+        rom[2] = (RAM_ABSOLUTE_START_ADDRESS + PROGRAM_RAM_RELATIVE_START_ADDRESS) >> 8;
+    }
 
     // Reset by running an initial setup phase where S is 0 afterwards.
+    // O is cleared as well, with a prefetching control ROM the nop at step 0 fetches the first opcode.
     CPU state = update_cpu((CPU){.c_exec = 1,
                                  .r_s = 0xf});
 
@@ -733,13 +1157,19 @@ int main(int argc, char **argv) {
         .tv_nsec = clock_hz <= 1 ? 0 : (1000000000 / clock_hz),
     };
 
+    pthread_t presentation_thread;
+    int error = pthread_create(&presentation_thread, NULL, present, NULL);
+    assert(error == 0 && "Failed to create presentation thread");
+
     while (1) {
         // Execute
         state = update_cpu(state);
-        print_state(state);
+        publish_snapshot(state);
 
         nanosleep(&ts, NULL);
 
+        ++n_cycles;
+
         if (!SIGNAL_LD_S(state.control_signals)) {
             ++n_instructions;
 
@@ -750,10 +1180,32 @@ int main(int argc, char **argv) {
 
         // Setup
         state = update_cpu(state);
-        print_state(state);
+        publish_snapshot(state);
 
         nanosleep(&ts, NULL);
+
+        // All latches of the previous instruction are done when about to fetch, or run a prefetched, opcode.
+        if (state.r_s == 0) {
+            uint64_t skipped_cycles = fast_forward_loop(&state, EXIT_AFTER_N_INSTRUCTIONS - 1);
+
+            if (skipped_cycles > 0) {
+                n_fast_forwarded_cycles += skipped_cycles;
+
+                // Keep the emulated clock rate, in one sleep instead of one per half cycle.
+                uint64_t skipped_ns = skipped_cycles * 2 * ((uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec);
+                struct timespec skipped_ts = {
+                    .tv_sec = (time_t)(skipped_ns / 1000000000),
+                    .tv_nsec = (long)(skipped_ns % 1000000000),
+                };
+                nanosleep(&skipped_ts, NULL);
+            }
+        }
     }
 
+    atomic_store_explicit(&emulation_done, true, memory_order_release);
+
+    error = pthread_join(presentation_thread, NULL);
+    assert(error == 0 && "Failed to join presentation thread");
+
     return 0;
 }
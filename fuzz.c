@@ -0,0 +1,759 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h> // f*, printf, snprintf
+#include <stdlib.h> // exit, strtoul
+#include <string.h> // memcpy, memset
+#include <sys/mman.h> // mmap
+#include <sys/wait.h> // wait
+#include <time.h> // clock_gettime
+#include <unistd.h> // fork, sysconf
+
+#include "control.h"
+#include "control_verify.h"
+#include "cpu.h"
+#include "isa.h"
+
+// Differential fuzzer, runs random instruction streams through both the half cycle engine with
+// the generated control ROM and the reference model in `isa.h`, comparing them after every
+// instruction.
+//
+// The engine keeps its state in globals, so streams are sharded over forked workers rather
+// than threads. Workers report through a shared mapping.
+
+#define DEFAULT_N_STREAMS (2048) // Per worker
+#define N_STREAM_INSTRUCTIONS (48) // Placed in a row, jumps land on one of them
+#define MAX_RUN_INSTRUCTIONS (256) // Streams that loop are cut here
+#define MAX_WORKERS (64)
+#define MAX_ENGINE_WRITES (32)
+#define MAX_ENGINE_OUTS (4)
+#define REPRODUCER_SIZE (2048)
+
+#define CODE_START_ADDRESS (0x8000)
+#define CODE_SIZE (0x3000)
+#define DATA_START_ADDRESS (0xc000)
+#define DATA_SIZE (0x3f00) // Up to the stack page
+
+typedef struct {
+    uint16_t pc;
+    uint8_t f;
+    uint8_t io_inputs[8];
+    uint8_t ram[RAM_SIZE];
+    CPU cpu; // LS, RS, O and C as left by the previous instruction
+} Snapshot;
+
+typedef struct {
+    bool found;
+    int n_instructions; // Run by both before the one that diverged
+    char why[256];
+} Divergence;
+
+typedef struct {
+    bool done; // Cleared when a worker died, cpu.h may exit on its own
+    uint64_t n_streams;
+    uint64_t n_instructions;
+    uint64_t n_stops[4]; // By IsaResult, ISA_OK counts streams cut at MAX_RUN_INSTRUCTIONS
+    bool diverged;
+    char reproducer[REPRODUCER_SIZE];
+    uint8_t covered[256][N_STEPS][16]; // Opcode, step and F the engine looked up signals for
+} WorkerResult;
+
+static const char *register_names[16] = {
+    "a", "b", "c", "d", "sp", "il", "ih", "jl", "jh", "r9", "ra", "tl", "th", "ul", "re", "rf"};
+
+static const char *stop_names[4] = {
+    [ISA_OK] = "ran too long",
+    [ISA_STOP_HALT] = "halt",
+    [ISA_STOP_UNDEFINED] = "undefined opcode",
+    [ISA_STOP_REGISTER_AREA] = "register area",
+};
+
+static uint8_t valid_opcodes[256];
+static int n_valid_opcodes;
+
+static uint8_t isa_ram[RAM_SIZE];
+static const uint8_t *io_inputs;
+
+static int n_engine_writes;
+static uint16_t engine_write_addresses[MAX_ENGINE_WRITES];
+static int n_engine_outs;
+static uint8_t engine_out_ports[MAX_ENGINE_OUTS];
+static uint8_t engine_out_values[MAX_ENGINE_OUTS];
+static bool bus_conflict;
+
+static uint8_t (*covered)[N_STEPS][16];
+
+static void update_io_ld(CPU cpu) {
+    if (n_engine_outs < MAX_ENGINE_OUTS) {
+        engine_out_ports[n_engine_outs] = cpu.r_o & 7;
+        engine_out_values[n_engine_outs] = cpu.data_bus;
+    }
+
+    ++n_engine_outs;
+}
+
+static uint8_t update_io_oe(CPU cpu) {
+    return io_inputs[cpu.r_o & 7];
+}
+
+static void update_ram_ld(uint16_t ram_address) {
+    if (n_engine_writes < MAX_ENGINE_WRITES) {
+        engine_write_addresses[n_engine_writes++] = (uint16_t)(RAM_ABSOLUTE_START_ADDRESS | ram_address);
+    } else {
+        bus_conflict = true; // Can't compare what it wrote, treat the run as broken
+    }
+}
+
+static void update_bus_conflict(CPU cpu, int n_oe) {
+    (void)cpu;
+    (void)n_oe;
+
+    bus_conflict = true;
+}
+
+static uint32_t random_state = 0x2f6b1d35;
+
+static uint32_t random_u32(void) {
+    // xorshift32
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+
+    return random_state;
+}
+
+static uint8_t random_u8(void) {
+    return (uint8_t)random_u32();
+}
+
+// Streams are reproducible from the seed and their index alone, whichever worker ran them.
+static void seed_random(uint32_t seed, uint32_t stream) {
+    random_state = 0x2f6b1d35 ^ seed;
+
+    for (int i = 0; i < 8; ++i) {
+        random_u32();
+    }
+
+    random_state ^= stream;
+
+    if (random_state == 0) {
+        random_state = 1;
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        random_u32();
+    }
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint8_t *snapshot_reg(Snapshot *snapshot, uint8_t reg) {
+    return &snapshot->ram[ISA_REGISTERS_ADDRESS - ISA_RAM_START_ADDRESS + reg];
+}
+
+// Mostly inside the data area, sometimes anywhere.
+static uint16_t random_pointer(void) {
+    return (random_u32() & 3)
+               ? (uint16_t)(DATA_START_ADDRESS + random_u32() % DATA_SIZE)
+               : (uint16_t)random_u32();
+}
+
+static void generate_stream(Snapshot *snapshot) {
+    for (size_t i = 0; i < RAM_SIZE; ++i) {
+        snapshot->ram[i] = random_u8();
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        snapshot->io_inputs[i] = random_u8();
+    }
+
+    snapshot->pc = (uint16_t)(CODE_START_ADDRESS + random_u32() % (CODE_SIZE - 3 * N_STREAM_INSTRUCTIONS));
+    snapshot->f = random_u8() & 0xf;
+
+    uint8_t opcodes[N_STREAM_INSTRUCTIONS];
+    uint16_t addresses[N_STREAM_INSTRUCTIONS];
+    uint16_t address = snapshot->pc;
+
+    for (int i = 0; i < N_STREAM_INSTRUCTIONS; ++i) {
+        opcodes[i] = valid_opcodes[random_u32() % (uint32_t)n_valid_opcodes];
+        addresses[i] = address;
+        address = (uint16_t)(address + isa_instruction_length(opcodes[i]));
+    }
+
+    for (int i = 0; i < N_STREAM_INSTRUCTIONS; ++i) {
+        uint8_t *code = &snapshot->ram[addresses[i] - RAM_ABSOLUTE_START_ADDRESS];
+        uint16_t target = addresses[random_u32() % N_STREAM_INSTRUCTIONS];
+
+        code[0] = opcodes[i];
+
+        switch (opcodes[i]) {
+        case OPCODE_LD_I_IMM16:
+        case OPCODE_LD_J_IMM16: {
+            uint16_t pointer = (random_u32() & 7) ? random_pointer() : target;
+            code[1] = (uint8_t)pointer;
+            code[2] = (uint8_t)(pointer >> 8);
+        } break;
+
+        case OPCODE_JMP_IMM16:
+        case OPCODE_JZ_IMM16:
+        case OPCODE_JNZ_IMM16:
+        case OPCODE_JC_IMM16:
+        case OPCODE_JNC_IMM16:
+        case OPCODE_JO_IMM16:
+        case OPCODE_JNO_IMM16:
+        case OPCODE_JS_IMM16:
+        case OPCODE_JNS_IMM16:
+        case OPCODE_CALL_IMM16:
+        case OPCODE_DJNZ_B_IMM16:
+        case OPCODE_DJNZ_C_IMM16:
+        case OPCODE_DJNZ_D_IMM16:
+            code[1] = (uint8_t)target;
+            code[2] = (uint8_t)(target >> 8);
+            break;
+
+        case OPCODE_LD_SP_IMM8: code[1] = (uint8_t)(random_u32() % 0xe0); break;
+
+        default: break; // Operands stay random
+        }
+    }
+
+    uint16_t i = random_pointer();
+    uint16_t j = random_pointer();
+
+    *snapshot_reg(snapshot, ISA_SP) = (uint8_t)(random_u32() % 0xe0);
+    *snapshot_reg(snapshot, ISA_IL) = (uint8_t)i;
+    *snapshot_reg(snapshot, ISA_IH) = (uint8_t)(i >> 8);
+    *snapshot_reg(snapshot, ISA_JL) = (uint8_t)j;
+    *snapshot_reg(snapshot, ISA_JH) = (uint8_t)(j >> 8);
+
+    // Any instruction leaves C with IO OE cleared and a constant other than ALU_OP_SET_IO_OE_FLAG.
+    uint8_t c;
+
+    do {
+        c = random_u8() & 0x3f;
+    } while (c == ALU_OP_SET_IO_OE_FLAG);
+
+    snapshot->cpu = (CPU){
+        .r_o = random_u8(),
+        .r_ls = random_u8(),
+        .r_rs = random_u8(),
+        .r_c = (uint8_t)(0x80 | c),
+    };
+}
+
+// Right after the last step of a previous instruction, S wraps to 0 on the next setup.
+static CPU start_cpu(const Snapshot *snapshot) {
+    CPU cpu = snapshot->cpu;
+
+    cpu.c_exec = 1;
+    cpu.r_s = 0xf;
+    cpu.r_f = snapshot->f;
+    cpu.r_ml = (uint8_t)(snapshot->pc & 0xff);
+    cpu.r_mh = (uint8_t)(snapshot->pc >> 8);
+    cpu.r_sel_m_or_c = 0;
+    cpu.control_signals = ACTIVE_LOW_MASK;
+    cpu.alu_signals = alu_signals(cpu);
+
+    return cpu;
+}
+
+// Runs one instruction, leaving the CPU right after the setup that starts the next one.
+static bool engine_step(CPU *cpu) {
+    n_engine_writes = 0;
+    n_engine_outs = 0;
+    bus_conflict = false;
+
+    for (int half_cycle = 0; half_cycle < 2 * N_STEPS + 1 && !bus_conflict; ++half_cycle) {
+        *cpu = cpu_half_cycle(*cpu);
+
+        // Signals are looked up during setup, O is only known after the fetch executed.
+        if (covered != NULL && cpu->c_exec == (cpu->r_s == 0)) {
+            covered[cpu->r_o][cpu->r_s][cpu->r_f] = 1;
+        }
+
+        if (cpu->c_exec && !SIGNAL_LD_S(cpu->control_signals)) {
+            // The last step latches ML, MH, C and toggles during the next setup.
+            *cpu = cpu_half_cycle(*cpu);
+
+            return !bus_conflict;
+        }
+    }
+
+    return false;
+}
+
+static bool compare_byte(char *why, size_t why_size, const char *name, uint8_t engine, uint8_t reference) {
+    if (engine == reference) {
+        return true;
+    }
+
+    snprintf(why, why_size, "%s is 0x%02x, expected 0x%02x", name, engine, reference);
+
+    return false;
+}
+
+static bool compare_address(char *why, size_t why_size, uint16_t address) {
+    if (address < RAM_ABSOLUTE_START_ADDRESS ||
+        (address >= ISA_REGISTERS_ADDRESS && ISA_IS_SCRATCH_REGISTER(address & 0xf))) {
+        return true;
+    }
+
+    char name[16];
+    snprintf(name, sizeof(name), "[0x%04x]", address);
+
+    return compare_byte(why, why_size, name, ram[address - RAM_ABSOLUTE_START_ADDRESS], isa_ram[address - RAM_ABSOLUTE_START_ADDRESS]);
+}
+
+// Everything an instruction leaves behind, except the scratch registers and what LS, RS, O and
+// C hold since they are always loaded before being used.
+static bool compare(const CPU *cpu, const IsaState *isa, char *why, size_t why_size) {
+    uint16_t pc = (uint16_t)((cpu->r_mh << 8) | cpu->r_ml);
+
+    if (pc != isa->pc) {
+        snprintf(why, why_size, "pc is 0x%04x, expected 0x%04x", pc, isa->pc);
+        return false;
+    }
+
+    if (cpu->r_sel_m_or_c) {
+        snprintf(why, why_size, "the address bus is left selecting C");
+        return false;
+    }
+
+    if (C_OE_IO(cpu->r_c)) {
+        snprintf(why, why_size, "the IO port is left asserting to the data bus");
+        return false;
+    }
+
+    if (!compare_byte(why, why_size, "F", cpu->r_f, isa->f)) {
+        return false;
+    }
+
+    for (uint8_t reg = 0; reg < 16; ++reg) {
+        if (!ISA_IS_SCRATCH_REGISTER(reg) &&
+            !compare_byte(why, why_size, register_names[reg], ram[ISA_REGISTERS_ADDRESS - RAM_ABSOLUTE_START_ADDRESS + reg], isa_ram[ISA_REGISTERS_ADDRESS - RAM_ABSOLUTE_START_ADDRESS + reg])) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < n_engine_writes; ++i) {
+        if (!compare_address(why, why_size, engine_write_addresses[i])) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < isa->n_writes; ++i) {
+        if (!compare_address(why, why_size, isa->write_addresses[i])) {
+            return false;
+        }
+    }
+
+    if (n_engine_outs != isa->n_outs) {
+        snprintf(why, why_size, "%d out latches, expected %d", n_engine_outs, isa->n_outs);
+        return false;
+    }
+
+    for (int i = 0; i < isa->n_outs; ++i) {
+        if (engine_out_ports[i] != isa->out_ports[i] || engine_out_values[i] != isa->out_values[i]) {
+            snprintf(why, why_size, "out 0x%02x to port %d, expected 0x%02x to port %d",
+                     engine_out_values[i], engine_out_ports[i], isa->out_values[i], isa->out_ports[i]);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Runs both from the snapshot, stops at the first divergence or when the reference stops.
+// Leaves the state before the last instruction in `before` when given.
+static Divergence run(const Snapshot *snapshot, int max_instructions, IsaResult *stop, Snapshot *before) {
+    Divergence divergence = {0};
+
+    memcpy(ram, snapshot->ram, RAM_SIZE);
+    memcpy(isa_ram, snapshot->ram, RAM_SIZE);
+    io_inputs = snapshot->io_inputs;
+
+    IsaState isa = {
+        .pc = snapshot->pc,
+        .f = snapshot->f,
+        .ram = isa_ram,
+        .rom = rom,
+        .io_inputs = snapshot->io_inputs,
+    };
+
+    CPU cpu = start_cpu(snapshot);
+
+    *stop = ISA_OK;
+
+    for (int i = 0; i < max_instructions; ++i) {
+        if (before != NULL && i == max_instructions - 1) {
+            before->pc = isa.pc;
+            before->f = isa.f;
+            memcpy(before->io_inputs, snapshot->io_inputs, sizeof(before->io_inputs));
+            memcpy(before->ram, isa_ram, RAM_SIZE);
+            before->cpu = cpu;
+        }
+
+        IsaResult result = isa_step(&isa);
+
+        if (result != ISA_OK) {
+            *stop = result;
+            break;
+        }
+
+        divergence.n_instructions = i;
+
+        if (!engine_step(&cpu)) {
+            snprintf(divergence.why, sizeof(divergence.why), bus_conflict ? "bus conflict" : "never loads S");
+            divergence.found = true;
+            break;
+        }
+
+        if (!compare(&cpu, &isa, divergence.why, sizeof(divergence.why))) {
+            divergence.found = true;
+            break;
+        }
+
+        divergence.n_instructions = i + 1;
+    }
+
+    return divergence;
+}
+
+static bool diverges(const Snapshot *snapshot, int max_instructions) {
+    IsaResult stop;
+
+    return run(snapshot, max_instructions, &stop, NULL).found;
+}
+
+// Zeroes as much of RAM as possible while the divergence stays, halving the chunks that
+// can't be zeroed whole.
+static void minimize_ram(Snapshot *snapshot, int max_instructions, size_t start, size_t size, uint16_t code_start, uint16_t code_end) {
+    bool any_nonzero = false;
+
+    for (size_t i = start; i < start + size; ++i) {
+        uint16_t address = (uint16_t)(RAM_ABSOLUTE_START_ADDRESS + i);
+        any_nonzero |= snapshot->ram[i] != 0 && (address < code_start || address >= code_end);
+    }
+
+    if (!any_nonzero) {
+        return;
+    }
+
+    static uint8_t saved[RAM_SIZE];
+    memcpy(saved, &snapshot->ram[start], size);
+
+    for (size_t i = start; i < start + size; ++i) {
+        uint16_t address = (uint16_t)(RAM_ABSOLUTE_START_ADDRESS + i);
+
+        if (address < code_start || address >= code_end) {
+            snapshot->ram[i] = 0;
+        }
+    }
+
+    if (diverges(snapshot, max_instructions)) {
+        return;
+    }
+
+    memcpy(&snapshot->ram[start], saved, size);
+
+    if (size > 1) {
+        minimize_ram(snapshot, max_instructions, start, size / 2, code_start, code_end);
+        minimize_ram(snapshot, max_instructions, start + size / 2, size - size / 2, code_start, code_end);
+    }
+}
+
+// Shrinks a diverging stream to the single instruction that diverged and the state it needs.
+static void minimize(Snapshot *snapshot, const Divergence *divergence, char *reproducer, size_t reproducer_size) {
+    Snapshot *before = malloc(sizeof(Snapshot));
+    assert(before != NULL && "Failed to allocate snapshot");
+
+    IsaResult stop;
+    int max_instructions = divergence->n_instructions + 1;
+
+    run(snapshot, max_instructions, &stop, before);
+
+    // It may need what earlier instructions left in LS, RS, O or C, then the whole prefix stays.
+    if (diverges(before, 1)) {
+        *snapshot = *before;
+        max_instructions = 1;
+
+        Snapshot canonical = *snapshot;
+        canonical.cpu = (CPU){.r_c = 0x80};
+
+        if (diverges(&canonical, 1)) {
+            *snapshot = canonical;
+        }
+    }
+
+    free(before);
+
+    uint8_t opcode = isa_read(&(IsaState){.ram = snapshot->ram, .rom = rom}, snapshot->pc);
+    uint16_t code_start = max_instructions == 1 ? snapshot->pc : CODE_START_ADDRESS;
+    uint16_t code_end = max_instructions == 1 ? (uint16_t)(snapshot->pc + isa_instruction_length(opcode)) : CODE_START_ADDRESS + CODE_SIZE;
+
+    minimize_ram(snapshot, max_instructions, 0, RAM_SIZE, code_start, code_end);
+
+    for (uint8_t bit = 1; bit < 0x10; bit <<= 1) {
+        if (snapshot->f & bit) {
+            snapshot->f &= (uint8_t)~bit;
+
+            if (!diverges(snapshot, max_instructions)) {
+                snapshot->f |= bit;
+            }
+        }
+    }
+
+    Divergence minimized = run(snapshot, max_instructions, &stop, NULL);
+    assert(minimized.found && "Lost the divergence while minimizing");
+
+    size_t n = 0;
+
+    n += (size_t)snprintf(reproducer + n, reproducer_size - n, "Divergence after %d instructions, %s\n", divergence->n_instructions, divergence->why);
+
+    if (max_instructions == 1) {
+        n += (size_t)snprintf(reproducer + n, reproducer_size - n, "Minimized: %s\n  pc: 0x%04x\n  bytes:", minimized.why, snapshot->pc);
+
+        for (uint16_t address = code_start; address < code_end && n < reproducer_size; ++address) {
+            n += (size_t)snprintf(reproducer + n, reproducer_size - n, " 0x%02x", snapshot->ram[address - RAM_ABSOLUTE_START_ADDRESS]);
+        }
+
+        n += (size_t)snprintf(reproducer + n, reproducer_size - n, "\n  O: 0x%02x, LS: 0x%02x, RS: 0x%02x, C: 0x%02x\n",
+                              snapshot->cpu.r_o, snapshot->cpu.r_ls, snapshot->cpu.r_rs, snapshot->cpu.r_c);
+    } else {
+        n += (size_t)snprintf(reproducer + n, reproducer_size - n, "Depends on earlier instructions, minimized the stream: %s\n  pc: 0x%04x\n",
+                              minimized.why, snapshot->pc);
+    }
+
+    n += (size_t)snprintf(reproducer + n, reproducer_size - n, "  F: 0x%x\n  registers:", snapshot->f);
+
+    for (uint8_t reg = 0; reg < 16 && n < reproducer_size; ++reg) {
+        n += (size_t)snprintf(reproducer + n, reproducer_size - n, " %s=0x%02x", register_names[reg], *snapshot_reg(snapshot, reg));
+    }
+
+    n += (size_t)snprintf(reproducer + n, reproducer_size - n, "\n  nonzero memory:");
+
+    int n_shown = 0;
+
+    for (size_t i = 0; i < ISA_REGISTERS_ADDRESS - RAM_ABSOLUTE_START_ADDRESS && n < reproducer_size; ++i) {
+        uint16_t address = (uint16_t)(RAM_ABSOLUTE_START_ADDRESS + i);
+
+        if (snapshot->ram[i] == 0 || (address >= code_start && address < code_end)) {
+            continue;
+        }
+
+        if (++n_shown > 16) {
+            n += (size_t)snprintf(reproducer + n, reproducer_size - n, " ...");
+            break;
+        }
+
+        n += (size_t)snprintf(reproducer + n, reproducer_size - n, " [0x%04x]=0x%02x", address, snapshot->ram[i]);
+    }
+
+    if (n < reproducer_size) {
+        snprintf(reproducer + n, reproducer_size - n, "%s\n", n_shown == 0 ? " none" : "");
+    }
+}
+
+static void fuzz_worker(WorkerResult *result, uint32_t seed, int worker, int n_workers, int n_streams) {
+    Snapshot *snapshot = malloc(sizeof(Snapshot));
+    assert(snapshot != NULL && "Failed to allocate snapshot");
+
+    covered = result->covered;
+
+    for (int stream = 0; stream < n_streams; ++stream) {
+        seed_random(seed, (uint32_t)(stream * n_workers + worker));
+        generate_stream(snapshot);
+
+        IsaResult stop;
+        Divergence divergence = run(snapshot, MAX_RUN_INSTRUCTIONS, &stop, NULL);
+
+        ++result->n_streams;
+        result->n_instructions += (uint64_t)divergence.n_instructions + divergence.found;
+
+        if (divergence.found) {
+            covered = NULL;
+            minimize(snapshot, &divergence, result->reproducer, sizeof(result->reproducer));
+            result->diverged = true;
+            break;
+        }
+
+        ++result->n_stops[stop];
+    }
+
+    free(snapshot);
+
+    result->done = true;
+}
+
+// Opcode, step and F combinations the control table can reach from any F, forking on every
+// F latch like the verifier does.
+static void reachable_walk(uint8_t (*reachable)[N_STEPS][16], uint8_t opcode, uint8_t step, uint8_t flags) {
+    if (reachable[opcode][step][flags]) {
+        return;
+    }
+
+    reachable[opcode][step][flags] = 1;
+
+    uint16_t signals = signals_from_table((const uint8_t(*)[CONTROL_ROM_SIZE]) & control_rom, step, flags, (Opcode)opcode);
+
+    bool ld_c = signals & LD_C;
+
+    if ((!ld_c && (signals & (HALT_NOT_LD_C | LD_S_NOT_LD_C))) || step == N_STEPS - 1) {
+        return;
+    }
+
+    if ((signals & OE_ALU) && (signals & LD_LS)) {
+        for (uint8_t next_flags = 0; next_flags < 16; ++next_flags) {
+            reachable_walk(reachable, opcode, (uint8_t)(step + 1), next_flags);
+        }
+    } else {
+        reachable_walk(reachable, opcode, (uint8_t)(step + 1), flags);
+    }
+}
+
+// The whole of text as a number in C notation, at most max.
+static bool parse_number(const char *text, unsigned long max, unsigned long *value) {
+    char *end;
+    *value = strtoul(text, &end, 0);
+
+    return text[0] >= '0' && text[0] <= '9' && *end == '\0' && *value <= max;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n_streams_arg = DEFAULT_N_STREAMS;
+    unsigned long seed_arg = 1;
+
+    if (argc > 3 || (argc > 1 && (!parse_number(argv[1], INT32_MAX, &n_streams_arg) || n_streams_arg == 0)) ||
+        (argc > 2 && !parse_number(argv[2], UINT32_MAX, &seed_arg))) {
+        fprintf(stderr, "Usage: %s [STREAMS PER WORKER, DEFAULTS TO %d] [SEED]\n", argv[0], DEFAULT_N_STREAMS);
+        exit(1);
+    }
+
+    int n_streams = (int)n_streams_arg;
+    uint32_t seed = (uint32_t)seed_arg;
+
+    read_rom("./bin/alu_low.bin", alu_low_rom, ALU_ROM_SIZE);
+    read_rom("./bin/alu_high.bin", alu_high_rom, ALU_ROM_SIZE);
+
+    generate_table(&control_rom);
+
+    seed_random(seed, 0xffffffff);
+
+    for (size_t i = 0; i < ROM_SIZE; ++i) {
+        rom[i] = random_u8();
+    }
+
+    for (int opcode = 0; opcode < 256; ++opcode) {
+        if (isa_instruction_length((uint8_t)opcode) > 0 && opcode != OPCODE_HALT) {
+            valid_opcodes[n_valid_opcodes++] = (uint8_t)opcode;
+        }
+    }
+
+    long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int n_workers = n_cpus < 1 ? 1 : n_cpus > MAX_WORKERS ? MAX_WORKERS : (int)n_cpus;
+
+    WorkerResult *results = mmap(NULL, sizeof(WorkerResult) * (size_t)n_workers, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    assert(results != MAP_FAILED && "Failed to map worker results");
+
+    memset(results, 0, sizeof(WorkerResult) * (size_t)n_workers);
+
+    uint64_t start_ns = now_ns();
+
+    for (int worker = 0; worker < n_workers; ++worker) {
+        pid_t pid = fork();
+        assert(pid >= 0 && "Failed to fork worker");
+
+        if (pid == 0) {
+            fuzz_worker(&results[worker], seed, worker, n_workers, n_streams);
+            exit(0);
+        }
+    }
+
+    for (int worker = 0; worker < n_workers; ++worker) {
+        wait(NULL);
+    }
+
+    uint64_t elapsed_ns = now_ns() - start_ns;
+
+    static uint8_t reachable[256][N_STEPS][16];
+    static uint8_t all_covered[256][N_STEPS][16];
+
+    uint64_t n_total_streams = 0;
+    uint64_t n_total_instructions = 0;
+    uint64_t n_total_stops[4] = {0};
+    int n_diverged = 0;
+    int n_died = 0;
+
+    for (int worker = 0; worker < n_workers; ++worker) {
+        const WorkerResult *result = &results[worker];
+
+        if (!result->done) {
+            fprintf(stderr, "Worker %d died\n", worker);
+            ++n_died;
+        }
+
+        if (result->diverged) {
+            fprintf(stderr, "Worker %d: %s", worker, result->reproducer);
+            ++n_diverged;
+        }
+
+        n_total_streams += result->n_streams;
+        n_total_instructions += result->n_instructions;
+
+        for (int i = 0; i < 4; ++i) {
+            n_total_stops[i] += result->n_stops[i];
+        }
+
+        for (size_t i = 0; i < sizeof(all_covered); ++i) {
+            (&all_covered[0][0][0])[i] |= (&result->covered[0][0][0])[i];
+        }
+    }
+
+    int n_reachable = 0;
+    int n_covered = 0;
+
+    for (int i = 0; i < n_valid_opcodes; ++i) {
+        uint8_t opcode = valid_opcodes[i];
+
+        for (uint8_t flags = 0; flags < 16; ++flags) {
+            reachable_walk(reachable, opcode, 0, flags);
+        }
+
+        for (uint8_t step = 0; step < N_STEPS; ++step) {
+            for (uint8_t flags = 0; flags < 16; ++flags) {
+                n_reachable += reachable[opcode][step][flags];
+                n_covered += reachable[opcode][step][flags] && all_covered[opcode][step][flags];
+            }
+        }
+    }
+
+    printf("Ran %llu streams, %llu instructions on %d workers in %llu ms (%.1f M instructions/s)\n",
+           (unsigned long long)n_total_streams,
+           (unsigned long long)n_total_instructions,
+           n_workers,
+           (unsigned long long)(elapsed_ns / 1000000),
+           elapsed_ns > 0 ? (double)n_total_instructions * 1000.0 / (double)elapsed_ns : 0.0);
+
+    printf("Streams stopped by:");
+
+    for (int i = 0; i < 4; ++i) {
+        printf(" %s %llu%s", stop_names[i], (unsigned long long)n_total_stops[i], i < 3 ? "," : "\n");
+    }
+
+    printf("Covered %d of %d reachable opcode, step and F combinations (%.1f%%)\n",
+           n_covered, n_reachable, n_reachable > 0 ? 100.0 * n_covered / n_reachable : 0.0);
+
+    if (n_diverged > 0 || n_died > 0) {
+        printf("FAILED, %d diverged, %d died\n", n_diverged, n_died);
+        return 1;
+    }
+
+    printf("OK\n");
+
+    return 0;
+}
@@ -0,0 +1,709 @@
+// BLEH-1 instruction level reference model.
+//
+// Written from the instruction set, one opcode at a time, without looking at how the microcode
+// in `control.h` does it. Tools run it next to the half cycle engine (`cpu.h`) to check the
+// control and ALU ROMs against it.
+//
+// Instructions are modelled as atomic, so accesses where the order of the microcode steps
+// would show (data in the register area, the stack running into it or code inside it) stop
+// the model instead of guessing.
+#ifndef ISA_H
+#define ISA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "alu_op.h"
+#include "opcode.h"
+
+#define ISA_RAM_START_ADDRESS (0x8000)
+#define ISA_RAM_SIZE (0x8000)
+#define ISA_ROM_SIZE (0x8000)
+#define ISA_REGISTERS_ADDRESS (0xfff0)
+#define ISA_STACK_PAGE (0xff00)
+
+// Offsets into the register area.
+#define ISA_A (0x0)
+#define ISA_B (0x1)
+#define ISA_C (0x2)
+#define ISA_D (0x3)
+#define ISA_SP (0x4)
+#define ISA_IL (0x5)
+#define ISA_IH (0x6)
+#define ISA_JL (0x7)
+#define ISA_JH (0x8)
+
+// TL, TH and UL are scratch for the microcode, their value after an instruction is undefined.
+#define ISA_IS_SCRATCH_REGISTER(offset) ((offset) >= 0xb && (offset) <= 0xd)
+
+#define ISA_ZF (1 << 0)
+#define ISA_CF (1 << 1)
+#define ISA_OF (1 << 2)
+#define ISA_SF (1 << 3)
+
+#define ISA_MAX_WRITES (4)
+#define ISA_MAX_OUTS (1)
+
+typedef enum {
+    ISA_OK,
+    ISA_STOP_HALT,
+    ISA_STOP_UNDEFINED, // Not an opcode
+    ISA_STOP_REGISTER_AREA, // Data, stack or code in the register area
+} IsaResult;
+
+typedef struct {
+    uint16_t pc;
+    uint8_t f;
+    uint8_t *ram; // ISA_RAM_SIZE bytes, the registers are the last 16
+    const uint8_t *rom; // ISA_ROM_SIZE bytes
+    const uint8_t *io_inputs; // What `in` reads from each of the 8 ports
+
+    // What the last instruction did, for comparing against another model.
+    int n_writes;
+    uint16_t write_addresses[ISA_MAX_WRITES];
+    int n_outs;
+    uint8_t out_ports[ISA_MAX_OUTS];
+    uint8_t out_values[ISA_MAX_OUTS];
+    bool touched_register_area;
+} IsaState;
+
+// Instruction length in bytes, 0 when the opcode is undefined.
+static int isa_instruction_length(uint8_t opcode) {
+    if (opcode >= OPCODE_ALU_MATRIX_FIRST && opcode <= OPCODE_ALU_MATRIX_LAST) {
+        return OPCODE_ALU_MATRIX_DEST(opcode) == OPCODE_ALU_MATRIX_SRC(opcode) ? 2 : 1;
+    }
+
+    switch ((Opcode)opcode) {
+    case OPCODE_LD_A_IMM8:
+    case OPCODE_LD_B_IMM8:
+    case OPCODE_LD_C_IMM8:
+    case OPCODE_LD_D_IMM8:
+    case OPCODE_ADC_D_IMM8:
+    case OPCODE_ADD_A_IMM8:
+    case OPCODE_OR_A_IMM8:
+    case OPCODE_AND_A_IMM8:
+    case OPCODE_XOR_A_IMM8:
+    case OPCODE_ADC_A_IMM8:
+    case OPCODE_ADD_B_IMM8:
+    case OPCODE_CMP_A_IMM8:
+    case OPCODE_CMP_B_IMM8:
+    case OPCODE_LD_SP_IMM8:
+    case OPCODE_LD_A_SP_PLUS_IMM8_PTR:
+    case OPCODE_ADD_I_IMM8:
+    case OPCODE_LD_SP_PLUS_IMM8_PTR_A:
+    case OPCODE_LD_A_I_PLUS_IMM8_PTR:
+    case OPCODE_LD_A_J_PLUS_IMM8_PTR:
+    case OPCODE_LD_I_PLUS_IMM8_PTR_A:
+    case OPCODE_LD_J_PLUS_IMM8_PTR_A:
+    case OPCODE_OUT_PORT0_IMM8:
+    case OPCODE_OUT_PORT1_IMM8:
+    case OPCODE_OUT_PORT2_IMM8:
+    case OPCODE_OUT_PORT3_IMM8:
+    case OPCODE_OUT_PORT4_IMM8:
+    case OPCODE_OUT_PORT5_IMM8:
+    case OPCODE_OUT_PORT6_IMM8:
+    case OPCODE_OUT_PORT7_IMM8: return 2;
+
+    case OPCODE_LD_I_IMM16:
+    case OPCODE_LD_J_IMM16:
+    case OPCODE_JMP_IMM16:
+    case OPCODE_JZ_IMM16:
+    case OPCODE_JNZ_IMM16:
+    case OPCODE_JC_IMM16:
+    case OPCODE_JNC_IMM16:
+    case OPCODE_JO_IMM16:
+    case OPCODE_JNO_IMM16:
+    case OPCODE_JS_IMM16:
+    case OPCODE_JNS_IMM16:
+    case OPCODE_CALL_IMM16:
+    case OPCODE_DJNZ_B_IMM16:
+    case OPCODE_DJNZ_C_IMM16:
+    case OPCODE_DJNZ_D_IMM16: return 3;
+
+    case OPCODE_NOP:
+    case OPCODE_HALT:
+    case OPCODE_LD_A_I_PTR:
+    case OPCODE_LD_A_J_PTR:
+    case OPCODE_LD_A_I_PTR_INC1:
+    case OPCODE_LD_A_J_PTR_INC1:
+    case OPCODE_LD_I_PTR_A:
+    case OPCODE_LD_J_PTR_A:
+    case OPCODE_LD_I_PTR_INC1_A:
+    case OPCODE_LD_J_PTR_INC1_A:
+    case OPCODE_LD_I_PTR_AB:
+    case OPCODE_LD_I_PTR_CD:
+    case OPCODE_LD_J_PTR_CD:
+    case OPCODE_LD_AB_I_PTR:
+    case OPCODE_LD_CD_I_PTR:
+    case OPCODE_LD_CD_J_PTR:
+    case OPCODE_LD_A_B:
+    case OPCODE_LD_A_C:
+    case OPCODE_LD_A_D:
+    case OPCODE_LD_B_A:
+    case OPCODE_LD_B_C:
+    case OPCODE_LD_B_D:
+    case OPCODE_LD_C_A:
+    case OPCODE_LD_C_B:
+    case OPCODE_LD_C_D:
+    case OPCODE_LD_D_A:
+    case OPCODE_LD_D_B:
+    case OPCODE_LD_D_C:
+    case OPCODE_INC_A:
+    case OPCODE_SHL_A:
+    case OPCODE_SHR_A:
+    case OPCODE_NOT_A:
+    case OPCODE_DEC_A:
+    case OPCODE_ROR_A:
+    case OPCODE_ADD_A_B:
+    case OPCODE_OR_A_B:
+    case OPCODE_AND_A_B:
+    case OPCODE_XOR_A_B:
+    case OPCODE_ADC_A_B:
+    case OPCODE_DEC_B:
+    case OPCODE_DEC_C:
+    case OPCODE_DEC_D:
+    case OPCODE_INC_B:
+    case OPCODE_INC_C:
+    case OPCODE_INC_D:
+    case OPCODE_ADD_D_B:
+    case OPCODE_ADC_C_A:
+    case OPCODE_JMP_I:
+    case OPCODE_JMP_J:
+    case OPCODE_PUSH_A:
+    case OPCODE_PUSH_B:
+    case OPCODE_PUSH_C:
+    case OPCODE_PUSH_D:
+    case OPCODE_PUSH_I:
+    case OPCODE_PUSH_J:
+    case OPCODE_POP_A:
+    case OPCODE_POP_B:
+    case OPCODE_POP_C:
+    case OPCODE_POP_D:
+    case OPCODE_POP_I:
+    case OPCODE_POP_J:
+    case OPCODE_RET:
+    case OPCODE_LD_J_PTR_INC1_I_PTR_INC1:
+    case OPCODE_INC_I:
+    case OPCODE_INC_J:
+    case OPCODE_DEC_I:
+    case OPCODE_DEC_J:
+    case OPCODE_ADD_I_A:
+    case OPCODE_LD_A_I_PLUS_A_PTR:
+    case OPCODE_ROL_A:
+    case OPCODE_SAR_A:
+    case OPCODE_SWAP_A:
+    case OPCODE_SUB_A_B:
+    case OPCODE_SBC_A_B:
+    case OPCODE_CMP_A_B:
+    case OPCODE_MULSTEP_A_B:
+    case OPCODE_LD_I_J_PTR:
+    case OPCODE_LD_J_I_PTR:
+    case OPCODE_LD_I_I_PTR:
+    case OPCODE_IN_A_PORT0:
+    case OPCODE_IN_A_PORT1:
+    case OPCODE_IN_A_PORT2:
+    case OPCODE_IN_A_PORT3:
+    case OPCODE_IN_A_PORT4:
+    case OPCODE_IN_A_PORT5:
+    case OPCODE_IN_A_PORT6:
+    case OPCODE_IN_A_PORT7:
+    case OPCODE_OUT_PORT0_A:
+    case OPCODE_OUT_PORT1_A:
+    case OPCODE_OUT_PORT2_A:
+    case OPCODE_OUT_PORT3_A:
+    case OPCODE_OUT_PORT4_A:
+    case OPCODE_OUT_PORT5_A:
+    case OPCODE_OUT_PORT6_A:
+    case OPCODE_OUT_PORT7_A: return 1;
+    }
+
+    return 0;
+}
+
+// Q of the ALU op, `f` is updated with the flags it gives. ZF and SF always follow Q,
+// INC and DEC keep CF while the logic, shift and rotate ops clear OF.
+static uint8_t isa_alu(ALU_OP alu_op, uint8_t ls, uint8_t rs, uint8_t *f) {
+    bool in_cf = *f & ISA_CF;
+    bool cf = false;
+    bool of = false;
+    uint8_t q = 0;
+
+    switch (alu_op) {
+    case ALU_OP_INC_LS:
+        q = (uint8_t)(ls + 1);
+        cf = in_cf;
+        of = q == 0x80;
+        break;
+    case ALU_OP_DEC_LS:
+        q = (uint8_t)(ls - 1);
+        cf = in_cf;
+        of = q == 0x7f;
+        break;
+    case ALU_OP_SHL_LS:
+        q = (uint8_t)(ls << 1);
+        cf = ls >> 7;
+        break;
+    case ALU_OP_SHR_LS:
+        q = ls >> 1;
+        cf = ls & 1;
+        break;
+    case ALU_OP_NOT_LS:
+        q = (uint8_t)~ls;
+        break;
+    case ALU_OP_ROR_LS:
+        q = (uint8_t)((ls << 7) | (ls >> 1));
+        cf = ls & 1;
+        break;
+    case ALU_OP_ROL_LS:
+        q = (uint8_t)((ls << 1) | (ls >> 7));
+        cf = ls >> 7;
+        break;
+    case ALU_OP_SAR_LS:
+        q = (uint8_t)((ls & 0x80) | (ls >> 1));
+        cf = ls & 1;
+        break;
+    case ALU_OP_LS_OR_RS: q = ls | rs; break;
+    case ALU_OP_LS_AND_RS: q = ls & rs; break;
+    case ALU_OP_LS_XOR_RS: q = ls ^ rs; break;
+    case ALU_OP_LS_ADD_RS:
+    case ALU_OP_LS_ADC_RS:
+    case ALU_OP_LS_ADD_RS_IF_CF: {
+        uint8_t added = alu_op == ALU_OP_LS_ADD_RS_IF_CF && !in_cf ? 0 : rs;
+        int sum = ls + added + (alu_op == ALU_OP_LS_ADC_RS && in_cf);
+        q = (uint8_t)sum;
+        cf = sum > 0xff;
+        of = (ls >> 7) == (added >> 7) && (q >> 7) != (ls >> 7);
+        break;
+    }
+    case ALU_OP_LS_SUB_RS:
+    case ALU_OP_LS_SBC_RS: {
+        int borrow = alu_op == ALU_OP_LS_SBC_RS && in_cf;
+        q = (uint8_t)(ls - rs - borrow);
+        cf = ls < rs + borrow;
+        of = (ls >> 7) != (rs >> 7) && (q >> 7) != (ls >> 7);
+        break;
+    }
+    case ALU_OP_SET_IO_OE_FLAG: break;
+    }
+
+    *f = (uint8_t)((q == 0 ? ISA_ZF : 0) | (cf ? ISA_CF : 0) | (of ? ISA_OF : 0) | (q >> 7 ? ISA_SF : 0));
+
+    return q;
+}
+
+static uint8_t isa_read(const IsaState *s, uint16_t address) {
+    return address >= ISA_RAM_START_ADDRESS
+               ? s->ram[address - ISA_RAM_START_ADDRESS]
+               : s->rom[address];
+}
+
+// Reads and writes through a pointer or the stack, the register area is off limits.
+static uint8_t isa_read_data(IsaState *s, uint16_t address) {
+    if (address >= ISA_REGISTERS_ADDRESS) {
+        s->touched_register_area = true;
+    }
+
+    return isa_read(s, address);
+}
+
+static void isa_write_data(IsaState *s, uint16_t address, uint8_t value) {
+    if (address >= ISA_REGISTERS_ADDRESS) {
+        s->touched_register_area = true;
+    }
+
+    if (address >= ISA_RAM_START_ADDRESS) { // ROM is read only
+        s->ram[address - ISA_RAM_START_ADDRESS] = value;
+    }
+
+    if (s->n_writes < ISA_MAX_WRITES) {
+        s->write_addresses[s->n_writes++] = address;
+    }
+}
+
+static uint8_t isa_reg(const IsaState *s, uint8_t reg) {
+    return s->ram[ISA_REGISTERS_ADDRESS - ISA_RAM_START_ADDRESS + reg];
+}
+
+static void isa_set_reg(IsaState *s, uint8_t reg, uint8_t value) {
+    s->ram[ISA_REGISTERS_ADDRESS - ISA_RAM_START_ADDRESS + reg] = value;
+}
+
+static uint16_t isa_index(const IsaState *s, uint8_t index_l) {
+    return (uint16_t)((isa_reg(s, (uint8_t)(index_l + 1)) << 8) | isa_reg(s, index_l));
+}
+
+static void isa_set_index(IsaState *s, uint8_t index_l, uint16_t value) {
+    isa_set_reg(s, index_l, (uint8_t)value);
+    isa_set_reg(s, (uint8_t)(index_l + 1), (uint8_t)(value >> 8));
+}
+
+static uint16_t isa_stack_address(uint8_t sp) {
+    return (uint16_t)(ISA_STACK_PAGE | sp);
+}
+
+static void isa_push(IsaState *s, uint8_t value) {
+    uint8_t sp = (uint8_t)(isa_reg(s, ISA_SP) + 1);
+    isa_set_reg(s, ISA_SP, sp);
+    isa_write_data(s, isa_stack_address(sp), value);
+}
+
+static uint8_t isa_pop(IsaState *s) {
+    uint8_t sp = isa_reg(s, ISA_SP);
+    isa_set_reg(s, ISA_SP, (uint8_t)(sp - 1));
+    return isa_read_data(s, isa_stack_address(sp));
+}
+
+static void isa_alu_reg(IsaState *s, ALU_OP alu_op, uint8_t dest, uint8_t rs) {
+    isa_set_reg(s, dest, isa_alu(alu_op, isa_reg(s, dest), rs, &s->f));
+}
+
+static void isa_cmp(IsaState *s, uint8_t reg, uint8_t rs) {
+    isa_alu(ALU_OP_LS_SUB_RS, isa_reg(s, reg), rs, &s->f);
+}
+
+// The high byte follows the low byte's carry, F is from the last byte the ALU changed.
+static void isa_add_index(IsaState *s, uint8_t index_l, uint8_t value) {
+    uint8_t l = isa_alu(ALU_OP_LS_ADD_RS, isa_reg(s, index_l), value, &s->f);
+    isa_set_reg(s, index_l, l);
+
+    if (s->f & ISA_CF) {
+        isa_alu_reg(s, ALU_OP_INC_LS, (uint8_t)(index_l + 1), 0);
+    }
+}
+
+// Address of [index+imm], F is from adding imm to the low byte of the index.
+static uint16_t isa_index_plus(IsaState *s, uint8_t index_l, uint8_t value) {
+    isa_alu(ALU_OP_LS_ADD_RS, isa_reg(s, index_l), value, &s->f);
+
+    return (uint16_t)(isa_index(s, index_l) + value);
+}
+
+static void isa_jump_if(bool condition, uint16_t address, uint16_t *next_pc) {
+    if (condition) {
+        *next_pc = address;
+    }
+}
+
+static IsaResult isa_step(IsaState *s) {
+    s->n_writes = 0;
+    s->n_outs = 0;
+    s->touched_register_area = false;
+
+    uint8_t opcode = isa_read(s, s->pc);
+    int length = isa_instruction_length(opcode);
+
+    if (length == 0) {
+        return ISA_STOP_UNDEFINED;
+    }
+
+    if (opcode == OPCODE_HALT) {
+        return ISA_STOP_HALT;
+    }
+
+    if (s->pc >= ISA_REGISTERS_ADDRESS - length + 1) {
+        return ISA_STOP_REGISTER_AREA;
+    }
+
+    uint8_t imm8 = isa_read(s, (uint16_t)(s->pc + 1));
+    uint16_t imm16 = (uint16_t)((isa_read(s, (uint16_t)(s->pc + 2)) << 8) | imm8);
+    uint16_t next_pc = (uint16_t)(s->pc + length);
+
+    if (opcode >= OPCODE_ALU_MATRIX_FIRST && opcode <= OPCODE_ALU_MATRIX_LAST) {
+        static const ALU_OP alu_ops[] = {
+            [ALU_MATRIX_ADD] = ALU_OP_LS_ADD_RS,
+            [ALU_MATRIX_ADC] = ALU_OP_LS_ADC_RS,
+            [ALU_MATRIX_SUB] = ALU_OP_LS_SUB_RS,
+            [ALU_MATRIX_AND] = ALU_OP_LS_AND_RS,
+            [ALU_MATRIX_OR] = ALU_OP_LS_OR_RS,
+            [ALU_MATRIX_XOR] = ALU_OP_LS_XOR_RS,
+            [ALU_MATRIX_CMP] = ALU_OP_LS_SUB_RS,
+        };
+
+        AluMatrixOp op = OPCODE_ALU_MATRIX_OP(opcode);
+        uint8_t dest = OPCODE_ALU_MATRIX_DEST(opcode);
+        uint8_t src = OPCODE_ALU_MATRIX_SRC(opcode);
+        uint8_t rs = dest == src ? imm8 : isa_reg(s, src);
+
+        if (op == ALU_MATRIX_CMP) {
+            isa_cmp(s, dest, rs);
+        } else {
+            isa_alu_reg(s, alu_ops[op], dest, rs);
+        }
+
+        s->pc = next_pc;
+        return ISA_OK;
+    }
+
+    switch ((Opcode)opcode) {
+    case OPCODE_NOP: break;
+    case OPCODE_HALT: break;
+
+    case OPCODE_LD_A_IMM8: isa_set_reg(s, ISA_A, imm8); break;
+    case OPCODE_LD_B_IMM8: isa_set_reg(s, ISA_B, imm8); break;
+    case OPCODE_LD_C_IMM8: isa_set_reg(s, ISA_C, imm8); break;
+    case OPCODE_LD_D_IMM8: isa_set_reg(s, ISA_D, imm8); break;
+    case OPCODE_LD_SP_IMM8: isa_set_reg(s, ISA_SP, imm8); break;
+    case OPCODE_LD_I_IMM16: isa_set_index(s, ISA_IL, imm16); break;
+    case OPCODE_LD_J_IMM16: isa_set_index(s, ISA_JL, imm16); break;
+
+    case OPCODE_LD_A_I_PTR: isa_set_reg(s, ISA_A, isa_read_data(s, isa_index(s, ISA_IL))); break;
+    case OPCODE_LD_A_J_PTR: isa_set_reg(s, ISA_A, isa_read_data(s, isa_index(s, ISA_JL))); break;
+    case OPCODE_LD_A_I_PTR_INC1:
+        isa_set_reg(s, ISA_A, isa_read_data(s, isa_index(s, ISA_IL)));
+        isa_set_index(s, ISA_IL, (uint16_t)(isa_index(s, ISA_IL) + 1));
+        break;
+    case OPCODE_LD_A_J_PTR_INC1:
+        isa_set_reg(s, ISA_A, isa_read_data(s, isa_index(s, ISA_JL)));
+        isa_set_index(s, ISA_JL, (uint16_t)(isa_index(s, ISA_JL) + 1));
+        break;
+    case OPCODE_LD_I_PTR_A: isa_write_data(s, isa_index(s, ISA_IL), isa_reg(s, ISA_A)); break;
+    case OPCODE_LD_J_PTR_A: isa_write_data(s, isa_index(s, ISA_JL), isa_reg(s, ISA_A)); break;
+    case OPCODE_LD_I_PTR_INC1_A:
+        isa_write_data(s, isa_index(s, ISA_IL), isa_reg(s, ISA_A));
+        isa_set_index(s, ISA_IL, (uint16_t)(isa_index(s, ISA_IL) + 1));
+        break;
+    case OPCODE_LD_J_PTR_INC1_A:
+        isa_write_data(s, isa_index(s, ISA_JL), isa_reg(s, ISA_A));
+        isa_set_index(s, ISA_JL, (uint16_t)(isa_index(s, ISA_JL) + 1));
+        break;
+
+    // Register pairs are little-endian, the second register is the low byte.
+    case OPCODE_LD_I_PTR_AB:
+    case OPCODE_LD_I_PTR_CD:
+    case OPCODE_LD_J_PTR_CD: {
+        uint16_t address = isa_index(s, opcode == OPCODE_LD_J_PTR_CD ? ISA_JL : ISA_IL);
+        uint8_t h = opcode == OPCODE_LD_I_PTR_AB ? ISA_A : ISA_C;
+        isa_write_data(s, address, isa_reg(s, (uint8_t)(h + 1)));
+        isa_write_data(s, (uint16_t)(address + 1), isa_reg(s, h));
+        break;
+    }
+    case OPCODE_LD_AB_I_PTR:
+    case OPCODE_LD_CD_I_PTR:
+    case OPCODE_LD_CD_J_PTR:
+    case OPCODE_LD_I_J_PTR:
+    case OPCODE_LD_J_I_PTR:
+    case OPCODE_LD_I_I_PTR: {
+        uint8_t src_index_l = opcode == OPCODE_LD_CD_J_PTR || opcode == OPCODE_LD_I_J_PTR ? ISA_JL : ISA_IL;
+        uint8_t dest_l = opcode == OPCODE_LD_AB_I_PTR   ? ISA_B
+                         : opcode == OPCODE_LD_J_I_PTR  ? ISA_JL
+                         : opcode == OPCODE_LD_I_J_PTR  ? ISA_IL
+                         : opcode == OPCODE_LD_I_I_PTR  ? ISA_IL
+                                                        : ISA_D;
+        uint16_t address = isa_index(s, src_index_l);
+        uint8_t l = isa_read_data(s, address);
+        uint8_t h = isa_read_data(s, (uint16_t)(address + 1));
+
+        // The pairs from a, b, c and d name the high register first, the index registers the low.
+        if (dest_l == ISA_IL || dest_l == ISA_JL) {
+            isa_set_index(s, dest_l, (uint16_t)((h << 8) | l));
+        } else {
+            isa_set_reg(s, dest_l, l);
+            isa_set_reg(s, (uint8_t)(dest_l - 1), h);
+        }
+        break;
+    }
+
+    case OPCODE_LD_A_B: isa_set_reg(s, ISA_A, isa_reg(s, ISA_B)); break;
+    case OPCODE_LD_A_C: isa_set_reg(s, ISA_A, isa_reg(s, ISA_C)); break;
+    case OPCODE_LD_A_D: isa_set_reg(s, ISA_A, isa_reg(s, ISA_D)); break;
+    case OPCODE_LD_B_A: isa_set_reg(s, ISA_B, isa_reg(s, ISA_A)); break;
+    case OPCODE_LD_B_C: isa_set_reg(s, ISA_B, isa_reg(s, ISA_C)); break;
+    case OPCODE_LD_B_D: isa_set_reg(s, ISA_B, isa_reg(s, ISA_D)); break;
+    case OPCODE_LD_C_A: isa_set_reg(s, ISA_C, isa_reg(s, ISA_A)); break;
+    case OPCODE_LD_C_B: isa_set_reg(s, ISA_C, isa_reg(s, ISA_B)); break;
+    case OPCODE_LD_C_D: isa_set_reg(s, ISA_C, isa_reg(s, ISA_D)); break;
+    case OPCODE_LD_D_A: isa_set_reg(s, ISA_D, isa_reg(s, ISA_A)); break;
+    case OPCODE_LD_D_B: isa_set_reg(s, ISA_D, isa_reg(s, ISA_B)); break;
+    case OPCODE_LD_D_C: isa_set_reg(s, ISA_D, isa_reg(s, ISA_C)); break;
+
+    case OPCODE_INC_A: isa_alu_reg(s, ALU_OP_INC_LS, ISA_A, 0); break;
+    case OPCODE_INC_B: isa_alu_reg(s, ALU_OP_INC_LS, ISA_B, 0); break;
+    case OPCODE_INC_C: isa_alu_reg(s, ALU_OP_INC_LS, ISA_C, 0); break;
+    case OPCODE_INC_D: isa_alu_reg(s, ALU_OP_INC_LS, ISA_D, 0); break;
+    case OPCODE_DEC_A: isa_alu_reg(s, ALU_OP_DEC_LS, ISA_A, 0); break;
+    case OPCODE_DEC_B: isa_alu_reg(s, ALU_OP_DEC_LS, ISA_B, 0); break;
+    case OPCODE_DEC_C: isa_alu_reg(s, ALU_OP_DEC_LS, ISA_C, 0); break;
+    case OPCODE_DEC_D: isa_alu_reg(s, ALU_OP_DEC_LS, ISA_D, 0); break;
+    case OPCODE_SHL_A: isa_alu_reg(s, ALU_OP_SHL_LS, ISA_A, 0); break;
+    case OPCODE_SHR_A: isa_alu_reg(s, ALU_OP_SHR_LS, ISA_A, 0); break;
+    case OPCODE_NOT_A: isa_alu_reg(s, ALU_OP_NOT_LS, ISA_A, 0); break;
+    case OPCODE_ROR_A: isa_alu_reg(s, ALU_OP_ROR_LS, ISA_A, 0); break;
+    case OPCODE_ROL_A: isa_alu_reg(s, ALU_OP_ROL_LS, ISA_A, 0); break;
+    case OPCODE_SAR_A: isa_alu_reg(s, ALU_OP_SAR_LS, ISA_A, 0); break;
+
+    // F as after rotating right four times, CF and SF are both bit 3 of a.
+    case OPCODE_SWAP_A: {
+        uint8_t a = isa_reg(s, ISA_A);
+        uint8_t swapped = (uint8_t)((a << 4) | (a >> 4));
+        isa_set_reg(s, ISA_A, swapped);
+        s->f = (uint8_t)((swapped == 0 ? ISA_ZF : 0) | ((a >> 3) & 1 ? ISA_CF | ISA_SF : 0));
+        break;
+    }
+
+    case OPCODE_ADD_A_B: isa_alu_reg(s, ALU_OP_LS_ADD_RS, ISA_A, isa_reg(s, ISA_B)); break;
+    case OPCODE_OR_A_B: isa_alu_reg(s, ALU_OP_LS_OR_RS, ISA_A, isa_reg(s, ISA_B)); break;
+    case OPCODE_AND_A_B: isa_alu_reg(s, ALU_OP_LS_AND_RS, ISA_A, isa_reg(s, ISA_B)); break;
+    case OPCODE_XOR_A_B: isa_alu_reg(s, ALU_OP_LS_XOR_RS, ISA_A, isa_reg(s, ISA_B)); break;
+    case OPCODE_ADC_A_B: isa_alu_reg(s, ALU_OP_LS_ADC_RS, ISA_A, isa_reg(s, ISA_B)); break;
+    case OPCODE_ADC_C_A: isa_alu_reg(s, ALU_OP_LS_ADC_RS, ISA_C, isa_reg(s, ISA_A)); break;
+    case OPCODE_ADD_D_B: isa_alu_reg(s, ALU_OP_LS_ADD_RS, ISA_D, isa_reg(s, ISA_B)); break;
+    case OPCODE_SUB_A_B: isa_alu_reg(s, ALU_OP_LS_SUB_RS, ISA_A, isa_reg(s, ISA_B)); break;
+    case OPCODE_SBC_A_B: isa_alu_reg(s, ALU_OP_LS_SBC_RS, ISA_A, isa_reg(s, ISA_B)); break;
+    case OPCODE_MULSTEP_A_B: isa_alu_reg(s, ALU_OP_LS_ADD_RS_IF_CF, ISA_A, isa_reg(s, ISA_B)); break;
+    case OPCODE_CMP_A_B: isa_cmp(s, ISA_A, isa_reg(s, ISA_B)); break;
+
+    case OPCODE_ADD_A_IMM8: isa_alu_reg(s, ALU_OP_LS_ADD_RS, ISA_A, imm8); break;
+    case OPCODE_ADD_B_IMM8: isa_alu_reg(s, ALU_OP_LS_ADD_RS, ISA_B, imm8); break;
+    case OPCODE_AND_A_IMM8: isa_alu_reg(s, ALU_OP_LS_AND_RS, ISA_A, imm8); break;
+    case OPCODE_OR_A_IMM8: isa_alu_reg(s, ALU_OP_LS_OR_RS, ISA_A, imm8); break;
+    case OPCODE_XOR_A_IMM8: isa_alu_reg(s, ALU_OP_LS_XOR_RS, ISA_A, imm8); break;
+    case OPCODE_ADC_A_IMM8: isa_alu_reg(s, ALU_OP_LS_ADC_RS, ISA_A, imm8); break;
+    case OPCODE_ADC_D_IMM8: isa_alu_reg(s, ALU_OP_LS_ADC_RS, ISA_D, imm8); break;
+    case OPCODE_CMP_A_IMM8: isa_cmp(s, ISA_A, imm8); break;
+    case OPCODE_CMP_B_IMM8: isa_cmp(s, ISA_B, imm8); break;
+
+    case OPCODE_JMP_I: next_pc = isa_index(s, ISA_IL); break;
+    case OPCODE_JMP_J: next_pc = isa_index(s, ISA_JL); break;
+    case OPCODE_JMP_IMM16: next_pc = imm16; break;
+    case OPCODE_JZ_IMM16: isa_jump_if(s->f & ISA_ZF, imm16, &next_pc); break;
+    case OPCODE_JNZ_IMM16: isa_jump_if(!(s->f & ISA_ZF), imm16, &next_pc); break;
+    case OPCODE_JC_IMM16: isa_jump_if(s->f & ISA_CF, imm16, &next_pc); break;
+    case OPCODE_JNC_IMM16: isa_jump_if(!(s->f & ISA_CF), imm16, &next_pc); break;
+    case OPCODE_JO_IMM16: isa_jump_if(s->f & ISA_OF, imm16, &next_pc); break;
+    case OPCODE_JNO_IMM16: isa_jump_if(!(s->f & ISA_OF), imm16, &next_pc); break;
+    case OPCODE_JS_IMM16: isa_jump_if(s->f & ISA_SF, imm16, &next_pc); break;
+    case OPCODE_JNS_IMM16: isa_jump_if(!(s->f & ISA_SF), imm16, &next_pc); break;
+
+    case OPCODE_DJNZ_B_IMM16:
+    case OPCODE_DJNZ_C_IMM16:
+    case OPCODE_DJNZ_D_IMM16: {
+        uint8_t reg = opcode == OPCODE_DJNZ_B_IMM16 ? ISA_B : opcode == OPCODE_DJNZ_C_IMM16 ? ISA_C : ISA_D;
+        isa_alu_reg(s, ALU_OP_DEC_LS, reg, 0);
+        isa_jump_if(!(s->f & ISA_ZF), imm16, &next_pc);
+        break;
+    }
+
+    case OPCODE_PUSH_A: isa_push(s, isa_reg(s, ISA_A)); break;
+    case OPCODE_PUSH_B: isa_push(s, isa_reg(s, ISA_B)); break;
+    case OPCODE_PUSH_C: isa_push(s, isa_reg(s, ISA_C)); break;
+    case OPCODE_PUSH_D: isa_push(s, isa_reg(s, ISA_D)); break;
+    case OPCODE_PUSH_I:
+        isa_push(s, isa_reg(s, ISA_IL));
+        isa_push(s, isa_reg(s, ISA_IH));
+        break;
+    case OPCODE_PUSH_J:
+        isa_push(s, isa_reg(s, ISA_JL));
+        isa_push(s, isa_reg(s, ISA_JH));
+        break;
+    case OPCODE_POP_A: isa_set_reg(s, ISA_A, isa_pop(s)); break;
+    case OPCODE_POP_B: isa_set_reg(s, ISA_B, isa_pop(s)); break;
+    case OPCODE_POP_C: isa_set_reg(s, ISA_C, isa_pop(s)); break;
+    case OPCODE_POP_D: isa_set_reg(s, ISA_D, isa_pop(s)); break;
+    case OPCODE_POP_I:
+        isa_set_reg(s, ISA_IH, isa_pop(s));
+        isa_set_reg(s, ISA_IL, isa_pop(s));
+        break;
+    case OPCODE_POP_J:
+        isa_set_reg(s, ISA_JH, isa_pop(s));
+        isa_set_reg(s, ISA_JL, isa_pop(s));
+        break;
+    case OPCODE_CALL_IMM16:
+        isa_push(s, (uint8_t)next_pc);
+        isa_push(s, (uint8_t)(next_pc >> 8));
+        next_pc = imm16;
+        break;
+    case OPCODE_RET: {
+        uint8_t h = isa_pop(s);
+        next_pc = (uint16_t)((h << 8) | isa_pop(s));
+        break;
+    }
+
+    case OPCODE_LD_A_SP_PLUS_IMM8_PTR:
+        isa_set_reg(s, ISA_A, isa_read_data(s, isa_stack_address((uint8_t)(isa_reg(s, ISA_SP) + imm8))));
+        break;
+    case OPCODE_LD_SP_PLUS_IMM8_PTR_A:
+        isa_write_data(s, isa_stack_address((uint8_t)(isa_reg(s, ISA_SP) + imm8)), isa_reg(s, ISA_A));
+        break;
+
+    case OPCODE_LD_J_PTR_INC1_I_PTR_INC1:
+        isa_write_data(s, isa_index(s, ISA_JL), isa_read_data(s, isa_index(s, ISA_IL)));
+        isa_set_index(s, ISA_IL, (uint16_t)(isa_index(s, ISA_IL) + 1));
+        isa_set_index(s, ISA_JL, (uint16_t)(isa_index(s, ISA_JL) + 1));
+        break;
+
+    case OPCODE_INC_I:
+    case OPCODE_INC_J: {
+        uint8_t index_l = opcode == OPCODE_INC_I ? ISA_IL : ISA_JL;
+        isa_alu_reg(s, ALU_OP_INC_LS, index_l, 0);
+
+        if (s->f & ISA_ZF) {
+            isa_alu_reg(s, ALU_OP_INC_LS, (uint8_t)(index_l + 1), 0);
+        }
+        break;
+    }
+
+    // F is from the high byte when the low byte wrapped, otherwise as after
+    // incrementing the decremented low byte back, which tells if it wrapped.
+    case OPCODE_DEC_I:
+    case OPCODE_DEC_J: {
+        uint8_t index_l = opcode == OPCODE_DEC_I ? ISA_IL : ISA_JL;
+        uint8_t l = isa_reg(s, index_l);
+        isa_set_reg(s, index_l, (uint8_t)(l - 1));
+        isa_alu(ALU_OP_INC_LS, (uint8_t)(l - 1), 0, &s->f);
+
+        if (l == 0) {
+            isa_alu_reg(s, ALU_OP_DEC_LS, (uint8_t)(index_l + 1), 0);
+        }
+        break;
+    }
+
+    case OPCODE_ADD_I_IMM8: isa_add_index(s, ISA_IL, imm8); break;
+    case OPCODE_ADD_I_A: isa_add_index(s, ISA_IL, isa_reg(s, ISA_A)); break;
+
+    case OPCODE_LD_A_I_PLUS_IMM8_PTR: isa_set_reg(s, ISA_A, isa_read_data(s, isa_index_plus(s, ISA_IL, imm8))); break;
+    case OPCODE_LD_A_J_PLUS_IMM8_PTR: isa_set_reg(s, ISA_A, isa_read_data(s, isa_index_plus(s, ISA_JL, imm8))); break;
+    case OPCODE_LD_I_PLUS_IMM8_PTR_A: isa_write_data(s, isa_index_plus(s, ISA_IL, imm8), isa_reg(s, ISA_A)); break;
+    case OPCODE_LD_J_PLUS_IMM8_PTR_A: isa_write_data(s, isa_index_plus(s, ISA_JL, imm8), isa_reg(s, ISA_A)); break;
+    case OPCODE_LD_A_I_PLUS_A_PTR: isa_set_reg(s, ISA_A, isa_read_data(s, isa_index_plus(s, ISA_IL, isa_reg(s, ISA_A)))); break;
+
+    case OPCODE_IN_A_PORT0:
+    case OPCODE_IN_A_PORT1:
+    case OPCODE_IN_A_PORT2:
+    case OPCODE_IN_A_PORT3:
+    case OPCODE_IN_A_PORT4:
+    case OPCODE_IN_A_PORT5:
+    case OPCODE_IN_A_PORT6:
+    case OPCODE_IN_A_PORT7: isa_set_reg(s, ISA_A, s->io_inputs[opcode & 7]); break;
+
+    case OPCODE_OUT_PORT0_A:
+    case OPCODE_OUT_PORT1_A:
+    case OPCODE_OUT_PORT2_A:
+    case OPCODE_OUT_PORT3_A:
+    case OPCODE_OUT_PORT4_A:
+    case OPCODE_OUT_PORT5_A:
+    case OPCODE_OUT_PORT6_A:
+    case OPCODE_OUT_PORT7_A:
+    case OPCODE_OUT_PORT0_IMM8:
+    case OPCODE_OUT_PORT1_IMM8:
+    case OPCODE_OUT_PORT2_IMM8:
+    case OPCODE_OUT_PORT3_IMM8:
+    case OPCODE_OUT_PORT4_IMM8:
+    case OPCODE_OUT_PORT5_IMM8:
+    case OPCODE_OUT_PORT6_IMM8:
+    case OPCODE_OUT_PORT7_IMM8:
+        s->out_ports[0] = opcode & 7;
+        s->out_values[0] = length == 2 ? imm8 : isa_reg(s, ISA_A);
+        s->n_outs = 1;
+        break;
+    }
+
+    if (s->touched_register_area) {
+        return ISA_STOP_REGISTER_AREA;
+    }
+
+    s->pc = next_pc;
+
+    return ISA_OK;
+}
+
+#endif
@@ -91,6 +91,32 @@ typedef enum {
     OPCODE_RET,
     OPCODE_LD_A_SP_PLUS_IMM8_PTR,
     OPCODE_HALT,
+    OPCODE_LD_J_PTR_INC1_I_PTR_INC1,
+    OPCODE_INC_I,
+    OPCODE_INC_J,
+    OPCODE_DEC_I,
+    OPCODE_DEC_J,
+    OPCODE_ADD_I_IMM8,
+    OPCODE_ADD_I_A,
+    OPCODE_LD_SP_PLUS_IMM8_PTR_A,
+    OPCODE_LD_A_I_PLUS_IMM8_PTR,
+    OPCODE_LD_A_J_PLUS_IMM8_PTR,
+    OPCODE_LD_I_PLUS_IMM8_PTR_A,
+    OPCODE_LD_J_PLUS_IMM8_PTR_A,
+    OPCODE_DJNZ_B_IMM16,
+    OPCODE_DJNZ_C_IMM16,
+    OPCODE_DJNZ_D_IMM16,
+    OPCODE_LD_A_I_PLUS_A_PTR,
+    OPCODE_ROL_A,
+    OPCODE_SAR_A,
+    OPCODE_SWAP_A,
+    OPCODE_SUB_A_B,
+    OPCODE_SBC_A_B,
+    OPCODE_CMP_A_B,
+    OPCODE_MULSTEP_A_B,
+    OPCODE_LD_I_J_PTR = 0xe0,
+    OPCODE_LD_J_I_PTR,
+    OPCODE_LD_I_I_PTR,
     OPCODE_IN_A_PORT0 = 0xe8,
     OPCODE_IN_A_PORT1,
     OPCODE_IN_A_PORT2,
@@ -117,6 +143,32 @@ typedef enum {
     OPCODE_OUT_PORT7_IMM8,
 } Opcode;
 
+// The ALU matrix is generated, 16 opcodes per AluMatrixOp where bits 3..2 select the
+// destination and bits 1..0 the source register (a, b, c, d). Destination equal to source
+// is the imm8 form instead, e.g. `add b, {imm: i8}`.
+#define OPCODE_ALU_MATRIX_FIRST (0x70)
+#define OPCODE_ALU_MATRIX_LAST (0xdf)
+
+typedef enum {
+    ALU_MATRIX_ADD,
+    ALU_MATRIX_ADC,
+    ALU_MATRIX_SUB,
+    ALU_MATRIX_AND,
+    ALU_MATRIX_OR,
+    ALU_MATRIX_XOR,
+    ALU_MATRIX_CMP,
+} AluMatrixOp;
+
+#define OPCODE_ALU_MATRIX_OP(opcode) ((AluMatrixOp)(((opcode) - OPCODE_ALU_MATRIX_FIRST) >> 4))
+#define OPCODE_ALU_MATRIX_DEST(opcode) (((opcode) >> 2) & 3)
+#define OPCODE_ALU_MATRIX_SRC(opcode) (((opcode) >> 0) & 3)
+
+_Static_assert((OPCODE_ALU_MATRIX_FIRST & 0xf) == 0, "Expected 0");
+_Static_assert(OPCODE_ALU_MATRIX_LAST - OPCODE_ALU_MATRIX_FIRST + 1 == (ALU_MATRIX_CMP + 1) * 16, "Expected 16 opcodes per op");
+_Static_assert(OPCODE_ALU_MATRIX_FIRST > OPCODE_MULSTEP_A_B, "Expected after the fixed opcodes");
+_Static_assert(OPCODE_ALU_MATRIX_LAST < OPCODE_LD_I_J_PTR, "Expected before the pointer loads");
+_Static_assert(OPCODE_LD_I_I_PTR < OPCODE_IN_A_PORT0, "Expected before the port opcodes");
+
 // Port selection is defined by the lower 3 bits of the opcode.
 _Static_assert((OPCODE_IN_A_PORT0 & 7) == 0, "Expected 0");
 _Static_assert((OPCODE_IN_A_PORT1 & 7) == 1, "Expected 1");
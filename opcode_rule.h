@@ -0,0 +1,294 @@
+#ifndef OPCODE_RULE_H
+#define OPCODE_RULE_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h> // snprintf
+#include <string.h> // strcmp
+
+#include "opcode.h"
+
+typedef enum {
+    NONE,
+    PORT,
+    PORT_IMM8,
+    PORT_A,
+    IMM8,
+    IMM8_IN_NAME, // For displacements, where the name places {imm} itself
+    IMM16
+} Operand;
+
+typedef struct {
+    const char *n;
+    Operand op;
+} Rule;
+
+static inline Rule rule(const char *name, Operand operand) {
+    return (Rule){.n = name, .op = operand};
+}
+
+static Rule rule_from_alu_matrix_opcode(Opcode opcode) {
+    static const char *op_names[] = {
+        [ALU_MATRIX_ADD] = "add",
+        [ALU_MATRIX_ADC] = "adc",
+        [ALU_MATRIX_SUB] = "sub",
+        [ALU_MATRIX_AND] = "and",
+        [ALU_MATRIX_OR] = "or",
+        [ALU_MATRIX_XOR] = "xor",
+        [ALU_MATRIX_CMP] = "cmp",
+    };
+    static const char reg_names[] = "abcd";
+    static char names[OPCODE_ALU_MATRIX_LAST - OPCODE_ALU_MATRIX_FIRST + 1][16];
+
+    char *name = names[opcode - OPCODE_ALU_MATRIX_FIRST];
+    const char *op_name = op_names[OPCODE_ALU_MATRIX_OP(opcode)];
+    char dest = reg_names[OPCODE_ALU_MATRIX_DEST(opcode)];
+    char src = reg_names[OPCODE_ALU_MATRIX_SRC(opcode)];
+
+    if (dest == src) {
+        snprintf(name, sizeof(names[0]), "%s %c,", op_name, dest);
+        return rule(name, IMM8);
+    }
+
+    snprintf(name, sizeof(names[0]), "%s %c, %c", op_name, dest, src);
+    return rule(name, NONE);
+}
+
+static Rule rule_from_opcode(Opcode opcode) {
+    if (opcode >= OPCODE_ALU_MATRIX_FIRST && opcode <= OPCODE_ALU_MATRIX_LAST) {
+        return rule_from_alu_matrix_opcode(opcode);
+    }
+
+    switch (opcode) {
+    case OPCODE_NOP: return rule("nop", NONE);
+    case OPCODE_LD_A_IMM8: return rule("ld a,", IMM8);
+    case OPCODE_LD_B_IMM8: return rule("ld b,", IMM8);
+    case OPCODE_LD_C_IMM8: return rule("ld c,", IMM8);
+    case OPCODE_LD_D_IMM8: return rule("ld d,", IMM8);
+    case OPCODE_LD_I_IMM16: return rule("ld i,", IMM16);
+    case OPCODE_LD_J_IMM16: return rule("ld j,", IMM16);
+    case OPCODE_LD_A_I_PTR: return rule("ld a, [i]", NONE);
+    case OPCODE_LD_A_J_PTR: return rule("ld a, [j]", NONE);
+    case OPCODE_LD_A_I_PTR_INC1: return rule("ld a, [i++]", NONE);
+    case OPCODE_LD_A_J_PTR_INC1: return rule("ld a, [j++]", NONE);
+    case OPCODE_LD_I_PTR_A: return rule("ld [i], a", NONE);
+    case OPCODE_LD_J_PTR_A: return rule("ld [j], a", NONE);
+    case OPCODE_LD_I_PTR_INC1_A: return rule("ld [i++], a", NONE);
+    case OPCODE_LD_J_PTR_INC1_A: return rule("ld [j++], a", NONE);
+    case OPCODE_LD_I_PTR_AB: return rule("ld [i], ab", NONE);
+    case OPCODE_LD_I_PTR_CD: return rule("ld [i], cd", NONE);
+    case OPCODE_LD_J_PTR_CD: return rule("ld [j], cd", NONE);
+    case OPCODE_LD_AB_I_PTR: return rule("ld ab, [i]", NONE);
+    case OPCODE_LD_CD_I_PTR: return rule("ld cd, [i]", NONE);
+    case OPCODE_LD_CD_J_PTR: return rule("ld cd, [j]", NONE);
+    case OPCODE_LD_A_B: return rule("ld a, b", NONE);
+    case OPCODE_LD_A_C: return rule("ld a, c", NONE);
+    case OPCODE_LD_A_D: return rule("ld a, d", NONE);
+    case OPCODE_LD_B_A: return rule("ld b, a", NONE);
+    case OPCODE_LD_B_C: return rule("ld b, c", NONE);
+    case OPCODE_LD_B_D: return rule("ld b, d", NONE);
+    case OPCODE_LD_C_A: return rule("ld c, a", NONE);
+    case OPCODE_LD_C_B: return rule("ld c, b", NONE);
+    case OPCODE_LD_C_D: return rule("ld c, d", NONE);
+    case OPCODE_LD_D_A: return rule("ld d, a", NONE);
+    case OPCODE_LD_D_B: return rule("ld d, b", NONE);
+    case OPCODE_LD_D_C: return rule("ld d, c", NONE);
+    case OPCODE_INC_A: return rule("inc a", NONE);
+    case OPCODE_SHL_A: return rule("shl a", NONE);
+    case OPCODE_SHR_A: return rule("shr a", NONE);
+    case OPCODE_NOT_A: return rule("not a", NONE);
+    case OPCODE_DEC_A: return rule("dec a", NONE);
+    case OPCODE_ROR_A: return rule("ror a", NONE);
+    case OPCODE_ADD_A_B: return rule("add a, b", NONE);
+    case OPCODE_OR_A_B: return rule("or a, b", NONE);
+    case OPCODE_AND_A_B: return rule("and a, b", NONE);
+    case OPCODE_XOR_A_B: return rule("xor a, b", NONE);
+    case OPCODE_ADC_A_B: return rule("adc a, b", NONE);
+    case OPCODE_DEC_B: return rule("dec b", NONE);
+    case OPCODE_DEC_C: return rule("dec c", NONE);
+    case OPCODE_DEC_D: return rule("dec d", NONE);
+    case OPCODE_INC_B: return rule("inc b", NONE);
+    case OPCODE_INC_C: return rule("inc c", NONE);
+    case OPCODE_INC_D: return rule("inc d", NONE);
+    case OPCODE_ADD_D_B: return rule("add d, b", NONE);
+    case OPCODE_ADC_C_A: return rule("adc c, a", NONE);
+    case OPCODE_ADC_D_IMM8: return rule("adc d,", IMM8);
+    case OPCODE_ADD_A_IMM8: return rule("add a,", IMM8);
+    case OPCODE_OR_A_IMM8: return rule("or a,", IMM8);
+    case OPCODE_AND_A_IMM8: return rule("and a,", IMM8);
+    case OPCODE_XOR_A_IMM8: return rule("xor a,", IMM8);
+    case OPCODE_ADC_A_IMM8: return rule("adc a,", IMM8);
+    case OPCODE_ADD_B_IMM8: return rule("add b,", IMM8);
+    case OPCODE_CMP_A_IMM8: return rule("cmp a,", IMM8);
+    case OPCODE_CMP_B_IMM8: return rule("cmp b,", IMM8);
+    case OPCODE_OUT_PORT0_IMM8: assert((opcode & 7) == 0); return rule("out", PORT_IMM8);
+    case OPCODE_OUT_PORT1_IMM8:
+        assert(opcode - 1 == OPCODE_OUT_PORT0_IMM8);
+        assert((opcode & 7) == 1);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT2_IMM8:
+        assert(opcode - 1 == OPCODE_OUT_PORT1_IMM8);
+        assert((opcode & 7) == 2);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT3_IMM8:
+        assert(opcode - 1 == OPCODE_OUT_PORT2_IMM8);
+        assert((opcode & 7) == 3);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT4_IMM8:
+        assert(opcode - 1 == OPCODE_OUT_PORT3_IMM8);
+        assert((opcode & 7) == 4);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT5_IMM8:
+        assert(opcode - 1 == OPCODE_OUT_PORT4_IMM8);
+        assert((opcode & 7) == 5);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT6_IMM8:
+        assert(opcode - 1 == OPCODE_OUT_PORT5_IMM8);
+        assert((opcode & 7) == 6);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT7_IMM8:
+        assert(opcode - 1 == OPCODE_OUT_PORT6_IMM8);
+        assert((opcode & 7) == 7);
+        return rule("", NONE);
+    case OPCODE_IN_A_PORT0: assert((opcode & 7) == 0); return rule("in a,", PORT);
+    case OPCODE_IN_A_PORT1:
+        assert(opcode - 1 == OPCODE_IN_A_PORT0);
+        assert((opcode & 7) == 1);
+        return rule("", NONE);
+    case OPCODE_IN_A_PORT2:
+        assert(opcode - 1 == OPCODE_IN_A_PORT1);
+        assert((opcode & 7) == 2);
+        return rule("", NONE);
+    case OPCODE_IN_A_PORT3:
+        assert(opcode - 1 == OPCODE_IN_A_PORT2);
+        assert((opcode & 7) == 3);
+        return rule("", NONE);
+    case OPCODE_IN_A_PORT4:
+        assert(opcode - 1 == OPCODE_IN_A_PORT3);
+        assert((opcode & 7) == 4);
+        return rule("", NONE);
+    case OPCODE_IN_A_PORT5:
+        assert(opcode - 1 == OPCODE_IN_A_PORT4);
+        assert((opcode & 7) == 5);
+        return rule("", NONE);
+    case OPCODE_IN_A_PORT6:
+        assert(opcode - 1 == OPCODE_IN_A_PORT5);
+        assert((opcode & 7) == 6);
+        return rule("", NONE);
+    case OPCODE_IN_A_PORT7:
+        assert(opcode - 1 == OPCODE_IN_A_PORT6);
+        assert((opcode & 7) == 7);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT0_A: assert((opcode & 7) == 0); return rule("out", PORT_A);
+    case OPCODE_OUT_PORT1_A:
+        assert(opcode - 1 == OPCODE_OUT_PORT0_A);
+        assert((opcode & 7) == 1);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT2_A:
+        assert(opcode - 1 == OPCODE_OUT_PORT1_A);
+        assert((opcode & 7) == 2);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT3_A:
+        assert(opcode - 1 == OPCODE_OUT_PORT2_A);
+        assert((opcode & 7) == 3);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT4_A:
+        assert(opcode - 1 == OPCODE_OUT_PORT3_A);
+        assert((opcode & 7) == 4);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT5_A:
+        assert(opcode - 1 == OPCODE_OUT_PORT4_A);
+        assert((opcode & 7) == 5);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT6_A:
+        assert(opcode - 1 == OPCODE_OUT_PORT5_A);
+        assert((opcode & 7) == 6);
+        return rule("", NONE);
+    case OPCODE_OUT_PORT7_A:
+        assert(opcode - 1 == OPCODE_OUT_PORT6_A);
+        assert((opcode & 7) == 7);
+        return rule("", NONE);
+    case OPCODE_JMP_I: return rule("jmp i", NONE);
+    case OPCODE_JMP_J: return rule("jmp j", NONE);
+    case OPCODE_JMP_IMM16: return rule("jmp", IMM16);
+    case OPCODE_JZ_IMM16: return rule("jz", IMM16);
+    case OPCODE_JNZ_IMM16: return rule("jnz", IMM16);
+    case OPCODE_JC_IMM16: return rule("jc", IMM16);
+    case OPCODE_JNC_IMM16: return rule("jnc", IMM16);
+    case OPCODE_JO_IMM16: return rule("jo", IMM16);
+    case OPCODE_JNO_IMM16: return rule("jno", IMM16);
+    case OPCODE_JS_IMM16: return rule("js", IMM16);
+    case OPCODE_JNS_IMM16: return rule("jns", IMM16);
+    case OPCODE_LD_SP_IMM8: return rule("ld sp,", IMM8);
+    case OPCODE_PUSH_A: return rule("push a", NONE);
+    case OPCODE_PUSH_B: return rule("push b", NONE);
+    case OPCODE_PUSH_C: return rule("push c", NONE);
+    case OPCODE_PUSH_D: return rule("push d", NONE);
+    case OPCODE_PUSH_I: return rule("push i", NONE);
+    case OPCODE_PUSH_J: return rule("push j", NONE);
+    case OPCODE_POP_A: return rule("pop a", NONE);
+    case OPCODE_POP_B: return rule("pop b", NONE);
+    case OPCODE_POP_C: return rule("pop c", NONE);
+    case OPCODE_POP_D: return rule("pop d", NONE);
+    case OPCODE_POP_I: return rule("pop i", NONE);
+    case OPCODE_POP_J: return rule("pop j", NONE);
+    case OPCODE_CALL_IMM16: return rule("call", IMM16);
+    case OPCODE_RET: return rule("ret", NONE);
+    case OPCODE_LD_A_SP_PLUS_IMM8_PTR: return rule("ld a, [sp+{imm: i8}]", IMM8_IN_NAME);
+    case OPCODE_HALT: return rule("halt", NONE);
+    case OPCODE_LD_J_PTR_INC1_I_PTR_INC1: return rule("ld [j++], [i++]", NONE);
+    case OPCODE_INC_I: return rule("inc i", NONE);
+    case OPCODE_INC_J: return rule("inc j", NONE);
+    case OPCODE_DEC_I: return rule("dec i", NONE);
+    case OPCODE_DEC_J: return rule("dec j", NONE);
+    case OPCODE_ADD_I_IMM8: return rule("add i,", IMM8);
+    case OPCODE_ADD_I_A: return rule("add i, a", NONE);
+    case OPCODE_LD_SP_PLUS_IMM8_PTR_A: return rule("ld [sp+{imm: i8}], a", IMM8_IN_NAME);
+    case OPCODE_LD_A_I_PLUS_IMM8_PTR: return rule("ld a, [i+{imm: u8}]", IMM8_IN_NAME);
+    case OPCODE_LD_A_J_PLUS_IMM8_PTR: return rule("ld a, [j+{imm: u8}]", IMM8_IN_NAME);
+    case OPCODE_LD_I_PLUS_IMM8_PTR_A: return rule("ld [i+{imm: u8}], a", IMM8_IN_NAME);
+    case OPCODE_LD_J_PLUS_IMM8_PTR_A: return rule("ld [j+{imm: u8}], a", IMM8_IN_NAME);
+    case OPCODE_DJNZ_B_IMM16: return rule("djnz b,", IMM16);
+    case OPCODE_DJNZ_C_IMM16: return rule("djnz c,", IMM16);
+    case OPCODE_DJNZ_D_IMM16: return rule("djnz d,", IMM16);
+    case OPCODE_LD_A_I_PLUS_A_PTR: return rule("ld a, [i+a]", NONE);
+    case OPCODE_ROL_A: return rule("rol a", NONE);
+    case OPCODE_SAR_A: return rule("sar a", NONE);
+    case OPCODE_SWAP_A: return rule("swap a", NONE);
+    case OPCODE_SUB_A_B: return rule("sub a, b", NONE);
+    case OPCODE_SBC_A_B: return rule("sbc a, b", NONE);
+    case OPCODE_CMP_A_B: return rule("cmp a, b", NONE);
+    case OPCODE_MULSTEP_A_B: return rule("mulstep a, b", NONE);
+    case OPCODE_LD_I_J_PTR: return rule("ld i, [j]", NONE);
+    case OPCODE_LD_J_I_PTR: return rule("ld j, [i]", NONE);
+    case OPCODE_LD_I_I_PTR: return rule("ld i, [i]", NONE);
+    }
+
+    return rule("; ?", NONE);
+}
+
+// The generated ALU matrix overlaps some of the fixed opcodes, keep the fixed encoding for those.
+static bool rule_defined_before(Opcode opcode, Rule r) {
+    for (Opcode prev = 0; prev < opcode; ++prev) {
+        Rule prev_r = rule_from_opcode(prev);
+        if (prev_r.op == r.op && strcmp(prev_r.n, r.n) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// The customasm pattern of a rule, with its operands as `{name: type}` parameters.
+static void rule_pattern(Rule r, char *pattern, size_t size) {
+    snprintf(pattern, size, "%s%s", r.n,
+             r.op == NONE        ? ""
+             : r.op == PORT      ? " {port: u3}"
+             : r.op == PORT_IMM8 ? " {port: u3}, {imm: i8}"
+             : r.op == PORT_A    ? " {port: u3}, a"
+             : r.op == IMM8      ? " {imm: i8}"
+             : r.op == IMM16     ? " {imm: i16}"
+                                 : "");
+}
+
+#endif
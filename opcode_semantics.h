@@ -0,0 +1,261 @@
+// Generated by semantics.c from ./bin/control.bin, do not edit.
+#ifndef OPCODE_SEMANTICS_H
+#define OPCODE_SEMANTICS_H
+
+#include "control_semantics.h"
+
+// Transfer function per opcode, see OpcodeSemantics. Opcodes left out halt the clock.
+static const OpcodeSemantics opcode_semantics[256] = {
+    [0x00] = {.defined = 1, .length = 1, .min_cycles = 8, .max_cycles = 8, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 8, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x01] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .register_deps = {[0] = 0x00010000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x02] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .register_deps = {[1] = 0x00010000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x03] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .register_deps = {[2] = 0x00010000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x04] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .register_deps = {[3] = 0x00010000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x05] = {.defined = 1, .length = 3, .min_cycles = 5, .max_cycles = 5, .reads = 0x0000, .writes = 0x0060, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[5] = 0x00010000, [6] = 0x00020000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x06] = {.defined = 1, .length = 3, .min_cycles = 5, .max_cycles = 5, .reads = 0x0000, .writes = 0x0180, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[7] = 0x00010000, [8] = 0x00020000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x07] = {.defined = 1, .length = 1, .min_cycles = 10, .max_cycles = 10, .reads = 0x0060, .writes = 0x0001, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 10, .jump_cycles = 0, .register_deps = {[0] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x08] = {.defined = 1, .length = 1, .min_cycles = 10, .max_cycles = 10, .reads = 0x0180, .writes = 0x0001, .address_reads = 0x0180, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 10, .jump_cycles = 0, .register_deps = {[0] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x09] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0060, .writes = 0x0061, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[0] = 0x00080000, [5] = 0x00000020, [6] = 0x00000060, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x0a] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0180, .writes = 0x0181, .address_reads = 0x0180, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[0] = 0x00080000, [7] = 0x00000080, [8] = 0x00000180, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x0b] = {.defined = 1, .length = 1, .min_cycles = 10, .max_cycles = 10, .reads = 0x0061, .writes = 0x0000, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x02, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 10, .jump_cycles = 0, .memory_write_deps = 0x00000001, .out_deps = 0x00000000},
+    [0x0c] = {.defined = 1, .length = 1, .min_cycles = 10, .max_cycles = 10, .reads = 0x0181, .writes = 0x0000, .address_reads = 0x0180, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x02, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 10, .jump_cycles = 0, .memory_write_deps = 0x00000001, .out_deps = 0x00000000},
+    [0x0d] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0061, .writes = 0x0060, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x02, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[5] = 0x00000020, [6] = 0x00000060, }, .memory_write_deps = 0x00000001, .out_deps = 0x00000000},
+    [0x0e] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0181, .writes = 0x0180, .address_reads = 0x0180, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x02, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[7] = 0x00000080, [8] = 0x00000180, }, .memory_write_deps = 0x00000001, .out_deps = 0x00000000},
+    [0x0f] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0063, .writes = 0x0000, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x02, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .memory_write_deps = 0x00000003, .out_deps = 0x00000000},
+    [0x10] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x006c, .writes = 0x0000, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x02, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .memory_write_deps = 0x0000000c, .out_deps = 0x00000000},
+    [0x11] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x018c, .writes = 0x0000, .address_reads = 0x0180, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x02, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .memory_write_deps = 0x0000000c, .out_deps = 0x00000000},
+    [0x12] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0060, .writes = 0x0003, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[0] = 0x00080000, [1] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x13] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0060, .writes = 0x000c, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[2] = 0x00080000, [3] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x14] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0180, .writes = 0x000c, .address_reads = 0x0180, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[2] = 0x00080000, [3] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x15] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0002, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[0] = 0x00000002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x16] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0004, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[0] = 0x00000004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x17] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0008, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[0] = 0x00000008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x18] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[1] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x19] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0004, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[1] = 0x00000004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x1a] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0008, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[1] = 0x00000008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x1b] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[2] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x1c] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0002, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[2] = 0x00000002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x1d] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0008, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[2] = 0x00000008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x1e] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[3] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x1f] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0002, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[3] = 0x00000002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x20] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0004, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .register_deps = {[3] = 0x00000004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x21] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00000001, }, .flag_deps = {[0] = 0x00000001, [2] = 0x00000001, [3] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 0, .update_alu_op = 0},
+    [0x22] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00000001, }, .flag_deps = {[0] = 0x00000001, [1] = 0x00000001, [2] = 0x00000001, [3] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 0, .update_alu_op = 1},
+    [0x23] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00000001, }, .flag_deps = {[0] = 0x00000001, [1] = 0x00000001, [2] = 0x00000001, [3] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 0, .update_alu_op = 2},
+    [0x24] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00000001, }, .flag_deps = {[0] = 0x00000001, [1] = 0x00000001, [2] = 0x00000001, [3] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 0, .update_alu_op = 3},
+    [0x25] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00000001, }, .flag_deps = {[0] = 0x00000001, [2] = 0x00000001, [3] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 0, .update_alu_op = 4},
+    [0x26] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00000001, }, .flag_deps = {[0] = 0x00000001, [1] = 0x00000001, [2] = 0x00000001, [3] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 0, .update_alu_op = 5},
+    [0x27] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x28] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x29] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x2a] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x2b] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x02000003, }, .flag_deps = {[0] = 0x02000003, [1] = 0x02000003, [2] = 0x02000003, [3] = 0x02000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x2c] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0002, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[1] = 0x00000002, }, .flag_deps = {[0] = 0x00000002, [2] = 0x00000002, [3] = 0x00000002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 1, .update_alu_op = 4},
+    [0x2d] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0004, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[2] = 0x00000004, }, .flag_deps = {[0] = 0x00000004, [2] = 0x00000004, [3] = 0x00000004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 2, .update_alu_op = 4},
+    [0x2e] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0008, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[3] = 0x00000008, }, .flag_deps = {[0] = 0x00000008, [2] = 0x00000008, [3] = 0x00000008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 3, .update_alu_op = 4},
+    [0x2f] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0002, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[1] = 0x00000002, }, .flag_deps = {[0] = 0x00000002, [2] = 0x00000002, [3] = 0x00000002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 1, .update_alu_op = 0},
+    [0x30] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0004, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[2] = 0x00000004, }, .flag_deps = {[0] = 0x00000004, [2] = 0x00000004, [3] = 0x00000004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 2, .update_alu_op = 0},
+    [0x31] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0008, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[3] = 0x00000008, }, .flag_deps = {[0] = 0x00000008, [2] = 0x00000008, [3] = 0x00000008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 3, .update_alu_op = 0},
+    [0x32] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x33] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x02000005, }, .flag_deps = {[0] = 0x02000005, [1] = 0x02000005, [2] = 0x02000005, [3] = 0x02000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x34] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0008, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[3] = 0x02010008, }, .flag_deps = {[0] = 0x02010008, [1] = 0x02010008, [2] = 0x02010008, [3] = 0x02010008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x35] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x00010001, }, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x36] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x00010001, }, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x37] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x00010001, }, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x38] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x00010001, }, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x39] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x02010001, }, .flag_deps = {[0] = 0x02010001, [1] = 0x02010001, [2] = 0x02010001, [3] = 0x02010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x3a] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0002, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[1] = 0x00010002, }, .flag_deps = {[0] = 0x00010002, [1] = 0x00010002, [2] = 0x00010002, [3] = 0x00010002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x3b] = {.defined = 1, .length = 2, .min_cycles = 5, .max_cycles = 5, .reads = 0x0001, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x3c] = {.defined = 1, .length = 2, .min_cycles = 5, .max_cycles = 5, .reads = 0x0002, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .flag_deps = {[0] = 0x00010002, [1] = 0x00010002, [2] = 0x00010002, [3] = 0x00010002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x3d] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0060, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 0, .jumps = 1, .jump_deps = 0x00000060, .fall_through_cycles = 0, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x3e] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0180, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 0, .jumps = 1, .jump_deps = 0x00000180, .fall_through_cycles = 0, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x3f] = {.defined = 1, .length = 3, .min_cycles = 4, .max_cycles = 4, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 0, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 0, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x40] = {.defined = 1, .length = 3, .min_cycles = 4, .max_cycles = 4, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x1, .flags_written = 0x0, .control_flags_read = 0x1, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 4, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x41] = {.defined = 1, .length = 3, .min_cycles = 4, .max_cycles = 4, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x1, .flags_written = 0x0, .control_flags_read = 0x1, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 4, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x42] = {.defined = 1, .length = 3, .min_cycles = 4, .max_cycles = 4, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0x0, .control_flags_read = 0x2, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 4, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x43] = {.defined = 1, .length = 3, .min_cycles = 4, .max_cycles = 4, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0x0, .control_flags_read = 0x2, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 4, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x44] = {.defined = 1, .length = 3, .min_cycles = 4, .max_cycles = 4, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x4, .flags_written = 0x0, .control_flags_read = 0x4, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 4, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x45] = {.defined = 1, .length = 3, .min_cycles = 4, .max_cycles = 4, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x4, .flags_written = 0x0, .control_flags_read = 0x4, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 4, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x46] = {.defined = 1, .length = 3, .min_cycles = 4, .max_cycles = 4, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x8, .flags_written = 0x0, .control_flags_read = 0x8, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 4, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x47] = {.defined = 1, .length = 3, .min_cycles = 4, .max_cycles = 4, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x8, .flags_written = 0x0, .control_flags_read = 0x8, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 4, .jump_cycles = 4, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x48] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0010, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .register_deps = {[4] = 0x00010000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x49] = {.defined = 1, .length = 1, .min_cycles = 11, .max_cycles = 11, .reads = 0x0011, .writes = 0x0010, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x08, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 11, .jump_cycles = 0, .register_deps = {[4] = 0x00000010, }, .memory_write_deps = 0x00000001, .out_deps = 0x00000000},
+    [0x4a] = {.defined = 1, .length = 1, .min_cycles = 11, .max_cycles = 11, .reads = 0x0012, .writes = 0x0010, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x08, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 11, .jump_cycles = 0, .register_deps = {[4] = 0x00000010, }, .memory_write_deps = 0x00000002, .out_deps = 0x00000000},
+    [0x4b] = {.defined = 1, .length = 1, .min_cycles = 11, .max_cycles = 11, .reads = 0x0014, .writes = 0x0010, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x08, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 11, .jump_cycles = 0, .register_deps = {[4] = 0x00000010, }, .memory_write_deps = 0x00000004, .out_deps = 0x00000000},
+    [0x4c] = {.defined = 1, .length = 1, .min_cycles = 11, .max_cycles = 11, .reads = 0x0018, .writes = 0x0010, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x08, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 11, .jump_cycles = 0, .register_deps = {[4] = 0x00000010, }, .memory_write_deps = 0x00000008, .out_deps = 0x00000000},
+    [0x4d] = {.defined = 1, .length = 1, .min_cycles = 13, .max_cycles = 13, .reads = 0x0070, .writes = 0x0010, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x0a, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 13, .jump_cycles = 0, .register_deps = {[4] = 0x00000010, }, .memory_write_deps = 0x00000060, .out_deps = 0x00000000},
+    [0x4e] = {.defined = 1, .length = 1, .min_cycles = 13, .max_cycles = 13, .reads = 0x0190, .writes = 0x0010, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x0a, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 13, .jump_cycles = 0, .register_deps = {[4] = 0x00000010, }, .memory_write_deps = 0x00000180, .out_deps = 0x00000000},
+    [0x4f] = {.defined = 1, .length = 1, .min_cycles = 11, .max_cycles = 11, .reads = 0x0010, .writes = 0x0011, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x04, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 11, .jump_cycles = 0, .register_deps = {[0] = 0x00080000, [4] = 0x00000010, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x50] = {.defined = 1, .length = 1, .min_cycles = 11, .max_cycles = 11, .reads = 0x0010, .writes = 0x0012, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x04, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 11, .jump_cycles = 0, .register_deps = {[1] = 0x00080000, [4] = 0x00000010, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x51] = {.defined = 1, .length = 1, .min_cycles = 11, .max_cycles = 11, .reads = 0x0010, .writes = 0x0014, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x04, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 11, .jump_cycles = 0, .register_deps = {[2] = 0x00080000, [4] = 0x00000010, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x52] = {.defined = 1, .length = 1, .min_cycles = 11, .max_cycles = 11, .reads = 0x0010, .writes = 0x0018, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x04, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 11, .jump_cycles = 0, .register_deps = {[3] = 0x00080000, [4] = 0x00000010, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x53] = {.defined = 1, .length = 1, .min_cycles = 15, .max_cycles = 15, .reads = 0x0010, .writes = 0x0070, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x04, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 15, .jump_cycles = 0, .register_deps = {[4] = 0x00000010, [5] = 0x00080000, [6] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x54] = {.defined = 1, .length = 1, .min_cycles = 15, .max_cycles = 15, .reads = 0x0010, .writes = 0x0190, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x04, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 15, .jump_cycles = 0, .register_deps = {[4] = 0x00000010, [7] = 0x00080000, [8] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x55] = {.defined = 1, .length = 3, .min_cycles = 15, .max_cycles = 15, .reads = 0x0010, .writes = 0x0010, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x0a, .falls_through = 0, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 0, .jump_cycles = 15, .register_deps = {[4] = 0x00000010, }, .memory_write_deps = 0x00040000, .out_deps = 0x00000000},
+    [0x56] = {.defined = 1, .length = 1, .min_cycles = 11, .max_cycles = 11, .reads = 0x0010, .writes = 0x0010, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x04, .falls_through = 0, .jumps = 1, .jump_deps = 0x00080000, .fall_through_cycles = 0, .jump_cycles = 11, .register_deps = {[4] = 0x00000010, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x57] = {.defined = 1, .length = 2, .min_cycles = 12, .max_cycles = 12, .reads = 0x0010, .writes = 0x0001, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x04, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[0] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x59] = {.defined = 1, .length = 1, .min_cycles = 16, .max_cycles = 16, .reads = 0x01e0, .writes = 0x01e0, .address_reads = 0x01e0, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x03, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 16, .jump_cycles = 0, .register_deps = {[5] = 0x00000020, [6] = 0x00000060, [7] = 0x00000080, [8] = 0x00000180, }, .memory_write_deps = 0x00080000, .out_deps = 0x00000000},
+    [0x5a] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 8, .reads = 0x0060, .writes = 0x0060, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 8, .jump_cycles = 0, .register_deps = {[5] = 0x00000020, [6] = 0x00000040, }, .flag_deps = {[0] = 0x00000060, [2] = 0x00000060, [3] = 0x00000060, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x5b] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 8, .reads = 0x0180, .writes = 0x0180, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 8, .jump_cycles = 0, .register_deps = {[7] = 0x00000080, [8] = 0x00000100, }, .flag_deps = {[0] = 0x00000180, [2] = 0x00000180, [3] = 0x00000180, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x5c] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 9, .reads = 0x0060, .writes = 0x0060, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 9, .jump_cycles = 0, .register_deps = {[5] = 0x00000020, [6] = 0x00000040, }, .flag_deps = {[0] = 0x00000060, [2] = 0x00000060, [3] = 0x00000060, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x5d] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 9, .reads = 0x0180, .writes = 0x0180, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 9, .jump_cycles = 0, .register_deps = {[7] = 0x00000080, [8] = 0x00000100, }, .flag_deps = {[0] = 0x00000180, [2] = 0x00000180, [3] = 0x00000180, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x5e] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 9, .reads = 0x0060, .writes = 0x0060, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 9, .jump_cycles = 0, .register_deps = {[5] = 0x00010020, [6] = 0x00000040, }, .flag_deps = {[0] = 0x00010060, [1] = 0x00010020, [2] = 0x00010060, [3] = 0x00010060, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x5f] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 10, .reads = 0x0061, .writes = 0x0060, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 10, .jump_cycles = 0, .register_deps = {[5] = 0x00000021, [6] = 0x00000040, }, .flag_deps = {[0] = 0x00000061, [1] = 0x00000021, [2] = 0x00000061, [3] = 0x00000061, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x60] = {.defined = 1, .length = 2, .min_cycles = 12, .max_cycles = 12, .reads = 0x0011, .writes = 0x0000, .address_reads = 0x0010, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x08, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .memory_write_deps = 0x00000001, .out_deps = 0x00000000},
+    [0x61] = {.defined = 1, .length = 2, .min_cycles = 13, .max_cycles = 13, .reads = 0x0060, .writes = 0x0001, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 13, .jump_cycles = 0, .register_deps = {[0] = 0x00080000, }, .flag_deps = {[0] = 0x00010020, [1] = 0x00010020, [2] = 0x00010020, [3] = 0x00010020, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x62] = {.defined = 1, .length = 2, .min_cycles = 13, .max_cycles = 13, .reads = 0x0180, .writes = 0x0001, .address_reads = 0x0180, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 13, .jump_cycles = 0, .register_deps = {[0] = 0x00080000, }, .flag_deps = {[0] = 0x00010080, [1] = 0x00010080, [2] = 0x00010080, [3] = 0x00010080, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x63] = {.defined = 1, .length = 2, .min_cycles = 13, .max_cycles = 13, .reads = 0x0061, .writes = 0x0000, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x02, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 13, .jump_cycles = 0, .flag_deps = {[0] = 0x00010020, [1] = 0x00010020, [2] = 0x00010020, [3] = 0x00010020, }, .memory_write_deps = 0x00000001, .out_deps = 0x00000000},
+    [0x64] = {.defined = 1, .length = 2, .min_cycles = 13, .max_cycles = 13, .reads = 0x0181, .writes = 0x0000, .address_reads = 0x0180, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x02, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 13, .jump_cycles = 0, .flag_deps = {[0] = 0x00010080, [1] = 0x00010080, [2] = 0x00010080, [3] = 0x00010080, }, .memory_write_deps = 0x00000001, .out_deps = 0x00000000},
+    [0x65] = {.defined = 1, .length = 3, .min_cycles = 6, .max_cycles = 8, .reads = 0x0002, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 6, .jump_cycles = 8, .register_deps = {[1] = 0x00000002, }, .flag_deps = {[0] = 0x00000002, [2] = 0x00000002, [3] = 0x00000002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 1, .update_alu_op = 4},
+    [0x66] = {.defined = 1, .length = 3, .min_cycles = 6, .max_cycles = 8, .reads = 0x0004, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 6, .jump_cycles = 8, .register_deps = {[2] = 0x00000004, }, .flag_deps = {[0] = 0x00000004, [2] = 0x00000004, [3] = 0x00000004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 2, .update_alu_op = 4},
+    [0x67] = {.defined = 1, .length = 3, .min_cycles = 6, .max_cycles = 8, .reads = 0x0008, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xd, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 1, .jump_deps = 0x00030000, .fall_through_cycles = 6, .jump_cycles = 8, .register_deps = {[3] = 0x00000008, }, .flag_deps = {[0] = 0x00000008, [2] = 0x00000008, [3] = 0x00000008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 3, .update_alu_op = 4},
+    [0x68] = {.defined = 1, .length = 1, .min_cycles = 14, .max_cycles = 14, .reads = 0x0061, .writes = 0x0001, .address_reads = 0x0061, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 14, .jump_cycles = 0, .register_deps = {[0] = 0x00080000, }, .flag_deps = {[0] = 0x00000021, [1] = 0x00000021, [2] = 0x00000021, [3] = 0x00000021, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x69] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00000001, }, .flag_deps = {[0] = 0x00000001, [1] = 0x00000001, [2] = 0x00000001, [3] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 0, .update_alu_op = 12},
+    [0x6a] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00000001, }, .flag_deps = {[0] = 0x00000001, [1] = 0x00000001, [2] = 0x00000001, [3] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000, .has_unary_update = 1, .update_reg = 0, .update_alu_op = 13},
+    [0x6b] = {.defined = 1, .length = 1, .min_cycles = 8, .max_cycles = 8, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 8, .jump_cycles = 0, .register_deps = {[0] = 0x00000001, }, .flag_deps = {[0] = 0x00000001, [1] = 0x00000001, [2] = 0x00000001, [3] = 0x00000001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x6c] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x6d] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x02000003, }, .flag_deps = {[0] = 0x02000003, [1] = 0x02000003, [2] = 0x02000003, [3] = 0x02000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x6e] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x0003, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x6f] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x02000003, }, .flag_deps = {[0] = 0x02000003, [1] = 0x02000003, [2] = 0x02000003, [3] = 0x02000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x70] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x00010001, }, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x71] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x72] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000005, }, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x73] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000009, }, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x74] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x75] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0002, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[1] = 0x00010002, }, .flag_deps = {[0] = 0x00010002, [1] = 0x00010002, [2] = 0x00010002, [3] = 0x00010002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x76] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x00000006, }, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x77] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x78] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x00000005, }, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x79] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x00000006, }, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x7a] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0004, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[2] = 0x00010004, }, .flag_deps = {[0] = 0x00010004, [1] = 0x00010004, [2] = 0x00010004, [3] = 0x00010004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x7b] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x0000000c, }, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x7c] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x00000009, }, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x7d] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x7e] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000c, }, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x7f] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0008, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[3] = 0x00010008, }, .flag_deps = {[0] = 0x00010008, [1] = 0x00010008, [2] = 0x00010008, [3] = 0x00010008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x80] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x02010001, }, .flag_deps = {[0] = 0x02010001, [1] = 0x02010001, [2] = 0x02010001, [3] = 0x02010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x81] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x02000003, }, .flag_deps = {[0] = 0x02000003, [1] = 0x02000003, [2] = 0x02000003, [3] = 0x02000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x82] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x02000005, }, .flag_deps = {[0] = 0x02000005, [1] = 0x02000005, [2] = 0x02000005, [3] = 0x02000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x83] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x02000009, }, .flag_deps = {[0] = 0x02000009, [1] = 0x02000009, [2] = 0x02000009, [3] = 0x02000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x84] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x02000003, }, .flag_deps = {[0] = 0x02000003, [1] = 0x02000003, [2] = 0x02000003, [3] = 0x02000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x85] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0002, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[1] = 0x02010002, }, .flag_deps = {[0] = 0x02010002, [1] = 0x02010002, [2] = 0x02010002, [3] = 0x02010002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x86] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x02000006, }, .flag_deps = {[0] = 0x02000006, [1] = 0x02000006, [2] = 0x02000006, [3] = 0x02000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x87] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x0200000a, }, .flag_deps = {[0] = 0x0200000a, [1] = 0x0200000a, [2] = 0x0200000a, [3] = 0x0200000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x88] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x02000005, }, .flag_deps = {[0] = 0x02000005, [1] = 0x02000005, [2] = 0x02000005, [3] = 0x02000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x89] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x02000006, }, .flag_deps = {[0] = 0x02000006, [1] = 0x02000006, [2] = 0x02000006, [3] = 0x02000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x8a] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0004, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[2] = 0x02010004, }, .flag_deps = {[0] = 0x02010004, [1] = 0x02010004, [2] = 0x02010004, [3] = 0x02010004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x8b] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x0200000c, }, .flag_deps = {[0] = 0x0200000c, [1] = 0x0200000c, [2] = 0x0200000c, [3] = 0x0200000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x8c] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x02000009, }, .flag_deps = {[0] = 0x02000009, [1] = 0x02000009, [2] = 0x02000009, [3] = 0x02000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x8d] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0200000a, }, .flag_deps = {[0] = 0x0200000a, [1] = 0x0200000a, [2] = 0x0200000a, [3] = 0x0200000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x8e] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0200000c, }, .flag_deps = {[0] = 0x0200000c, [1] = 0x0200000c, [2] = 0x0200000c, [3] = 0x0200000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x8f] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0008, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x2, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[3] = 0x02010008, }, .flag_deps = {[0] = 0x02010008, [1] = 0x02010008, [2] = 0x02010008, [3] = 0x02010008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x90] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x00010001, }, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x91] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x92] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000005, }, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x93] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000009, }, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x94] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x95] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0002, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[1] = 0x00010002, }, .flag_deps = {[0] = 0x00010002, [1] = 0x00010002, [2] = 0x00010002, [3] = 0x00010002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x96] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x00000006, }, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x97] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x98] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x00000005, }, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x99] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x00000006, }, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x9a] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0004, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[2] = 0x00010004, }, .flag_deps = {[0] = 0x00010004, [1] = 0x00010004, [2] = 0x00010004, [3] = 0x00010004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x9b] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x0000000c, }, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x9c] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x00000009, }, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x9d] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x9e] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000c, }, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0x9f] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0008, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[3] = 0x00010008, }, .flag_deps = {[0] = 0x00010008, [1] = 0x00010008, [2] = 0x00010008, [3] = 0x00010008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xa0] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x00010001, }, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xa1] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xa2] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000005, }, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xa3] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000009, }, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xa4] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xa5] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0002, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[1] = 0x00010002, }, .flag_deps = {[0] = 0x00010002, [1] = 0x00010002, [2] = 0x00010002, [3] = 0x00010002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xa6] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x00000006, }, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xa7] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xa8] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x00000005, }, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xa9] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x00000006, }, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xaa] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0004, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[2] = 0x00010004, }, .flag_deps = {[0] = 0x00010004, [1] = 0x00010004, [2] = 0x00010004, [3] = 0x00010004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xab] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x0000000c, }, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xac] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x00000009, }, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xad] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xae] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000c, }, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xaf] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0008, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[3] = 0x00010008, }, .flag_deps = {[0] = 0x00010008, [1] = 0x00010008, [2] = 0x00010008, [3] = 0x00010008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xb0] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x00010001, }, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xb1] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xb2] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000005, }, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xb3] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000009, }, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xb4] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xb5] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0002, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[1] = 0x00010002, }, .flag_deps = {[0] = 0x00010002, [1] = 0x00010002, [2] = 0x00010002, [3] = 0x00010002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xb6] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x00000006, }, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xb7] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xb8] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x00000005, }, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xb9] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x00000006, }, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xba] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0004, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[2] = 0x00010004, }, .flag_deps = {[0] = 0x00010004, [1] = 0x00010004, [2] = 0x00010004, [3] = 0x00010004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xbb] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x0000000c, }, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xbc] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x00000009, }, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xbd] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xbe] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000c, }, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xbf] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0008, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[3] = 0x00010008, }, .flag_deps = {[0] = 0x00010008, [1] = 0x00010008, [2] = 0x00010008, [3] = 0x00010008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xc0] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0001, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[0] = 0x00010001, }, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xc1] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xc2] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000005, }, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xc3] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[0] = 0x00000009, }, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xc4] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0003, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x00000003, }, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xc5] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0002, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[1] = 0x00010002, }, .flag_deps = {[0] = 0x00010002, [1] = 0x00010002, [2] = 0x00010002, [3] = 0x00010002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xc6] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x00000006, }, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xc7] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0002, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[1] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xc8] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0005, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x00000005, }, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xc9] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0006, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x00000006, }, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xca] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0004, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[2] = 0x00010004, }, .flag_deps = {[0] = 0x00010004, [1] = 0x00010004, [2] = 0x00010004, [3] = 0x00010004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xcb] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0004, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[2] = 0x0000000c, }, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xcc] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x0009, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x00000009, }, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xcd] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000a, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000a, }, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xce] = {.defined = 1, .length = 1, .min_cycles = 7, .max_cycles = 7, .reads = 0x000c, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 7, .jump_cycles = 0, .register_deps = {[3] = 0x0000000c, }, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xcf] = {.defined = 1, .length = 2, .min_cycles = 6, .max_cycles = 6, .reads = 0x0008, .writes = 0x0008, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .register_deps = {[3] = 0x00010008, }, .flag_deps = {[0] = 0x00010008, [1] = 0x00010008, [2] = 0x00010008, [3] = 0x00010008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xd0] = {.defined = 1, .length = 2, .min_cycles = 5, .max_cycles = 5, .reads = 0x0001, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .flag_deps = {[0] = 0x00010001, [1] = 0x00010001, [2] = 0x00010001, [3] = 0x00010001, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xd1] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x0003, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xd2] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x0005, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xd3] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x0009, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xd4] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x0003, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x00000003, [1] = 0x00000003, [2] = 0x00000003, [3] = 0x00000003, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xd5] = {.defined = 1, .length = 2, .min_cycles = 5, .max_cycles = 5, .reads = 0x0002, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .flag_deps = {[0] = 0x00010002, [1] = 0x00010002, [2] = 0x00010002, [3] = 0x00010002, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xd6] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x0006, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xd7] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x000a, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xd8] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x0005, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x00000005, [1] = 0x00000005, [2] = 0x00000005, [3] = 0x00000005, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xd9] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x0006, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x00000006, [1] = 0x00000006, [2] = 0x00000006, [3] = 0x00000006, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xda] = {.defined = 1, .length = 2, .min_cycles = 5, .max_cycles = 5, .reads = 0x0004, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .flag_deps = {[0] = 0x00010004, [1] = 0x00010004, [2] = 0x00010004, [3] = 0x00010004, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xdb] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x000c, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xdc] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x0009, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x00000009, [1] = 0x00000009, [2] = 0x00000009, [3] = 0x00000009, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xdd] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x000a, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x0000000a, [1] = 0x0000000a, [2] = 0x0000000a, [3] = 0x0000000a, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xde] = {.defined = 1, .length = 1, .min_cycles = 6, .max_cycles = 6, .reads = 0x000c, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 6, .jump_cycles = 0, .flag_deps = {[0] = 0x0000000c, [1] = 0x0000000c, [2] = 0x0000000c, [3] = 0x0000000c, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xdf] = {.defined = 1, .length = 2, .min_cycles = 5, .max_cycles = 5, .reads = 0x0008, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0xf, .control_flags_read = 0x0, .effects = 0x00, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .flag_deps = {[0] = 0x00010008, [1] = 0x00010008, [2] = 0x00010008, [3] = 0x00010008, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xe0] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0180, .writes = 0x0060, .address_reads = 0x0180, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[5] = 0x00080000, [6] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xe1] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0060, .writes = 0x0180, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[7] = 0x00080000, [8] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xe2] = {.defined = 1, .length = 1, .min_cycles = 12, .max_cycles = 12, .reads = 0x0060, .writes = 0x0060, .address_reads = 0x0060, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x01, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 12, .jump_cycles = 0, .register_deps = {[5] = 0x00080000, [6] = 0x00080000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xe8] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0000, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x10, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00100000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xe9] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0000, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x10, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00100000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xea] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0000, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x10, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00100000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xeb] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0000, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x10, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00100000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xec] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0000, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x10, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00100000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xed] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0000, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x10, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00100000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xee] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0000, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x10, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00100000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xef] = {.defined = 1, .length = 1, .min_cycles = 5, .max_cycles = 5, .reads = 0x0000, .writes = 0x0001, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x10, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 5, .jump_cycles = 0, .register_deps = {[0] = 0x00100000, }, .memory_write_deps = 0x00000000, .out_deps = 0x00000000},
+    [0xf0] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00000001},
+    [0xf1] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00000001},
+    [0xf2] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00000001},
+    [0xf3] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00000001},
+    [0xf4] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00000001},
+    [0xf5] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00000001},
+    [0xf6] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00000001},
+    [0xf7] = {.defined = 1, .length = 1, .min_cycles = 4, .max_cycles = 4, .reads = 0x0001, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 4, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00000001},
+    [0xf8] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00010000},
+    [0xf9] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00010000},
+    [0xfa] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00010000},
+    [0xfb] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00010000},
+    [0xfc] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00010000},
+    [0xfd] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00010000},
+    [0xfe] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00010000},
+    [0xff] = {.defined = 1, .length = 2, .min_cycles = 3, .max_cycles = 3, .reads = 0x0000, .writes = 0x0000, .address_reads = 0x0000, .flags_read = 0x0, .flags_written = 0x0, .control_flags_read = 0x0, .effects = 0x20, .falls_through = 1, .jumps = 0, .jump_deps = 0x00000000, .fall_through_cycles = 3, .jump_cycles = 0, .memory_write_deps = 0x00000000, .out_deps = 0x00010000},
+};
+
+#endif
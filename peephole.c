@@ -0,0 +1,988 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h> // f*, printf, snprintf
+#include <stdlib.h> // exit
+#include <string.h> // memcpy, memset, strlen
+
+#include "assembler.h"
+#include "control.h"
+#include "control_semantics.h"
+#include "cpu.h"
+#include "isa.h"
+#include "opcode_rule.h"
+
+// Peephole optimizer, rewrites the instruction lines of an assembled program and assembles it
+// again, so labels keep pointing at the instructions they were on.
+//
+// Rewrites are tried on every run of instructions nothing jumps into the middle of, each one
+// is kept only when it takes fewer cycles according to the control ROM and the reference model
+// in `isa.h` gives the same registers, flags, memory and IO from random states for everything
+// still read afterwards. What is read afterwards follows the code from the end of the run,
+// through jumps and calls, until each register and flag is either read or overwritten.
+//
+// The best rewrite is applied and the program assembled again until none is left. Then both
+// programs run on the emulator's engine (`cpu.h`) with every `in` reading 0 and have to `out`
+// the same.
+
+#define ORIGIN (RAM_ABSOLUTE_START_ADDRESS)
+#define MAX_INSNS (ASM_MAX_LINES)
+#define MAX_WINDOW (4)
+#define MAX_REWRITES (4096)
+#define MAX_LIVENESS_STEPS (1024) // Instructions followed per question, more is taken as read
+#define MAX_LIVENESS_CALLS (8)
+#define N_TRIALS (512)
+#define N_QUICK_TRIALS (16) // Before the full trials, most candidates differ right away
+#define MAX_TRIAL_STEPS (8)
+#define MAX_TRIAL_WRITES (16)
+#define RUN_CYCLES (4000000) // Of the original program on the engine
+#define MAX_OUTS (4096)
+
+#define LIVE_REGISTERS (0x1ef) // a, b, c, d, il, ih, jl and jh, SP is always live
+#define ALL_FLAGS (0xf)
+
+typedef struct {
+    int line; // Into assembler.lines
+    uint16_t pc;
+    uint8_t opcode;
+    int length;
+    bool target; // A label is on it, something may jump here
+} AsmInsn;
+
+typedef struct {
+    int first; // Into insns
+    int n; // Instructions replaced
+    int n_replacements;
+    char replacements[MAX_WINDOW][64];
+    int saved; // Cycles
+    const char *name;
+} Rewrite;
+
+typedef struct {
+    uint16_t registers;
+    uint8_t flags;
+} Live;
+
+typedef struct {
+    uint16_t address;
+    uint8_t value;
+} TrialWrite;
+
+typedef struct {
+    uint8_t registers[9];
+    uint8_t f;
+    int n_writes;
+    TrialWrite writes[MAX_TRIAL_WRITES];
+    int n_outs;
+    uint8_t out_ports[MAX_TRIAL_STEPS];
+    uint8_t out_values[MAX_TRIAL_STEPS];
+} TrialOutcome;
+
+typedef struct {
+    int n_outs;
+    uint8_t out_ports[MAX_OUTS];
+    uint8_t out_values[MAX_OUTS];
+    uint64_t cycles; // When the last of them was latched, or when it halted
+    bool halted;
+    bool bus_conflict;
+} EngineRun;
+
+static OpcodeSemantics semantics[256];
+
+static uint8_t program[RAM_SIZE];
+static size_t program_size;
+static uint8_t image[0x10000]; // Program at ORIGIN
+
+static AsmInsn insns[MAX_INSNS];
+static int n_insns;
+
+static char text_pool[ASM_MAX_SOURCE_SIZE];
+static size_t text_pool_size;
+
+static uint8_t isa_scratch_ram[ISA_RAM_SIZE];
+static uint8_t isa_base_ram[ISA_RAM_SIZE];
+static uint8_t isa_rom[ISA_ROM_SIZE];
+
+static EngineRun *engine_run;
+
+static uint32_t random_state = 0x2f6b1d35;
+
+static uint32_t random_u32(void) {
+    // xorshift32
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+
+    return random_state;
+}
+
+static uint8_t random_u8(void) {
+    return (uint8_t)random_u32();
+}
+
+// Registers get the values where flags flip a few times as often as any other.
+static uint8_t random_register(void) {
+    static const uint8_t edges[] = {0x00, 0x01, 0x0f, 0x10, 0x7f, 0x80, 0xfe, 0xff};
+
+    return (random_u32() & 3) == 0 ? edges[random_u32() % sizeof(edges)] : random_u8();
+}
+
+// Engine hooks, `in` reads 0 so waiting on the LCD ends right away.
+static void update_io_ld(CPU cpu) {
+    if (engine_run->n_outs < MAX_OUTS) {
+        engine_run->out_ports[engine_run->n_outs] = cpu.r_o & 7;
+        engine_run->out_values[engine_run->n_outs] = cpu.data_bus;
+    }
+
+    ++engine_run->n_outs;
+}
+
+static uint8_t update_io_oe(CPU cpu) {
+    (void)cpu;
+
+    return 0;
+}
+
+static void update_ram_ld(uint16_t ram_address) {
+    (void)ram_address;
+}
+
+static void update_bus_conflict(CPU cpu, int n_oe) {
+    (void)cpu;
+    (void)n_oe;
+
+    engine_run->bus_conflict = true;
+}
+
+static bool is_straight(uint8_t opcode) {
+    const OpcodeSemantics *s = &semantics[opcode];
+
+    return s->defined && !s->jumps && s->falls_through && s->min_cycles == s->max_cycles;
+}
+
+// Whether anything in `live` is read, starting with the instruction at `pc`, before being overwritten.
+static bool read_from(uint16_t pc, Live live, uint16_t *returns, int n_returns, int *steps, uint16_t *on_path) {
+    for (;;) {
+        if (live.registers == 0 && live.flags == 0) {
+            return false;
+        }
+
+        if (++*steps > MAX_LIVENESS_STEPS || pc < ORIGIN || pc >= ORIGIN + program_size) {
+            return true;
+        }
+
+        // Around a loop with nothing more to look for than the first time round.
+        uint16_t looking_for = (uint16_t)(live.registers | (live.flags << 9) | (1 << 15));
+
+        if (on_path[pc] != 0 && (looking_for & ~on_path[pc]) == 0) {
+            return false;
+        }
+
+        const OpcodeSemantics *s = &semantics[image[pc]];
+
+        if (!s->defined) {
+            return true; // Halts, the registers are what's left
+        }
+
+        if ((s->reads & live.registers) || ((s->flags_read | s->control_flags_read) & live.flags)) {
+            return true;
+        }
+
+        if (s->min_cycles == s->max_cycles || s->has_unary_update) {
+            live.registers &= (uint16_t)~s->writes;
+            live.flags &= (uint8_t)~s->flags_written;
+        }
+
+        uint16_t next = (uint16_t)(pc + s->length);
+        bool direct = s->jump_deps == (SEMANTICS_DEP_OPERAND_0 | SEMANTICS_DEP_OPERAND_1);
+        uint16_t target = (uint16_t)(image[(uint16_t)(pc + 1)] | (image[(uint16_t)(pc + 2)] << 8));
+
+        if (!s->jumps) {
+            pc = next;
+            continue;
+        }
+
+        uint16_t saved = on_path[pc];
+        on_path[pc] = looking_for;
+        bool read = true;
+
+        if (direct && (s->effects & SEMANTICS_STACK_WRITE)) {
+            // A call, what the callee leaves is looked at again after it returns.
+            if (n_returns < MAX_LIVENESS_CALLS) {
+                returns[n_returns] = next;
+                read = read_from(target, live, returns, n_returns + 1, steps, on_path);
+            }
+        } else if (direct) {
+            read = read_from(target, live, returns, n_returns, steps, on_path) ||
+                   (s->falls_through && read_from(next, live, returns, n_returns, steps, on_path));
+        } else if ((s->effects & SEMANTICS_STACK_READ) && n_returns > 0) {
+            read = read_from(returns[n_returns - 1], live, returns, n_returns - 1, steps, on_path);
+        }
+
+        on_path[pc] = saved;
+        return read;
+    }
+}
+
+// Registers and flags read after the instruction at `pc` before being overwritten.
+static Live live_at(uint16_t pc) {
+    static uint16_t on_path[0x10000];
+    uint16_t returns[MAX_LIVENESS_CALLS];
+    Live live = {.registers = 1 << C_SPL};
+
+    for (int reg = 0; reg <= C_JH; ++reg) {
+        int steps = 0;
+
+        if ((LIVE_REGISTERS & (1 << reg)) &&
+            read_from(pc, (Live){.registers = (uint16_t)(1 << reg)}, returns, 0, &steps, on_path)) {
+            live.registers |= (uint16_t)(1 << reg);
+        }
+    }
+
+    for (int bit = 0; bit < 4; ++bit) {
+        int steps = 0;
+
+        if (read_from(pc, (Live){.flags = (uint8_t)(1 << bit)}, returns, 0, &steps, on_path)) {
+            live.flags |= (uint8_t)(1 << bit);
+        }
+    }
+
+    return live;
+}
+
+// Runs straight line code placed at ORIGIN from the scratch RAM, undoing its writes afterwards.
+static bool run_trial(const uint8_t *code, int length, const uint8_t *io_inputs, uint8_t f, TrialOutcome *outcome) {
+    memcpy(isa_scratch_ram, code, (size_t)length);
+
+    IsaState s = {.pc = ORIGIN, .f = f, .ram = isa_scratch_ram, .rom = isa_rom, .io_inputs = io_inputs};
+    bool ok = true;
+
+    outcome->n_writes = 0;
+    outcome->n_outs = 0;
+
+    for (int step = 0; s.pc != ORIGIN + length; ++step) {
+        if (step == MAX_TRIAL_STEPS || isa_step(&s) != ISA_OK || s.touched_register_area) {
+            ok = false;
+            break;
+        }
+
+        for (int i = 0; i < s.n_writes && outcome->n_writes < MAX_TRIAL_WRITES; ++i) {
+            outcome->writes[outcome->n_writes++] = (TrialWrite){.address = s.write_addresses[i]};
+        }
+
+        for (int i = 0; i < s.n_outs; ++i) {
+            outcome->out_ports[outcome->n_outs] = s.out_ports[i];
+            outcome->out_values[outcome->n_outs++] = s.out_values[i];
+        }
+    }
+
+    for (int i = 0; i < outcome->n_writes; ++i) {
+        uint16_t at = (uint16_t)(outcome->writes[i].address - ISA_RAM_START_ADDRESS);
+        outcome->writes[i].value = isa_scratch_ram[at];
+    }
+
+    memcpy(outcome->registers, isa_scratch_ram + ISA_REGISTERS_ADDRESS - ISA_RAM_START_ADDRESS, sizeof(outcome->registers));
+    outcome->f = s.f;
+
+    // Back to the base state for the next run.
+    for (int i = 0; i < outcome->n_writes; ++i) {
+        uint16_t at = (uint16_t)(outcome->writes[i].address - ISA_RAM_START_ADDRESS);
+        isa_scratch_ram[at] = isa_base_ram[at];
+    }
+
+    memcpy(isa_scratch_ram, isa_base_ram, (size_t)length);
+    memcpy(isa_scratch_ram + ISA_REGISTERS_ADDRESS - ISA_RAM_START_ADDRESS,
+           isa_base_ram + ISA_REGISTERS_ADDRESS - ISA_RAM_START_ADDRESS, 16);
+
+    return ok;
+}
+
+static uint8_t value_after(const TrialOutcome *outcome, uint16_t address) {
+    for (int i = outcome->n_writes - 1; i >= 0; --i) {
+        if (outcome->writes[i].address == address) {
+            return outcome->writes[i].value;
+        }
+    }
+
+    return isa_base_ram[address - ISA_RAM_START_ADDRESS];
+}
+
+static bool same_outcome(const TrialOutcome *a, const TrialOutcome *b, Live live) {
+    for (int reg = 0; reg < 9; ++reg) {
+        if ((live.registers & (1 << reg)) && a->registers[reg] != b->registers[reg]) {
+            return false;
+        }
+    }
+
+    if ((a->f ^ b->f) & live.flags) {
+        return false;
+    }
+
+    for (int i = 0; i < a->n_writes; ++i) {
+        if (value_after(b, a->writes[i].address) != a->writes[i].value) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < b->n_writes; ++i) {
+        if (value_after(a, b->writes[i].address) != b->writes[i].value) {
+            return false;
+        }
+    }
+
+    return a->n_outs == b->n_outs && memcmp(a->out_ports, b->out_ports, (size_t)a->n_outs) == 0 &&
+           memcmp(a->out_values, b->out_values, (size_t)a->n_outs) == 0;
+}
+
+// Random registers, flags and inputs, pointers into the data half of RAM away from the code.
+static void random_trial_state(uint8_t *io_inputs, uint8_t *f) {
+    uint8_t *registers = isa_scratch_ram + ISA_REGISTERS_ADDRESS - ISA_RAM_START_ADDRESS;
+
+    for (int reg = 0; reg < 16; ++reg) {
+        registers[reg] = random_register();
+    }
+
+    registers[ISA_SP] = (uint8_t)(random_u32() % 0xe0);
+    registers[ISA_IH] = (uint8_t)(0xc0 + random_u32() % 0x3f);
+    registers[ISA_JH] = (uint8_t)(0xc0 + random_u32() % 0x3f);
+
+    for (int port = 0; port < 8; ++port) {
+        io_inputs[port] = random_register();
+    }
+
+    *f = random_u8() & 0xf;
+
+    memcpy(isa_base_ram + ISA_REGISTERS_ADDRESS - ISA_RAM_START_ADDRESS, registers, 16);
+}
+
+// Whether `replacement` leaves the same as `original` for everything in `live`.
+static bool equivalent(const uint8_t *original, int original_length, const uint8_t *replacement,
+                       int replacement_length, Live live) {
+    int n_compared = 0;
+
+    for (int trial = 0; trial < N_TRIALS; ++trial) {
+        uint8_t io_inputs[8];
+        uint8_t f;
+        TrialOutcome a;
+        TrialOutcome b;
+
+        random_trial_state(io_inputs, &f);
+
+        if (!run_trial(original, original_length, io_inputs, f, &a) ||
+            !run_trial(replacement, replacement_length, io_inputs, f, &b)) {
+            continue;
+        }
+
+        if (!same_outcome(&a, &b, live)) {
+            return false;
+        }
+
+        if (++n_compared == N_QUICK_TRIALS && trial >= N_QUICK_TRIALS * 4) {
+            return false; // Mostly stops the model, like touching the register area
+        }
+    }
+
+    return n_compared >= N_TRIALS / 2;
+}
+
+static int cycles_of(const uint8_t *code, int length) {
+    int cycles = 0;
+
+    for (int at = 0; at < length; at += semantics[code[at]].length) {
+        cycles += semantics[code[at]].max_cycles;
+    }
+
+    return cycles;
+}
+
+// Text of an instruction without a 16 bit operand, in the syntax of the rules.
+static void insn_text(uint8_t opcode, uint8_t imm8, char *text, size_t size) {
+    Rule r = rule_from_opcode(opcode);
+    int port = opcode & 7;
+
+    if (r.n[0] == '\0') {
+        r = rule_from_opcode((Opcode)(opcode & ~7));
+    }
+
+    switch (r.op) {
+    case NONE: snprintf(text, size, "%s", r.n); break;
+    case PORT: snprintf(text, size, "%s %d", r.n, port); break;
+    case PORT_IMM8: snprintf(text, size, "%s %d, 0x%02x", r.n, port, imm8); break;
+    case PORT_A: snprintf(text, size, "%s %d, a", r.n, port); break;
+    case IMM8: snprintf(text, size, "%s 0x%02x", r.n, imm8); break;
+    case IMM8_IN_NAME:
+    case IMM16: text[0] = '\0'; break;
+    }
+}
+
+// The statement of a line, after its labels.
+static const char *statement_of(const char *text) {
+    const char *s = text;
+
+    for (;;) {
+        char name[ASM_MAX_SYMBOL_LENGTH];
+        const char *end = asm_identifier(asm_skip_spaces(s), name, sizeof(name));
+
+        if (end == NULL || *asm_skip_spaces(end) != ':') {
+            return asm_skip_spaces(s);
+        }
+
+        s = asm_skip_spaces(end) + 1;
+    }
+}
+
+// The operand of a line like `jmp label`, after the mnemonic.
+static const char *operand_of(const char *text) {
+    const char *s = statement_of(text);
+
+    while (*s != '\0' && *s != ' ' && *s != '\t') {
+        ++s;
+    }
+
+    return asm_skip_spaces(s);
+}
+
+// Last global label before `line`, `.local` labels in an operand only mean the same under it.
+static const char *scope_of(int line, char *scope, size_t size) {
+    scope[0] = '\0';
+
+    for (int i = line; i >= 0 && scope[0] == '\0'; --i) {
+        const char *s = assembler.lines[i].text;
+
+        for (;;) {
+            char name[ASM_MAX_SYMBOL_LENGTH];
+            const char *end = asm_identifier(asm_skip_spaces(s), name, sizeof(name));
+
+            if (end == NULL || (*asm_skip_spaces(end) != ':' && *asm_skip_spaces(end) != '=')) {
+                break;
+            }
+
+            if (name[0] != '.') {
+                snprintf(scope, size, "%s", name);
+            }
+
+            if (*asm_skip_spaces(end) == '=') {
+                break;
+            }
+
+            s = asm_skip_spaces(end) + 1;
+        }
+    }
+
+    return scope;
+}
+
+static void set_statement(int line, const char *statement) {
+    AsmLine *asm_line = &assembler.lines[line];
+    const char *old_statement = statement_of(asm_line->text);
+    size_t prefix_length = (size_t)(old_statement - asm_line->text);
+    size_t length = prefix_length + strlen(statement) + 2;
+
+    if (text_pool_size + length > sizeof(text_pool)) {
+        fprintf(stderr, "Out of room for rewritten lines\n");
+        exit(1);
+    }
+
+    char *text = text_pool + text_pool_size;
+    snprintf(text, length, "%.*s%s%s", (int)prefix_length, asm_line->text, prefix_length > 0 ? " " : "", statement);
+    text_pool_size += length;
+
+    asm_line->text = text;
+    asm_line->rule = 0;
+}
+
+// Instruction lines of the last assembly in address order, with the program copied to ORIGIN.
+static void collect_insns(void) {
+    memset(image, 0, sizeof(image));
+    memcpy(image + ORIGIN, program, program_size);
+
+    n_insns = 0;
+    bool labeled = false;
+
+    for (int i = 0; i < assembler.n_lines; ++i) {
+        const AsmLine *line = &assembler.lines[i];
+        labeled |= line->labeled;
+
+        if (line->rule == 0 || line->offset < 0) {
+            continue;
+        }
+
+        uint8_t opcode = program[line->offset];
+        insns[n_insns++] = (AsmInsn){
+            .line = i,
+            .pc = (uint16_t)(ORIGIN + line->offset),
+            .opcode = opcode,
+            .length = semantics[opcode].length,
+            .target = labeled,
+        };
+        labeled = false;
+    }
+}
+
+// Instructions `first` to `first + n` follow each other and nothing jumps between them.
+static bool is_run(int first, int n) {
+    if (first + n > n_insns) {
+        return false;
+    }
+
+    for (int i = 1; i < n; ++i) {
+        const AsmInsn *prev = &insns[first + i - 1];
+
+        if (insns[first + i].target || insns[first + i].pc != prev->pc + prev->length) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int assemble_replacements(const Rewrite *rewrite, uint8_t *code) {
+    int length = 0;
+
+    for (int i = 0; i < rewrite->n_replacements; ++i) {
+        const char *text = rewrite->replacements[i];
+
+        for (int opcode = 0; opcode < 256; ++opcode) {
+            char candidate[64];
+            uint8_t imm8 = 0;
+            int n_read = 0;
+
+            insn_text((uint8_t)opcode, 0, candidate, sizeof(candidate));
+
+            if (candidate[0] == '\0' || !semantics[opcode].defined) {
+                continue;
+            }
+
+            Rule r = rule_from_opcode((Opcode)opcode);
+
+            if (r.op == IMM8) {
+                unsigned value = 0;
+
+                if (strncmp(text, r.n, strlen(r.n)) != 0 || sscanf(text + strlen(r.n), " 0x%x%n", &value, &n_read) != 1 ||
+                    text[strlen(r.n) + (size_t)n_read] != '\0') {
+                    continue;
+                }
+
+                imm8 = (uint8_t)value;
+            } else if (strcmp(candidate, text) != 0) {
+                continue;
+            }
+
+            code[length++] = (uint8_t)opcode;
+
+            if (semantics[opcode].length == 2) {
+                code[length++] = imm8;
+            }
+
+            break;
+        }
+    }
+
+    return length;
+}
+
+// Keeps `candidate` when it's straight line code doing the same as the run for what's live after it.
+static void consider(Rewrite *best, const Rewrite *candidate, Live live) {
+    const AsmInsn *first = &insns[candidate->first];
+    const AsmInsn *last = &insns[candidate->first + candidate->n - 1];
+    int original_length = last->pc + last->length - first->pc;
+    uint8_t replacement[MAX_WINDOW * 2];
+    int replacement_length = assemble_replacements(candidate, replacement);
+
+    int saved = cycles_of(image + first->pc, original_length) - cycles_of(replacement, replacement_length);
+
+    if (saved <= (best->name != NULL ? best->saved : 0)) {
+        return;
+    }
+
+    for (int at = 0; at < replacement_length; at += semantics[replacement[at]].length) {
+        if (!is_straight(replacement[at])) {
+            return;
+        }
+    }
+
+    if (!equivalent(image + first->pc, original_length, replacement, replacement_length, live)) {
+        return;
+    }
+
+    *best = *candidate;
+    best->saved = saved;
+}
+
+// Straight line rewrites of the run starting at instruction `k`.
+static void straight_rewrites(int k, Rewrite *best) {
+    const AsmInsn *insn = &insns[k];
+    const OpcodeSemantics *s = &semantics[insn->opcode];
+
+    if (!is_straight(insn->opcode) || insn->opcode == OPCODE_NOP) {
+        return;
+    }
+
+    Live live = live_at((uint16_t)(insn->pc + insn->length));
+
+    // Dead: nothing it changes is read.
+    if (s->effects == 0 && (s->writes || s->flags_written)) {
+        consider(best, &(Rewrite){.first = k, .n = 1, .name = "dead"}, live);
+    }
+
+    // Cheaper instruction doing the same for what's read afterwards, like `cmp a, 0` for `or a, 0`.
+    if (s->effects == 0) {
+        uint8_t imm8 = image[(uint16_t)(insn->pc + 1)];
+        static const uint8_t imm8s[] = {0x00, 0x01, 0xff};
+
+        for (int opcode = 0; opcode < 256; ++opcode) {
+            const OpcodeSemantics *c = &semantics[opcode];
+
+            if (!is_straight((uint8_t)opcode) || c->effects != 0 || c->max_cycles >= s->max_cycles ||
+                (c->writes & live.registers & ~s->writes) || (c->flags_written & live.flags & ~s->flags_written)) {
+                continue;
+            }
+
+            for (int i = 0; i < (c->length == 2 ? 4 : 1); ++i) {
+                Rewrite candidate = {.first = k, .n = 1, .n_replacements = 1, .name = "cheaper"};
+                insn_text((uint8_t)opcode, i < 3 ? imm8s[i] : imm8, candidate.replacements[0], sizeof(candidate.replacements[0]));
+
+                if (candidate.replacements[0][0] != '\0') {
+                    consider(best, &candidate, live);
+                }
+            }
+        }
+    }
+
+    // Redundant after the one before, like `ld a, b` right after `ld b, a`.
+    if (k > 0 && is_run(k - 1, 2) && is_straight(insns[k - 1].opcode) && s->effects == 0 &&
+        (s->writes || s->flags_written)) {
+        Rewrite candidate = {.first = k - 1, .n = 2, .n_replacements = 1, .name = "redundant"};
+        insn_text(insns[k - 1].opcode, image[(uint16_t)(insns[k - 1].pc + 1)], candidate.replacements[0],
+                  sizeof(candidate.replacements[0]));
+
+        if (candidate.replacements[0][0] != '\0') {
+            consider(best, &candidate, live);
+        }
+    }
+
+    // Shifting a by four, `swap a` and masking off the half shifted in.
+    if (k >= 3 && is_run(k - 3, 4) && (insn->opcode == OPCODE_SHR_A || insn->opcode == OPCODE_SHL_A)) {
+        bool same = true;
+
+        for (int i = 1; i <= 3; ++i) {
+            same &= insns[k - i].opcode == insn->opcode;
+        }
+
+        if (same) {
+            Rewrite candidate = {.first = k - 3, .n = 4, .n_replacements = 2, .name = "swap"};
+            insn_text(OPCODE_SWAP_A, 0, candidate.replacements[0], sizeof(candidate.replacements[0]));
+            insn_text(OPCODE_AND_A_IMM8, insn->opcode == OPCODE_SHR_A ? 0x0f : 0xf0, candidate.replacements[1],
+                      sizeof(candidate.replacements[1]));
+            consider(best, &candidate, live);
+        }
+    }
+}
+
+// `ld i, imm16` or `ld j, imm16`, like before jumping somewhere that returns with `jmp i` or `jmp j`.
+static bool is_link_load(uint8_t opcode) {
+    const OpcodeSemantics *s = &semantics[opcode];
+    uint32_t imm16 = SEMANTICS_DEP_OPERAND_0 | SEMANTICS_DEP_OPERAND_1;
+
+    return s->defined && s->length == 3 && !s->jumps && s->effects == 0 &&
+           (s->writes == ((1 << C_IL) | (1 << C_IH)) || s->writes == ((1 << C_JL) | (1 << C_JH))) &&
+           (s->register_deps[C_IL] | s->register_deps[C_JL]) != 0 &&
+           ((s->register_deps[C_IL] | s->register_deps[C_IH] | s->register_deps[C_JL] | s->register_deps[C_JH]) & ~imm16) == 0;
+}
+
+static int insn_at(uint16_t pc) {
+    int low = 0;
+    int high = n_insns - 1;
+
+    while (low <= high) {
+        int mid = (low + high) / 2;
+
+        if (insns[mid].pc == pc) return mid;
+        if (insns[mid].pc < pc) low = mid + 1;
+        else high = mid - 1;
+    }
+
+    return -1;
+}
+
+// Whether code reached from `pc` addresses the stack relative to SP or loads SP, where a
+// callee entered by `jmp` instead of `call` would see the stack one return address lower.
+// `jmp i` and `jmp j` are taken to go back to an address the code loaded into them before.
+static bool uses_stack_frame(uint16_t pc) {
+    static uint8_t seen[0x10000];
+    static uint16_t stack[0x10000];
+    int n_stack = 0;
+    bool uses = false;
+    bool jumps_indirect = false;
+    bool loads_link = false;
+
+    memset(seen, 0, sizeof(seen));
+    stack[n_stack++] = pc;
+
+    while (n_stack > 0 && !uses) {
+        uint16_t at = stack[--n_stack];
+
+        if (seen[at] || at < ORIGIN || at >= ORIGIN + program_size) {
+            uses |= !seen[at];
+            continue;
+        }
+
+        seen[at] = 1;
+        const OpcodeSemantics *s = &semantics[image[at]];
+        bool stack_op = (s->effects & (SEMANTICS_STACK_READ | SEMANTICS_STACK_WRITE)) != 0;
+
+        uses |= !stack_op && (((s->address_reads & (1 << C_SPL)) != 0) || ((s->writes & (1 << C_SPL)) != 0));
+        jumps_indirect |= s->jumps && s->jump_deps != (SEMANTICS_DEP_OPERAND_0 | SEMANTICS_DEP_OPERAND_1) &&
+                          !(s->effects & SEMANTICS_STACK_READ);
+
+        if (is_link_load(image[at])) {
+            loads_link = true;
+            stack[n_stack++] = (uint16_t)(image[(uint16_t)(at + 1)] | (image[(uint16_t)(at + 2)] << 8));
+        }
+
+        if (s->jump_deps == (SEMANTICS_DEP_OPERAND_0 | SEMANTICS_DEP_OPERAND_1)) {
+            stack[n_stack++] = (uint16_t)(image[(uint16_t)(at + 1)] | (image[(uint16_t)(at + 2)] << 8));
+        }
+
+        if (s->falls_through || (s->effects & SEMANTICS_STACK_WRITE)) {
+            stack[n_stack++] = (uint16_t)(at + s->length);
+        }
+    }
+
+    return uses || (jumps_indirect && !loads_link);
+}
+
+// Rewrites of jumps, they change where the program goes rather than what it computes.
+static void jump_rewrites(int k, Rewrite *best) {
+    const AsmInsn *insn = &insns[k];
+    const OpcodeSemantics *s = &semantics[insn->opcode];
+    const OpcodeSemantics *jmp = &semantics[OPCODE_JMP_IMM16];
+    const OpcodeSemantics *ret = &semantics[OPCODE_RET];
+    uint16_t target = (uint16_t)(image[(uint16_t)(insn->pc + 1)] | (image[(uint16_t)(insn->pc + 2)] << 8));
+    int target_k = s->jumps && s->jump_deps == (SEMANTICS_DEP_OPERAND_0 | SEMANTICS_DEP_OPERAND_1) ? insn_at(target) : -1;
+    int saved = 0;
+
+    if (target_k < 0) {
+        return;
+    }
+
+    const AsmInsn *target_insn = &insns[target_k];
+    const char *line_text = assembler.lines[insn->line].text;
+    char mnemonic[16];
+    snprintf(mnemonic, sizeof(mnemonic), "%.*s", (int)strcspn(statement_of(line_text), " \t"), statement_of(line_text));
+
+    // `call f` then `ret` is `jmp f`, f returns for us.
+    if ((s->effects & SEMANTICS_STACK_WRITE) && is_run(k, 2) && insns[k + 1].opcode == OPCODE_RET &&
+        !uses_stack_frame(target)) {
+        saved = s->max_cycles + ret->max_cycles - jmp->max_cycles;
+
+        if (saved > (best->name != NULL ? best->saved : 0)) {
+            *best = (Rewrite){.first = k, .n = 2, .n_replacements = 1, .saved = saved, .name = "tail call"};
+            snprintf(best->replacements[0], sizeof(best->replacements[0]), "jmp %s", operand_of(line_text));
+        }
+
+        return;
+    }
+
+    if (s->effects != 0) {
+        return;
+    }
+
+    // `jmp` to a `ret` is the `ret`.
+    if (insn->opcode == OPCODE_JMP_IMM16 && target_insn->opcode == OPCODE_RET) {
+        saved = s->max_cycles;
+
+        if (saved > (best->name != NULL ? best->saved : 0)) {
+            *best = (Rewrite){.first = k, .n = 1, .n_replacements = 1, .saved = saved, .name = "jump to ret"};
+            insn_text(OPCODE_RET, 0, best->replacements[0], sizeof(best->replacements[0]));
+        }
+
+        return;
+    }
+
+    // Jumping to a `jmp` goes straight to where that one goes, when its label means the same here.
+    if (target_insn->opcode == OPCODE_JMP_IMM16 && target_k != k) {
+        const char *operand = operand_of(assembler.lines[target_insn->line].text);
+        char scope[ASM_MAX_SYMBOL_LENGTH];
+        char target_scope[ASM_MAX_SYMBOL_LENGTH];
+
+        if (operand[0] == '.' && strcmp(scope_of(insn->line, scope, sizeof(scope)),
+                                        scope_of(target_insn->line, target_scope, sizeof(target_scope))) != 0) {
+            return;
+        }
+
+        uint16_t final_target = (uint16_t)(image[(uint16_t)(target_insn->pc + 1)] | (image[(uint16_t)(target_insn->pc + 2)] << 8));
+
+        if (final_target == target || final_target == insn->pc) {
+            return;
+        }
+
+        saved = jmp->jump_cycles;
+
+        if (saved > (best->name != NULL ? best->saved : 0)) {
+            *best = (Rewrite){.first = k, .n = 1, .n_replacements = 1, .saved = saved, .name = "jump to jump"};
+            snprintf(best->replacements[0], sizeof(best->replacements[0]), "%s %s", mnemonic, operand);
+        }
+    }
+}
+
+static void print_rewrite(const Rewrite *rewrite) {
+    const AsmLine *line = &assembler.lines[insns[rewrite->first].line];
+
+    printf("%s:%d: %s, ", assembler.files[line->file], line->line, rewrite->name);
+
+    for (int i = 0; i < rewrite->n; ++i) {
+        printf("%s%s", i > 0 ? "; " : "", statement_of(assembler.lines[insns[rewrite->first + i].line].text));
+    }
+
+    printf(" ->");
+
+    for (int i = 0; i < rewrite->n_replacements; ++i) {
+        printf("%s %s", i > 0 ? ";" : "", rewrite->replacements[i]);
+    }
+
+    printf("%s, %d cycles fewer\n", rewrite->n_replacements == 0 ? " nothing" : "", rewrite->saved);
+}
+
+static void apply(const Rewrite *rewrite) {
+    for (int i = 0; i < rewrite->n; ++i) {
+        const AsmInsn *insn = &insns[rewrite->first + i];
+
+        // Dropped instructions keep their line for its labels, a `ret` something jumps to stays.
+        if (i < rewrite->n_replacements) {
+            set_statement(insn->line, rewrite->replacements[i]);
+        } else if (!(insn->target && insn->opcode == OPCODE_RET)) {
+            set_statement(insn->line, "");
+        }
+    }
+}
+
+static void run_engine(const uint8_t *code, size_t size, int max_outs, uint64_t max_cycles, EngineRun *run) {
+    *run = (EngineRun){0};
+    engine_run = run;
+
+    memset(ram, 0, sizeof(ram));
+    memcpy(ram, code, size);
+
+    rom[0] = OPCODE_JMP_IMM16;
+    rom[1] = ORIGIN & 0xff;
+    rom[2] = ORIGIN >> 8;
+
+    CPU cpu = cpu_half_cycle((CPU){.c_exec = 1, .r_s = 0xf});
+
+    for (uint64_t cycle = 0; cycle < max_cycles && run->n_outs < max_outs && !run->bus_conflict; ++cycle) {
+        if (!SIGNAL_HALT(cpu.control_signals)) {
+            run->halted = true;
+            run->cycles = cycle;
+            break;
+        }
+
+        int n_outs = run->n_outs;
+
+        cpu = cpu_half_cycle(cpu);
+        cpu = cpu_half_cycle(cpu);
+
+        if (run->n_outs != n_outs) {
+            run->cycles = cycle + 1;
+        }
+    }
+
+    engine_run = NULL;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <PROGRAM>.asm [OPTIMIZED PROGRAM].bin\n", argv[0]);
+        exit(1);
+    }
+
+    read_rom("./bin/control.bin", control_rom, CONTROL_ROM_SIZE);
+    read_rom("./bin/alu_low.bin", alu_low_rom, ALU_ROM_SIZE);
+    read_rom("./bin/alu_high.bin", alu_high_rom, ALU_ROM_SIZE);
+    derive_semantics((const uint8_t(*)[CONTROL_ROM_SIZE])&control_rom, &semantics);
+
+    if (assemble(argv[1], program, sizeof(program), &program_size) > 0) {
+        exit(1);
+    }
+
+    for (int i = 0; i < assembler.n_banks; ++i) {
+        const AsmBank *bank = &assembler.banks[i];
+
+        if (bank->outp == 0 && bank->end > bank->addr && bank->addr != ORIGIN) {
+            fprintf(stderr, "%s isn't loaded into RAM at 0x%04x, include bleh.asm rather than bleh_rom.asm\n", argv[1], ORIGIN);
+            exit(1);
+        }
+    }
+
+    static uint8_t original[RAM_SIZE];
+    size_t original_size = program_size;
+    memcpy(original, program, program_size);
+
+    for (int i = 0; i < ISA_RAM_SIZE; ++i) {
+        isa_base_ram[i] = random_u8();
+    }
+
+    memcpy(isa_scratch_ram, isa_base_ram, sizeof(isa_scratch_ram));
+
+    int n_rewrites = 0;
+    int static_saved = 0;
+
+    for (; n_rewrites < MAX_REWRITES; ++n_rewrites) {
+        collect_insns();
+
+        Rewrite best = {0};
+
+        for (int k = 0; k < n_insns; ++k) {
+            straight_rewrites(k, &best);
+            jump_rewrites(k, &best);
+        }
+
+        if (best.name == NULL) {
+            break;
+        }
+
+        print_rewrite(&best);
+        apply(&best);
+        static_saved += best.saved;
+
+        if (reassemble(program, sizeof(program), &program_size) > 0) {
+            fprintf(stderr, "The rewritten program doesn't assemble\n");
+            exit(1);
+        }
+    }
+
+    printf("%d rewrites, %d cycles fewer along them, %zu bytes to %zu bytes\n", n_rewrites, static_saved,
+           original_size, program_size);
+
+    // Both on the engine, the optimized one has to `out` the same as the original did.
+    static EngineRun before;
+    static EngineRun after;
+
+    run_engine(original, original_size, MAX_OUTS, RUN_CYCLES, &before);
+    run_engine(program, program_size, before.halted ? MAX_OUTS + 1 : before.n_outs, 2 * (uint64_t)RUN_CYCLES, &after);
+
+    bool same = !before.bus_conflict && !after.bus_conflict && before.halted == after.halted &&
+                before.n_outs == after.n_outs &&
+                memcmp(before.out_ports, after.out_ports, (size_t)(before.n_outs < MAX_OUTS ? before.n_outs : MAX_OUTS)) == 0 &&
+                memcmp(before.out_values, after.out_values, (size_t)(before.n_outs < MAX_OUTS ? before.n_outs : MAX_OUTS)) == 0;
+
+    if (!same) {
+        fprintf(stderr, "The optimized program differs on the emulator: %d outs%s before, %d outs%s after\n",
+                before.n_outs, before.halted ? " and halted" : "", after.n_outs, after.halted ? " and halted" : "");
+        return 1;
+    }
+
+    printf("Emulator: same %d outs%s in %llu cycles, was %llu cycles (%.1f%% fewer)\n", before.n_outs,
+           before.halted ? " and halt" : "", (unsigned long long)after.cycles, (unsigned long long)before.cycles,
+           before.cycles > 0 ? 100.0 * ((double)before.cycles - (double)after.cycles) / (double)before.cycles : 0.0);
+
+    if (argc > 2) {
+        FILE *file = fopen(argv[2], "w");
+
+        if (file == NULL || fwrite(program, sizeof(uint8_t), program_size, file) != program_size || fclose(file) != 0) {
+            fprintf(stderr, "Failed to write %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,263 @@
+#include <stdint.h> // uint*_t
+#include <stdio.h> // FILE, f* functions
+#include <stdlib.h> // exit
+#include <string.h> // strlen
+
+#include "control_semantics.h"
+#include "isa.h"
+
+static const char *register_names[16] = {
+    "a", "b", "c", "d", "sp", "il", "ih", "jl", "jh", "r9", "ra", "tl", "th", "ul", "re", "rf"};
+
+static const char *flag_names[4] = {"zf", "cf", "of", "sf"};
+
+static void append(char *string, size_t size, const char *part) {
+    size_t n = strlen(string);
+    snprintf(string + n, size - n, "%s%s", n > 0 ? " " : "", part);
+}
+
+static const char *deps_string(uint32_t deps, char *string, size_t size) {
+    string[0] = '\0';
+
+    for (int reg = 0; reg < 16; ++reg) {
+        if (deps & (1u << reg)) {
+            append(string, size, register_names[reg]);
+        }
+    }
+
+    for (int bit = 0; bit < 4; ++bit) {
+        if (deps & SEMANTICS_DEP_FLAG(bit)) {
+            append(string, size, flag_names[bit]);
+        }
+    }
+
+    if (deps & SEMANTICS_DEP_OPERAND_0) append(string, size, "imm0");
+    if (deps & SEMANTICS_DEP_OPERAND_1) append(string, size, "imm1");
+    if (deps & SEMANTICS_DEP_PC) append(string, size, "pc");
+    if (deps & SEMANTICS_DEP_MEMORY) append(string, size, "mem");
+    if (deps & SEMANTICS_DEP_IO) append(string, size, "io");
+    if (deps & SEMANTICS_DEP_UNDEFINED) append(string, size, "undefined");
+
+    if (string[0] == '\0') {
+        append(string, size, "const");
+    }
+
+    return string;
+}
+
+// One line per opcode: what each written location is computed from, `;` between them.
+static void print_semantics(uint8_t opcode, const OpcodeSemantics *s) {
+    char transfer[512] = "";
+    char part[160];
+    char deps[128];
+
+    for (int reg = 0; reg < 16; ++reg) {
+        if (s->writes & (1 << reg)) {
+            snprintf(part, sizeof(part), "%s <- %s;", register_names[reg], deps_string(s->register_deps[reg], deps, sizeof(deps)));
+            append(transfer, sizeof(transfer), part);
+        }
+    }
+
+    for (int bit = 0; bit < 4; ++bit) {
+        if (s->flags_written & (1 << bit)) {
+            snprintf(part, sizeof(part), "%s <- %s;", flag_names[bit], deps_string(s->flag_deps[bit], deps, sizeof(deps)));
+            append(transfer, sizeof(transfer), part);
+        }
+    }
+
+    if (s->effects & (SEMANTICS_MEMORY_READ | SEMANTICS_STACK_READ | SEMANTICS_MEMORY_WRITE | SEMANTICS_STACK_WRITE)) {
+        bool reads = s->effects & (SEMANTICS_STACK_READ | SEMANTICS_MEMORY_READ);
+        bool writes = s->effects & (SEMANTICS_STACK_WRITE | SEMANTICS_MEMORY_WRITE);
+
+        snprintf(part, sizeof(part), "%s%s%s at %s;",
+                 s->effects & SEMANTICS_STACK_READ ? "reads stack" : reads ? "reads memory" : "",
+                 reads && writes ? " and " : "",
+                 s->effects & SEMANTICS_STACK_WRITE ? "writes stack" : writes ? "writes memory" : "",
+                 deps_string(s->address_reads, deps, sizeof(deps)));
+        append(transfer, sizeof(transfer), part);
+    }
+
+    if (s->effects & (SEMANTICS_MEMORY_WRITE | SEMANTICS_STACK_WRITE)) {
+        snprintf(part, sizeof(part), "[] <- %s;", deps_string(s->memory_write_deps, deps, sizeof(deps)));
+        append(transfer, sizeof(transfer), part);
+    }
+
+    if (s->effects & SEMANTICS_IO_OUT) {
+        snprintf(part, sizeof(part), "out <- %s;", deps_string(s->out_deps, deps, sizeof(deps)));
+        append(transfer, sizeof(transfer), part);
+    }
+
+    if (s->jumps) {
+        snprintf(part, sizeof(part), "pc <- %s%s;", deps_string(s->jump_deps, deps, sizeof(deps)), s->falls_through ? " or next" : "");
+        append(transfer, sizeof(transfer), part);
+    }
+
+    if (s->control_flags_read) {
+        deps_string((uint32_t)s->control_flags_read << 24, deps, sizeof(deps));
+        snprintf(part, sizeof(part), "steps by %s;", deps);
+        append(transfer, sizeof(transfer), part);
+    }
+
+    char cycles[16];
+
+    if (s->min_cycles != s->max_cycles) {
+        snprintf(cycles, sizeof(cycles), "%d/%d", s->min_cycles, s->max_cycles);
+    } else {
+        snprintf(cycles, sizeof(cycles), "%d", s->min_cycles);
+    }
+
+    printf("0x%02x    %-6s  %d      %s\n", opcode, cycles, s->length, transfer[0] != '\0' ? transfer : "-");
+}
+
+// Errors the symbolic run can tell on its own, and where it disagrees with the reference model.
+static int check_semantics(uint8_t opcode, const OpcodeSemantics *s) {
+    int isa_length = isa_instruction_length(opcode);
+    int n_errors = 0;
+
+    if (!s->defined) {
+        if (isa_length > 0 && opcode != OPCODE_HALT) {
+            fprintf(stderr, "0x%02x halts, %s expects %d bytes\n", opcode, "isa.h", isa_length);
+            ++n_errors;
+        }
+
+        return n_errors;
+    }
+
+    if (s->uses_undefined) {
+        fprintf(stderr, "0x%02x depends on LS, RS or C before loading them\n", opcode);
+        ++n_errors;
+    }
+
+    if (s->lengths_disagree) {
+        fprintf(stderr, "0x%02x continues at different addresses when not jumping\n", opcode);
+        ++n_errors;
+    }
+
+    if (s->reads & ((1 << C_TL) | (1 << C_TH) | (1 << C_UL))) {
+        fprintf(stderr, "0x%02x depends on a scratch register from before the instruction\n", opcode);
+        ++n_errors;
+    }
+
+    if (s->length != isa_length) {
+        fprintf(stderr, "0x%02x is %d bytes, isa.h expects %d\n", opcode, s->length, isa_length);
+        ++n_errors;
+    }
+
+    return n_errors;
+}
+
+static void write_deps_array(FILE *file, const char *name, const uint32_t *deps, int n) {
+    bool any = false;
+
+    for (int i = 0; i < n; ++i) {
+        any |= deps[i] != 0;
+    }
+
+    if (!any) {
+        return;
+    }
+
+    fprintf(file, " .%s = {", name);
+
+    for (int i = 0; i < n; ++i) {
+        if (deps[i] != 0) {
+            fprintf(file, "[%d] = 0x%08x, ", i, deps[i]);
+        }
+    }
+
+    fprintf(file, "},");
+}
+
+static int write_semantics_header(const char *filename, const char *control_filename,
+                                  const OpcodeSemantics (*semantics)[256]) {
+    FILE *file = fopen(filename, "w");
+
+    if (file == NULL) {
+        perror(__func__);
+        return 1;
+    }
+
+    fprintf(file, "// Generated by semantics.c from %s, do not edit.\n", control_filename);
+    fprintf(file, "#ifndef OPCODE_SEMANTICS_H\n");
+    fprintf(file, "#define OPCODE_SEMANTICS_H\n\n");
+    fprintf(file, "#include \"control_semantics.h\"\n\n");
+    fprintf(file, "// Transfer function per opcode, see OpcodeSemantics. Opcodes left out halt the clock.\n");
+    fprintf(file, "static const OpcodeSemantics opcode_semantics[256] = {\n");
+
+    for (int opcode = 0; opcode < 256; ++opcode) {
+        const OpcodeSemantics *s = &(*semantics)[opcode];
+
+        if (!s->defined) {
+            continue;
+        }
+
+        fprintf(file, "    [0x%02x] = {.defined = 1, .length = %d, .min_cycles = %d, .max_cycles = %d,"
+                      " .reads = 0x%04x, .writes = 0x%04x, .address_reads = 0x%04x,"
+                      " .flags_read = 0x%x, .flags_written = 0x%x, .control_flags_read = 0x%x, .effects = 0x%02x,"
+                      " .falls_through = %d, .jumps = %d, .jump_deps = 0x%08x,"
+                      " .fall_through_cycles = %d, .jump_cycles = %d,",
+                opcode, s->length, s->min_cycles, s->max_cycles,
+                s->reads, s->writes, s->address_reads,
+                s->flags_read, s->flags_written, s->control_flags_read, s->effects,
+                s->falls_through, s->jumps, s->jump_deps,
+                s->fall_through_cycles, s->jump_cycles);
+
+        write_deps_array(file, "register_deps", s->register_deps, 16);
+        write_deps_array(file, "flag_deps", s->flag_deps, 4);
+
+        fprintf(file, " .memory_write_deps = 0x%08x, .out_deps = 0x%08x", s->memory_write_deps, s->out_deps);
+
+        if (s->has_unary_update) {
+            fprintf(file, ", .has_unary_update = 1, .update_reg = %d, .update_alu_op = %d", s->update_reg, s->update_alu_op);
+        }
+
+        fprintf(file, "},\n");
+    }
+
+    fprintf(file, "};\n\n");
+    fprintf(file, "#endif\n");
+
+    return fclose(file) == 0 ? 0 : 2;
+}
+
+int main(int argc, char **argv) {
+    const char *control_filename = argc > 1 ? argv[1] : "./bin/control.bin";
+
+    static uint8_t table[CONTROL_ROM_SIZE];
+
+    FILE *file = fopen(control_filename, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Failed to read %s\n", control_filename);
+        exit(1);
+    }
+
+    if (fread(table, sizeof(uint8_t), CONTROL_ROM_SIZE, file) != CONTROL_ROM_SIZE) {
+        fprintf(stderr, "Failed to read the entire contents of %s\n", control_filename);
+        exit(1);
+    }
+
+    fclose(file);
+
+    static OpcodeSemantics semantics[256];
+    derive_semantics((const uint8_t(*)[CONTROL_ROM_SIZE])&table, &semantics);
+
+    int n_errors = 0;
+
+    printf("OPCODE  CYCLES  BYTES  TRANSFER\n");
+
+    for (int opcode = 0; opcode < 256; ++opcode) {
+        if (semantics[opcode].defined) {
+            print_semantics((uint8_t)opcode, &semantics[opcode]);
+        }
+
+        n_errors += check_semantics((uint8_t)opcode, &semantics[opcode]);
+    }
+
+    if (n_errors > 0) {
+        fprintf(stderr, "%d errors\n", n_errors);
+        return 1;
+    }
+
+    return write_semantics_header("opcode_semantics.h", control_filename,
+                                  (const OpcodeSemantics(*)[256])&semantics);
+}
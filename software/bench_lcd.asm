@@ -0,0 +1,94 @@
+#include "../bleh.asm"
+
+; Draws the same frames with lcd.asm, redrawing both lines every frame, and with
+; lcd_framebuffer.asm. Writes 1 and 2 to the debug port around the first and 3
+; and 4 around the second, the emulator prints the cycles between them.
+
+DEBUG_PORT = 1
+LCD_PORT = 2
+
+LCD_FB = 0xc000
+FRAME = 0xc100 ; Second line of the current frame, 0 terminated
+
+N_FRAMES = 10
+
+start:
+    call lcd_init
+
+    out DEBUG_PORT, 1
+    ld c, N_FRAMES
+
+    redraw_frame:
+    call make_frame
+    call lcd_return_home
+
+    ld i, title
+    call lcd_write_string
+
+    call lcd_set_cgram_address
+
+    ld i, FRAME
+    call lcd_write_string
+
+    djnz c, redraw_frame
+
+    out DEBUG_PORT, 2
+
+    call lcd_fb_init
+
+    out DEBUG_PORT, 3
+    ld c, N_FRAMES
+
+    flush_frame:
+    call make_frame
+
+    ld i, title
+    ld j, LCD_FB_LINE_1
+    call lcd_fb_write_string
+
+    ld i, FRAME
+    ld j, LCD_FB_LINE_2
+    call lcd_fb_write_string
+
+    push c
+    call lcd_fb_flush
+    pop c
+
+    djnz c, flush_frame
+
+    out DEBUG_PORT, 4
+
+done:
+    jmp done
+
+make_frame:
+    ; Input:
+    ;   c: frames left
+    ; Destroys:
+    ;   a, b, i, j
+    ld i, countdown
+    ld j, FRAME
+    ld b, COUNTDOWN_LENGTH
+
+    .copy:
+    ld [j++], [i++]
+    djnz b, .copy
+
+    ld a, c
+    add a, '0' - 1
+    ld [j], a
+
+    ld a, 0
+    ld [j+1], a
+
+    ret
+
+title:
+    #d "BLEH-1 benchmark\0"
+
+countdown:
+    #d "Frames left:   "
+COUNTDOWN_LENGTH = $ - countdown
+
+#include "./libraries/lcd.asm"
+#include "./libraries/lcd_framebuffer.asm"
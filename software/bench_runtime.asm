@@ -0,0 +1,73 @@
+#include "../bleh.asm"
+
+; Times the slower runtime routines, the debug port gets 1 before the first and
+; the number of the next one after each, the emulator prints the cycles between
+; them. Each includes the `out`, setting up the inputs and the call.
+;
+;   2: memcpy of 256 bytes
+;   3: memset of 256 bytes
+;   4: memcmp of 256 equal bytes
+;   5: mul8 of 255 * 254
+;   6: mul16 of 0xffff * 0xffff
+;   7: div16_8 of 65535 / 3
+;   8: u16_to_decimal of 39999
+
+DEBUG_PORT = 1
+
+BLOCK = 0xc000
+OUTPUT = 0xc200
+
+start:
+    out DEBUG_PORT, 1
+
+    ld i, _mul8_squares_low
+    ld j, BLOCK
+    ld c, 1
+    ld d, 0
+    call memcpy
+    out DEBUG_PORT, 2
+
+    ld a, 0
+    ld j, BLOCK + 256
+    ld c, 1
+    ld d, 0
+    call memset
+    out DEBUG_PORT, 3
+
+    ld i, _mul8_squares_low
+    ld j, BLOCK
+    ld c, 1
+    ld d, 0
+    call memcmp
+    out DEBUG_PORT, 4
+
+    ld a, 255
+    ld b, 254
+    call mul8
+    out DEBUG_PORT, 5
+
+    ld a, 0xff
+    ld b, 0xff
+    ld c, 0xff
+    ld d, 0xff
+    call mul16
+    out DEBUG_PORT, 6
+
+    ld a, 0xff
+    ld b, 0xff
+    ld c, 3
+    call div16_8
+    out DEBUG_PORT, 7
+
+    ld a, 39999 >> 8
+    ld b, 39999 & 0xff
+    ld j, OUTPUT
+    call u16_to_decimal
+    out DEBUG_PORT, 8
+
+done:
+    jmp done
+
+#include "./libraries/memory.asm"
+#include "./libraries/math.asm"
+#include "./libraries/format.asm"
@@ -1,50 +1,81 @@
 #include "../bleh_rom.asm"
 
+; Loads a program from the boot device in frames, see
+; arduino/BootDeviceSketch/boot_protocol.h, and jumps to the address of the last
+; frame. A frame whose checksum is wrong is asked for again, and writes BOOT_NAK
+; to the debug port. BOOT_NOT_READY in place of a frame is read again, the device
+; sends it while the frame is still being uploaded.
+
 BOOT_PORT = 0
-BOOT_COMMAND_GET_BYTES = 0xab
+BOOT_READY = 0x01
+BOOT_NOT_READY = 0xff
+BOOT_COMMAND_GET_BLOCKS = 0xb1
+BOOT_ACK = 0x06
+BOOT_NAK = 0x15
 
 DEBUG_PORT = 1
 
-BOOT_ADDRESS = 0x8000
+BOOT_HEADER = 0xffee ; Address of the frame being read, below the registers
 
 ld sp, 0xff
+ld j, BOOT_HEADER
 
 wait_until_boot_device_ready:
     in a, BOOT_PORT
-    out DEBUG_PORT, a
-    dec a
+    cmp a, BOOT_READY
     jnz wait_until_boot_device_ready
 
-ld a, BOOT_COMMAND_GET_BYTES
-out BOOT_PORT, a
+out BOOT_PORT, BOOT_COMMAND_GET_BLOCKS
 
-in a, BOOT_PORT ; Read low size into a
-ld b, a         ; b = low size
-in a, BOOT_PORT ; Read high size into a
-inc a           ; Convert to number of 256 byte pages
-ld c, a         ; c = number of pages to load
+read_frame:
+    in a, BOOT_PORT ; Number of 4 byte groups
+    cmp a, BOOT_NOT_READY
+    jz read_frame
+    ld b, a
+    ld c, a         ; c = sum of the frame
+    ld d, a         ; d = 0 for the last frame
 
-start_read_bytes:
-ld i, BOOT_ADDRESS ; Program destination in RAM
+    in a, BOOT_PORT
+    ld [j], a
+    add c, a
+    in a, BOOT_PORT
+    ld [j+1], a
+    add c, a
+    ld i, [j]
 
-loop_read_bytes:
-ld a, b
-out DEBUG_PORT, a ; Debug low bytes left
+    cmp b, 0
+    jz read_checksum
 
-in a, BOOT_PORT ; Read byte into a
-ld [i++], a     ; Store read byte into RAM
+read_group:
+    in a, BOOT_PORT
+    ld [i++], a
+    add c, a
+    in a, BOOT_PORT
+    ld [i++], a
+    add c, a
+    in a, BOOT_PORT
+    ld [i++], a
+    add c, a
+    in a, BOOT_PORT
+    ld [i++], a
+    add c, a
+    djnz b, read_group
 
-dec b
-jnz loop_read_bytes
+read_checksum:
+    in a, BOOT_PORT
+    add c, a
+    jnz bad_frame
 
-dec c
-jnz loop_read_bytes
+    out BOOT_PORT, BOOT_ACK
 
-; Temp indicator that we're done.
-ld a, 0xaa
-ld b, 0xbb
-ld c, 0xcc
-ld d, 0xdd
+    cmp d, 0
+    jnz read_frame
 
 ; Run program
-jmp BOOT_ADDRESS
\ No newline at end of file
+ld i, [j]
+jmp i
+
+bad_frame:
+    out BOOT_PORT, BOOT_NAK
+    out DEBUG_PORT, BOOT_NAK
+    jmp read_frame
@@ -0,0 +1,281 @@
+; Binary to BCD and decimal text.
+;
+; Digits are found by subtracting 8, 4, 2 and 1 times their place value, at
+; most 4 compares per digit where subtracting the place value until it
+; borrows takes up to 10.
+
+u8_to_bcd:
+    ; Input:
+    ;   a: value
+    ; Output:
+    ;   b: hundreds
+    ;   a: tens in the high nibble, ones in the low
+    ; Destroys:
+    ;   c
+    ; Cycles:
+    ;   At most 135
+    ld b, 0
+    cmp a, 200
+    jc .below_200
+    sub a, 200
+    ld b, 2
+    jmp .tens
+    .below_200:
+    cmp a, 100
+    jc .tens
+    sub a, 100
+    ld b, 1
+
+    .tens:
+    ld c, 0
+    cmp a, 80
+    jc .below_80
+    sub a, 80
+    or c, 8 << 4
+    .below_80:
+    cmp a, 40
+    jc .below_40
+    sub a, 40
+    or c, 4 << 4
+    .below_40:
+    cmp a, 20
+    jc .below_20
+    sub a, 20
+    or c, 2 << 4
+    .below_20:
+    cmp a, 10
+    jc .below_10
+    sub a, 10
+    or c, 1 << 4
+    .below_10:
+    or a, c
+    ret
+
+u8_to_decimal:
+    ; Input:
+    ;   a: value
+    ;   j: where to write 3 digits, with leading zeros, and a terminating 0
+    ; Output:
+    ;   j: at the terminating 0
+    ; Destroys:
+    ;   a, b, c
+    ; Cycles:
+    ;   At most 264
+    call u8_to_bcd
+    ld c, a
+    ld a, b
+    or a, '0'
+    ld [j++], a
+    ld a, c
+    swap a
+    and a, 0x0f
+    or a, '0'
+    ld [j++], a
+    ld a, c
+    and a, 0x0f
+    or a, '0'
+    ld [j++], a
+    ld a, 0
+    ld [j], a
+    ret
+
+u16_to_decimal:
+    ; Input:
+    ;   ab: value
+    ;   j: where to write 5 digits, with leading zeros, and a terminating 0
+    ; Output:
+    ;   j: at the terminating 0
+    ; Destroys:
+    ;   a, b, c, d
+    ; Cycles:
+    ;   At most 740
+    ld c, a
+    ld d, b
+
+    ; Ten thousands, at most 6
+    ld b, '0'
+    cmp c, 40000 >> 8
+    jc .below_40000
+    jnz .take_40000
+    cmp d, 40000 & 0xff
+    jc .below_40000
+    .take_40000:
+    sub d, 40000 & 0xff
+    jnc .high_40000
+    dec c
+    .high_40000:
+    sub c, 40000 >> 8
+    or b, 4
+    .below_40000:
+    cmp c, 20000 >> 8
+    jc .below_20000
+    jnz .take_20000
+    cmp d, 20000 & 0xff
+    jc .below_20000
+    .take_20000:
+    sub d, 20000 & 0xff
+    jnc .high_20000
+    dec c
+    .high_20000:
+    sub c, 20000 >> 8
+    or b, 2
+    .below_20000:
+    cmp c, 10000 >> 8
+    jc .below_10000
+    jnz .take_10000
+    cmp d, 10000 & 0xff
+    jc .below_10000
+    .take_10000:
+    sub d, 10000 & 0xff
+    jnc .high_10000
+    dec c
+    .high_10000:
+    sub c, 10000 >> 8
+    or b, 1
+    .below_10000:
+    ld a, b
+    ld [j++], a
+
+    ; Thousands
+    ld b, '0'
+    cmp c, 8000 >> 8
+    jc .below_8000
+    jnz .take_8000
+    cmp d, 8000 & 0xff
+    jc .below_8000
+    .take_8000:
+    sub d, 8000 & 0xff
+    jnc .high_8000
+    dec c
+    .high_8000:
+    sub c, 8000 >> 8
+    or b, 8
+    .below_8000:
+    cmp c, 4000 >> 8
+    jc .below_4000
+    jnz .take_4000
+    cmp d, 4000 & 0xff
+    jc .below_4000
+    .take_4000:
+    sub d, 4000 & 0xff
+    jnc .high_4000
+    dec c
+    .high_4000:
+    sub c, 4000 >> 8
+    or b, 4
+    .below_4000:
+    cmp c, 2000 >> 8
+    jc .below_2000
+    jnz .take_2000
+    cmp d, 2000 & 0xff
+    jc .below_2000
+    .take_2000:
+    sub d, 2000 & 0xff
+    jnc .high_2000
+    dec c
+    .high_2000:
+    sub c, 2000 >> 8
+    or b, 2
+    .below_2000:
+    cmp c, 1000 >> 8
+    jc .below_1000
+    jnz .take_1000
+    cmp d, 1000 & 0xff
+    jc .below_1000
+    .take_1000:
+    sub d, 1000 & 0xff
+    jnc .high_1000
+    dec c
+    .high_1000:
+    sub c, 1000 >> 8
+    or b, 1
+    .below_1000:
+    ld a, b
+    ld [j++], a
+
+    ; Hundreds, c is 0 after them
+    ld b, '0'
+    cmp c, 800 >> 8
+    jc .below_800
+    jnz .take_800
+    cmp d, 800 & 0xff
+    jc .below_800
+    .take_800:
+    sub d, 800 & 0xff
+    jnc .high_800
+    dec c
+    .high_800:
+    sub c, 800 >> 8
+    or b, 8
+    .below_800:
+    cmp c, 400 >> 8
+    jc .below_400
+    jnz .take_400
+    cmp d, 400 & 0xff
+    jc .below_400
+    .take_400:
+    sub d, 400 & 0xff
+    jnc .high_400
+    dec c
+    .high_400:
+    dec c
+    or b, 4
+    .below_400:
+    cmp c, 200 >> 8
+    jc .below_200
+    jnz .take_200
+    cmp d, 200 & 0xff
+    jc .below_200
+    .take_200:
+    sub d, 200 & 0xff
+    jnc .high_200
+    dec c
+    .high_200:
+    or b, 2
+    .below_200:
+    cmp c, 100 >> 8
+    jc .below_100
+    jnz .take_100
+    cmp d, 100 & 0xff
+    jc .below_100
+    .take_100:
+    sub d, 100 & 0xff
+    jnc .high_100
+    dec c
+    .high_100:
+    or b, 1
+    .below_100:
+    ld a, b
+    ld [j++], a
+
+    ; Tens
+    ld b, '0'
+    cmp d, 80
+    jc .below_80_tens
+    sub d, 80
+    or b, 8
+    .below_80_tens:
+    cmp d, 40
+    jc .below_40_tens
+    sub d, 40
+    or b, 4
+    .below_40_tens:
+    cmp d, 20
+    jc .below_20_tens
+    sub d, 20
+    or b, 2
+    .below_20_tens:
+    cmp d, 10
+    jc .below_10_tens
+    sub d, 10
+    or b, 1
+    .below_10_tens:
+    ld a, b
+    ld [j++], a
+
+    ld a, d
+    or a, '0'
+    ld [j++], a
+    ld a, 0
+    ld [j], a
+    ret
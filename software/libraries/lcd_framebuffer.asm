@@ -0,0 +1,255 @@
+; HD44780 2x16 driver drawing from a framebuffer in RAM, only cells that differ
+; from what the LCD shows are sent.
+;
+; Requires:
+;   LCD_PORT: IO port the LCD is on
+;   LCD_FB: 64 bytes of RAM, cell n is the character at LCD_FB + 2 * n and what
+;   the LCD shows at LCD_FB + 2 * n + 1, first line cells 0 to 15, second 16 to 31
+;
+; Draw into the even bytes, see lcd_fb_write_string, then call lcd_fb_flush.
+
+LCD_RS_IR = 0 << 7
+LCD_RS_DR = 1 << 7
+
+LCD_RW_WRITE = 0 << 6
+LCD_RW_READ = 1 << 6
+
+LCD_E_HIGH = 1 << 5
+LCD_E_LOW = 0 << 5
+
+LCD_FB_LINE_1 = LCD_FB
+LCD_FB_LINE_2 = LCD_FB + 2 * 16
+
+LCD_FB_CELLS = 2 * 16
+
+lcd_fb_init:
+    ; Destroys:
+    ;   a, b, c, j
+    call lcd_fb_reset
+
+    ld j, .function_set
+    jmp _lcd_fb_busy_wait_ret_to_j
+    .function_set:
+    ; 4-bit interface, 2 lines, 5x8 dots font
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH | 0b0010
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_LOW | 0b0010
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH | 0b1000
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_LOW | 0b1000
+
+    ld j, .display_on
+    jmp _lcd_fb_busy_wait_ret_to_j
+    .display_on:
+    ; Display on, cursor off, blinking off
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH | 0b0000
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_LOW | 0b0000
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH | 0b1100
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_LOW | 0b1100
+
+    ld j, .clear_display
+    jmp _lcd_fb_busy_wait_ret_to_j
+    .clear_display:
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH | 0b0000
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_LOW | 0b0000
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH | 0b0001
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_LOW | 0b0001
+
+    ; Both the framebuffer and what the LCD shows are blank now.
+    ld j, LCD_FB
+    ld a, ' '
+    ld b, 2 * LCD_FB_CELLS
+
+    .clear_framebuffer:
+    ld [j++], a
+    djnz b, .clear_framebuffer
+
+    ret
+
+lcd_fb_reset:
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH | 0b0011
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_LOW | 0b0011
+
+    ; 4.3 ms, 3 * 256 djnz of 8 cycles or more is 6.1 ms at 1 MHz.
+    ld b, 0
+    ld c, 3
+
+    .wait_first:
+    djnz b, .wait_first
+    djnz c, .wait_first
+
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH | 0b0011
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_LOW | 0b0011
+
+    ld c, 3
+
+    .wait_second:
+    djnz b, .wait_second
+    djnz c, .wait_second
+
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH | 0b0011
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_LOW | 0b0011
+
+    ; 100 us, 13 djnz of 8 cycles or more at 1 MHz.
+    ld b, 13
+
+    .wait_third:
+    djnz b, .wait_third
+
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH | 0b0010
+    out LCD_PORT, LCD_RS_IR | LCD_RW_WRITE | LCD_E_LOW | 0b0010
+
+    ret
+
+lcd_fb_write_string:
+    ; Input:
+    ;   i: address to 0 terminated string
+    ;   j: framebuffer address of the first cell, like LCD_FB_LINE_2 + 2 * 3
+    ; Destroys:
+    ;   a, i, j
+    ld a, [i++]
+    cmp a, 0
+    jz .done
+
+    ld [j++], a
+    inc j
+
+    jmp lcd_fb_write_string
+
+    .done:
+    ret
+
+lcd_fb_flush:
+    ; Sends the cells that changed since the last flush. The LCD moves its
+    ; address on to the next cell after each write, so a new address is only
+    ; sent before the first changed cell of each run of them. The busy flag is
+    ; read once right before each command, never between the nibbles.
+    ;
+    ; Cycles: 40 per unchanged cell, about 160 per changed cell and 130 more per
+    ; run of changed cells, not counting waiting on the LCD.
+    ; Destroys:
+    ;   a, b, c, d, i, j
+    ld i, _lcd_fb_high_nibbles
+    ld j, LCD_FB
+    ld b, LCD_FB_CELLS
+
+    .scan:
+    ld cd, [j] ; d = character, c = shown
+    cmp c, d
+    jnz .set_address
+
+    .scan_next:
+    inc j
+    inc j
+    djnz b, .scan
+
+    ret
+
+    .set_address:
+    ; DDRAM address of the cell, b counts down from 32 to 1
+    ld a, 0x80 | 32
+    sub a, b
+    cmp a, 0x80 | 16
+    jc .first_line
+    add a, 0x40 - 16
+    .first_line:
+    ld c, a
+
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_LOW
+    .set_address_busy:
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_HIGH
+    in a, LCD_PORT
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_LOW
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_HIGH
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_LOW
+    shl a
+    jc .set_address_busy
+
+    ; Same table as for characters with RS cleared
+    ld a, c
+    ld a, [i+a]
+    xor a, LCD_RS_DR
+    out LCD_PORT, a
+    xor a, LCD_E_HIGH
+    out LCD_PORT, a
+    ld a, c
+    and a, 0x0f
+    or a, LCD_RS_IR | LCD_RW_WRITE | LCD_E_HIGH
+    out LCD_PORT, a
+    xor a, LCD_E_HIGH
+    out LCD_PORT, a
+
+    .write:
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_LOW
+    .write_busy:
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_HIGH
+    in a, LCD_PORT
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_LOW
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_HIGH
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_LOW
+    shl a
+    jc .write_busy
+
+    ld a, d
+    ld a, [i+a]
+    out LCD_PORT, a
+    xor a, LCD_E_HIGH
+    out LCD_PORT, a
+    ld a, d
+    and a, 0x0f
+    or a, LCD_RS_DR | LCD_RW_WRITE | LCD_E_HIGH
+    out LCD_PORT, a
+    xor a, LCD_E_HIGH
+    out LCD_PORT, a
+
+    ld c, d
+    ld [j], cd
+
+    ; The LCD is at the next cell, as long as it's on the same line
+    inc j
+    inc j
+    dec b
+    jz .done
+    cmp b, 16
+    jz .scan
+
+    ld cd, [j]
+    cmp c, d
+    jnz .write
+    jmp .scan_next
+
+    .done:
+    ret
+
+_lcd_fb_busy_wait_ret_to_j:
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_LOW
+
+    .try_again:
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_HIGH
+    in a, LCD_PORT
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_LOW
+
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_HIGH
+    out LCD_PORT, LCD_RS_IR | LCD_RW_READ | LCD_E_LOW
+
+    shl a
+    jc .try_again
+    jmp j
+
+; High nibble of every character as sent with RS and E high, the low nibble is
+; masked and or:ed in fewer cycles than a second table would take to point to.
+_lcd_fb_high_nibbles:
+    #d 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0
+    #d 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1, 0xa1
+    #d 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2, 0xa2
+    #d 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3
+    #d 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4, 0xa4
+    #d 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5
+    #d 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6
+    #d 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7
+    #d 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8
+    #d 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9, 0xa9
+    #d 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa
+    #d 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab
+    #d 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac
+    #d 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad
+    #d 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae
+    #d 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf
@@ -0,0 +1,290 @@
+; 16-bit arithmetic, multiply and divide.
+;
+; 16-bit values are in ab and cd, a and c the high bytes, as `ld ab, [i]` and
+; `ld cd, [i]` load them from little endian memory.
+
+add16:
+    ; Input:
+    ;   ab, cd: terms
+    ; Output:
+    ;   ab: ab + cd
+    ;   CF: set on carry out of bit 15
+    ; Cycles:
+    ;   25
+    add b, d
+    adc a, c
+    ret
+
+sub16:
+    ; Input:
+    ;   ab: minuend
+    ;   cd: subtrahend
+    ; Output:
+    ;   ab: ab - cd
+    ;   CF: set on borrow, if ab was below cd
+    ; Destroys:
+    ;   c
+    ; Cycles:
+    ;   28 or 35
+    sub b, d
+    adc c, 0 ; The borrow moves to the subtrahend, `sbc` only exists for a, b
+    jc .done ; c was 0xff, subtracting 0x100 from a leaves it and borrows
+    sub a, c
+    .done:
+    ret
+
+cmp16:
+    ; Input:
+    ;   ab, cd: values to compare, unsigned
+    ; Output:
+    ;   ZF: set if ab is cd
+    ;   CF: set if ab is below cd
+    ; Cycles:
+    ;   21 or 27
+    cmp a, c
+    jnz .done
+    cmp b, d
+    .done:
+    ret
+
+mul8:
+    ; Quarter squares, a * b = f(a + b) - f(|a - b|) with f(x) = x * x / 4 rounded
+    ; down, which is exact as a + b and a - b are both even or both odd. f comes
+    ; from two 512 byte tables indexed with `ld a, [i+a]`, 8 shifts and adds would
+    ; take twice as long with only a able to shift.
+    ;
+    ; Input:
+    ;   a, b: factors
+    ; Output:
+    ;   ab: a * b
+    ; Destroys:
+    ;   c, d, i
+    ; Cycles:
+    ;   At most 186
+    ld c, a
+    sub a, b
+    jnc .difference
+    not a
+    inc a
+    .difference:
+    ld d, a
+
+    ld a, c
+    add a, b
+    ld c, a
+    jc .sum_above_255
+    ld i, _mul8_squares_low
+    ld a, [i+a]
+    ld b, a
+    ld i, _mul8_squares_high
+    jmp .sum_high
+    .sum_above_255:
+    ld i, _mul8_squares_low + 256
+    ld a, [i+a]
+    ld b, a
+    ld i, _mul8_squares_high + 256
+    .sum_high:
+    ld a, c
+    ld a, [i+a]
+    ld c, a
+
+    ; `ld a, [i+a]` sets the flags, the borrow of the low byte is taken before it.
+    ld i, _mul8_squares_low
+    ld a, d
+    ld a, [i+a]
+    sub b, a
+    ld i, _mul8_squares_high
+    ld a, d
+    jnc .no_borrow
+    ld a, [i+a]
+    inc a ; f(|a - b|) is at most 0x3f80, the high byte does not wrap
+    sub c, a
+    ld a, c
+    ret
+
+    .no_borrow:
+    ld a, [i+a]
+    sub c, a
+    ld a, c
+    ret
+
+mul16:
+    ; Only the low 16 bits are kept, the high byte product x high * y high is
+    ; not needed and the two cross products only for their low bytes.
+    ;
+    ; Input:
+    ;   ab, cd: factors
+    ; Output:
+    ;   ab: ab * cd, the low 16 bits
+    ; Destroys:
+    ;   c, d, i
+    ; Cycles:
+    ;   At most 844
+    push a ; [sp-3] x high
+    push d ; [sp-2] y low
+    push b ; [sp-1] x low
+
+    ld a, c
+    call mul8
+    ld a, b
+    push a ; [sp+0] low byte of y high * x low
+
+    ld a, [sp+-2]
+    ld b, a
+    ld a, [sp+-1]
+    call mul8
+    ld c, a
+    ld a, [sp+0]
+    add a, c
+    ld [sp+0], a
+    ld a, b
+    ld [sp+-1], a
+
+    ld a, [sp+-2]
+    ld b, a
+    ld a, [sp+-3]
+    call mul8
+    ld a, [sp+0]
+    add a, b
+    ld c, a
+
+    pop b
+    pop b
+    pop d
+    pop d
+    ld a, c
+    ret
+
+div16_8:
+    ; Restoring division one bit at a time, the high byte is skipped when it is
+    ; below the divisor.
+    ;
+    ; Input:
+    ;   ab: dividend
+    ;   c: divisor, not 0
+    ; Output:
+    ;   ab: ab / c
+    ;   c: ab % c
+    ; Destroys:
+    ;   d, i
+    ; Cycles:
+    ;   At most 618 if a is below c, else at most 1252
+    ld d, c
+    cmp a, c
+    jc .high_below_divisor
+
+    push b
+    ld b, a
+    ld c, 0
+    call _div16_8_byte
+    ld a, b
+    pop b
+    push a
+    call _div16_8_byte
+    pop a
+    ret
+
+    .high_below_divisor:
+    ld c, a
+    call _div16_8_byte
+    ld a, 0
+    ret
+
+_div16_8_byte:
+    ; Input:
+    ;   b: dividend byte
+    ;   c: remainder so far, below d
+    ;   d: divisor
+    ; Output:
+    ;   b: c:b / d
+    ;   c: c:b % d
+    ; Destroys:
+    ;   a, i
+    ld i, 0xfff8 ; Counts 8 bits, `inc i` sets ZF when i wraps to 0
+
+    .bit:
+    ld a, b
+    add a, b
+    ld b, a
+    ld a, c
+    adc a, c
+    jc .subtract ; The remainder is above 255 and so above the divisor
+    cmp a, d
+    jc .next
+    .subtract:
+    sub a, d
+    inc b
+    .next:
+    ld c, a
+    inc i
+    jnz .bit
+
+    ret
+
+_mul8_squares_low:
+    #d 0x00, 0x00, 0x01, 0x02, 0x04, 0x06, 0x09, 0x0c, 0x10, 0x14, 0x19, 0x1e, 0x24, 0x2a, 0x31, 0x38
+    #d 0x40, 0x48, 0x51, 0x5a, 0x64, 0x6e, 0x79, 0x84, 0x90, 0x9c, 0xa9, 0xb6, 0xc4, 0xd2, 0xe1, 0xf0
+    #d 0x00, 0x10, 0x21, 0x32, 0x44, 0x56, 0x69, 0x7c, 0x90, 0xa4, 0xb9, 0xce, 0xe4, 0xfa, 0x11, 0x28
+    #d 0x40, 0x58, 0x71, 0x8a, 0xa4, 0xbe, 0xd9, 0xf4, 0x10, 0x2c, 0x49, 0x66, 0x84, 0xa2, 0xc1, 0xe0
+    #d 0x00, 0x20, 0x41, 0x62, 0x84, 0xa6, 0xc9, 0xec, 0x10, 0x34, 0x59, 0x7e, 0xa4, 0xca, 0xf1, 0x18
+    #d 0x40, 0x68, 0x91, 0xba, 0xe4, 0x0e, 0x39, 0x64, 0x90, 0xbc, 0xe9, 0x16, 0x44, 0x72, 0xa1, 0xd0
+    #d 0x00, 0x30, 0x61, 0x92, 0xc4, 0xf6, 0x29, 0x5c, 0x90, 0xc4, 0xf9, 0x2e, 0x64, 0x9a, 0xd1, 0x08
+    #d 0x40, 0x78, 0xb1, 0xea, 0x24, 0x5e, 0x99, 0xd4, 0x10, 0x4c, 0x89, 0xc6, 0x04, 0x42, 0x81, 0xc0
+    #d 0x00, 0x40, 0x81, 0xc2, 0x04, 0x46, 0x89, 0xcc, 0x10, 0x54, 0x99, 0xde, 0x24, 0x6a, 0xb1, 0xf8
+    #d 0x40, 0x88, 0xd1, 0x1a, 0x64, 0xae, 0xf9, 0x44, 0x90, 0xdc, 0x29, 0x76, 0xc4, 0x12, 0x61, 0xb0
+    #d 0x00, 0x50, 0xa1, 0xf2, 0x44, 0x96, 0xe9, 0x3c, 0x90, 0xe4, 0x39, 0x8e, 0xe4, 0x3a, 0x91, 0xe8
+    #d 0x40, 0x98, 0xf1, 0x4a, 0xa4, 0xfe, 0x59, 0xb4, 0x10, 0x6c, 0xc9, 0x26, 0x84, 0xe2, 0x41, 0xa0
+    #d 0x00, 0x60, 0xc1, 0x22, 0x84, 0xe6, 0x49, 0xac, 0x10, 0x74, 0xd9, 0x3e, 0xa4, 0x0a, 0x71, 0xd8
+    #d 0x40, 0xa8, 0x11, 0x7a, 0xe4, 0x4e, 0xb9, 0x24, 0x90, 0xfc, 0x69, 0xd6, 0x44, 0xb2, 0x21, 0x90
+    #d 0x00, 0x70, 0xe1, 0x52, 0xc4, 0x36, 0xa9, 0x1c, 0x90, 0x04, 0x79, 0xee, 0x64, 0xda, 0x51, 0xc8
+    #d 0x40, 0xb8, 0x31, 0xaa, 0x24, 0x9e, 0x19, 0x94, 0x10, 0x8c, 0x09, 0x86, 0x04, 0x82, 0x01, 0x80
+    #d 0x00, 0x80, 0x01, 0x82, 0x04, 0x86, 0x09, 0x8c, 0x10, 0x94, 0x19, 0x9e, 0x24, 0xaa, 0x31, 0xb8
+    #d 0x40, 0xc8, 0x51, 0xda, 0x64, 0xee, 0x79, 0x04, 0x90, 0x1c, 0xa9, 0x36, 0xc4, 0x52, 0xe1, 0x70
+    #d 0x00, 0x90, 0x21, 0xb2, 0x44, 0xd6, 0x69, 0xfc, 0x90, 0x24, 0xb9, 0x4e, 0xe4, 0x7a, 0x11, 0xa8
+    #d 0x40, 0xd8, 0x71, 0x0a, 0xa4, 0x3e, 0xd9, 0x74, 0x10, 0xac, 0x49, 0xe6, 0x84, 0x22, 0xc1, 0x60
+    #d 0x00, 0xa0, 0x41, 0xe2, 0x84, 0x26, 0xc9, 0x6c, 0x10, 0xb4, 0x59, 0xfe, 0xa4, 0x4a, 0xf1, 0x98
+    #d 0x40, 0xe8, 0x91, 0x3a, 0xe4, 0x8e, 0x39, 0xe4, 0x90, 0x3c, 0xe9, 0x96, 0x44, 0xf2, 0xa1, 0x50
+    #d 0x00, 0xb0, 0x61, 0x12, 0xc4, 0x76, 0x29, 0xdc, 0x90, 0x44, 0xf9, 0xae, 0x64, 0x1a, 0xd1, 0x88
+    #d 0x40, 0xf8, 0xb1, 0x6a, 0x24, 0xde, 0x99, 0x54, 0x10, 0xcc, 0x89, 0x46, 0x04, 0xc2, 0x81, 0x40
+    #d 0x00, 0xc0, 0x81, 0x42, 0x04, 0xc6, 0x89, 0x4c, 0x10, 0xd4, 0x99, 0x5e, 0x24, 0xea, 0xb1, 0x78
+    #d 0x40, 0x08, 0xd1, 0x9a, 0x64, 0x2e, 0xf9, 0xc4, 0x90, 0x5c, 0x29, 0xf6, 0xc4, 0x92, 0x61, 0x30
+    #d 0x00, 0xd0, 0xa1, 0x72, 0x44, 0x16, 0xe9, 0xbc, 0x90, 0x64, 0x39, 0x0e, 0xe4, 0xba, 0x91, 0x68
+    #d 0x40, 0x18, 0xf1, 0xca, 0xa4, 0x7e, 0x59, 0x34, 0x10, 0xec, 0xc9, 0xa6, 0x84, 0x62, 0x41, 0x20
+    #d 0x00, 0xe0, 0xc1, 0xa2, 0x84, 0x66, 0x49, 0x2c, 0x10, 0xf4, 0xd9, 0xbe, 0xa4, 0x8a, 0x71, 0x58
+    #d 0x40, 0x28, 0x11, 0xfa, 0xe4, 0xce, 0xb9, 0xa4, 0x90, 0x7c, 0x69, 0x56, 0x44, 0x32, 0x21, 0x10
+    #d 0x00, 0xf0, 0xe1, 0xd2, 0xc4, 0xb6, 0xa9, 0x9c, 0x90, 0x84, 0x79, 0x6e, 0x64, 0x5a, 0x51, 0x48
+    #d 0x40, 0x38, 0x31, 0x2a, 0x24, 0x1e, 0x19, 0x14, 0x10, 0x0c, 0x09, 0x06, 0x04, 0x02, 0x01, 0x00
+
+_mul8_squares_high:
+    #d 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    #d 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    #d 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02
+    #d 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03
+    #d 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x06
+    #d 0x06, 0x06, 0x06, 0x06, 0x06, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x08, 0x08, 0x08, 0x08, 0x08
+    #d 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0b, 0x0b, 0x0b, 0x0b, 0x0c
+    #d 0x0c, 0x0c, 0x0c, 0x0c, 0x0d, 0x0d, 0x0d, 0x0d, 0x0e, 0x0e, 0x0e, 0x0e, 0x0f, 0x0f, 0x0f, 0x0f
+    #d 0x10, 0x10, 0x10, 0x10, 0x11, 0x11, 0x11, 0x11, 0x12, 0x12, 0x12, 0x12, 0x13, 0x13, 0x13, 0x13
+    #d 0x14, 0x14, 0x14, 0x15, 0x15, 0x15, 0x15, 0x16, 0x16, 0x16, 0x17, 0x17, 0x17, 0x18, 0x18, 0x18
+    #d 0x19, 0x19, 0x19, 0x19, 0x1a, 0x1a, 0x1a, 0x1b, 0x1b, 0x1b, 0x1c, 0x1c, 0x1c, 0x1d, 0x1d, 0x1d
+    #d 0x1e, 0x1e, 0x1e, 0x1f, 0x1f, 0x1f, 0x20, 0x20, 0x21, 0x21, 0x21, 0x22, 0x22, 0x22, 0x23, 0x23
+    #d 0x24, 0x24, 0x24, 0x25, 0x25, 0x25, 0x26, 0x26, 0x27, 0x27, 0x27, 0x28, 0x28, 0x29, 0x29, 0x29
+    #d 0x2a, 0x2a, 0x2b, 0x2b, 0x2b, 0x2c, 0x2c, 0x2d, 0x2d, 0x2d, 0x2e, 0x2e, 0x2f, 0x2f, 0x30, 0x30
+    #d 0x31, 0x31, 0x31, 0x32, 0x32, 0x33, 0x33, 0x34, 0x34, 0x35, 0x35, 0x35, 0x36, 0x36, 0x37, 0x37
+    #d 0x38, 0x38, 0x39, 0x39, 0x3a, 0x3a, 0x3b, 0x3b, 0x3c, 0x3c, 0x3d, 0x3d, 0x3e, 0x3e, 0x3f, 0x3f
+    #d 0x40, 0x40, 0x41, 0x41, 0x42, 0x42, 0x43, 0x43, 0x44, 0x44, 0x45, 0x45, 0x46, 0x46, 0x47, 0x47
+    #d 0x48, 0x48, 0x49, 0x49, 0x4a, 0x4a, 0x4b, 0x4c, 0x4c, 0x4d, 0x4d, 0x4e, 0x4e, 0x4f, 0x4f, 0x50
+    #d 0x51, 0x51, 0x52, 0x52, 0x53, 0x53, 0x54, 0x54, 0x55, 0x56, 0x56, 0x57, 0x57, 0x58, 0x59, 0x59
+    #d 0x5a, 0x5a, 0x5b, 0x5c, 0x5c, 0x5d, 0x5d, 0x5e, 0x5f, 0x5f, 0x60, 0x60, 0x61, 0x62, 0x62, 0x63
+    #d 0x64, 0x64, 0x65, 0x65, 0x66, 0x67, 0x67, 0x68, 0x69, 0x69, 0x6a, 0x6a, 0x6b, 0x6c, 0x6c, 0x6d
+    #d 0x6e, 0x6e, 0x6f, 0x70, 0x70, 0x71, 0x72, 0x72, 0x73, 0x74, 0x74, 0x75, 0x76, 0x76, 0x77, 0x78
+    #d 0x79, 0x79, 0x7a, 0x7b, 0x7b, 0x7c, 0x7d, 0x7d, 0x7e, 0x7f, 0x7f, 0x80, 0x81, 0x82, 0x82, 0x83
+    #d 0x84, 0x84, 0x85, 0x86, 0x87, 0x87, 0x88, 0x89, 0x8a, 0x8a, 0x8b, 0x8c, 0x8d, 0x8d, 0x8e, 0x8f
+    #d 0x90, 0x90, 0x91, 0x92, 0x93, 0x93, 0x94, 0x95, 0x96, 0x96, 0x97, 0x98, 0x99, 0x99, 0x9a, 0x9b
+    #d 0x9c, 0x9d, 0x9d, 0x9e, 0x9f, 0xa0, 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8
+    #d 0xa9, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xad, 0xae, 0xaf, 0xb0, 0xb1, 0xb2, 0xb2, 0xb3, 0xb4, 0xb5
+    #d 0xb6, 0xb7, 0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbd, 0xbe, 0xbf, 0xc0, 0xc1, 0xc2, 0xc3
+    #d 0xc4, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcb, 0xcc, 0xcd, 0xce, 0xcf, 0xd0, 0xd1
+    #d 0xd2, 0xd3, 0xd4, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde, 0xdf, 0xe0
+    #d 0xe1, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xeb, 0xec, 0xed, 0xee, 0xef
+    #d 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
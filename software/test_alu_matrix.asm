@@ -0,0 +1,330 @@
+#include "../bleh.asm"
+
+; Runs every opcode of the ALU matrix, 0x70 to 0xdf, on the cases below. They are
+; patched into the slot as bytes, so the cells the ruledef gives a fixed encoding
+; are covered too. Each case is the opcode, its imm8 or a nop after the register
+; forms, CF before, a, b, c and d before, then a, b, c, d, ZF, CF, OF and SF after.
+; Writes 0xff to the debug port when all passed, the opcode and 0xee when one fails.
+
+DEBUG_PORT = 1
+
+RESULT = 0xc000 ; a, b, c, d, ZF, CF, OF and SF after the slot
+A_BEFORE = 0xc008
+
+start:
+    ld i, cases
+
+next_case:
+    ld j, slot
+    ld a, [i++]
+    ld [j++], a
+    ld a, [i++]
+    ld [j], a
+
+    ; CF from adding 0xff to 0 or 1, nothing below touches F until the slot.
+    ld a, [i++]
+    add a, 0xff
+
+    ld a, [i++]
+    ld j, A_BEFORE
+    ld [j], a
+    ld a, [i++]
+    ld b, a
+    ld a, [i++]
+    ld c, a
+    ld a, [i++]
+    ld d, a
+    push i
+    ld a, [j]
+
+slot:
+    #d 0x00, 0x00
+
+    ld j, RESULT
+    ld [j++], a
+    ld a, b
+    ld [j++], a
+    ld a, c
+    ld [j++], a
+    ld a, d
+    ld [j++], a
+
+    ld a, 0
+    jnz .zf_clear
+    ld a, 1
+    .zf_clear:
+    ld [j++], a
+
+    ld a, 0
+    jnc .cf_clear
+    ld a, 1
+    .cf_clear:
+    ld [j++], a
+
+    ld a, 0
+    jno .of_clear
+    ld a, 1
+    .of_clear:
+    ld [j++], a
+
+    ld a, 0
+    jns .sf_clear
+    ld a, 1
+    .sf_clear:
+    ld [j], a
+
+    pop i
+    ld j, RESULT
+    ld b, 8
+
+    .compare:
+    ld a, [j++]
+    ld c, a
+    ld a, [i++]
+    cmp a, c
+    jnz fail
+    djnz b, .compare
+
+    ld a, [i]
+    cmp a, 0
+    jnz next_case
+
+    out DEBUG_PORT, 0xff
+
+done:
+    jmp done
+
+fail:
+    ld j, slot
+    ld a, [j]
+    out DEBUG_PORT, a
+    out DEBUG_PORT, 0xee
+    jmp done
+
+; Two cases per opcode, the second giving 0.
+cases:
+    #d 0x70, 0xbb, 0x01, 0xd7, 0xdb, 0x34, 0x21, 0x92, 0xdb, 0x34, 0x21, 0x00, 0x01, 0x00, 0x01 ; add a, 0xbb, CF
+    #d 0x70, 0xa0, 0x00, 0x60, 0x0c, 0x9c, 0xab, 0x00, 0x0c, 0x9c, 0xab, 0x01, 0x01, 0x00, 0x00 ; add a, 0xa0
+    #d 0x71, 0x00, 0x01, 0xb0, 0xa7, 0x88, 0xa8, 0x57, 0xa7, 0x88, 0xa8, 0x00, 0x01, 0x01, 0x00 ; add a, b, CF
+    #d 0x71, 0x00, 0x01, 0xfe, 0x02, 0xc4, 0x96, 0x00, 0x02, 0xc4, 0x96, 0x01, 0x01, 0x00, 0x00 ; add a, b, CF
+    #d 0x72, 0x00, 0x00, 0x2b, 0xfa, 0x48, 0xdf, 0x73, 0xfa, 0x48, 0xdf, 0x00, 0x00, 0x00, 0x00 ; add a, c
+    #d 0x72, 0x00, 0x00, 0x62, 0x60, 0x9e, 0x8a, 0x00, 0x60, 0x9e, 0x8a, 0x01, 0x01, 0x00, 0x00 ; add a, c
+    #d 0x73, 0x00, 0x01, 0xf3, 0x34, 0x80, 0x3a, 0x2d, 0x34, 0x80, 0x3a, 0x00, 0x01, 0x00, 0x00 ; add a, d, CF
+    #d 0x73, 0x00, 0x01, 0x17, 0x1f, 0xc6, 0xe9, 0x00, 0x1f, 0xc6, 0xe9, 0x01, 0x01, 0x00, 0x00 ; add a, d, CF
+    #d 0x74, 0x00, 0x01, 0xb6, 0xe8, 0xd6, 0xfa, 0xb6, 0x9e, 0xd6, 0xfa, 0x00, 0x01, 0x00, 0x01 ; add b, a, CF
+    #d 0x74, 0x00, 0x00, 0x91, 0x6f, 0x44, 0xb1, 0x91, 0x00, 0x44, 0xb1, 0x01, 0x01, 0x00, 0x00 ; add b, a
+    #d 0x75, 0x0e, 0x00, 0x28, 0x7a, 0x7f, 0x9b, 0x28, 0x88, 0x7f, 0x9b, 0x00, 0x00, 0x01, 0x01 ; add b, 0x0e
+    #d 0x75, 0x27, 0x00, 0xdc, 0xd9, 0x6e, 0xe7, 0xdc, 0x00, 0x6e, 0xe7, 0x01, 0x01, 0x00, 0x00 ; add b, 0x27
+    #d 0x76, 0x00, 0x00, 0xba, 0x22, 0x0f, 0xb1, 0xba, 0x31, 0x0f, 0xb1, 0x00, 0x00, 0x00, 0x00 ; add b, c
+    #d 0x76, 0x00, 0x00, 0x61, 0x26, 0xda, 0x72, 0x61, 0x00, 0xda, 0x72, 0x01, 0x01, 0x00, 0x00 ; add b, c
+    #d 0x77, 0x00, 0x00, 0x17, 0xe2, 0x03, 0x4a, 0x17, 0x2c, 0x03, 0x4a, 0x00, 0x01, 0x00, 0x00 ; add b, d
+    #d 0x77, 0x00, 0x01, 0xe8, 0x85, 0xe0, 0x7b, 0xe8, 0x00, 0xe0, 0x7b, 0x01, 0x01, 0x00, 0x00 ; add b, d, CF
+    #d 0x78, 0x00, 0x01, 0x10, 0xae, 0x81, 0x0d, 0x10, 0xae, 0x91, 0x0d, 0x00, 0x00, 0x00, 0x01 ; add c, a, CF
+    #d 0x78, 0x00, 0x00, 0x55, 0x8c, 0xab, 0xfe, 0x55, 0x8c, 0x00, 0xfe, 0x01, 0x01, 0x00, 0x00 ; add c, a
+    #d 0x79, 0x00, 0x01, 0x85, 0x44, 0xd6, 0x5e, 0x85, 0x44, 0x1a, 0x5e, 0x00, 0x01, 0x00, 0x00 ; add c, b, CF
+    #d 0x79, 0x00, 0x00, 0xb6, 0x9f, 0x61, 0x0b, 0xb6, 0x9f, 0x00, 0x0b, 0x01, 0x01, 0x00, 0x00 ; add c, b
+    #d 0x7a, 0xd1, 0x01, 0xe2, 0xc5, 0x92, 0x03, 0xe2, 0xc5, 0x63, 0x03, 0x00, 0x01, 0x01, 0x00 ; add c, 0xd1, CF
+    #d 0x7a, 0x1a, 0x01, 0xfd, 0x69, 0xe6, 0xa1, 0xfd, 0x69, 0x00, 0xa1, 0x01, 0x01, 0x00, 0x00 ; add c, 0x1a, CF
+    #d 0x7b, 0x00, 0x00, 0xe1, 0xa2, 0x5f, 0x6e, 0xe1, 0xa2, 0xcd, 0x6e, 0x00, 0x00, 0x01, 0x01 ; add c, d
+    #d 0x7b, 0x00, 0x01, 0x96, 0xb6, 0x53, 0xad, 0x96, 0xb6, 0x00, 0xad, 0x01, 0x01, 0x00, 0x00 ; add c, d, CF
+    #d 0x7c, 0x00, 0x00, 0x0b, 0x7c, 0x6c, 0x9e, 0x0b, 0x7c, 0x6c, 0xa9, 0x00, 0x00, 0x00, 0x01 ; add d, a
+    #d 0x7c, 0x00, 0x00, 0xa2, 0x98, 0x1f, 0x5e, 0xa2, 0x98, 0x1f, 0x00, 0x01, 0x01, 0x00, 0x00 ; add d, a
+    #d 0x7d, 0x00, 0x00, 0xea, 0x1c, 0xcd, 0xf2, 0xea, 0x1c, 0xcd, 0x0e, 0x00, 0x01, 0x00, 0x00 ; add d, b
+    #d 0x7d, 0x00, 0x00, 0x3a, 0xba, 0x5b, 0x46, 0x3a, 0xba, 0x5b, 0x00, 0x01, 0x01, 0x00, 0x00 ; add d, b
+    #d 0x7e, 0x00, 0x01, 0x85, 0xaf, 0x34, 0x17, 0x85, 0xaf, 0x34, 0x4b, 0x00, 0x00, 0x00, 0x00 ; add d, c, CF
+    #d 0x7e, 0x00, 0x01, 0x54, 0x41, 0x15, 0xeb, 0x54, 0x41, 0x15, 0x00, 0x01, 0x01, 0x00, 0x00 ; add d, c, CF
+    #d 0x7f, 0xe5, 0x00, 0x3f, 0xd5, 0xdc, 0xe3, 0x3f, 0xd5, 0xdc, 0xc8, 0x00, 0x01, 0x00, 0x01 ; add d, 0xe5
+    #d 0x7f, 0x08, 0x01, 0x2f, 0x95, 0xf5, 0xf8, 0x2f, 0x95, 0xf5, 0x00, 0x01, 0x01, 0x00, 0x00 ; add d, 0x08, CF
+    #d 0x80, 0x8c, 0x00, 0x44, 0xea, 0x87, 0x80, 0xd0, 0xea, 0x87, 0x80, 0x00, 0x00, 0x00, 0x01 ; adc a, 0x8c
+    #d 0x80, 0x09, 0x01, 0xf6, 0x69, 0xb8, 0x1e, 0x00, 0x69, 0xb8, 0x1e, 0x01, 0x01, 0x00, 0x00 ; adc a, 0x09, CF
+    #d 0x81, 0x00, 0x00, 0x26, 0xb3, 0xf8, 0x9c, 0xd9, 0xb3, 0xf8, 0x9c, 0x00, 0x00, 0x00, 0x01 ; adc a, b
+    #d 0x81, 0x00, 0x01, 0x88, 0x77, 0x01, 0x0a, 0x00, 0x77, 0x01, 0x0a, 0x01, 0x01, 0x00, 0x00 ; adc a, b, CF
+    #d 0x82, 0x00, 0x01, 0x7e, 0xab, 0x86, 0x3f, 0x05, 0xab, 0x86, 0x3f, 0x00, 0x01, 0x00, 0x00 ; adc a, c, CF
+    #d 0x82, 0x00, 0x01, 0x0b, 0xbe, 0xf4, 0x4b, 0x00, 0xbe, 0xf4, 0x4b, 0x01, 0x01, 0x00, 0x00 ; adc a, c, CF
+    #d 0x83, 0x00, 0x00, 0x22, 0xd5, 0x78, 0xd4, 0xf6, 0xd5, 0x78, 0xd4, 0x00, 0x00, 0x00, 0x01 ; adc a, d
+    #d 0x83, 0x00, 0x01, 0xe9, 0x2c, 0x2a, 0x16, 0x00, 0x2c, 0x2a, 0x16, 0x01, 0x01, 0x00, 0x00 ; adc a, d, CF
+    #d 0x84, 0x00, 0x00, 0x6b, 0x3e, 0x57, 0x96, 0x6b, 0xa9, 0x57, 0x96, 0x00, 0x00, 0x01, 0x01 ; adc b, a
+    #d 0x84, 0x00, 0x01, 0x7e, 0x81, 0xf5, 0xa8, 0x7e, 0x00, 0xf5, 0xa8, 0x01, 0x01, 0x00, 0x00 ; adc b, a, CF
+    #d 0x85, 0x05, 0x01, 0x12, 0xea, 0x82, 0x48, 0x12, 0xf0, 0x82, 0x48, 0x00, 0x00, 0x00, 0x01 ; adc b, 0x05, CF
+    #d 0x85, 0x80, 0x01, 0xf7, 0x7f, 0x01, 0xd6, 0xf7, 0x00, 0x01, 0xd6, 0x01, 0x01, 0x00, 0x00 ; adc b, 0x80, CF
+    #d 0x86, 0x00, 0x00, 0x5c, 0x08, 0x88, 0x87, 0x5c, 0x90, 0x88, 0x87, 0x00, 0x00, 0x00, 0x01 ; adc b, c
+    #d 0x86, 0x00, 0x01, 0xff, 0x52, 0xad, 0xd2, 0xff, 0x00, 0xad, 0xd2, 0x01, 0x01, 0x00, 0x00 ; adc b, c, CF
+    #d 0x87, 0x00, 0x00, 0x26, 0xda, 0xc3, 0x4b, 0x26, 0x25, 0xc3, 0x4b, 0x00, 0x01, 0x00, 0x00 ; adc b, d
+    #d 0x87, 0x00, 0x01, 0xc5, 0x4c, 0x31, 0xb3, 0xc5, 0x00, 0x31, 0xb3, 0x01, 0x01, 0x00, 0x00 ; adc b, d, CF
+    #d 0x88, 0x00, 0x00, 0x92, 0x7b, 0xc9, 0x2c, 0x92, 0x7b, 0x5b, 0x2c, 0x00, 0x01, 0x01, 0x00 ; adc c, a
+    #d 0x88, 0x00, 0x01, 0xa7, 0x48, 0x58, 0x63, 0xa7, 0x48, 0x00, 0x63, 0x01, 0x01, 0x00, 0x00 ; adc c, a, CF
+    #d 0x89, 0x00, 0x01, 0x52, 0x94, 0x85, 0x9d, 0x52, 0x94, 0x1a, 0x9d, 0x00, 0x01, 0x01, 0x00 ; adc c, b, CF
+    #d 0x89, 0x00, 0x01, 0xd0, 0x32, 0xcd, 0xf5, 0xd0, 0x32, 0x00, 0xf5, 0x01, 0x01, 0x00, 0x00 ; adc c, b, CF
+    #d 0x8a, 0x0a, 0x01, 0xa6, 0x7c, 0x34, 0x26, 0xa6, 0x7c, 0x3f, 0x26, 0x00, 0x00, 0x00, 0x00 ; adc c, 0x0a, CF
+    #d 0x8a, 0x00, 0x01, 0x21, 0x26, 0xff, 0x0f, 0x21, 0x26, 0x00, 0x0f, 0x01, 0x01, 0x00, 0x00 ; adc c, 0x00, CF
+    #d 0x8b, 0x00, 0x00, 0xa6, 0xb9, 0x0d, 0x47, 0xa6, 0xb9, 0x54, 0x47, 0x00, 0x00, 0x00, 0x00 ; adc c, d
+    #d 0x8b, 0x00, 0x01, 0xcd, 0x97, 0xc3, 0x3c, 0xcd, 0x97, 0x00, 0x3c, 0x01, 0x01, 0x00, 0x00 ; adc c, d, CF
+    #d 0x8c, 0x00, 0x01, 0xc9, 0x83, 0x0c, 0x02, 0xc9, 0x83, 0x0c, 0xcc, 0x00, 0x00, 0x00, 0x01 ; adc d, a, CF
+    #d 0x8c, 0x00, 0x01, 0x92, 0x42, 0xd8, 0x6d, 0x92, 0x42, 0xd8, 0x00, 0x01, 0x01, 0x00, 0x00 ; adc d, a, CF
+    #d 0x8d, 0x00, 0x01, 0xf2, 0x11, 0x79, 0xfc, 0xf2, 0x11, 0x79, 0x0e, 0x00, 0x01, 0x00, 0x00 ; adc d, b, CF
+    #d 0x8d, 0x00, 0x01, 0x2b, 0x8f, 0x1e, 0x70, 0x2b, 0x8f, 0x1e, 0x00, 0x01, 0x01, 0x00, 0x00 ; adc d, b, CF
+    #d 0x8e, 0x00, 0x00, 0x49, 0x57, 0xad, 0x09, 0x49, 0x57, 0xad, 0xb6, 0x00, 0x00, 0x00, 0x01 ; adc d, c
+    #d 0x8e, 0x00, 0x01, 0x0b, 0x06, 0x3f, 0xc0, 0x0b, 0x06, 0x3f, 0x00, 0x01, 0x01, 0x00, 0x00 ; adc d, c, CF
+    #d 0x8f, 0xe1, 0x01, 0x55, 0xaf, 0x7c, 0xa2, 0x55, 0xaf, 0x7c, 0x84, 0x00, 0x01, 0x00, 0x01 ; adc d, 0xe1, CF
+    #d 0x8f, 0x51, 0x01, 0xd1, 0xdb, 0x1a, 0xae, 0xd1, 0xdb, 0x1a, 0x00, 0x01, 0x01, 0x00, 0x00 ; adc d, 0x51, CF
+    #d 0x90, 0x25, 0x00, 0xfb, 0xd1, 0x76, 0xd5, 0xd6, 0xd1, 0x76, 0xd5, 0x00, 0x00, 0x00, 0x01 ; sub a, 0x25
+    #d 0x90, 0x3f, 0x01, 0x3f, 0x1f, 0x84, 0x3c, 0x00, 0x1f, 0x84, 0x3c, 0x01, 0x00, 0x00, 0x00 ; sub a, 0x3f, CF
+    #d 0x91, 0x00, 0x01, 0x16, 0xd4, 0x15, 0xa8, 0x42, 0xd4, 0x15, 0xa8, 0x00, 0x01, 0x00, 0x00 ; sub a, b, CF
+    #d 0x91, 0x00, 0x00, 0x72, 0x72, 0x1a, 0xe4, 0x00, 0x72, 0x1a, 0xe4, 0x01, 0x00, 0x00, 0x00 ; sub a, b
+    #d 0x92, 0x00, 0x01, 0xd7, 0xbb, 0xbb, 0x13, 0x1c, 0xbb, 0xbb, 0x13, 0x00, 0x00, 0x00, 0x00 ; sub a, c, CF
+    #d 0x92, 0x00, 0x01, 0xac, 0x57, 0xac, 0xba, 0x00, 0x57, 0xac, 0xba, 0x01, 0x00, 0x00, 0x00 ; sub a, c, CF
+    #d 0x93, 0x00, 0x01, 0x0b, 0x92, 0x88, 0x01, 0x0a, 0x92, 0x88, 0x01, 0x00, 0x00, 0x00, 0x00 ; sub a, d, CF
+    #d 0x93, 0x00, 0x00, 0x14, 0x4b, 0x66, 0x14, 0x00, 0x4b, 0x66, 0x14, 0x01, 0x00, 0x00, 0x00 ; sub a, d
+    #d 0x94, 0x00, 0x00, 0xcf, 0x70, 0x87, 0xbc, 0xcf, 0xa1, 0x87, 0xbc, 0x00, 0x01, 0x01, 0x01 ; sub b, a
+    #d 0x94, 0x00, 0x00, 0x97, 0x97, 0x24, 0x31, 0x97, 0x00, 0x24, 0x31, 0x01, 0x00, 0x00, 0x00 ; sub b, a
+    #d 0x95, 0x68, 0x01, 0x33, 0x3a, 0x75, 0x99, 0x33, 0xd2, 0x75, 0x99, 0x00, 0x01, 0x00, 0x01 ; sub b, 0x68, CF
+    #d 0x95, 0x3d, 0x00, 0x61, 0x3d, 0x3c, 0x5e, 0x61, 0x00, 0x3c, 0x5e, 0x01, 0x00, 0x00, 0x00 ; sub b, 0x3d
+    #d 0x96, 0x00, 0x00, 0x13, 0xcd, 0x55, 0x17, 0x13, 0x78, 0x55, 0x17, 0x00, 0x00, 0x01, 0x00 ; sub b, c
+    #d 0x96, 0x00, 0x01, 0xc0, 0xef, 0xef, 0xc1, 0xc0, 0x00, 0xef, 0xc1, 0x01, 0x00, 0x00, 0x00 ; sub b, c, CF
+    #d 0x97, 0x00, 0x00, 0x30, 0xb2, 0xeb, 0xbb, 0x30, 0xf7, 0xeb, 0xbb, 0x00, 0x01, 0x00, 0x01 ; sub b, d
+    #d 0x97, 0x00, 0x01, 0xc8, 0xbf, 0xdf, 0xbf, 0xc8, 0x00, 0xdf, 0xbf, 0x01, 0x00, 0x00, 0x00 ; sub b, d, CF
+    #d 0x98, 0x00, 0x01, 0xcd, 0xd5, 0x5e, 0xbd, 0xcd, 0xd5, 0x91, 0xbd, 0x00, 0x01, 0x01, 0x01 ; sub c, a, CF
+    #d 0x98, 0x00, 0x00, 0x76, 0x37, 0x76, 0xbd, 0x76, 0x37, 0x00, 0xbd, 0x01, 0x00, 0x00, 0x00 ; sub c, a
+    #d 0x99, 0x00, 0x00, 0x38, 0xc7, 0x80, 0xfd, 0x38, 0xc7, 0xb9, 0xfd, 0x00, 0x01, 0x00, 0x01 ; sub c, b
+    #d 0x99, 0x00, 0x00, 0x9d, 0xa4, 0xa4, 0x70, 0x9d, 0xa4, 0x00, 0x70, 0x01, 0x00, 0x00, 0x00 ; sub c, b
+    #d 0x9a, 0x6a, 0x01, 0x3e, 0x11, 0x96, 0x8b, 0x3e, 0x11, 0x2c, 0x8b, 0x00, 0x00, 0x01, 0x00 ; sub c, 0x6a, CF
+    #d 0x9a, 0xa1, 0x01, 0x5e, 0x76, 0xa1, 0x9b, 0x5e, 0x76, 0x00, 0x9b, 0x01, 0x00, 0x00, 0x00 ; sub c, 0xa1, CF
+    #d 0x9b, 0x00, 0x00, 0x8e, 0xcb, 0x7e, 0x13, 0x8e, 0xcb, 0x6b, 0x13, 0x00, 0x00, 0x00, 0x00 ; sub c, d
+    #d 0x9b, 0x00, 0x01, 0xf0, 0x51, 0xe7, 0xe7, 0xf0, 0x51, 0x00, 0xe7, 0x01, 0x00, 0x00, 0x00 ; sub c, d, CF
+    #d 0x9c, 0x00, 0x01, 0x50, 0x50, 0xd9, 0x65, 0x50, 0x50, 0xd9, 0x15, 0x00, 0x00, 0x00, 0x00 ; sub d, a, CF
+    #d 0x9c, 0x00, 0x00, 0xd5, 0x54, 0x85, 0xd5, 0xd5, 0x54, 0x85, 0x00, 0x01, 0x00, 0x00, 0x00 ; sub d, a
+    #d 0x9d, 0x00, 0x01, 0x7a, 0xfd, 0x9c, 0x92, 0x7a, 0xfd, 0x9c, 0x95, 0x00, 0x01, 0x00, 0x01 ; sub d, b, CF
+    #d 0x9d, 0x00, 0x00, 0x15, 0x79, 0x85, 0x79, 0x15, 0x79, 0x85, 0x00, 0x01, 0x00, 0x00, 0x00 ; sub d, b
+    #d 0x9e, 0x00, 0x01, 0x55, 0xc4, 0xa3, 0x4a, 0x55, 0xc4, 0xa3, 0xa7, 0x00, 0x01, 0x01, 0x01 ; sub d, c, CF
+    #d 0x9e, 0x00, 0x00, 0x4f, 0xc7, 0x5f, 0x5f, 0x4f, 0xc7, 0x5f, 0x00, 0x01, 0x00, 0x00, 0x00 ; sub d, c
+    #d 0x9f, 0x95, 0x01, 0x43, 0xe4, 0x31, 0xb4, 0x43, 0xe4, 0x31, 0x1f, 0x00, 0x00, 0x00, 0x00 ; sub d, 0x95, CF
+    #d 0x9f, 0x79, 0x01, 0xc0, 0x78, 0x96, 0x79, 0xc0, 0x78, 0x96, 0x00, 0x01, 0x00, 0x00, 0x00 ; sub d, 0x79, CF
+    #d 0xa0, 0x0e, 0x00, 0x12, 0x19, 0x0f, 0x99, 0x02, 0x19, 0x0f, 0x99, 0x00, 0x00, 0x00, 0x00 ; and a, 0x0e
+    #d 0xa0, 0x7d, 0x00, 0x82, 0x19, 0xc5, 0xf1, 0x00, 0x19, 0xc5, 0xf1, 0x01, 0x00, 0x00, 0x00 ; and a, 0x7d
+    #d 0xa1, 0x00, 0x01, 0xf9, 0x18, 0x42, 0x76, 0x18, 0x18, 0x42, 0x76, 0x00, 0x00, 0x00, 0x00 ; and a, b, CF
+    #d 0xa1, 0x00, 0x01, 0x33, 0xcc, 0xa7, 0x6d, 0x00, 0xcc, 0xa7, 0x6d, 0x01, 0x00, 0x00, 0x00 ; and a, b, CF
+    #d 0xa2, 0x00, 0x00, 0xbe, 0x0e, 0x14, 0xed, 0x14, 0x0e, 0x14, 0xed, 0x00, 0x00, 0x00, 0x00 ; and a, c
+    #d 0xa2, 0x00, 0x01, 0x50, 0x1d, 0xaf, 0x61, 0x00, 0x1d, 0xaf, 0x61, 0x01, 0x00, 0x00, 0x00 ; and a, c, CF
+    #d 0xa3, 0x00, 0x00, 0x11, 0xbd, 0x42, 0xd0, 0x10, 0xbd, 0x42, 0xd0, 0x00, 0x00, 0x00, 0x00 ; and a, d
+    #d 0xa3, 0x00, 0x01, 0x74, 0x2d, 0xe0, 0x8b, 0x00, 0x2d, 0xe0, 0x8b, 0x01, 0x00, 0x00, 0x00 ; and a, d, CF
+    #d 0xa4, 0x00, 0x01, 0x6f, 0x04, 0x2d, 0x39, 0x6f, 0x04, 0x2d, 0x39, 0x00, 0x00, 0x00, 0x00 ; and b, a, CF
+    #d 0xa4, 0x00, 0x00, 0x30, 0xcf, 0x10, 0xb1, 0x30, 0x00, 0x10, 0xb1, 0x01, 0x00, 0x00, 0x00 ; and b, a
+    #d 0xa5, 0x05, 0x00, 0x0e, 0xa3, 0xa1, 0x7a, 0x0e, 0x01, 0xa1, 0x7a, 0x00, 0x00, 0x00, 0x00 ; and b, 0x05
+    #d 0xa5, 0x59, 0x01, 0x49, 0xa6, 0xbb, 0x53, 0x49, 0x00, 0xbb, 0x53, 0x01, 0x00, 0x00, 0x00 ; and b, 0x59, CF
+    #d 0xa6, 0x00, 0x00, 0xce, 0x4e, 0xd6, 0xad, 0xce, 0x46, 0xd6, 0xad, 0x00, 0x00, 0x00, 0x00 ; and b, c
+    #d 0xa6, 0x00, 0x00, 0xfd, 0xd0, 0x2f, 0x97, 0xfd, 0x00, 0x2f, 0x97, 0x01, 0x00, 0x00, 0x00 ; and b, c
+    #d 0xa7, 0x00, 0x01, 0x33, 0x01, 0x4b, 0xdc, 0x33, 0x00, 0x4b, 0xdc, 0x01, 0x00, 0x00, 0x00 ; and b, d, CF
+    #d 0xa7, 0x00, 0x01, 0x5d, 0x57, 0x8d, 0xa8, 0x5d, 0x00, 0x8d, 0xa8, 0x01, 0x00, 0x00, 0x00 ; and b, d, CF
+    #d 0xa8, 0x00, 0x01, 0x58, 0xe4, 0xeb, 0xb5, 0x58, 0xe4, 0x48, 0xb5, 0x00, 0x00, 0x00, 0x00 ; and c, a, CF
+    #d 0xa8, 0x00, 0x01, 0xe3, 0xa9, 0x1c, 0xc2, 0xe3, 0xa9, 0x00, 0xc2, 0x01, 0x00, 0x00, 0x00 ; and c, a, CF
+    #d 0xa9, 0x00, 0x01, 0x4c, 0x21, 0x12, 0x92, 0x4c, 0x21, 0x00, 0x92, 0x01, 0x00, 0x00, 0x00 ; and c, b, CF
+    #d 0xa9, 0x00, 0x01, 0xe5, 0xb5, 0x4a, 0x3d, 0xe5, 0xb5, 0x00, 0x3d, 0x01, 0x00, 0x00, 0x00 ; and c, b, CF
+    #d 0xaa, 0xdd, 0x00, 0x29, 0xde, 0x1c, 0x32, 0x29, 0xde, 0x1c, 0x32, 0x00, 0x00, 0x00, 0x00 ; and c, 0xdd
+    #d 0xaa, 0x13, 0x00, 0x04, 0x12, 0xec, 0x05, 0x04, 0x12, 0x00, 0x05, 0x01, 0x00, 0x00, 0x00 ; and c, 0x13
+    #d 0xab, 0x00, 0x00, 0x6a, 0x4c, 0xc1, 0x33, 0x6a, 0x4c, 0x01, 0x33, 0x00, 0x00, 0x00, 0x00 ; and c, d
+    #d 0xab, 0x00, 0x01, 0x33, 0xb6, 0xdf, 0x20, 0x33, 0xb6, 0x00, 0x20, 0x01, 0x00, 0x00, 0x00 ; and c, d, CF
+    #d 0xac, 0x00, 0x00, 0x70, 0xe1, 0xd7, 0xbd, 0x70, 0xe1, 0xd7, 0x30, 0x00, 0x00, 0x00, 0x00 ; and d, a
+    #d 0xac, 0x00, 0x00, 0x46, 0x3f, 0xef, 0xb9, 0x46, 0x3f, 0xef, 0x00, 0x01, 0x00, 0x00, 0x00 ; and d, a
+    #d 0xad, 0x00, 0x00, 0x97, 0xd8, 0x8c, 0xc4, 0x97, 0xd8, 0x8c, 0xc0, 0x00, 0x00, 0x00, 0x01 ; and d, b
+    #d 0xad, 0x00, 0x01, 0x4e, 0x0a, 0xd7, 0xf5, 0x4e, 0x0a, 0xd7, 0x00, 0x01, 0x00, 0x00, 0x00 ; and d, b, CF
+    #d 0xae, 0x00, 0x01, 0x39, 0x3f, 0xe9, 0x77, 0x39, 0x3f, 0xe9, 0x61, 0x00, 0x00, 0x00, 0x00 ; and d, c, CF
+    #d 0xae, 0x00, 0x00, 0x9f, 0xdd, 0x3f, 0xc0, 0x9f, 0xdd, 0x3f, 0x00, 0x01, 0x00, 0x00, 0x00 ; and d, c
+    #d 0xaf, 0x7d, 0x01, 0xf2, 0x29, 0xd6, 0xf2, 0xf2, 0x29, 0xd6, 0x70, 0x00, 0x00, 0x00, 0x00 ; and d, 0x7d, CF
+    #d 0xaf, 0xc1, 0x00, 0xc1, 0x64, 0xa2, 0x3e, 0xc1, 0x64, 0xa2, 0x00, 0x01, 0x00, 0x00, 0x00 ; and d, 0xc1
+    #d 0xb0, 0x51, 0x01, 0xf4, 0xa4, 0xc1, 0xce, 0xf5, 0xa4, 0xc1, 0xce, 0x00, 0x00, 0x00, 0x01 ; or a, 0x51, CF
+    #d 0xb0, 0x00, 0x01, 0x00, 0x99, 0x04, 0x21, 0x00, 0x99, 0x04, 0x21, 0x01, 0x00, 0x00, 0x00 ; or a, 0x00, CF
+    #d 0xb1, 0x00, 0x00, 0xa9, 0x8b, 0x0c, 0xd3, 0xab, 0x8b, 0x0c, 0xd3, 0x00, 0x00, 0x00, 0x01 ; or a, b
+    #d 0xb1, 0x00, 0x01, 0x00, 0x00, 0xb3, 0x8c, 0x00, 0x00, 0xb3, 0x8c, 0x01, 0x00, 0x00, 0x00 ; or a, b, CF
+    #d 0xb2, 0x00, 0x00, 0x8f, 0x22, 0xa8, 0x42, 0xaf, 0x22, 0xa8, 0x42, 0x00, 0x00, 0x00, 0x01 ; or a, c
+    #d 0xb2, 0x00, 0x01, 0x00, 0xe1, 0x00, 0xb2, 0x00, 0xe1, 0x00, 0xb2, 0x01, 0x00, 0x00, 0x00 ; or a, c, CF
+    #d 0xb3, 0x00, 0x01, 0xb5, 0x1c, 0x9a, 0x25, 0xb5, 0x1c, 0x9a, 0x25, 0x00, 0x00, 0x00, 0x01 ; or a, d, CF
+    #d 0xb3, 0x00, 0x01, 0x00, 0xbc, 0x16, 0x00, 0x00, 0xbc, 0x16, 0x00, 0x01, 0x00, 0x00, 0x00 ; or a, d, CF
+    #d 0xb4, 0x00, 0x00, 0xf0, 0xfe, 0xb7, 0x94, 0xf0, 0xfe, 0xb7, 0x94, 0x00, 0x00, 0x00, 0x01 ; or b, a
+    #d 0xb4, 0x00, 0x01, 0x00, 0x00, 0xbd, 0xef, 0x00, 0x00, 0xbd, 0xef, 0x01, 0x00, 0x00, 0x00 ; or b, a, CF
+    #d 0xb5, 0xd0, 0x01, 0x9d, 0x75, 0xbb, 0x11, 0x9d, 0xf5, 0xbb, 0x11, 0x00, 0x00, 0x00, 0x01 ; or b, 0xd0, CF
+    #d 0xb5, 0x00, 0x01, 0xdd, 0x00, 0x6a, 0x2e, 0xdd, 0x00, 0x6a, 0x2e, 0x01, 0x00, 0x00, 0x00 ; or b, 0x00, CF
+    #d 0xb6, 0x00, 0x01, 0xd2, 0xe2, 0x98, 0x61, 0xd2, 0xfa, 0x98, 0x61, 0x00, 0x00, 0x00, 0x01 ; or b, c, CF
+    #d 0xb6, 0x00, 0x01, 0x33, 0x00, 0x00, 0xed, 0x33, 0x00, 0x00, 0xed, 0x01, 0x00, 0x00, 0x00 ; or b, c, CF
+    #d 0xb7, 0x00, 0x01, 0x51, 0x3e, 0x9e, 0xab, 0x51, 0xbf, 0x9e, 0xab, 0x00, 0x00, 0x00, 0x01 ; or b, d, CF
+    #d 0xb7, 0x00, 0x01, 0x35, 0x00, 0x27, 0x00, 0x35, 0x00, 0x27, 0x00, 0x01, 0x00, 0x00, 0x00 ; or b, d, CF
+    #d 0xb8, 0x00, 0x01, 0xf7, 0xfe, 0x7e, 0xed, 0xf7, 0xfe, 0xff, 0xed, 0x00, 0x00, 0x00, 0x01 ; or c, a, CF
+    #d 0xb8, 0x00, 0x01, 0x00, 0xe5, 0x00, 0x71, 0x00, 0xe5, 0x00, 0x71, 0x01, 0x00, 0x00, 0x00 ; or c, a, CF
+    #d 0xb9, 0x00, 0x01, 0xa0, 0xb3, 0xfb, 0xf4, 0xa0, 0xb3, 0xfb, 0xf4, 0x00, 0x00, 0x00, 0x01 ; or c, b, CF
+    #d 0xb9, 0x00, 0x01, 0x31, 0x00, 0x00, 0x71, 0x31, 0x00, 0x00, 0x71, 0x01, 0x00, 0x00, 0x00 ; or c, b, CF
+    #d 0xba, 0x25, 0x01, 0xe8, 0x07, 0x1b, 0xf4, 0xe8, 0x07, 0x3f, 0xf4, 0x00, 0x00, 0x00, 0x00 ; or c, 0x25, CF
+    #d 0xba, 0x00, 0x00, 0x9b, 0x7f, 0x00, 0x9b, 0x9b, 0x7f, 0x00, 0x9b, 0x01, 0x00, 0x00, 0x00 ; or c, 0x00
+    #d 0xbb, 0x00, 0x01, 0xeb, 0xad, 0x7d, 0xd6, 0xeb, 0xad, 0xff, 0xd6, 0x00, 0x00, 0x00, 0x01 ; or c, d, CF
+    #d 0xbb, 0x00, 0x00, 0xda, 0x50, 0x00, 0x00, 0xda, 0x50, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 ; or c, d
+    #d 0xbc, 0x00, 0x01, 0x8f, 0x2e, 0x93, 0x2c, 0x8f, 0x2e, 0x93, 0xaf, 0x00, 0x00, 0x00, 0x01 ; or d, a, CF
+    #d 0xbc, 0x00, 0x01, 0x00, 0x5a, 0x31, 0x00, 0x00, 0x5a, 0x31, 0x00, 0x01, 0x00, 0x00, 0x00 ; or d, a, CF
+    #d 0xbd, 0x00, 0x01, 0x90, 0x0e, 0x63, 0x58, 0x90, 0x0e, 0x63, 0x5e, 0x00, 0x00, 0x00, 0x00 ; or d, b, CF
+    #d 0xbd, 0x00, 0x00, 0x52, 0x00, 0x88, 0x00, 0x52, 0x00, 0x88, 0x00, 0x01, 0x00, 0x00, 0x00 ; or d, b
+    #d 0xbe, 0x00, 0x00, 0xed, 0x6e, 0xd8, 0x71, 0xed, 0x6e, 0xd8, 0xf9, 0x00, 0x00, 0x00, 0x01 ; or d, c
+    #d 0xbe, 0x00, 0x01, 0x24, 0xe2, 0x00, 0x00, 0x24, 0xe2, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 ; or d, c, CF
+    #d 0xbf, 0x03, 0x00, 0x85, 0xab, 0xf5, 0x57, 0x85, 0xab, 0xf5, 0x57, 0x00, 0x00, 0x00, 0x00 ; or d, 0x03
+    #d 0xbf, 0x00, 0x00, 0x7d, 0x84, 0x01, 0x00, 0x7d, 0x84, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00 ; or d, 0x00
+    #d 0xc0, 0xaf, 0x00, 0x4f, 0xe6, 0xe9, 0x56, 0xe0, 0xe6, 0xe9, 0x56, 0x00, 0x00, 0x00, 0x01 ; xor a, 0xaf
+    #d 0xc0, 0x71, 0x01, 0x71, 0xb8, 0x1a, 0xbe, 0x00, 0xb8, 0x1a, 0xbe, 0x01, 0x00, 0x00, 0x00 ; xor a, 0x71, CF
+    #d 0xc1, 0x00, 0x01, 0xf0, 0x9c, 0xfe, 0x80, 0x6c, 0x9c, 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00 ; xor a, b, CF
+    #d 0xc1, 0x00, 0x01, 0xea, 0xea, 0x8c, 0x7a, 0x00, 0xea, 0x8c, 0x7a, 0x01, 0x00, 0x00, 0x00 ; xor a, b, CF
+    #d 0xc2, 0x00, 0x01, 0x4e, 0x86, 0xbd, 0x3b, 0xf3, 0x86, 0xbd, 0x3b, 0x00, 0x00, 0x00, 0x01 ; xor a, c, CF
+    #d 0xc2, 0x00, 0x01, 0x82, 0x78, 0x82, 0xb9, 0x00, 0x78, 0x82, 0xb9, 0x01, 0x00, 0x00, 0x00 ; xor a, c, CF
+    #d 0xc3, 0x00, 0x01, 0x49, 0x18, 0x7a, 0xf7, 0xbe, 0x18, 0x7a, 0xf7, 0x00, 0x00, 0x00, 0x01 ; xor a, d, CF
+    #d 0xc3, 0x00, 0x01, 0xbc, 0xa1, 0xf4, 0xbc, 0x00, 0xa1, 0xf4, 0xbc, 0x01, 0x00, 0x00, 0x00 ; xor a, d, CF
+    #d 0xc4, 0x00, 0x00, 0xaf, 0x96, 0x33, 0x0a, 0xaf, 0x39, 0x33, 0x0a, 0x00, 0x00, 0x00, 0x00 ; xor b, a
+    #d 0xc4, 0x00, 0x00, 0x85, 0x85, 0xbd, 0xdb, 0x85, 0x00, 0xbd, 0xdb, 0x01, 0x00, 0x00, 0x00 ; xor b, a
+    #d 0xc5, 0xad, 0x01, 0xf9, 0x80, 0xc6, 0xd6, 0xf9, 0x2d, 0xc6, 0xd6, 0x00, 0x00, 0x00, 0x00 ; xor b, 0xad, CF
+    #d 0xc5, 0xbd, 0x01, 0x4f, 0xbd, 0xa4, 0x18, 0x4f, 0x00, 0xa4, 0x18, 0x01, 0x00, 0x00, 0x00 ; xor b, 0xbd, CF
+    #d 0xc6, 0x00, 0x00, 0x33, 0x73, 0xd6, 0xbe, 0x33, 0xa5, 0xd6, 0xbe, 0x00, 0x00, 0x00, 0x01 ; xor b, c
+    #d 0xc6, 0x00, 0x01, 0xa5, 0xc5, 0xc5, 0xdd, 0xa5, 0x00, 0xc5, 0xdd, 0x01, 0x00, 0x00, 0x00 ; xor b, c, CF
+    #d 0xc7, 0x00, 0x00, 0x26, 0x1d, 0x28, 0x21, 0x26, 0x3c, 0x28, 0x21, 0x00, 0x00, 0x00, 0x00 ; xor b, d
+    #d 0xc7, 0x00, 0x01, 0xfd, 0x4d, 0x88, 0x4d, 0xfd, 0x00, 0x88, 0x4d, 0x01, 0x00, 0x00, 0x00 ; xor b, d, CF
+    #d 0xc8, 0x00, 0x01, 0xf4, 0xae, 0x14, 0x68, 0xf4, 0xae, 0xe0, 0x68, 0x00, 0x00, 0x00, 0x01 ; xor c, a, CF
+    #d 0xc8, 0x00, 0x00, 0xb2, 0x23, 0xb2, 0x25, 0xb2, 0x23, 0x00, 0x25, 0x01, 0x00, 0x00, 0x00 ; xor c, a
+    #d 0xc9, 0x00, 0x00, 0x59, 0x4c, 0xbc, 0x06, 0x59, 0x4c, 0xf0, 0x06, 0x00, 0x00, 0x00, 0x01 ; xor c, b
+    #d 0xc9, 0x00, 0x01, 0x43, 0x6b, 0x6b, 0x74, 0x43, 0x6b, 0x00, 0x74, 0x01, 0x00, 0x00, 0x00 ; xor c, b, CF
+    #d 0xca, 0xe6, 0x00, 0x45, 0x7f, 0xa4, 0xce, 0x45, 0x7f, 0x42, 0xce, 0x00, 0x00, 0x00, 0x00 ; xor c, 0xe6
+    #d 0xca, 0xb1, 0x01, 0x65, 0xe2, 0xb1, 0x9c, 0x65, 0xe2, 0x00, 0x9c, 0x01, 0x00, 0x00, 0x00 ; xor c, 0xb1, CF
+    #d 0xcb, 0x00, 0x00, 0xd7, 0x70, 0x31, 0xad, 0xd7, 0x70, 0x9c, 0xad, 0x00, 0x00, 0x00, 0x01 ; xor c, d
+    #d 0xcb, 0x00, 0x01, 0xfc, 0x50, 0x49, 0x49, 0xfc, 0x50, 0x00, 0x49, 0x01, 0x00, 0x00, 0x00 ; xor c, d, CF
+    #d 0xcc, 0x00, 0x01, 0x5a, 0x70, 0x2a, 0x24, 0x5a, 0x70, 0x2a, 0x7e, 0x00, 0x00, 0x00, 0x00 ; xor d, a, CF
+    #d 0xcc, 0x00, 0x00, 0x76, 0x8f, 0xf2, 0x76, 0x76, 0x8f, 0xf2, 0x00, 0x01, 0x00, 0x00, 0x00 ; xor d, a
+    #d 0xcd, 0x00, 0x01, 0xf4, 0x38, 0xe8, 0x13, 0xf4, 0x38, 0xe8, 0x2b, 0x00, 0x00, 0x00, 0x00 ; xor d, b, CF
+    #d 0xcd, 0x00, 0x01, 0x2b, 0x3c, 0xfe, 0x3c, 0x2b, 0x3c, 0xfe, 0x00, 0x01, 0x00, 0x00, 0x00 ; xor d, b, CF
+    #d 0xce, 0x00, 0x01, 0xa0, 0xe2, 0x04, 0xe5, 0xa0, 0xe2, 0x04, 0xe1, 0x00, 0x00, 0x00, 0x01 ; xor d, c, CF
+    #d 0xce, 0x00, 0x01, 0xb0, 0x8a, 0x1e, 0x1e, 0xb0, 0x8a, 0x1e, 0x00, 0x01, 0x00, 0x00, 0x00 ; xor d, c, CF
+    #d 0xcf, 0x72, 0x01, 0x9f, 0x27, 0x39, 0xbf, 0x9f, 0x27, 0x39, 0xcd, 0x00, 0x00, 0x00, 0x01 ; xor d, 0x72, CF
+    #d 0xcf, 0xc9, 0x00, 0xd9, 0x17, 0xcb, 0xc9, 0xd9, 0x17, 0xcb, 0x00, 0x01, 0x00, 0x00, 0x00 ; xor d, 0xc9
+    #d 0xd0, 0x8f, 0x00, 0x5d, 0x85, 0x9d, 0xba, 0x5d, 0x85, 0x9d, 0xba, 0x00, 0x01, 0x01, 0x01 ; cmp a, 0x8f
+    #d 0xd0, 0xe0, 0x00, 0xe0, 0x01, 0xce, 0x38, 0xe0, 0x01, 0xce, 0x38, 0x01, 0x00, 0x00, 0x00 ; cmp a, 0xe0
+    #d 0xd1, 0x00, 0x01, 0x36, 0x2a, 0x2d, 0x4f, 0x36, 0x2a, 0x2d, 0x4f, 0x00, 0x00, 0x00, 0x00 ; cmp a, b, CF
+    #d 0xd1, 0x00, 0x01, 0x19, 0x19, 0xfb, 0xfa, 0x19, 0x19, 0xfb, 0xfa, 0x01, 0x00, 0x00, 0x00 ; cmp a, b, CF
+    #d 0xd2, 0x00, 0x01, 0x10, 0x8a, 0xc8, 0x3b, 0x10, 0x8a, 0xc8, 0x3b, 0x00, 0x01, 0x00, 0x00 ; cmp a, c, CF
+    #d 0xd2, 0x00, 0x00, 0x14, 0xca, 0x14, 0x3f, 0x14, 0xca, 0x14, 0x3f, 0x01, 0x00, 0x00, 0x00 ; cmp a, c
+    #d 0xd3, 0x00, 0x00, 0x0d, 0x5a, 0xf8, 0xd0, 0x0d, 0x5a, 0xf8, 0xd0, 0x00, 0x01, 0x00, 0x00 ; cmp a, d
+    #d 0xd3, 0x00, 0x01, 0x88, 0x80, 0xd8, 0x88, 0x88, 0x80, 0xd8, 0x88, 0x01, 0x00, 0x00, 0x00 ; cmp a, d, CF
+    #d 0xd4, 0x00, 0x01, 0x29, 0x78, 0xf7, 0xfa, 0x29, 0x78, 0xf7, 0xfa, 0x00, 0x00, 0x00, 0x00 ; cmp b, a, CF
+    #d 0xd4, 0x00, 0x00, 0xcc, 0xcc, 0xf9, 0xdf, 0xcc, 0xcc, 0xf9, 0xdf, 0x01, 0x00, 0x00, 0x00 ; cmp b, a
+    #d 0xd5, 0x08, 0x00, 0x3f, 0xdf, 0x53, 0x32, 0x3f, 0xdf, 0x53, 0x32, 0x00, 0x00, 0x00, 0x01 ; cmp b, 0x08
+    #d 0xd5, 0x99, 0x01, 0xab, 0x99, 0xdf, 0xe7, 0xab, 0x99, 0xdf, 0xe7, 0x01, 0x00, 0x00, 0x00 ; cmp b, 0x99, CF
+    #d 0xd6, 0x00, 0x00, 0x57, 0xb8, 0xf3, 0xa0, 0x57, 0xb8, 0xf3, 0xa0, 0x00, 0x01, 0x00, 0x01 ; cmp b, c
+    #d 0xd6, 0x00, 0x01, 0xe9, 0x47, 0x47, 0x4e, 0xe9, 0x47, 0x47, 0x4e, 0x01, 0x00, 0x00, 0x00 ; cmp b, c, CF
+    #d 0xd7, 0x00, 0x01, 0x5f, 0x5b, 0x53, 0xe7, 0x5f, 0x5b, 0x53, 0xe7, 0x00, 0x01, 0x00, 0x00 ; cmp b, d, CF
+    #d 0xd7, 0x00, 0x00, 0x96, 0x50, 0xe3, 0x50, 0x96, 0x50, 0xe3, 0x50, 0x01, 0x00, 0x00, 0x00 ; cmp b, d
+    #d 0xd8, 0x00, 0x01, 0x10, 0x8e, 0xf7, 0xe0, 0x10, 0x8e, 0xf7, 0xe0, 0x00, 0x00, 0x00, 0x01 ; cmp c, a, CF
+    #d 0xd8, 0x00, 0x00, 0xd4, 0x9c, 0xd4, 0x76, 0xd4, 0x9c, 0xd4, 0x76, 0x01, 0x00, 0x00, 0x00 ; cmp c, a
+    #d 0xd9, 0x00, 0x00, 0x1f, 0x41, 0xe6, 0xf2, 0x1f, 0x41, 0xe6, 0xf2, 0x00, 0x00, 0x00, 0x01 ; cmp c, b
+    #d 0xd9, 0x00, 0x00, 0x04, 0x03, 0x03, 0x2d, 0x04, 0x03, 0x03, 0x2d, 0x01, 0x00, 0x00, 0x00 ; cmp c, b
+    #d 0xda, 0x76, 0x00, 0xc1, 0xf1, 0x4b, 0xdf, 0xc1, 0xf1, 0x4b, 0xdf, 0x00, 0x01, 0x00, 0x01 ; cmp c, 0x76
+    #d 0xda, 0x6c, 0x00, 0x5c, 0x1a, 0x6c, 0x11, 0x5c, 0x1a, 0x6c, 0x11, 0x01, 0x00, 0x00, 0x00 ; cmp c, 0x6c
+    #d 0xdb, 0x00, 0x01, 0x64, 0x0a, 0xd2, 0x41, 0x64, 0x0a, 0xd2, 0x41, 0x00, 0x00, 0x00, 0x01 ; cmp c, d, CF
+    #d 0xdb, 0x00, 0x00, 0x97, 0xc5, 0xf9, 0xf9, 0x97, 0xc5, 0xf9, 0xf9, 0x01, 0x00, 0x00, 0x00 ; cmp c, d
+    #d 0xdc, 0x00, 0x01, 0x66, 0x5d, 0x06, 0xfa, 0x66, 0x5d, 0x06, 0xfa, 0x00, 0x00, 0x00, 0x01 ; cmp d, a, CF
+    #d 0xdc, 0x00, 0x01, 0x7c, 0x6b, 0x9b, 0x7c, 0x7c, 0x6b, 0x9b, 0x7c, 0x01, 0x00, 0x00, 0x00 ; cmp d, a, CF
+    #d 0xdd, 0x00, 0x00, 0x92, 0x9d, 0xbb, 0x10, 0x92, 0x9d, 0xbb, 0x10, 0x00, 0x01, 0x00, 0x00 ; cmp d, b
+    #d 0xdd, 0x00, 0x01, 0x1f, 0x37, 0x5c, 0x37, 0x1f, 0x37, 0x5c, 0x37, 0x01, 0x00, 0x00, 0x00 ; cmp d, b, CF
+    #d 0xde, 0x00, 0x01, 0xce, 0x32, 0x5a, 0x16, 0xce, 0x32, 0x5a, 0x16, 0x00, 0x01, 0x00, 0x01 ; cmp d, c, CF
+    #d 0xde, 0x00, 0x00, 0x48, 0x87, 0x85, 0x85, 0x48, 0x87, 0x85, 0x85, 0x01, 0x00, 0x00, 0x00 ; cmp d, c
+    #d 0xdf, 0xb3, 0x00, 0x9d, 0x1b, 0x5f, 0xdc, 0x9d, 0x1b, 0x5f, 0xdc, 0x00, 0x00, 0x00, 0x00 ; cmp d, 0xb3
+    #d 0xdf, 0x24, 0x00, 0xe3, 0xd6, 0x02, 0x24, 0xe3, 0xd6, 0x02, 0x24, 0x01, 0x00, 0x00, 0x00 ; cmp d, 0x24
+    #d 0x00 ; End
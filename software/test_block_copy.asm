@@ -0,0 +1,29 @@
+#include "../bleh.asm"
+
+DEBUG_PORT = 1
+
+COPY_DESTINATION = 0xc000
+COPY_N_BYTES = 8
+
+start:
+    ld i, copy_source
+    ld j, COPY_DESTINATION
+    ld b, COPY_N_BYTES
+
+copy:
+    ld [j++], [i++]
+    djnz b, copy
+
+    ld i, COPY_DESTINATION
+    ld b, COPY_N_BYTES
+
+show:
+    ld a, [i++]
+    out DEBUG_PORT, a
+    djnz b, show
+
+done:
+    jmp done
+
+copy_source:
+    #d 0b1000_0001, 0b0100_0010, 0b0010_0100, 0b0001_1000, 0b0010_0100, 0b0100_0010, 0b1000_0001, 0b1111_1111
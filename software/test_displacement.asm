@@ -0,0 +1,105 @@
+#include "../bleh.asm"
+
+; Loads and stores through [sp+imm8], [i+imm8] and [j+imm8], the index ones
+; across a page boundary. Writes the number of each test to the debug port when
+; it passes, 0xee when one fails and 0xff when all passed.
+
+DEBUG_PORT = 1
+
+RECORD = 0xc0fe ; Fields at 0xc0fe to 0xc101, the last two in the next page
+
+start:
+    ; 1: [sp+imm8] reaches the pushed bytes below the top, which push leaves at [sp+0]
+    ld sp, 0x40
+    ld a, 0x5a
+    push a
+    ld a, 0x3c
+    push a
+
+    ld a, [sp+0]
+    cmp a, 0x3c
+    jnz fail
+    ld a, [sp+-1]
+    cmp a, 0x5a
+    jnz fail
+
+    ld a, 0x77
+    ld [sp+-1], a
+    ld a, 0x66
+    ld [sp+1], a
+    ld a, [sp+1]
+    cmp a, 0x66
+    jnz fail
+
+    pop b
+    pop c
+    ld a, b
+    cmp a, 0x3c
+    jnz fail
+    ld a, c
+    cmp a, 0x77
+    jnz fail
+
+    out DEBUG_PORT, 1
+
+    ; 2: [i+imm8] and [j+imm8] stores, read back with [i++]
+    ld i, RECORD
+    ld a, 0x10
+    ld [i+0], a
+    ld a, 0x11
+    ld [i+1], a
+    ld j, RECORD
+    ld a, 0x12
+    ld [j+2], a
+    ld a, 0x13
+    ld [j+3], a
+
+    ld i, RECORD
+    ld a, [i++]
+    cmp a, 0x10
+    jnz fail
+    ld a, [i++]
+    cmp a, 0x11
+    jnz fail
+    ld a, [i++]
+    cmp a, 0x12
+    jnz fail
+    ld a, [i++]
+    cmp a, 0x13
+    jnz fail
+
+    out DEBUG_PORT, 2
+
+    ; 3: [i+imm8] and [j+imm8] loads, leaving the index as it was
+    ld i, RECORD
+    ld a, [i+3]
+    cmp a, 0x13
+    jnz fail
+    ld a, [i+0]
+    cmp a, 0x10
+    jnz fail
+
+    ld j, RECORD
+    ld a, [j+2]
+    cmp a, 0x12
+    jnz fail
+    ld a, [j+1]
+    cmp a, 0x11
+    jnz fail
+
+    ; The high byte carries for a displacement of 0x80 and up too.
+    ld i, RECORD + 3 - 0xff
+    ld a, [i+0xff]
+    cmp a, 0x13
+    jnz fail
+
+    out DEBUG_PORT, 3
+
+    out DEBUG_PORT, 0xff
+
+done:
+    jmp done
+
+fail:
+    out DEBUG_PORT, 0xee
+    jmp done
@@ -0,0 +1,101 @@
+#include "../bleh.asm"
+
+; Moves i and j across page boundaries with inc, dec and add, reading the marker
+; bytes around MARKERS to tell where they point. Writes the number of each test
+; to the debug port when it passes, 0xee when one fails and 0xff when all passed.
+
+DEBUG_PORT = 1
+
+MARKERS = 0xc100 ; 0x11 at MARKERS - 1, 0x22 at MARKERS and 0x33 at MARKERS + 1
+
+start:
+    ld j, MARKERS - 1
+    ld a, 0x11
+    ld [j++], a
+    ld a, 0x22
+    ld [j++], a
+    ld a, 0x33
+    ld [j], a
+
+    ; 1: inc carries into the high byte
+    ld i, MARKERS - 1
+    inc i
+    ld a, [i]
+    cmp a, 0x22
+    jnz fail
+
+    ld j, MARKERS - 1
+    inc j
+    ld a, [j]
+    cmp a, 0x22
+    jnz fail
+
+    inc j
+    ld a, [j]
+    cmp a, 0x33
+    jnz fail
+
+    out DEBUG_PORT, 1
+
+    ; 2: dec borrows from the high byte
+    ld i, MARKERS
+    dec i
+    ld a, [i]
+    cmp a, 0x11
+    jnz fail
+
+    ld j, MARKERS + 1
+    dec j
+    ld a, [j]
+    cmp a, 0x22
+    jnz fail
+
+    dec j
+    ld a, [j]
+    cmp a, 0x11
+    jnz fail
+
+    out DEBUG_PORT, 2
+
+    ; 3: add i, imm8 is unsigned and carries into the high byte
+    ld i, MARKERS - 2
+    add i, 1
+    ld a, [i]
+    cmp a, 0x11
+    jnz fail
+
+    ld i, MARKERS - 0x7f
+    add i, 0x80
+    ld a, [i]
+    cmp a, 0x33
+    jnz fail
+
+    out DEBUG_PORT, 3
+
+    ; 4: add i, a too, a is left as it was
+    ld i, MARKERS - 0xfe
+    ld a, 0xff
+    add i, a
+    cmp a, 0xff
+    jnz fail
+    ld a, [i]
+    cmp a, 0x33
+    jnz fail
+
+    ld i, MARKERS - 1
+    ld a, 0
+    add i, a
+    ld a, [i]
+    cmp a, 0x11
+    jnz fail
+
+    out DEBUG_PORT, 4
+
+    out DEBUG_PORT, 0xff
+
+done:
+    jmp done
+
+fail:
+    out DEBUG_PORT, 0xee
+    jmp done
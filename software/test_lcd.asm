@@ -30,8 +30,7 @@ delay:
     loop3:
     dec a
     jnz loop3
-    dec b
-    jnz loop3
+    djnz b, loop3
     ret
 
 message1:
@@ -0,0 +1,74 @@
+#include "../bleh.asm"
+
+; Follows the linked list below with ld i, [i] and loads pointers into i and j
+; with ld i, [j] and ld j, [i]. Writes the number of each test to the debug port
+; when it passes, 0xee when one fails and 0xff when all passed.
+
+DEBUG_PORT = 1
+
+start:
+    ; 1: ld i, [i] walks the list, summing the values to 1 + 2 + 3
+    ld i, node_1
+    ld b, 0
+    ld c, 3
+
+    .next_node:
+    ld a, [i+2]
+    add b, a
+    ld i, [i]
+    djnz c, .next_node
+
+    ld a, b
+    cmp a, 6
+    jnz fail
+    ld a, [i+2]
+    cmp a, 0xaa
+    jnz fail
+
+    out DEBUG_PORT, 1
+
+    ; 2: ld j, [i] leaves i as it was
+    ld i, pointer_to_node_3
+    ld j, [i]
+    ld a, [j+2]
+    cmp a, 3
+    jnz fail
+    ld a, [i]
+    cmp a, node_3 & 0xff
+    jnz fail
+
+    out DEBUG_PORT, 2
+
+    ; 3: ld i, [j] leaves j as it was
+    ld j, pointer_to_node_3
+    ld i, [j]
+    ld a, [i+2]
+    cmp a, 3
+    jnz fail
+    ld a, [j]
+    cmp a, node_3 & 0xff
+    jnz fail
+
+    out DEBUG_PORT, 3
+
+    out DEBUG_PORT, 0xff
+
+done:
+    jmp done
+
+fail:
+    out DEBUG_PORT, 0xee
+    jmp done
+
+; Pointer to the next node, then the value.
+node_1:
+    #d le(node_2`16), 0x01
+node_3:
+    #d le(node_end`16), 0x03
+node_2:
+    #d le(node_3`16), 0x02
+node_end:
+    #d le(0x0000`16), 0xaa
+
+pointer_to_node_3:
+    #d le(node_3`16)
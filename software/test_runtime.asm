@@ -0,0 +1,453 @@
+#include "../bleh.asm"
+
+; Runs the runtime libraries on the cases below, writes the number of each test
+; to the debug port when it passes, 0xee when one fails and 0xff when all passed.
+
+DEBUG_PORT = 1
+
+BLOCK = 0xc000 ; 1027 bytes with a guard byte on each side
+BLOCK_N_BYTES = 1027 ; 256 turns of 4 and 3 single bytes
+OUTPUT = 0xc800
+
+start:
+    ; 1: memset leaves the guard bytes and j past the block
+    ld a, 0xaa
+    ld j, BLOCK - 1
+    ld c, (BLOCK_N_BYTES + 2) >> 8
+    ld d, (BLOCK_N_BYTES + 2) & 0xff
+    call memset
+
+    ld a, 0x5a
+    ld j, BLOCK
+    ld c, BLOCK_N_BYTES >> 8
+    ld d, BLOCK_N_BYTES & 0xff
+    call memset
+    ld a, [j]
+    cmp a, 0xaa
+    jnz fail
+
+    ld j, BLOCK - 1
+    ld a, [j++]
+    cmp a, 0xaa
+    jnz fail
+    ld a, [j]
+    cmp a, 0x5a
+    jnz fail
+
+    ld j, BLOCK + BLOCK_N_BYTES - 1
+    ld a, [j]
+    cmp a, 0x5a
+    jnz fail
+    out DEBUG_PORT, 1
+
+    ; 2: memcpy, checked by memcmp
+    ld i, _mul8_squares_low
+    ld j, BLOCK
+    ld c, BLOCK_N_BYTES >> 8
+    ld d, BLOCK_N_BYTES & 0xff
+    call memcpy
+    ld a, [j]
+    cmp a, 0xaa
+    jnz fail
+
+    ld i, BLOCK
+    ld j, _mul8_squares_low
+    ld c, BLOCK_N_BYTES >> 8
+    ld d, BLOCK_N_BYTES & 0xff
+    call memcmp
+    jnz fail
+    out DEBUG_PORT, 2
+
+    ; 3: memcmp finds a difference either way round, and not before it
+    ld j, BLOCK + 700
+    ld a, [j]
+    inc a
+    ld [j], a
+
+    ld i, BLOCK
+    ld j, _mul8_squares_low
+    ld c, BLOCK_N_BYTES >> 8
+    ld d, BLOCK_N_BYTES & 0xff
+    call memcmp
+    jz fail
+    jc fail
+
+    ld i, _mul8_squares_low
+    ld j, BLOCK
+    ld c, BLOCK_N_BYTES >> 8
+    ld d, BLOCK_N_BYTES & 0xff
+    call memcmp
+    jz fail
+    jnc fail
+
+    ld i, BLOCK
+    ld j, _mul8_squares_low
+    ld c, 700 >> 8
+    ld d, 700 & 0xff
+    call memcmp
+    jnz fail
+
+    ld c, 0
+    ld d, 0
+    call memcmp
+    jnz fail
+    out DEBUG_PORT, 3
+
+    ; 4
+    ld i, add16_cases
+    .add16:
+    ld a, [i++]
+    cmp a, 0
+    jz .add16_done
+    call load_ab_cd
+    call add16
+    call expect_ab_cf
+    jmp .add16
+    .add16_done:
+    out DEBUG_PORT, 4
+
+    ; 5
+    ld i, sub16_cases
+    .sub16:
+    ld a, [i++]
+    cmp a, 0
+    jz .sub16_done
+    call load_ab_cd
+    call sub16
+    call expect_ab_cf
+    jmp .sub16
+    .sub16_done:
+    out DEBUG_PORT, 5
+
+    ; 6: ZF and CF as 2 * ZF + CF
+    ld i, cmp16_cases
+    .cmp16:
+    ld a, [i++]
+    cmp a, 0
+    jz .cmp16_done
+    call load_ab_cd
+    call cmp16
+    ld a, 0
+    jnz .not_equal
+    ld a, 2
+    .not_equal:
+    adc a, 0
+    ld b, a
+    ld a, [i++]
+    cmp a, b
+    jnz fail
+    jmp .cmp16
+    .cmp16_done:
+    out DEBUG_PORT, 6
+
+    ; 7
+    ld i, mul8_cases
+    .mul8:
+    ld a, [i++]
+    cmp a, 0
+    jz .mul8_done
+    ld a, [i++]
+    ld b, a
+    ld a, [i++]
+    push i
+    call mul8
+    pop i
+    call expect_ab
+    jmp .mul8
+    .mul8_done:
+    out DEBUG_PORT, 7
+
+    ; 8
+    ld i, mul16_cases
+    .mul16:
+    ld a, [i++]
+    cmp a, 0
+    jz .mul16_done
+    call load_ab_cd
+    push i
+    call mul16
+    pop i
+    call expect_ab
+    jmp .mul16
+    .mul16_done:
+    out DEBUG_PORT, 8
+
+    ; 9: the quotient, then the remainder
+    ld i, div16_8_cases
+    .div16_8:
+    ld a, [i++]
+    cmp a, 0
+    jz .div16_8_done
+    ld ab, [i]
+    add i, 2
+    ld d, a
+    ld a, [i++]
+    ld c, a
+    ld a, d
+    push i
+    call div16_8
+    pop i
+    ld d, a
+    ld a, [i+2]
+    cmp a, c
+    jnz fail
+    ld a, d
+    call expect_ab
+    inc i
+    jmp .div16_8
+    .div16_8_done:
+    out DEBUG_PORT, 9
+
+    ; 10: hundreds, then tens and ones
+    ld i, u8_to_bcd_cases
+    .u8_to_bcd:
+    ld a, [i++]
+    cmp a, 0
+    jz .u8_to_bcd_done
+    ld a, [i++]
+    call u8_to_bcd
+    ld c, a
+    ld a, [i++]
+    cmp a, b
+    jnz fail
+    ld a, [i++]
+    cmp a, c
+    jnz fail
+    jmp .u8_to_bcd
+    .u8_to_bcd_done:
+    out DEBUG_PORT, 10
+
+    ; 11
+    ld i, u8_to_decimal_cases
+    .u8_to_decimal:
+    ld a, [i++]
+    cmp a, 0
+    jz .u8_to_decimal_done
+    ld a, [i++]
+    ld j, OUTPUT
+    call u8_to_decimal
+    ld j, OUTPUT
+    ld c, 0
+    ld d, 4
+    call memcmp
+    jnz fail
+    jmp .u8_to_decimal
+    .u8_to_decimal_done:
+    out DEBUG_PORT, 11
+
+    ; 12
+    ld i, u16_to_decimal_cases
+    .u16_to_decimal:
+    ld a, [i++]
+    cmp a, 0
+    jz .u16_to_decimal_done
+    ld ab, [i]
+    add i, 2
+    ld j, OUTPUT
+    call u16_to_decimal
+    ld j, OUTPUT
+    ld c, 0
+    ld d, 6
+    call memcmp
+    jnz fail
+    jmp .u16_to_decimal
+    .u16_to_decimal_done:
+    out DEBUG_PORT, 12
+
+    out DEBUG_PORT, 0xff
+
+done:
+    jmp done
+
+fail:
+    out DEBUG_PORT, 0xee
+    jmp done
+
+load_ab_cd:
+    ; Input:
+    ;   i: two 16-bit values
+    ; Output:
+    ;   ab, cd: the values
+    ;   i: past them
+    ld ab, [i]
+    add i, 2
+    ld cd, [i]
+    add i, 2
+    ret
+
+expect_ab_cf:
+    ; Fails unless CF is the byte after the 16-bit value expect_ab compares ab with.
+    ;
+    ; Input:
+    ;   i: the 16-bit value and CF
+    ; Output:
+    ;   i: past them
+    ; Destroys:
+    ;   a, c, d
+    ld c, 0
+    adc c, 0
+    ld d, a
+    ld a, [i+2]
+    cmp a, c
+    jnz fail
+    ld a, d
+    call expect_ab
+    inc i
+    ret
+
+expect_ab:
+    ; Fails unless ab is the 16-bit value at i.
+    ;
+    ; Input:
+    ;   i: the 16-bit value
+    ; Output:
+    ;   i: past it
+    ; Destroys:
+    ;   a, d
+    ld d, a
+    ld a, [i+0]
+    cmp a, b
+    jnz fail
+    ld a, [i+1]
+    cmp a, d
+    jnz fail
+    add i, 2
+    ret
+
+add16_cases:
+    #d 0x01, le(0x0000`16), le(0x0000`16), le(0x0000`16), 0x00
+    #d 0x01, le(0x0001`16), le(0x0001`16), le(0x0002`16), 0x00
+    #d 0x01, le(0x00ff`16), le(0x0001`16), le(0x0100`16), 0x00
+    #d 0x01, le(0xffff`16), le(0x0001`16), le(0x0000`16), 0x01
+    #d 0x01, le(0x1234`16), le(0x1234`16), le(0x2468`16), 0x00
+    #d 0x01, le(0x1234`16), le(0x1235`16), le(0x2469`16), 0x00
+    #d 0x01, le(0x8000`16), le(0x8000`16), le(0x0000`16), 0x01
+    #d 0x01, le(0x0100`16), le(0x00ff`16), le(0x01ff`16), 0x00
+    #d 0x01, le(0x00ff`16), le(0x0100`16), le(0x01ff`16), 0x00
+    #d 0x01, le(0x1200`16), le(0xff01`16), le(0x1101`16), 0x01
+    #d 0x01, le(0xff00`16), le(0xff01`16), le(0xfe01`16), 0x01
+    #d 0x01, le(0x0000`16), le(0xffff`16), le(0xffff`16), 0x00
+    #d 0x01, le(0xc350`16), le(0x9c40`16), le(0x5f90`16), 0x01
+    #d 0x00
+
+sub16_cases:
+    #d 0x01, le(0x0000`16), le(0x0000`16), le(0x0000`16), 0x00
+    #d 0x01, le(0x0001`16), le(0x0001`16), le(0x0000`16), 0x00
+    #d 0x01, le(0x00ff`16), le(0x0001`16), le(0x00fe`16), 0x00
+    #d 0x01, le(0xffff`16), le(0x0001`16), le(0xfffe`16), 0x00
+    #d 0x01, le(0x1234`16), le(0x1234`16), le(0x0000`16), 0x00
+    #d 0x01, le(0x1234`16), le(0x1235`16), le(0xffff`16), 0x01
+    #d 0x01, le(0x8000`16), le(0x8000`16), le(0x0000`16), 0x00
+    #d 0x01, le(0x0100`16), le(0x00ff`16), le(0x0001`16), 0x00
+    #d 0x01, le(0x00ff`16), le(0x0100`16), le(0xffff`16), 0x01
+    #d 0x01, le(0x1200`16), le(0xff01`16), le(0x12ff`16), 0x01
+    #d 0x01, le(0xff00`16), le(0xff01`16), le(0xffff`16), 0x01
+    #d 0x01, le(0x0000`16), le(0xffff`16), le(0x0001`16), 0x01
+    #d 0x01, le(0xc350`16), le(0x9c40`16), le(0x2710`16), 0x00
+    #d 0x00
+
+cmp16_cases:
+    #d 0x01, le(0x0000`16), le(0x0000`16), 0x02
+    #d 0x01, le(0x0001`16), le(0x0001`16), 0x02
+    #d 0x01, le(0x00ff`16), le(0x0001`16), 0x00
+    #d 0x01, le(0xffff`16), le(0x0001`16), 0x00
+    #d 0x01, le(0x1234`16), le(0x1234`16), 0x02
+    #d 0x01, le(0x1234`16), le(0x1235`16), 0x01
+    #d 0x01, le(0x8000`16), le(0x8000`16), 0x02
+    #d 0x01, le(0x0100`16), le(0x00ff`16), 0x00
+    #d 0x01, le(0x00ff`16), le(0x0100`16), 0x01
+    #d 0x01, le(0x1200`16), le(0xff01`16), 0x01
+    #d 0x01, le(0xff00`16), le(0xff01`16), 0x01
+    #d 0x01, le(0x0000`16), le(0xffff`16), 0x01
+    #d 0x01, le(0xc350`16), le(0x9c40`16), 0x00
+    #d 0x00
+
+mul8_cases:
+    #d 0x01, 0x00, 0x00, le(0x0000`16)
+    #d 0x01, 0x00, 0xff, le(0x0000`16)
+    #d 0x01, 0x01, 0xff, le(0x00ff`16)
+    #d 0x01, 0xff, 0xff, le(0xfe01`16)
+    #d 0x01, 0xff, 0xfe, le(0xfd02`16)
+    #d 0x01, 0x80, 0x02, le(0x0100`16)
+    #d 0x01, 0x02, 0x80, le(0x0100`16)
+    #d 0x01, 0x10, 0x10, le(0x0100`16)
+    #d 0x01, 0xc8, 0x64, le(0x4e20`16)
+    #d 0x01, 0x64, 0xc8, le(0x4e20`16)
+    #d 0x01, 0x0d, 0x11, le(0x00dd`16)
+    #d 0x01, 0x7f, 0x81, le(0x3fff`16)
+    #d 0x01, 0x03, 0xfa, le(0x02ee`16)
+    #d 0x01, 0xfe, 0xff, le(0xfd02`16)
+    #d 0x00
+
+mul16_cases:
+    #d 0x01, le(0x0000`16), le(0x0000`16), le(0x0000`16)
+    #d 0x01, le(0x0001`16), le(0xffff`16), le(0xffff`16)
+    #d 0x01, le(0xffff`16), le(0xffff`16), le(0x0001`16)
+    #d 0x01, le(0x012c`16), le(0x00c8`16), le(0xea60`16)
+    #d 0x01, le(0x1234`16), le(0x5678`16), le(0x0060`16)
+    #d 0x01, le(0x0100`16), le(0x0100`16), le(0x0000`16)
+    #d 0x01, le(0x00ff`16), le(0x0101`16), le(0xffff`16)
+    #d 0x01, le(0x03e8`16), le(0x0041`16), le(0xfde8`16)
+    #d 0x01, le(0x00ff`16), le(0x00ff`16), le(0xfe01`16)
+    #d 0x01, le(0xabcd`16), le(0x0100`16), le(0xcd00`16)
+    #d 0x00
+
+div16_8_cases:
+    #d 0x01, le(0x0000`16), 0x01, le(0x0000`16), 0x00
+    #d 0x01, le(0xffff`16), 0x01, le(0xffff`16), 0x00
+    #d 0x01, le(0xffff`16), 0xff, le(0x0101`16), 0x00
+    #d 0x01, le(0xffff`16), 0x02, le(0x7fff`16), 0x01
+    #d 0x01, le(0x03e8`16), 0x07, le(0x008e`16), 0x06
+    #d 0x01, le(0x00ff`16), 0x10, le(0x000f`16), 0x0f
+    #d 0x01, le(0x0100`16), 0xff, le(0x0001`16), 0x01
+    #d 0x01, le(0x1234`16), 0x12, le(0x0102`16), 0x10
+    #d 0x01, le(0x0064`16), 0xc8, le(0x0000`16), 0x64
+    #d 0x01, le(0xea60`16), 0xfa, le(0x00f0`16), 0x00
+    #d 0x01, le(0x00fe`16), 0xff, le(0x0000`16), 0xfe
+    #d 0x01, le(0xff00`16), 0xff, le(0x0100`16), 0x00
+    #d 0x01, le(0xfe00`16), 0xff, le(0x00fe`16), 0xfe
+    #d 0x01, le(0x8000`16), 0x80, le(0x0100`16), 0x00
+    #d 0x00
+
+u8_to_bcd_cases:
+    #d 0x01, 0x00, 0x00, 0x00
+    #d 0x01, 0x09, 0x00, 0x09
+    #d 0x01, 0x0a, 0x00, 0x10
+    #d 0x01, 0x63, 0x00, 0x99
+    #d 0x01, 0x64, 0x01, 0x00
+    #d 0x01, 0x80, 0x01, 0x28
+    #d 0x01, 0xc7, 0x01, 0x99
+    #d 0x01, 0xc8, 0x02, 0x00
+    #d 0x01, 0xff, 0x02, 0x55
+    #d 0x01, 0x2a, 0x00, 0x42
+    #d 0x00
+
+u8_to_decimal_cases:
+    #d 0x01, 0x00, "000\0"
+    #d 0x01, 0x07, "007\0"
+    #d 0x01, 0x63, "099\0"
+    #d 0x01, 0x64, "100\0"
+    #d 0x01, 0xff, "255\0"
+    #d 0x00
+
+u16_to_decimal_cases:
+    #d 0x01, le(0x0000`16), "00000\0"
+    #d 0x01, le(0x0009`16), "00009\0"
+    #d 0x01, le(0x000a`16), "00010\0"
+    #d 0x01, le(0x0063`16), "00099\0"
+    #d 0x01, le(0x0064`16), "00100\0"
+    #d 0x01, le(0x03e7`16), "00999\0"
+    #d 0x01, le(0x03e8`16), "01000\0"
+    #d 0x01, le(0x270f`16), "09999\0"
+    #d 0x01, le(0x2710`16), "10000\0"
+    #d 0x01, le(0x3039`16), "12345\0"
+    #d 0x01, le(0x9c3f`16), "39999\0"
+    #d 0x01, le(0x9c40`16), "40000\0"
+    #d 0x01, le(0xea5f`16), "59999\0"
+    #d 0x01, le(0xea60`16), "60000\0"
+    #d 0x01, le(0xffff`16), "65535\0"
+    #d 0x00
+
+#include "./libraries/memory.asm"
+#include "./libraries/math.asm"
+#include "./libraries/format.asm"
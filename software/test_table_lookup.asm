@@ -0,0 +1,72 @@
+#include "../bleh.asm"
+
+; Looks up bytes with ld a, [i+a], from a table of hex digits and across a page
+; boundary. Writes the number of each test to the debug port when it passes,
+; 0xee when one fails and 0xff when all passed.
+
+DEBUG_PORT = 1
+
+BASE = 0xc0f8 ; 0x44 here and 0x55 at BASE + 0x10, in the next page
+
+start:
+    ; 1: every hex digit, against walking the table with j
+    ld i, hex_digits
+    ld j, hex_digits
+    ld b, 0
+
+    .digit:
+    ld a, b
+    ld a, [i+a]
+    ld c, a
+    ld a, [j++]
+    cmp a, c
+    jnz fail
+    inc b
+    cmp b, 16
+    jnz .digit
+
+    ld a, 0x0c
+    ld a, [i+a]
+    cmp a, 'c'
+    jnz fail
+
+    out DEBUG_PORT, 1
+
+    ; 2: a is unsigned and carries into the high byte
+    ld j, BASE
+    ld a, 0x44
+    ld [j], a
+    ld j, BASE + 0x10
+    ld a, 0x55
+    ld [j], a
+
+    ld i, BASE
+    ld a, 0x10
+    ld a, [i+a]
+    cmp a, 0x55
+    jnz fail
+
+    ld a, 0
+    ld a, [i+a]
+    cmp a, 0x44
+    jnz fail
+
+    ld i, BASE + 0x10 - 0xff
+    ld a, 0xff
+    ld a, [i+a]
+    cmp a, 0x55
+    jnz fail
+
+    out DEBUG_PORT, 2
+
+    out DEBUG_PORT, 0xff
+
+done:
+    jmp done
+
+fail:
+    out DEBUG_PORT, 0xee
+    jmp done
+
+hex_digits:
+    #d "0123456789abcdef"
@@ -0,0 +1,785 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h> // f*
+#include <stdlib.h> // exit
+#include <string.h> // memcpy
+
+#include "control.h"
+#include "control_verify.h"
+#include "cpu.h"
+
+#define N_TRIALS (256)
+#define N_FINAL_TRIALS (8192)
+#define MAX_EVENTS (32)
+
+typedef struct {
+    uint16_t pc;
+    uint8_t r_o;
+    uint8_t r_f;
+    uint8_t r_ls;
+    uint8_t r_rs;
+    uint8_t r_c;
+    uint8_t io_inputs[8];
+    uint8_t ram[RAM_SIZE];
+} Trial;
+
+typedef enum {
+    EVENT_RAM_LD,
+    EVENT_IO_LD,
+    EVENT_IO_OE,
+} EventType;
+
+typedef struct {
+    EventType type;
+    uint16_t address; // RAM address or IO port
+    uint8_t value; // Value before a RAM latch, value on the bus otherwise
+} Event;
+
+// Everything an instruction can leave behind for the next one.
+// LS, RS, O and C (except the IO OE flag) are always loaded before being used.
+typedef struct {
+    uint8_t r_f;
+    uint8_t r_ml;
+    uint8_t r_mh;
+    bool r_sel_m_or_c;
+    uint8_t c_oe_io;
+
+    int n_ram_lds;
+    uint16_t ram_addresses[MAX_EVENTS];
+    uint8_t ram_values[MAX_EVENTS];
+
+    int n_io_events;
+    Event io_events[MAX_EVENTS];
+} Outcome;
+
+typedef struct {
+    int n_steps;
+    uint16_t steps[N_STEPS];
+} Sequence;
+
+// What an opcode runs per F. The row is picked by F at every step, so an opcode
+// latching F midway continues in the row of the F it latched.
+typedef struct {
+    Sequence rows[16];
+} Rows;
+
+static Trial *trials;
+static Trial *extra_trial; // Trials past N_TRIALS are generated one by one into it
+
+static const Trial *current_trial;
+static int n_events;
+static Event events[MAX_EVENTS];
+static bool bus_conflict;
+
+static uint16_t optimized_flags_mask[256]; // Bit per F value, set when that opcode and F uses the optimized sequence
+static Sequence optimized[256][16];
+
+static void update_io_ld(CPU cpu) {
+    if (n_events < MAX_EVENTS) {
+        events[n_events++] = (Event){.type = EVENT_IO_LD, .address = cpu.r_o & 7, .value = cpu.data_bus};
+    }
+}
+
+static uint8_t update_io_oe(CPU cpu) {
+    uint8_t value = current_trial->io_inputs[cpu.r_o & 7];
+
+    if (n_events < MAX_EVENTS) {
+        events[n_events++] = (Event){.type = EVENT_IO_OE, .address = cpu.r_o & 7, .value = value};
+    }
+
+    return value;
+}
+
+static void update_ram_ld(uint16_t ram_address) {
+    if (n_events < MAX_EVENTS) {
+        events[n_events++] = (Event){.type = EVENT_RAM_LD, .address = ram_address, .value = ram[ram_address]};
+    } else {
+        bus_conflict = true; // Can't undo it, treat the run as broken
+    }
+}
+
+static void update_bus_conflict(CPU cpu, int n_oe) {
+    (void)cpu;
+    (void)n_oe;
+
+    bus_conflict = true;
+}
+
+static uint32_t random_state = 0x2f6b1d35;
+
+static uint32_t random_u32(void) {
+    // xorshift32
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+
+    return random_state;
+}
+
+static uint8_t random_u8(void) {
+    return (uint8_t)random_u32();
+}
+
+static uint32_t control_rom_address(uint8_t step, uint8_t r_f, uint8_t opcode, bool is_high_slice) {
+    return (uint32_t)((S_Q2(step) << PIN_STEP_2) |
+                      (S_Q1(step) << PIN_STEP_1) |
+                      (S_Q3(step) << PIN_STEP_3) |
+                      (S_Q0(step) << PIN_STEP_0) |
+                      (F_SF(r_f) << PIN_FLAG_3_SIGN) |
+                      (F_ZF(r_f) << PIN_FLAG_0_ZERO) |
+                      (F_CF(r_f) << PIN_FLAG_1_CARRY) |
+                      (F_OF(r_f) << PIN_FLAG_2_OVERFLOW) |
+                      (is_high_slice << PIN_HIGH_SLICE) |
+                      opcode);
+}
+
+static void write_signals(uint8_t step, uint8_t r_f, uint8_t opcode, uint16_t active_high_signals) {
+    uint16_t unmasked_signals = active_high_signals ^ ACTIVE_LOW_MASK;
+
+    control_rom[control_rom_address(step, r_f, opcode, false)] = (uint8_t)(unmasked_signals & 0xff);
+    control_rom[control_rom_address(step, r_f, opcode, true)] = (uint8_t)(unmasked_signals >> 8);
+}
+
+static void write_sequence(uint8_t opcode, uint16_t flags_mask, const Sequence *sequence) {
+    for (uint8_t r_f = 0; r_f < 16; ++r_f) {
+        if (!((flags_mask >> r_f) & 1)) {
+            continue;
+        }
+
+        for (uint8_t step = 0; step < N_STEPS; ++step) {
+            write_signals(step, r_f, opcode, step < sequence->n_steps ? sequence->steps[step] : HALT_NOT_LD_C);
+        }
+    }
+}
+
+static void write_rows(uint8_t opcode, uint16_t flags_mask, const Rows *rows) {
+    for (uint8_t r_f = 0; r_f < 16; ++r_f) {
+        if ((flags_mask >> r_f) & 1) {
+            write_sequence(opcode, (uint16_t)(1 << r_f), &rows->rows[r_f]);
+        }
+    }
+}
+
+static Rows rows_of(const Sequence *sequence) {
+    Rows rows;
+
+    for (int r_f = 0; r_f < 16; ++r_f) {
+        rows.rows[r_f] = *sequence;
+    }
+
+    return rows;
+}
+
+static bool ends(uint16_t signals) {
+    return (signals & (LD_S_NOT_LD_C | LD_C)) == LD_S_NOT_LD_C;
+}
+
+static Sequence reference_sequence(uint8_t opcode, uint8_t r_f) {
+    Sequence sequence = {0};
+
+    for (uint8_t step = 0; step < N_STEPS; ++step) {
+        uint16_t signals = signals_from_input(step, F_ZF(r_f), F_CF(r_f), F_OF(r_f), F_SF(r_f), opcode);
+
+        sequence.steps[sequence.n_steps++] = signals;
+
+        if (ends(signals)) {
+            break;
+        }
+    }
+
+    return sequence;
+}
+
+static bool latches_f(const Sequence *sequence) {
+    for (int i = 0; i < sequence->n_steps; ++i) {
+        if ((sequence->steps[i] & (OE_ALU | LD_LS)) == (OE_ALU | LD_LS)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void generate_trial(Trial *trial, int i) {
+    // Fill RAM (and the memory backed registers) with a pattern for the first trials to cover the edges.
+    for (size_t address = 0; address < RAM_SIZE; ++address) {
+        switch (i) {
+        case 0: trial->ram[address] = 0x00; break;
+        case 1: trial->ram[address] = 0xff; break;
+        case 2: trial->ram[address] = 0x7f; break;
+        case 3: trial->ram[address] = 0x80; break;
+        default: trial->ram[address] = random_u8(); break;
+        }
+    }
+
+    // Keep the instruction away from the registers, sometimes right before a page boundary.
+    trial->pc = (uint16_t)(RAM_ABSOLUTE_START_ADDRESS + (random_u32() % 0x7000));
+    if (i & 4) {
+        trial->pc |= 0xfe + ((i >> 3) & 1);
+    }
+
+    trial->r_o = random_u8();
+    trial->r_f = random_u8() & 0xf;
+    trial->r_ls = random_u8();
+    trial->r_rs = random_u8();
+    trial->r_c = (uint8_t)((1 << 7) | (random_u8() & 0xf)); // A previous constant, IO OE is never left on
+
+    for (int port = 0; port < 8; ++port) {
+        trial->io_inputs[port] = random_u8();
+    }
+}
+
+// Runs a single instruction placed at the trial's PC, leaving RAM modified until `undo_ram_lds`.
+static bool run_instruction(const Trial *trial, uint8_t opcode, uint8_t r_f, Outcome *outcome) {
+    current_trial = trial;
+    n_events = 0;
+    bus_conflict = false;
+
+    ram[trial->pc & (RAM_ABSOLUTE_START_ADDRESS - 1)] = opcode;
+
+    // Right after the last step of a previous instruction, S wraps to 0 on the next setup.
+    CPU cpu = {
+        .c_exec = 1,
+        .r_s = 0xf,
+        .r_o = trial->r_o,
+        .r_f = r_f,
+        .r_ls = trial->r_ls,
+        .r_rs = trial->r_rs,
+        .r_c = trial->r_c,
+        .r_ml = (uint8_t)(trial->pc & 0xff),
+        .r_mh = (uint8_t)(trial->pc >> 8),
+        .r_sel_m_or_c = 0,
+        .control_signals = ACTIVE_LOW_MASK,
+    };
+
+    cpu.alu_signals = alu_signals(cpu);
+
+    bool done = false;
+
+    for (int half_cycle = 0; half_cycle < 2 * N_STEPS && !done && !bus_conflict; ++half_cycle) {
+        cpu = cpu_half_cycle(cpu);
+
+        if (cpu.c_exec && !SIGNAL_LD_S(cpu.control_signals)) {
+            // The last step latches ML, MH, C and toggles during the next setup.
+            cpu = cpu_half_cycle(cpu);
+            done = true;
+        }
+    }
+
+    if (!done || bus_conflict) {
+        return false;
+    }
+
+    outcome->r_f = cpu.r_f;
+    outcome->r_ml = cpu.r_ml;
+    outcome->r_mh = cpu.r_mh;
+    outcome->r_sel_m_or_c = cpu.r_sel_m_or_c;
+    outcome->c_oe_io = C_OE_IO(cpu.r_c);
+
+    outcome->n_ram_lds = 0;
+    outcome->n_io_events = 0;
+
+    for (int i = 0; i < n_events; ++i) {
+        if (events[i].type == EVENT_RAM_LD) {
+            outcome->ram_addresses[outcome->n_ram_lds] = events[i].address;
+            outcome->ram_values[outcome->n_ram_lds++] = ram[events[i].address];
+        } else {
+            outcome->io_events[outcome->n_io_events++] = events[i];
+        }
+    }
+
+    return true;
+}
+
+static void undo_ram_lds(const Trial *trial) {
+    for (int i = n_events - 1; i >= 0; --i) {
+        if (events[i].type == EVENT_RAM_LD) {
+            ram[events[i].address] = events[i].value;
+        }
+    }
+
+    size_t pc_address = trial->pc & (RAM_ABSOLUTE_START_ADDRESS - 1);
+    ram[pc_address] = trial->ram[pc_address];
+}
+
+static bool same_outcome(const Outcome *a, const Outcome *b) {
+    if (a->r_f != b->r_f || a->r_ml != b->r_ml || a->r_mh != b->r_mh ||
+        a->r_sel_m_or_c != b->r_sel_m_or_c || a->c_oe_io != b->c_oe_io ||
+        a->n_io_events != b->n_io_events) {
+        return false;
+    }
+
+    for (int i = 0; i < a->n_io_events; ++i) {
+        if (a->io_events[i].type != b->io_events[i].type ||
+            a->io_events[i].address != b->io_events[i].address ||
+            a->io_events[i].value != b->io_events[i].value) {
+            return false;
+        }
+    }
+
+    // The final value of every address either of them wrote, the last write wins.
+    for (int i = 0; i < a->n_ram_lds + b->n_ram_lds; ++i) {
+        uint16_t address = i < a->n_ram_lds ? a->ram_addresses[i] : b->ram_addresses[i - a->n_ram_lds];
+
+        int a_value = -1;
+        int b_value = -1;
+
+        for (int j = 0; j < a->n_ram_lds; ++j) {
+            if (a->ram_addresses[j] == address) {
+                a_value = a->ram_values[j];
+            }
+        }
+
+        for (int j = 0; j < b->n_ram_lds; ++j) {
+            if (b->ram_addresses[j] == address) {
+                b_value = b->ram_values[j];
+            }
+        }
+
+        // Not written by one of them means the value from before the instruction.
+        if (a_value != b_value && a_value != -1 && b_value != -1) {
+            return false;
+        }
+
+        if ((a_value == -1 || b_value == -1) && (a_value == -1 ? b_value : a_value) != ram[address]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Runs the trials from the F values in flags_mask, F the trial has when it is one of them.
+static bool equivalent(uint8_t opcode, uint16_t flags_mask, const Rows *reference, const Rows *candidate, int n_trials) {
+    bool is_equivalent = true;
+
+    for (int i = 0; i < n_trials && is_equivalent; ++i) {
+        Trial *trial = &trials[i];
+
+        if (i >= N_TRIALS) {
+            trial = extra_trial;
+            generate_trial(trial, i);
+        }
+
+        uint8_t r_f = trial->r_f;
+        while (!((flags_mask >> r_f) & 1)) {
+            r_f = (r_f + 1) & 0xf;
+        }
+
+        memcpy(ram, trial->ram, RAM_SIZE);
+
+        Outcome reference_outcome;
+        write_rows(opcode, flags_mask, reference);
+        bool reference_ok = run_instruction(trial, opcode, r_f, &reference_outcome);
+        undo_ram_lds(trial);
+
+        if (!reference_ok) {
+            continue; // Not a state the reference can run from
+        }
+
+        Outcome candidate_outcome;
+        write_rows(opcode, flags_mask, candidate);
+        // RAM is back to the trial's, compare against it for addresses only one of them wrote.
+        is_equivalent = run_instruction(trial, opcode, r_f, &candidate_outcome);
+        undo_ram_lds(trial);
+
+        is_equivalent = is_equivalent && same_outcome(&reference_outcome, &candidate_outcome);
+    }
+
+    write_rows(opcode, flags_mask, reference);
+
+    return is_equivalent;
+}
+
+static bool sequence_equivalent(uint8_t opcode, uint16_t flags_mask, const Rows *reference, const Sequence *candidate, int n_trials) {
+    Rows candidate_rows = rows_of(candidate);
+
+    return equivalent(opcode, flags_mask, reference, &candidate_rows, n_trials);
+}
+
+static bool step_valid(uint16_t signals) {
+    // A step without LD_C only uses the low bits for CE_M, LD_O, LD_S, LD_RS, LD_IO and HALT.
+    bool is_halt = (signals & (HALT_NOT_LD_C | LD_C)) == HALT_NOT_LD_C;
+
+    return signals_valid(signals) && !is_halt;
+}
+
+static bool merge_signals(uint16_t a, uint16_t b, uint16_t *merged) {
+    if ((a & LD_C) && (b & LD_C) && (a & 0x3f) != (b & 0x3f)) {
+        return false; // Two different constants
+    }
+
+    if (((a ^ b) & LD_C) && ((a & LD_C) ? b : a) & 0x3f) {
+        return false; // A constant and CE_M/LD_O/LD_S/LD_RS/LD_IO at the same time
+    }
+
+    if ((a & TG_M_C) && (b & TG_M_C)) {
+        return false; // Would cancel out
+    }
+
+    *merged = a | b;
+
+    return step_valid(*merged);
+}
+
+static Sequence remove_step(const Sequence *sequence, int step) {
+    Sequence removed = {.n_steps = sequence->n_steps - 1};
+
+    for (int i = 0, j = 0; i < sequence->n_steps; ++i) {
+        if (i != step) {
+            removed.steps[j++] = sequence->steps[i];
+        }
+    }
+
+    return removed;
+}
+
+// Removes a single step from `best` by either dropping it or merging it into any earlier step (after the fetch).
+static bool improve(uint8_t opcode, uint16_t flags_mask, const Rows *reference, Sequence *best) {
+    for (int step = best->n_steps - 1; step >= 1; --step) {
+        Sequence candidate = remove_step(best, step);
+
+        bool is_last = step == best->n_steps - 1;
+
+        // The new last step must load S
+        bool can_remove = !is_last ||
+                          (step > 1 && merge_signals(candidate.steps[step - 1], LD_S_NOT_LD_C, &candidate.steps[step - 1]));
+
+        if (can_remove && sequence_equivalent(opcode, flags_mask, reference, &candidate, N_TRIALS)) {
+            *best = candidate;
+            return true;
+        }
+
+        for (int into = step - 1; into >= 1; --into) {
+            candidate = remove_step(best, step);
+
+            if (merge_signals(candidate.steps[into], best->steps[step], &candidate.steps[into]) &&
+                sequence_equivalent(opcode, flags_mask, reference, &candidate, N_TRIALS)) {
+                *best = candidate;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Greedy search, keeps the first step removal that is equivalent until none is left.
+// When stuck, swaps two adjacent steps (not the last one) if that lets another step go.
+static Sequence optimize(uint8_t opcode, uint16_t flags_mask, const Sequence *sequence) {
+    Rows reference = rows_of(sequence);
+    Sequence best = *sequence;
+
+    bool improved = true;
+
+    while (improved) {
+        improved = improve(opcode, flags_mask, &reference, &best);
+
+        for (int step = 1; step + 2 < best.n_steps && !improved; ++step) {
+            Sequence swapped = best;
+            swapped.steps[step] = best.steps[step + 1];
+            swapped.steps[step + 1] = best.steps[step];
+
+            if (sequence_equivalent(opcode, flags_mask, &reference, &swapped, N_TRIALS) &&
+                improve(opcode, flags_mask, &reference, &swapped)) {
+                best = swapped;
+                improved = true;
+            }
+        }
+    }
+
+    return best;
+}
+
+// Steps up to the one loading S when F doesn't change.
+static int path_length(const Sequence *row) {
+    for (int i = 0; i < row->n_steps; ++i) {
+        if (ends(row->steps[i])) {
+            return i + 1;
+        }
+    }
+
+    return row->n_steps;
+}
+
+static int max_path_length(const Rows *rows) {
+    int length = 0;
+
+    for (int r_f = 0; r_f < 16; ++r_f) {
+        int row_length = path_length(&rows->rows[r_f]);
+        length = row_length > length ? row_length : length;
+    }
+
+    return length;
+}
+
+// All steps of every row, a row can be entered midway from another one.
+static Rows reference_rows(uint8_t opcode) {
+    Rows rows;
+
+    for (uint8_t r_f = 0; r_f < 16; ++r_f) {
+        rows.rows[r_f].n_steps = N_STEPS;
+
+        for (uint8_t step = 0; step < N_STEPS; ++step) {
+            rows.rows[r_f].steps[step] = signals_from_input(step, F_ZF(r_f), F_CF(r_f), F_OF(r_f), F_SF(r_f), opcode);
+        }
+    }
+
+    return rows;
+}
+
+// Removes `step` from every row, dropping it or merging it into `into` (0 drops it) in the rows reaching it.
+static bool remove_rows_step(const Rows *rows, int step, int into, Rows *removed) {
+    for (int r_f = 0; r_f < 16; ++r_f) {
+        const Sequence *row = &rows->rows[r_f];
+        Sequence *candidate = &removed->rows[r_f];
+        int length = path_length(row);
+
+        *candidate = remove_step(row, step);
+
+        if (step >= length) {
+            continue;
+        }
+
+        if (into > 0) {
+            if (!merge_signals(candidate->steps[into], row->steps[step], &candidate->steps[into])) {
+                return false;
+            }
+        } else if (step == length - 1) {
+            // The new last step must load S
+            if (step == 1 || !merge_signals(candidate->steps[step - 1], LD_S_NOT_LD_C, &candidate->steps[step - 1])) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// `improve` for opcodes latching F midway, removes the same step from every row.
+static bool improve_rows(uint8_t opcode, const Rows *reference, Rows *best) {
+    for (int step = max_path_length(best) - 1; step >= 1; --step) {
+        Rows candidate;
+
+        if (remove_rows_step(best, step, 0, &candidate) &&
+            equivalent(opcode, 0xffff, reference, &candidate, N_TRIALS)) {
+            *best = candidate;
+            return true;
+        }
+
+        for (int into = step - 1; into >= 1; --into) {
+            if (remove_rows_step(best, step, into, &candidate) &&
+                equivalent(opcode, 0xffff, reference, &candidate, N_TRIALS)) {
+                *best = candidate;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// `optimize` over all rows at once, for opcodes whose rows differ after latching F.
+static Rows optimize_rows(uint8_t opcode, const Rows *reference) {
+    Rows best = *reference;
+
+    bool improved = true;
+
+    while (improved) {
+        improved = improve_rows(opcode, reference, &best);
+
+        for (int step = 1; step + 2 < max_path_length(&best) && !improved; ++step) {
+            Rows swapped = best;
+
+            for (int r_f = 0; r_f < 16; ++r_f) {
+                Sequence *row = &swapped.rows[r_f];
+
+                if (step + 2 < path_length(row)) {
+                    row->steps[step] = best.rows[r_f].steps[step + 1];
+                    row->steps[step + 1] = best.rows[r_f].steps[step];
+                }
+            }
+
+            if (equivalent(opcode, 0xffff, reference, &swapped, N_TRIALS) &&
+                improve_rows(opcode, reference, &swapped)) {
+                best = swapped;
+                improved = true;
+            }
+        }
+    }
+
+    return best;
+}
+
+static uint16_t superoptimized_signals_from_input(uint8_t step, bool zero_flag_set, bool carry_flag_set, bool overflow_flag_set, bool sign_flag_set, Opcode opcode) {
+    uint8_t r_f = (uint8_t)((sign_flag_set << 3) | (overflow_flag_set << 2) | (carry_flag_set << 1) | zero_flag_set);
+
+    if (!((optimized_flags_mask[opcode] >> r_f) & 1)) {
+        return signals_from_input(step, zero_flag_set, carry_flag_set, overflow_flag_set, sign_flag_set, opcode);
+    }
+
+    const Sequence *sequence = &optimized[opcode][r_f];
+
+    return step < sequence->n_steps ? sequence->steps[step] : HALT_NOT_LD_C;
+}
+
+static int write_to_file(const char *filename,
+                         const uint8_t (*table)[CONTROL_ROM_SIZE]) {
+    FILE *file = fopen(filename, "wb");
+
+    if (file == NULL) {
+        perror(__func__);
+        return 1;
+    }
+
+    if (fwrite(*table, sizeof(*table), 1, file) == 0) {
+        perror(__func__);
+        fclose(file);
+        return 2;
+    }
+
+    return fclose(file) == 0 ? 0 : 3;
+}
+
+int main(void) {
+    read_rom("./bin/alu_low.bin", alu_low_rom, ALU_ROM_SIZE);
+    read_rom("./bin/alu_high.bin", alu_high_rom, ALU_ROM_SIZE);
+
+    generate_table(&control_rom);
+
+    for (size_t i = 0; i < ROM_SIZE; ++i) {
+        rom[i] = random_u8();
+    }
+
+    trials = malloc(sizeof(Trial) * N_TRIALS);
+    extra_trial = malloc(sizeof(Trial));
+    assert(trials != NULL && extra_trial != NULL && "Failed to allocate trials");
+
+    for (int i = 0; i < N_TRIALS; ++i) {
+        generate_trial(&trials[i], i);
+    }
+
+    int total_before = 0;
+    int total_after = 0;
+
+    printf("OPCODE  FLAGS  STEPS BEFORE  STEPS AFTER\n");
+
+    for (int opcode = 0; opcode < 256; ++opcode) {
+        // Undefined opcodes and halt stops right after the fetch.
+        // NOP keeps its steps, it is the only way for software to wait a fixed time.
+        if (signals_from_input(1, 0, 0, 0, 0, (Opcode)opcode) == HALT_NOT_LD_C || opcode == OPCODE_NOP) {
+            continue;
+        }
+
+        // Group F values with the same reference sequence, conditional jumps have two.
+        uint16_t flags_masks[16];
+        Sequence references[16];
+        int n_groups = 0;
+        bool latches = false;
+        uint16_t done_mask = 0;
+
+        for (uint8_t r_f = 0; r_f < 16; ++r_f) {
+            if ((done_mask >> r_f) & 1) {
+                continue;
+            }
+
+            Sequence reference = reference_sequence((uint8_t)opcode, r_f);
+            uint16_t flags_mask = 0;
+
+            for (uint8_t other_r_f = r_f; other_r_f < 16; ++other_r_f) {
+                Sequence other = reference_sequence((uint8_t)opcode, other_r_f);
+
+                if (other.n_steps == reference.n_steps &&
+                    memcmp(other.steps, reference.steps, sizeof(uint16_t) * (size_t)reference.n_steps) == 0) {
+                    flags_mask |= (uint16_t)(1 << other_r_f);
+                }
+            }
+
+            done_mask |= flags_mask;
+            latches = latches || latches_f(&reference);
+            references[n_groups] = reference;
+            flags_masks[n_groups++] = flags_mask;
+        }
+
+        // A group's sequence would be continued in the row of the F it latches, so the rows
+        // are optimized together, starting from any F.
+        if (n_groups > 1 && latches) {
+            Rows reference = reference_rows((uint8_t)opcode);
+            Rows best = optimize_rows((uint8_t)opcode, &reference);
+            bool rejected = !equivalent((uint8_t)opcode, 0xffff, &reference, &best, N_FINAL_TRIALS);
+
+            if (rejected) {
+                best = reference;
+            }
+
+            for (uint8_t r_f = 0; r_f < 16; ++r_f) {
+                optimized[opcode][r_f] = best.rows[r_f];
+            }
+
+            optimized_flags_mask[opcode] = 0xffff;
+
+            for (int group = 0; group < n_groups; ++group) {
+                int before = references[group].n_steps;
+                int after = path_length(&best.rows[__builtin_ctz(flags_masks[group])]);
+                int n_flags = __builtin_popcount(flags_masks[group]);
+
+                total_before += before * n_flags;
+                total_after += after * n_flags;
+
+                if (rejected) {
+                    printf("0x%02x    %04x   %12d  rejected by final check\n", opcode, flags_masks[group], before);
+                } else {
+                    printf("0x%02x    %04x   %12d  %11d  (latches F, optimized with the other rows)\n",
+                           opcode, flags_masks[group], before, after);
+                }
+            }
+
+            continue;
+        }
+
+        for (int group = 0; group < n_groups; ++group) {
+            const Sequence *reference = &references[group];
+            uint16_t flags_mask = flags_masks[group];
+            Rows reference_in_rows = rows_of(reference);
+
+            Sequence best = optimize((uint8_t)opcode, flags_mask, reference);
+
+            if (best.n_steps < reference->n_steps &&
+                !sequence_equivalent((uint8_t)opcode, flags_mask, &reference_in_rows, &best, N_FINAL_TRIALS)) {
+                printf("0x%02x    %04x   %12d  rejected by final check\n", opcode, flags_mask, reference->n_steps);
+                best = *reference;
+            }
+
+            for (uint8_t optimized_r_f = 0; optimized_r_f < 16; ++optimized_r_f) {
+                if ((flags_mask >> optimized_r_f) & 1) {
+                    optimized[opcode][optimized_r_f] = best;
+                }
+            }
+
+            optimized_flags_mask[opcode] |= flags_mask;
+
+            int n_flags = __builtin_popcount(flags_mask);
+            total_before += reference->n_steps * n_flags;
+            total_after += best.n_steps * n_flags;
+
+            printf("0x%02x    %04x   %12d  %11d\n", opcode, flags_mask, reference->n_steps, best.n_steps);
+        }
+    }
+
+    printf("Steps summed over opcodes and flags: %d -> %d\n", total_before, total_after);
+
+    static uint8_t table[CONTROL_ROM_SIZE];
+    generate_table_with(&table, superoptimized_signals_from_input);
+
+    free(trials);
+    free(extra_trial);
+
+    static OpcodeVerification verifications[256];
+    if (verify_table((const uint8_t(*)[CONTROL_ROM_SIZE])&table, &verifications) > 0) {
+        fprintf(stderr, "The superoptimized control ROM failed verification, see ./bin/verify_control\n");
+        return 1;
+    }
+
+    return write_to_file("./bin/control_superoptimized.bin", (const uint8_t(*)[CONTROL_ROM_SIZE])&table);
+}
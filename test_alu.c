@@ -1,7 +1,11 @@
 #include <assert.h>
+#include <pthread.h> // pthread_*
+#include <stdatomic.h> // atomic_*
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h> // f*
+#include <time.h> // clock_gettime
+#include <unistd.h> // sysconf
 
 #include "alu_op.h"
 
@@ -37,6 +41,11 @@
 #define EXPECT_OF_SET (1 << 5)
 #define EXPECT_OF_CLEARED (1 << 6)
 
+// Every op is split by LS into shards that the worker threads pick up one at a time.
+#define N_LS_PER_SHARD (0x20)
+#define N_SHARDS_PER_OP (0x100 / N_LS_PER_SHARD)
+#define MAX_WORKERS (64)
+
 typedef struct {
     uint8_t ls;
     uint8_t rs;
@@ -67,6 +76,10 @@ static inline const char *alu_op_to_string(ALU_OP alu_op) {
     case ALU_OP_LS_XOR_RS: return "ALU_OP_LS_XOR_RS";
     case ALU_OP_LS_ADC_RS: return "ALU_OP_LS_ADC_RS";
     case ALU_OP_LS_SUB_RS: return "ALU_OP_LS_SUB_RS";
+    case ALU_OP_ROL_LS: return "ALU_OP_ROL_LS";
+    case ALU_OP_SAR_LS: return "ALU_OP_SAR_LS";
+    case ALU_OP_LS_SBC_RS: return "ALU_OP_LS_SBC_RS";
+    case ALU_OP_LS_ADD_RS_IF_CF: return "ALU_OP_LS_ADD_RS_IF_CF";
     case ALU_OP_SET_IO_OE_FLAG: return "ALU_OP_SET_IO_OE_FLAG";
     }
 }
@@ -86,34 +99,38 @@ static void inline print_unexpected_flag(ALU_OP alu_op, ALU_Result r, const char
             ALU_SIGNAL_Q_SF(r.alu_signals));
 }
 
-static void test_alu_op(ALU_OP alu_op, Expect (*expect_fn)(ALU_Result)) {
+static void test_alu_op_shard(ALU_OP alu_op, Expect (*expect_fn)(ALU_Result), uint16_t ls_begin, uint16_t ls_end) {
     bool success = true;
 
-    for (uint16_t ls = 0; ls < 0x100; ++ls) {
+    // The op bits are the same for every case, only the flags fed back between the slices and the operands change.
+    uint32_t op_address = (ALU_OP_5(alu_op) << 16) |
+                          (ALU_OP_4(alu_op) << 14) | (ALU_OP_3(alu_op) << 13) |
+                          (ALU_OP_2(alu_op) << 11) | (ALU_OP_1(alu_op) << 10) | (ALU_OP_0(alu_op) << 9);
+
+    for (uint16_t ls = ls_begin; ls < ls_end; ++ls) {
         for (uint16_t rs = 0; rs < 0x100; ++rs) {
             for (uint8_t in_cf = 0; in_cf < 2; ++in_cf) {
                 uint16_t alu_signals = 0;
 
+                uint32_t alu_l_operands = op_address |
+                                          (((uint32_t)in_cf & 1) << 8) |
+                                          (((uint32_t)rs & 0xf) << 4) |
+                                          (ls & 0xf);
+
+                uint32_t alu_h_operands = op_address |
+                                          (((uint32_t)in_cf & 1) << 8) |
+                                          (((uint32_t)rs >> 4) << 4) |
+                                          (ls >> 4);
+
                 uint8_t i = 0;
                 for (; i < 10; ++i) {
-                    uint32_t alu_l_address = (ALU_OP_5(alu_op) << 16) |
+                    uint32_t alu_l_address = alu_l_operands |
                                              (ALU_SIGNAL_H_QC((uint32_t)alu_signals) << 15) |
-                                             (ALU_OP_4(alu_op) << 14) | (ALU_OP_3(alu_op) << 13) |
-                                             (ALU_SIGNAL_H_QZ((uint32_t)alu_signals) << 12) |
-                                             (ALU_OP_2(alu_op) << 11) | (ALU_OP_1(alu_op) << 10) | (ALU_OP_0(alu_op) << 9) |
-                                             (((uint32_t)in_cf & 1) << 8) |
-                                             (((uint32_t)rs & 0xf) << 4) |
-                                             (ls & 0xf);
-
-                    uint32_t alu_h_address = (ALU_OP_5(alu_op) << 16) |
-                                             (ALU_SIGNAL_L_QC((uint32_t)alu_signals) << 15) |
-                                             (ALU_OP_4(alu_op) << 14) | (ALU_OP_3(alu_op) << 13) |
-                                             (ALU_SIGNAL_L_QZ((uint32_t)alu_signals) << 12) |
-                                             (ALU_OP_2(alu_op) << 11) | (ALU_OP_1(alu_op) << 10) | (ALU_OP_0(alu_op) << 9) |
-                                             (((uint32_t)in_cf & 1) << 8) |
-                                             (((uint32_t)rs >> 4) << 4) |
-                                             (ls >> 4);
+                                             (ALU_SIGNAL_H_QZ((uint32_t)alu_signals) << 12);
 
+                    uint32_t alu_h_address = alu_h_operands |
+                                             (ALU_SIGNAL_L_QC((uint32_t)alu_signals) << 15) |
+                                             (ALU_SIGNAL_L_QZ((uint32_t)alu_signals) << 12);
                     uint16_t next_alu_signals =
                         (uint16_t)((alu_high_rom[alu_h_address] << 8) |
                                    alu_low_rom[alu_l_address]);
@@ -178,12 +195,39 @@ static void test_alu_op(ALU_OP alu_op, Expect (*expect_fn)(ALU_Result)) {
             }
         }
     }
+}
+
+typedef struct {
+    ALU_OP alu_op;
+    Expect (*expect_fn)(ALU_Result);
+} ALU_Test;
+
+typedef struct {
+    ALU_Test *tests;
+    int n_tests;
+    atomic_int next_shard;
+} ALU_TestQueue;
+
+static void *test_alu_worker(void *arg) {
+    ALU_TestQueue *queue = arg;
 
-    if (success) {
-        printf("%s (%d) OK!\n", alu_op_to_string(alu_op), alu_op);
-    } else {
-        assert(false);
+    for (int shard = atomic_fetch_add(&queue->next_shard, 1);
+         shard < queue->n_tests * N_SHARDS_PER_OP;
+         shard = atomic_fetch_add(&queue->next_shard, 1)) {
+        ALU_Test *test = &queue->tests[shard / N_SHARDS_PER_OP];
+        uint16_t ls_begin = (uint16_t)((shard % N_SHARDS_PER_OP) * N_LS_PER_SHARD);
+
+        test_alu_op_shard(test->alu_op, test->expect_fn, ls_begin, (uint16_t)(ls_begin + N_LS_PER_SHARD));
     }
+
+    return NULL;
+}
+
+static double seconds_since(struct timespec start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)(now.tv_sec - start.tv_sec) + (double)(now.tv_nsec - start.tv_nsec) / 1e9;
 }
 
 static Expect expect_inc(ALU_Result r) {
@@ -319,6 +363,55 @@ static Expect expect_sub(ALU_Result r) {
     return expect;
 }
 
+static Expect expect_rol(ALU_Result r) {
+    Expect expect = {.q = (uint8_t)((r.ls << 1) | (r.ls >> 7))};
+
+    expect.flags |= ALU_SIGNAL_Q(r.alu_signals) == 0 ? EXPECT_ZF_SET : EXPECT_ZF_CLEARED;
+    expect.flags |= (r.ls >> 7) ? EXPECT_CF_SET : EXPECT_CF_CLEARED;
+    expect.flags |= EXPECT_OF_CLEARED;
+
+    return expect;
+}
+
+static Expect expect_sar(ALU_Result r) {
+    Expect expect = {.q = (uint8_t)((r.ls & 0x80) | (r.ls >> 1))};
+
+    expect.flags |= ALU_SIGNAL_Q(r.alu_signals) == 0 ? EXPECT_ZF_SET : EXPECT_ZF_CLEARED;
+    expect.flags |= (r.ls & 1) ? EXPECT_CF_SET : EXPECT_CF_CLEARED;
+    expect.flags |= EXPECT_OF_CLEARED;
+
+    return expect;
+}
+
+static Expect expect_sbc(ALU_Result r) {
+    uint16_t expect_q = (uint16_t)(r.ls - r.rs - r.in_cf);
+    Expect expect = {.q = (uint8_t)expect_q};
+
+    expect.flags |= ALU_SIGNAL_Q(r.alu_signals) == 0 ? EXPECT_ZF_SET : EXPECT_ZF_CLEARED;
+    expect.flags |= (expect_q & 0x100) ? EXPECT_CF_SET : EXPECT_CF_CLEARED;
+    expect.flags |= ((!(r.ls >> 7) && (r.rs >> 7) && (ALU_SIGNAL_Q(r.alu_signals) >> 7)) ||
+                     ((r.ls >> 7) && !(r.rs >> 7) && !(ALU_SIGNAL_Q(r.alu_signals) >> 7)))
+                        ? EXPECT_OF_SET
+                        : EXPECT_OF_CLEARED;
+
+    return expect;
+}
+
+static Expect expect_add_if_cf(ALU_Result r) {
+    uint8_t rs = r.in_cf ? r.rs : 0;
+    uint16_t expect_q = r.ls + rs;
+    Expect expect = {.q = (uint8_t)expect_q};
+
+    expect.flags |= ALU_SIGNAL_Q(r.alu_signals) == 0 ? EXPECT_ZF_SET : EXPECT_ZF_CLEARED;
+    expect.flags |= expect_q > 0xff ? EXPECT_CF_SET : EXPECT_CF_CLEARED;
+    expect.flags |= (((r.ls >> 7) && (rs >> 7) && !(ALU_SIGNAL_Q(r.alu_signals) >> 7)) ||
+                     (!(r.ls >> 7) && !(rs >> 7) && (ALU_SIGNAL_Q(r.alu_signals) >> 7)))
+                        ? EXPECT_OF_SET
+                        : EXPECT_OF_CLEARED;
+
+    return expect;
+}
+
 int main(void) {
     FILE *file = fopen("./bin/alu_low.bin", "r");
     assert(file != NULL && "Failed to read alu_low.bin");
@@ -332,19 +425,58 @@ int main(void) {
     assert(read_bytes == ALU_ROM_SIZE && "Failed to read the entire contents of alu_high.bin");
     assert(fclose(file) == 0 && "Failed to close file");
 
-    test_alu_op(ALU_OP_INC_LS, expect_inc);
-    test_alu_op(ALU_OP_SHL_LS, expect_shl);
-    test_alu_op(ALU_OP_SHR_LS, expect_shr);
-    test_alu_op(ALU_OP_NOT_LS, expect_not);
-    test_alu_op(ALU_OP_DEC_LS, expect_dec);
-    test_alu_op(ALU_OP_ROR_LS, expect_ror);
-
-    test_alu_op(ALU_OP_LS_ADD_RS, expect_add);
-    test_alu_op(ALU_OP_LS_OR_RS, expect_or);
-    test_alu_op(ALU_OP_LS_AND_RS, expect_and);
-    test_alu_op(ALU_OP_LS_XOR_RS, expect_xor);
-    test_alu_op(ALU_OP_LS_ADC_RS, expect_adc);
-    test_alu_op(ALU_OP_LS_SUB_RS, expect_sub);
+    ALU_Test tests[] = {
+        {.alu_op = ALU_OP_INC_LS, .expect_fn = expect_inc},
+        {.alu_op = ALU_OP_SHL_LS, .expect_fn = expect_shl},
+        {.alu_op = ALU_OP_SHR_LS, .expect_fn = expect_shr},
+        {.alu_op = ALU_OP_NOT_LS, .expect_fn = expect_not},
+        {.alu_op = ALU_OP_DEC_LS, .expect_fn = expect_dec},
+        {.alu_op = ALU_OP_ROR_LS, .expect_fn = expect_ror},
+
+        {.alu_op = ALU_OP_LS_ADD_RS, .expect_fn = expect_add},
+        {.alu_op = ALU_OP_LS_OR_RS, .expect_fn = expect_or},
+        {.alu_op = ALU_OP_LS_AND_RS, .expect_fn = expect_and},
+        {.alu_op = ALU_OP_LS_XOR_RS, .expect_fn = expect_xor},
+        {.alu_op = ALU_OP_LS_ADC_RS, .expect_fn = expect_adc},
+        {.alu_op = ALU_OP_LS_SUB_RS, .expect_fn = expect_sub},
+
+        {.alu_op = ALU_OP_ROL_LS, .expect_fn = expect_rol},
+        {.alu_op = ALU_OP_SAR_LS, .expect_fn = expect_sar},
+        {.alu_op = ALU_OP_LS_SBC_RS, .expect_fn = expect_sbc},
+        {.alu_op = ALU_OP_LS_ADD_RS_IF_CF, .expect_fn = expect_add_if_cf},
+    };
+
+    ALU_TestQueue queue = {
+        .tests = tests,
+        .n_tests = sizeof(tests) / sizeof(tests[0]),
+    };
+
+    long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int n_workers = n_cpus < 1 ? 1 : n_cpus > MAX_WORKERS ? MAX_WORKERS : (int)n_cpus;
+    pthread_t workers[MAX_WORKERS];
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < n_workers; ++i) {
+        int error = pthread_create(&workers[i], NULL, test_alu_worker, &queue);
+        assert(error == 0 && "Failed to create worker thread");
+    }
+
+    for (int i = 0; i < n_workers; ++i) {
+        int error = pthread_join(workers[i], NULL);
+        assert(error == 0 && "Failed to join worker thread");
+    }
+
+    double seconds = seconds_since(start);
+
+    // A failing case asserts in its worker, so reaching here means every op passed.
+    for (int i = 0; i < queue.n_tests; ++i) {
+        printf("%s (%d) OK!\n", alu_op_to_string(tests[i].alu_op), tests[i].alu_op);
+    }
+
+    printf("Tested %d ops x 0x100 LS x 0x100 RS x 2 CF in %.1f ms on %d threads\n",
+           queue.n_tests, seconds * 1000.0, n_workers);
 
     return 0;
 }
@@ -0,0 +1,82 @@
+#include <stdint.h> // uint*_t
+#include <stdio.h> // FILE, f* functions
+#include <stdlib.h> // exit
+
+#include "control_verify.h"
+
+static int write_cycles_header(const char *filename, const char *control_filename,
+                               const OpcodeVerification (*verifications)[256]) {
+    FILE *file = fopen(filename, "w");
+
+    if (file == NULL) {
+        perror(__func__);
+        return 1;
+    }
+
+    fprintf(file, "// Generated by verify_control.c from %s, do not edit.\n", control_filename);
+    fprintf(file, "#ifndef CONTROL_CYCLES_H\n");
+    fprintf(file, "#define CONTROL_CYCLES_H\n\n");
+    fprintf(file, "#include <stdint.h> // uint*_t\n\n");
+    fprintf(file, "// Clock cycles per opcode including the fetch, {fewest, most}.\n");
+    fprintf(file, "// Conditional jumps take the most when taken. {0, 0} for opcodes halting the clock.\n");
+    fprintf(file, "static const uint8_t opcode_cycles[256][2] = {\n");
+
+    for (int opcode = 0; opcode < 256; ++opcode) {
+        const OpcodeVerification *verification = &(*verifications)[opcode];
+
+        fprintf(file, "    [0x%02x] = {%d, %d},\n", opcode, verification->min_steps, verification->max_steps);
+    }
+
+    fprintf(file, "};\n\n");
+    fprintf(file, "#endif\n");
+
+    return fclose(file) == 0 ? 0 : 2;
+}
+
+int main(int argc, char **argv) {
+    const char *control_filename = argc > 1 ? argv[1] : "./bin/control.bin";
+
+    static uint8_t table[CONTROL_ROM_SIZE];
+
+    FILE *file = fopen(control_filename, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Failed to read %s\n", control_filename);
+        exit(1);
+    }
+
+    if (fread(table, sizeof(uint8_t), CONTROL_ROM_SIZE, file) != CONTROL_ROM_SIZE) {
+        fprintf(stderr, "Failed to read the entire contents of %s\n", control_filename);
+        exit(1);
+    }
+
+    fclose(file);
+
+    static OpcodeVerification verifications[256];
+    int n_errors = verify_table((const uint8_t(*)[CONTROL_ROM_SIZE])&table, &verifications);
+
+    printf("OPCODE  CYCLES\n");
+
+    for (int opcode = 0; opcode < 256; ++opcode) {
+        const OpcodeVerification *verification = &verifications[opcode];
+
+        if (verification->error != VERIFY_OK) {
+            printf("0x%02x    step %d with flags %x %s\n", opcode,
+                   verification->error_step, verification->error_flags,
+                   verify_error_string(verification->error));
+        } else if (verification->halts && verification->max_steps == 0) {
+            continue; // Undefined opcodes and halt
+        } else if (verification->min_steps != verification->max_steps) {
+            printf("0x%02x    %d/%d\n", opcode, verification->min_steps, verification->max_steps);
+        } else {
+            printf("0x%02x    %d\n", opcode, verification->min_steps);
+        }
+    }
+
+    if (n_errors > 0) {
+        fprintf(stderr, "%d opcodes failed verification\n", n_errors);
+        return 1;
+    }
+
+    return write_cycles_header("control_cycles.h", control_filename,
+                               (const OpcodeVerification(*)[256])&verifications);
+}